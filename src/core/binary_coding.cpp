@@ -0,0 +1,84 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "core/binary_coding.h"
+
+namespace fastonosql {
+namespace core {
+
+void PutFixed32(uint32_t val, std::string* out) {
+  for (size_t i = 0; i < 4; ++i) {
+    out->push_back(static_cast<char>((val >> (8 * i)) & 0xFF));
+  }
+}
+
+void PutFixed64(uint64_t val, std::string* out) {
+  for (size_t i = 0; i < 8; ++i) {
+    out->push_back(static_cast<char>((val >> (8 * i)) & 0xFF));
+  }
+}
+
+uint32_t GetFixed32(const uint8_t* data) {
+  uint32_t val = 0;
+  for (size_t i = 0; i < 4; ++i) {
+    val |= static_cast<uint32_t>(data[i]) << (8 * i);
+  }
+  return val;
+}
+
+uint64_t GetFixed64(const uint8_t* data) {
+  uint64_t val = 0;
+  for (size_t i = 0; i < 8; ++i) {
+    val |= static_cast<uint64_t>(data[i]) << (8 * i);
+  }
+  return val;
+}
+
+void PutVarint(uint64_t val, std::string* out) {
+  while (val >= 0x80) {
+    out->push_back(static_cast<char>(val | 0x80));
+    val >>= 7;
+  }
+  out->push_back(static_cast<char>(val));
+}
+
+bool GetVarint(const uint8_t** data, const uint8_t* end, uint64_t* val) {
+  uint64_t result = 0;
+  for (unsigned shift = 0; shift < 64 && *data < end; shift += 7) {
+    const uint64_t byte = **data;
+    ++(*data);
+    result |= (byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      *val = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+uint64_t ZigzagEncode(int64_t val) {
+  return (static_cast<uint64_t>(val) << 1) ^ static_cast<uint64_t>(val >> 63);
+}
+
+int64_t ZigzagDecode(uint64_t val) {
+  return static_cast<int64_t>(val >> 1) ^ -static_cast<int64_t>(val & 1);
+}
+
+}  // namespace core
+}  // namespace fastonosql
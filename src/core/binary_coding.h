@@ -0,0 +1,42 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <stdint.h>  // for uint32_t, uint64_t
+
+#include <string>  // for string
+
+namespace fastonosql {
+namespace core {
+
+// Little-endian fixed and LEB128 variable length integers of the on-disk formats.
+void PutFixed32(uint32_t val, std::string* out);
+void PutFixed64(uint64_t val, std::string* out);
+uint32_t GetFixed32(const uint8_t* data);
+uint64_t GetFixed64(const uint8_t* data);
+
+void PutVarint(uint64_t val, std::string* out);
+bool GetVarint(const uint8_t** data, const uint8_t* end, uint64_t* val);  // advances data
+
+uint64_t ZigzagEncode(int64_t val);
+int64_t ZigzagDecode(uint64_t val);
+
+}  // namespace core
+}  // namespace fastonosql
@@ -34,7 +34,7 @@ auto count_space(const std::string& data) -> std::string::difference_type {
 namespace fastonosql {
 namespace core {
 
-common::Error TestArgsInRange(const CommandInfo& cmd, commands_args_t argv) {
+common::Error TestArgsInRange(const CommandInfo& cmd, const commands_args_t& argv) {
   const size_t argc = argv.size();
   const uint16_t max = cmd.MaxArgumentsCount();
   const uint16_t min = cmd.MinArgumentsCount();
@@ -48,7 +48,7 @@ common::Error TestArgsInRange(const CommandInfo& cmd, commands_args_t argv) {
   return common::Error();
 }
 
-common::Error TestArgsModule2Equal1(const CommandInfo& cmd, commands_args_t argv) {
+common::Error TestArgsModule2Equal1(const CommandInfo& cmd, const commands_args_t& argv) {
   const size_t argc = argv.size();
   if (argc % 2 != 1) {
     std::string buff = common::MemSPrintf(
@@ -73,25 +73,26 @@ CommandHolder::CommandHolder(const std::string& name,
       white_spaces_count_(count_space(name)),
       test_funcs_(tests) {}
 
-bool CommandHolder::IsCommand(commands_args_t argv, size_t* offset) const {
+bool CommandHolder::IsCommand(const commands_args_t& argv, size_t* offset) const {
   if (argv.empty()) {
     return false;
   }
 
   const size_t uargc = argv.size();
-  if (uargc == white_spaces_count_) {
+  if (uargc <= white_spaces_count_) {
     return false;
   }
 
-  CHECK(uargc > white_spaces_count_);
-  std::vector<command_buffer_t> merged;
-  for (size_t i = 0; i < white_spaces_count_ + 1; ++i) {
-    merged.push_back(argv[i]);
-  }
-
-  command_buffer_t ws = common::JoinString(merged, " ");
-  if (!IsEqualName(ws)) {
-    return false;
+  if (white_spaces_count_ == 0) {  // most commands are one word, compare without joining
+    if (!IsEqualName(argv[0])) {
+      return false;
+    }
+  } else {
+    std::vector<command_buffer_t> merged(argv.begin(), argv.begin() + white_spaces_count_ + 1);
+    command_buffer_t ws = common::JoinString(merged, " ");
+    if (!IsEqualName(ws)) {
+      return false;
+    }
   }
 
   if (offset) {
@@ -100,10 +101,9 @@ bool CommandHolder::IsCommand(commands_args_t argv, size_t* offset) const {
   return true;
 }
 
-common::Error CommandHolder::TestArgs(commands_args_t argv) const {
-  const CommandInfo inf = *this;
-  for (test_function_t func : test_funcs_) {
-    common::Error err = func(inf, argv);
+common::Error CommandHolder::TestArgs(const commands_args_t& argv) const {
+  for (const test_function_t& func : test_funcs_) {
+    common::Error err = func(*this, argv);
     if (err && err->IsError()) {
       return err;
     }
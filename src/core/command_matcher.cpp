@@ -0,0 +1,176 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "core/command_matcher.h"
+
+#include <algorithm>  // for lower_bound, sort
+#include <queue>      // for queue
+
+namespace {
+
+const uint32_t root_node = 0;
+const uint32_t no_node = static_cast<uint32_t>(-1);
+
+unsigned char toLowerAscii(unsigned char c) {
+  return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c - 'A' + 'a') : c;
+}
+
+bool isTokenDelimiter(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+}  // namespace
+
+namespace fastonosql {
+namespace core {
+
+CommandMatcher::Node::Node() : edges(), fail(root_node), output(no_node), pattern_index(0), depth(0), terminal(false) {}
+
+CommandMatcher::CommandMatcher(const std::vector<std::string>& patterns) : nodes_(1), patterns_count_(0) {
+  for (size_t i = 0; i < patterns.size(); ++i) {
+    AddPattern(patterns[i], i);
+  }
+  BuildLinks();
+}
+
+size_t CommandMatcher::PatternsCount() const {
+  return patterns_count_;
+}
+
+uint32_t CommandMatcher::FindEdge(uint32_t node, unsigned char symbol) const {
+  const auto& edges = nodes_[node].edges;
+  auto it = std::lower_bound(edges.begin(), edges.end(), symbol,
+                             [](const std::pair<unsigned char, uint32_t>& edge, unsigned char sym) {
+                               return edge.first < sym;
+                             });
+  if (it == edges.end() || it->first != symbol) {
+    return no_node;
+  }
+
+  return it->second;
+}
+
+uint32_t CommandMatcher::Step(uint32_t node, unsigned char symbol) const {
+  while (true) {
+    uint32_t next = FindEdge(node, symbol);
+    if (next != no_node) {
+      return next;
+    }
+
+    if (node == root_node) {
+      return root_node;
+    }
+    node = nodes_[node].fail;
+  }
+}
+
+void CommandMatcher::AddPattern(const std::string& pattern, size_t index) {
+  if (pattern.empty()) {
+    return;
+  }
+
+  uint32_t node = root_node;
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    const unsigned char symbol = toLowerAscii(pattern[i]);
+    uint32_t next = FindEdge(node, symbol);
+    if (next == no_node) {
+      next = static_cast<uint32_t>(nodes_.size());
+      nodes_.push_back(Node());
+      nodes_[next].depth = nodes_[node].depth + 1;
+      auto& edges = nodes_[node].edges;
+      auto pos = std::lower_bound(edges.begin(), edges.end(), std::make_pair(symbol, uint32_t(0)));
+      edges.insert(pos, std::make_pair(symbol, next));
+    }
+    node = next;
+  }
+
+  if (!nodes_[node].terminal) {  // first registration wins for duplicated names
+    nodes_[node].terminal = true;
+    nodes_[node].pattern_index = index;
+    patterns_count_++;
+  }
+}
+
+void CommandMatcher::BuildLinks() {
+  std::queue<uint32_t> pending;
+  for (const auto& edge : nodes_[root_node].edges) {
+    nodes_[edge.second].fail = root_node;
+    pending.push(edge.second);
+  }
+
+  while (!pending.empty()) {
+    const uint32_t node = pending.front();
+    pending.pop();
+
+    const Node& current = nodes_[node];
+    nodes_[node].output = current.terminal ? node : nodes_[current.fail].output;
+    for (const auto& edge : current.edges) {
+      uint32_t fallback = current.fail;
+      uint32_t target = FindEdge(fallback, edge.first);
+      while (target == no_node && fallback != root_node) {
+        fallback = nodes_[fallback].fail;
+        target = FindEdge(fallback, edge.first);
+      }
+      nodes_[edge.second].fail = target == no_node ? root_node : target;
+      pending.push(edge.second);
+    }
+  }
+}
+
+CommandMatcher::matches_t CommandMatcher::FindAll(const char* text, size_t size) const {
+  matches_t candidates;
+  if (!text || size == 0 || patterns_count_ == 0) {
+    return candidates;
+  }
+
+  uint32_t state = root_node;
+  for (size_t pos = 0; pos < size; ++pos) {
+    state = Step(state, toLowerAscii(text[pos]));
+    const size_t end = pos + 1;
+    if (end != size && !isTokenDelimiter(text[end])) {
+      continue;
+    }
+
+    for (uint32_t out = nodes_[state].output; out != no_node; out = nodes_[nodes_[out].fail].output) {
+      const Node& hit = nodes_[out];
+      const size_t offset = end - hit.depth;
+      if (offset == 0 || isTokenDelimiter(text[offset - 1])) {
+        candidates.push_back({offset, hit.depth, hit.pattern_index});
+      }
+    }
+  }
+
+  std::sort(candidates.begin(), candidates.end(), [](const Match& lhs, const Match& rhs) {
+    return lhs.offset == rhs.offset ? lhs.length > rhs.length : lhs.offset < rhs.offset;
+  });
+
+  matches_t result;
+  size_t covered = 0;
+  for (const Match& match : candidates) {
+    if (match.offset < covered) {
+      continue;
+    }
+    result.push_back(match);
+    covered = match.offset + match.length;
+  }
+  return result;
+}
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,72 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint32_t
+
+#include <string>  // for string
+#include <vector>  // for vector
+
+namespace fastonosql {
+namespace core {
+
+// Case-insensitive multi-pattern matcher (Aho-Corasick automaton) over command names,
+// built once per command set and run in a single pass over the text.
+// Only matches which start and end on token boundaries are reported.
+class CommandMatcher {
+ public:
+  struct Match {
+    size_t offset;
+    size_t length;
+    size_t pattern_index;
+  };
+  typedef std::vector<Match> matches_t;
+
+  explicit CommandMatcher(const std::vector<std::string>& patterns);
+
+  // leftmost-longest, non-overlapping matches ordered by offset
+  matches_t FindAll(const char* text, size_t size) const;
+
+  size_t PatternsCount() const;
+
+ private:
+  struct Node {
+    Node();
+
+    std::vector<std::pair<unsigned char, uint32_t>> edges;  // sorted by symbol
+    uint32_t fail;
+    uint32_t output;  // nearest node (self included) on the fail chain ending a pattern
+    size_t pattern_index;
+    size_t depth;
+    bool terminal;
+  };
+
+  uint32_t FindEdge(uint32_t node, unsigned char symbol) const;
+  uint32_t Step(uint32_t node, unsigned char symbol) const;
+  void AddPattern(const std::string& pattern, size_t index);
+  void BuildLinks();
+
+  std::vector<Node> nodes_;
+  size_t patterns_count_;
+};
+
+}  // namespace core
+}  // namespace fastonosql
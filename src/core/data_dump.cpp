@@ -0,0 +1,828 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/data_dump.h"
+
+#include <inttypes.h>  // for PRIu64
+#include <stdlib.h>    // for strtoll
+#include <string.h>    // for memchr, strcasecmp
+
+#ifdef OS_WIN
+#include <io.h>  // for _chsize_s, _fileno
+#else
+#include <unistd.h>  // for ftruncate
+#endif
+
+#include <algorithm>  // for min
+
+#include <json-c/json_object.h>
+#include <json-c/json_tokener.h>
+
+#include <zlib.h>  // for compress2, uncompress, crc32
+
+#include <common/sprintf.h>  // for MemSPrintf
+
+#include "core/binary_coding.h"  // for PutVarint, GetVarint
+#include "core/types.h"           // for ParseCommandLine
+
+#define DUMP_ARCHIVE_MAGIC "FNBACKUP"
+#define DUMP_ARCHIVE_VERSION 1
+#define DUMP_ARCHIVE_HEADER_SIZE 12
+#define DUMP_ARCHIVE_CHUNK_HEADER_SIZE 20
+#define DUMP_ARCHIVE_MAX_CHUNK_SIZE (4 * DUMP_ARCHIVE_CHUNK_SIZE)  // flushed even without resume position
+
+namespace fastonosql {
+namespace core {
+namespace {
+
+struct ChunkHeader {
+  uint32_t crc;
+  uint32_t records;
+  uint32_t raw_size;
+  uint32_t packed_size;
+  uint32_t position_size;
+};
+
+std::string makeArchiveHeader(connectionTypes type, DumpValueEncoding encoding) {
+  std::string header(DUMP_ARCHIVE_MAGIC);
+  header.push_back(static_cast<char>(DUMP_ARCHIVE_VERSION));
+  header.push_back(static_cast<char>(type));
+  header.push_back(static_cast<char>(encoding));
+  header.push_back(0);
+  return header;
+}
+
+bool parseArchiveHeader(const std::string& header, connectionTypes* type, DumpValueEncoding* encoding) {
+  if (header.size() != DUMP_ARCHIVE_HEADER_SIZE || header.compare(0, 8, DUMP_ARCHIVE_MAGIC) != 0 ||
+      header[8] != DUMP_ARCHIVE_VERSION || header[10] > DUMP_REDIS_VALUES) {
+    return false;
+  }
+
+  *type = static_cast<connectionTypes>(header[9]);
+  *encoding = static_cast<DumpValueEncoding>(header[10]);
+  return true;
+}
+
+ChunkHeader parseChunkHeader(const std::string& data) {
+  const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data.data());
+  ChunkHeader header;
+  header.crc = GetFixed32(ptr);
+  header.records = GetFixed32(ptr + 4);
+  header.raw_size = GetFixed32(ptr + 8);
+  header.packed_size = GetFixed32(ptr + 12);
+  header.position_size = GetFixed32(ptr + 16);
+  return header;
+}
+
+// crc covers everything after the crc field
+uint32_t chunkCrc(const std::string& header, const std::string& position, const std::string& packed) {
+  uLong crc = crc32(0L, Z_NULL, 0);
+  crc = crc32(crc, reinterpret_cast<const Bytef*>(header.data()) + 4, DUMP_ARCHIVE_CHUNK_HEADER_SIZE - 4);
+  crc = crc32(crc, reinterpret_cast<const Bytef*>(position.data()), position.size());
+  crc = crc32(crc, reinterpret_cast<const Bytef*>(packed.data()), packed.size());
+  return static_cast<uint32_t>(crc);
+}
+
+// 64 bit offsets, backups of big databases are bigger than 2 GiB
+int seekFile(FILE* file, int64_t offset, int whence) {
+#ifdef OS_WIN
+  return _fseeki64(file, offset, whence);
+#else
+  return fseeko(file, static_cast<off_t>(offset), whence);
+#endif
+}
+
+int64_t tellFile(FILE* file) {
+#ifdef OS_WIN
+  return _ftelli64(file);
+#else
+  return ftello(file);
+#endif
+}
+
+int truncateFile(FILE* file, int64_t size) {
+  if (fflush(file) != 0) {
+    return -1;
+  }
+#ifdef OS_WIN
+  return _chsize_s(_fileno(file), size);
+#else
+  return ftruncate(fileno(file), static_cast<off_t>(size));
+#endif
+}
+
+bool readString(FILE* file, size_t size, std::string* out) {
+  out->resize(size);
+  return size == 0 || fread(&(*out)[0], 1, size, file) == size;
+}
+
+bool hasExtension(const std::string& path, const char* ext) {
+  const size_t ext_len = strlen(ext);
+  return path.size() > ext_len && strcasecmp(path.c_str() + path.size() - ext_len, ext) == 0;
+}
+
+bool isCommand(const command_buffer_t& arg, const char* name) {
+  return strcasecmp(arg.c_str(), name) == 0;
+}
+
+bool parseInteger(const std::string& str, long long* out) {
+  if (str.empty()) {
+    return false;
+  }
+
+  char* end = nullptr;
+  long long val = strtoll(str.c_str(), &end, 10);
+  if (*end != '\0') {
+    return false;
+  }
+
+  *out = val;
+  return true;
+}
+
+ttl_t msecToTTL(long long msec) {
+  return (msec + 999) / 1000;  // keys shouldn't expire earlier than asked
+}
+
+NDbKValue makeRecord(const std::string& key, const std::string& value, ttl_t ttl) {
+  NValue val(common::Value::CreateStringValue(value));
+  return NDbKValue(NKey(key_t(key), ttl), val);
+}
+
+// splits one CSV row, returns false if a quoted field continues on the next line
+bool splitCsvRow(const std::string& row, std::vector<std::string>* fields, std::string* field, bool* quoted) {
+  for (size_t i = 0; i < row.size(); ++i) {
+    const char c = row[i];
+    if (*quoted) {
+      if (c != '"') {
+        *field += c;
+      } else if (i + 1 < row.size() && row[i + 1] == '"') {
+        *field += '"';
+        ++i;
+      } else {
+        *quoted = false;
+      }
+    } else if (c == '"') {
+      *quoted = true;
+    } else if (c == ',') {
+      fields->push_back(*field);
+      field->clear();
+    } else {
+      *field += c;
+    }
+  }
+
+  if (*quoted) {
+    *field += '\n';
+    return false;
+  }
+
+  fields->push_back(*field);
+  field->clear();
+  return true;
+}
+
+}  // namespace
+
+bool DumpFormatFromPath(const std::string& path, DumpFormat* format) {
+  if (!format) {
+    return false;
+  }
+
+  if (hasExtension(path, ".resp") || hasExtension(path, ".aof") || hasExtension(path, ".txt")) {
+    *format = DUMP_RESP;
+    return true;
+  }
+
+  if (hasExtension(path, ".jsonl") || hasExtension(path, ".json")) {
+    *format = DUMP_JSON_LINES;
+    return true;
+  }
+
+  if (hasExtension(path, ".csv")) {
+    *format = DUMP_CSV;
+    return true;
+  }
+
+  if (hasExtension(path, DUMP_ARCHIVE_EXTENSION)) {
+    *format = DUMP_ARCHIVE;
+    return true;
+  }
+
+  return false;
+}
+
+DumpReader::DumpReader(DumpFormat format)
+    : format_(format),
+      file_(nullptr),
+      buffer_(DUMP_READ_BUFFER_SIZE),
+      buffer_pos_(0),
+      buffer_len_(0),
+      bytes_read_(0),
+      size_(0),
+      line_number_(0),
+      encoding_(DUMP_RAW_VALUES),
+      chunk_(),
+      chunk_pos_(0) {}
+
+DumpReader::~DumpReader() {
+  Close();
+}
+
+common::Error DumpReader::Open(const std::string& path) {
+  Close();
+  file_ = fopen(path.c_str(), "rb");
+  if (!file_) {
+    return common::make_error_value("Can't open dump file: " + path, common::ErrorValue::E_ERROR);
+  }
+
+  if (seekFile(file_, 0, SEEK_END) == 0) {
+    int64_t size = tellFile(file_);
+    size_ = size > 0 ? static_cast<uint64_t>(size) : 0;
+  }
+  rewind(file_);
+
+  if (format_ == DUMP_ARCHIVE) {
+    std::string header;
+    connectionTypes type;
+    if (!ReadBytes(DUMP_ARCHIVE_HEADER_SIZE, &header) || !parseArchiveHeader(header, &type, &encoding_)) {
+      Close();
+      return common::make_error_value("Not a backup archive: " + path, common::ErrorValue::E_ERROR);
+    }
+  }
+  return common::Error();
+}
+
+void DumpReader::Close() {
+  if (file_) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+
+  buffer_pos_ = 0;
+  buffer_len_ = 0;
+  bytes_read_ = 0;
+  size_ = 0;
+  line_number_ = 0;
+  encoding_ = DUMP_RAW_VALUES;
+  chunk_.clear();
+  chunk_pos_ = 0;
+}
+
+common::Error DumpReader::Next(NDbKValue* record, bool* eof) {
+  if (!record || !eof) {
+    DNOTREACHED();
+    return common::make_inval_error_value(common::ErrorValue::E_ERROR);
+  }
+
+  if (!file_) {
+    return common::make_error_value("Dump file not opened", common::ErrorValue::E_ERROR);
+  }
+
+  *eof = false;
+  if (format_ == DUMP_JSON_LINES) {
+    return NextJsonLine(record, eof);
+  } else if (format_ == DUMP_CSV) {
+    return NextCsv(record, eof);
+  } else if (format_ == DUMP_ARCHIVE) {
+    return NextArchive(record, eof);
+  }
+
+  return NextResp(record, eof);
+}
+
+uint64_t DumpReader::BytesRead() const {
+  return bytes_read_;
+}
+
+uint64_t DumpReader::Size() const {
+  return size_;
+}
+
+size_t DumpReader::LineNumber() const {
+  return line_number_;
+}
+
+DumpValueEncoding DumpReader::ValueEncoding() const {
+  return encoding_;
+}
+
+bool DumpReader::FillBuffer() {
+  if (!file_) {
+    return false;
+  }
+
+  buffer_pos_ = 0;
+  buffer_len_ = fread(buffer_.data(), 1, buffer_.size(), file_);
+  return buffer_len_ != 0;
+}
+
+bool DumpReader::ReadLine(std::string* line) {
+  line->clear();
+  bool has_data = false;
+  while (true) {
+    if (buffer_pos_ == buffer_len_ && !FillBuffer()) {
+      if (!has_data) {
+        return false;
+      }
+      break;
+    }
+
+    has_data = true;
+    const char* start = buffer_.data() + buffer_pos_;
+    const size_t avail = buffer_len_ - buffer_pos_;
+    const char* end = static_cast<const char*>(memchr(start, '\n', avail));
+    if (end) {
+      const size_t len = end - start;
+      line->append(start, len);
+      buffer_pos_ += len + 1;
+      bytes_read_ += len + 1;
+      break;
+    }
+
+    line->append(start, avail);
+    buffer_pos_ = buffer_len_;
+    bytes_read_ += avail;
+  }
+
+  if (!line->empty() && (*line)[line->size() - 1] == '\r') {
+    line->pop_back();
+  }
+  line_number_++;
+  return true;
+}
+
+bool DumpReader::ReadBytes(size_t count, std::string* out) {
+  out->clear();
+  out->reserve(count);
+  while (out->size() < count) {
+    if (buffer_pos_ == buffer_len_ && !FillBuffer()) {
+      return false;
+    }
+
+    const size_t chunk = std::min(count - out->size(), buffer_len_ - buffer_pos_);
+    out->append(buffer_.data() + buffer_pos_, chunk);
+    buffer_pos_ += chunk;
+    bytes_read_ += chunk;
+  }
+
+  return true;
+}
+
+common::Error DumpReader::NextResp(NDbKValue* record, bool* eof) {
+  std::string line;
+  while (true) {
+    if (!ReadLine(&line)) {
+      *eof = true;
+      return common::Error();
+    }
+
+    if (line.empty()) {
+      continue;
+    }
+
+    commands_args_t argv;
+    if (line[0] == '*') {
+      long long argc = 0;
+      if (!parseInteger(line.substr(1), &argc) || argc < 0) {
+        return MakeParseError("invalid multibulk length");
+      }
+
+      for (long long i = 0; i < argc; ++i) {
+        long long len = 0;
+        if (!ReadLine(&line) || line.empty() || line[0] != '$' || !parseInteger(line.substr(1), &len) || len < 0) {
+          return MakeParseError("invalid bulk length");
+        }
+
+        std::string arg;
+        if (!ReadBytes(static_cast<size_t>(len), &arg) || !ReadLine(&line) || !line.empty()) {
+          return MakeParseError("unexpected end of bulk string");
+        }
+        argv.push_back(arg);
+      }
+    } else if (!ParseCommandLine(line, &argv)) {
+      return MakeParseError("invalid inline command");
+    }
+
+    if (argv.empty()) {
+      continue;
+    }
+
+    // records go to the current database, transactions of AOF files don't matter for import
+    const command_buffer_t name = argv[0];
+    if (isCommand(name, "SELECT") || isCommand(name, "MULTI") || isCommand(name, "EXEC")) {
+      continue;
+    }
+
+    long long num = 0;
+    if (isCommand(name, "SET") && argv.size() >= 3) {
+      ttl_t ttl = NO_TTL;
+      for (size_t i = 3; i < argv.size(); i += 2) {
+        if (i + 1 == argv.size() || !parseInteger(argv[i + 1], &num) || num <= 0) {
+          return MakeParseError("invalid SET expire time");
+        }
+
+        if (isCommand(argv[i], "EX")) {
+          ttl = num;
+        } else if (isCommand(argv[i], "PX")) {
+          ttl = msecToTTL(num);
+        } else {
+          return MakeParseError("unsupported SET option " + argv[i]);
+        }
+      }
+
+      *record = makeRecord(argv[1], argv[2], ttl);
+      return common::Error();
+    } else if ((isCommand(name, "SETEX") || isCommand(name, "PSETEX")) && argv.size() == 4) {
+      if (!parseInteger(argv[2], &num) || num <= 0) {
+        return MakeParseError("invalid expire time");
+      }
+
+      *record = makeRecord(argv[1], argv[3], isCommand(name, "SETEX") ? num : msecToTTL(num));
+      return common::Error();
+    }
+
+    return MakeParseError("unsupported command " + name);
+  }
+}
+
+common::Error DumpReader::NextJsonLine(NDbKValue* record, bool* eof) {
+  std::string line;
+  while (true) {
+    if (!ReadLine(&line)) {
+      *eof = true;
+      return common::Error();
+    }
+
+    if (line.find_first_not_of(" \t") == std::string::npos) {
+      continue;
+    }
+
+    json_object* obj = json_tokener_parse(line.c_str());
+    if (!obj) {
+      return MakeParseError("invalid json");
+    }
+
+    json_object* jkey = nullptr;
+    json_object* jvalue = nullptr;
+    if (!json_object_object_get_ex(obj, "key", &jkey) || !json_object_is_type(jkey, json_type_string) ||
+        !json_object_object_get_ex(obj, "value", &jvalue)) {
+      json_object_put(obj);
+      return MakeParseError("key and value fields expected");
+    }
+
+    ttl_t ttl = NO_TTL;
+    json_object* jttl = nullptr;
+    if (json_object_object_get_ex(obj, "ttl", &jttl) && json_object_is_type(jttl, json_type_int)) {
+      long long num = json_object_get_int64(jttl);
+      if (num > 0) {
+        ttl = num;
+      }
+    }
+
+    const std::string key(json_object_get_string(jkey), json_object_get_string_len(jkey));
+    std::string value;
+    if (json_object_is_type(jvalue, json_type_string)) {
+      value.assign(json_object_get_string(jvalue), json_object_get_string_len(jvalue));
+    } else if (!json_object_is_type(jvalue, json_type_null)) {
+      value = json_object_to_json_string_ext(jvalue, JSON_C_TO_STRING_PLAIN);  // numbers, objects as json text
+    }
+    json_object_put(obj);
+
+    *record = makeRecord(key, value, ttl);
+    return common::Error();
+  }
+}
+
+common::Error DumpReader::NextCsv(NDbKValue* record, bool* eof) {
+  std::string line;
+  while (true) {
+    std::vector<std::string> fields;
+    std::string field;
+    bool quoted = false;
+    bool has_row = false;
+    while (ReadLine(&line)) {
+      has_row = true;
+      if (splitCsvRow(line, &fields, &field, &quoted)) {
+        break;
+      }
+    }
+
+    if (!has_row) {
+      *eof = true;
+      return common::Error();
+    }
+
+    if (quoted) {
+      return MakeParseError("unterminated quoted field");
+    }
+
+    if (fields.size() == 1 && fields[0].empty()) {
+      continue;
+    }
+
+    if (fields.size() < 2 || fields.size() > 3) {
+      return MakeParseError("key,value[,ttl] row expected");
+    }
+
+    const bool header = line_number_ == 1 && fields[0] == "key" && fields[1] == "value";
+    if (header) {
+      continue;
+    }
+
+    ttl_t ttl = NO_TTL;
+    long long num = 0;
+    if (fields.size() == 3 && !fields[2].empty()) {
+      if (!parseInteger(fields[2], &num)) {
+        return MakeParseError("invalid ttl");
+      }
+      if (num > 0) {
+        ttl = num;
+      }
+    }
+
+    *record = makeRecord(fields[0], fields[1], ttl);
+    return common::Error();
+  }
+}
+
+common::Error DumpReader::NextArchive(NDbKValue* record, bool* eof) {
+  if (chunk_pos_ == chunk_.size()) {
+    std::string header_data;
+    if (!ReadBytes(DUMP_ARCHIVE_CHUNK_HEADER_SIZE, &header_data)) {
+      return common::make_error_value("Unfinished backup archive", common::ErrorValue::E_ERROR);
+    }
+
+    const ChunkHeader header = parseChunkHeader(header_data);
+    std::string position;
+    std::string packed;
+    if (!ReadBytes(header.position_size, &position) || !ReadBytes(header.packed_size, &packed) ||
+        chunkCrc(header_data, position, packed) != header.crc) {
+      return common::make_error_value("Damaged backup archive chunk", common::ErrorValue::E_ERROR);
+    }
+
+    if (header.records == 0) {
+      *eof = true;
+      return common::Error();
+    }
+
+    chunk_.resize(header.raw_size);
+    uLongf raw_size = header.raw_size;
+    if (uncompress(reinterpret_cast<Bytef*>(&chunk_[0]), &raw_size, reinterpret_cast<const Bytef*>(packed.data()),
+                   packed.size()) != Z_OK ||
+        raw_size != header.raw_size) {
+      return common::make_error_value("Damaged backup archive chunk", common::ErrorValue::E_ERROR);
+    }
+    chunk_pos_ = 0;
+  }
+
+  const uint8_t* begin = reinterpret_cast<const uint8_t*>(chunk_.data());
+  const uint8_t* ptr = begin + chunk_pos_;
+  const uint8_t* end = begin + chunk_.size();
+  uint64_t key_size = 0;
+  uint64_t value_size = 0;
+  uint64_t ttl = 0;
+  if (!GetVarint(&ptr, end, &key_size) || key_size > static_cast<uint64_t>(end - ptr)) {
+    return common::make_error_value("Damaged backup archive record", common::ErrorValue::E_ERROR);
+  }
+  const std::string key(reinterpret_cast<const char*>(ptr), key_size);
+  ptr += key_size;
+
+  if (!GetVarint(&ptr, end, &value_size) || value_size > static_cast<uint64_t>(end - ptr)) {
+    return common::make_error_value("Damaged backup archive record", common::ErrorValue::E_ERROR);
+  }
+  const std::string value(reinterpret_cast<const char*>(ptr), value_size);
+  ptr += value_size;
+
+  if (!GetVarint(&ptr, end, &ttl)) {
+    return common::make_error_value("Damaged backup archive record", common::ErrorValue::E_ERROR);
+  }
+
+  chunk_pos_ = ptr - begin;
+  *record = makeRecord(key, value, ZigzagDecode(ttl));
+  return common::Error();
+}
+
+common::Error DumpReader::MakeParseError(const std::string& reason) const {
+  std::string buff =
+      common::MemSPrintf("Dump parse error at line %" PRIu64 ": %s", static_cast<uint64_t>(line_number_), reason);
+  return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+}
+
+DumpArchiveWriter::DumpArchiveWriter(connectionTypes type, DumpValueEncoding encoding)
+    : type_(type), encoding_(encoding), file_(nullptr), chunk_(), chunk_records_(0), chunk_position_(), records_count_(0) {}
+
+DumpArchiveWriter::~DumpArchiveWriter() {
+  Close();
+}
+
+common::Error DumpArchiveWriter::Open(const std::string& path, std::string* resume_position) {
+  if (!resume_position) {
+    DNOTREACHED();
+    return common::make_inval_error_value(common::ErrorValue::E_ERROR);
+  }
+
+  Close();
+  resume_position->clear();
+  file_ = fopen(path.c_str(), "r+b");
+  if (!file_) {
+    return Create(path);
+  }
+
+  std::string header;
+  connectionTypes type;
+  DumpValueEncoding encoding;
+  if (!readString(file_, DUMP_ARCHIVE_HEADER_SIZE, &header) || !parseArchiveHeader(header, &type, &encoding) ||
+      type != type_ || encoding != encoding_) {
+    Close();
+    return Create(path);
+  }
+
+  // chunks are appended in order, so only the tail can be torn: headers are
+  // skipped up to the last chunk and only its crc (or the previous one) is checked
+  int64_t candidates[] = {-1, -1};  // last and previous chunks offsets
+  uint64_t candidates_records[] = {0, 0};
+  uint64_t records = 0;
+  while (true) {
+    const int64_t offset = tellFile(file_);
+    std::string chunk_header;
+    if (!readString(file_, DUMP_ARCHIVE_CHUNK_HEADER_SIZE, &chunk_header)) {
+      break;
+    }
+
+    const ChunkHeader parsed = parseChunkHeader(chunk_header);
+    if (parsed.records == 0) {  // finished archive, new backup starts over
+      Close();
+      return Create(path);
+    }
+
+    if (seekFile(file_, static_cast<int64_t>(parsed.position_size) + parsed.packed_size, SEEK_CUR) != 0) {
+      break;
+    }
+    records += parsed.records;
+    candidates[1] = candidates[0];
+    candidates_records[1] = candidates_records[0];
+    candidates[0] = offset;
+    candidates_records[0] = records;
+  }
+
+  seekFile(file_, 0, SEEK_END);
+  const int64_t file_size = tellFile(file_);
+  for (size_t i = 0; i < SIZEOFMASS(candidates); ++i) {
+    if (candidates[i] < 0 || seekFile(file_, candidates[i], SEEK_SET) != 0) {
+      continue;
+    }
+
+    std::string chunk_header;
+    std::string position;
+    std::string packed;
+    if (!readString(file_, DUMP_ARCHIVE_CHUNK_HEADER_SIZE, &chunk_header)) {
+      continue;
+    }
+
+    const ChunkHeader parsed = parseChunkHeader(chunk_header);
+    const int64_t chunk_end =
+        candidates[i] + DUMP_ARCHIVE_CHUNK_HEADER_SIZE + static_cast<int64_t>(parsed.position_size) + parsed.packed_size;
+    if (chunk_end > file_size || !readString(file_, parsed.position_size, &position) ||
+        !readString(file_, parsed.packed_size, &packed) || chunkCrc(chunk_header, position, packed) != parsed.crc ||
+        position.empty()) {
+      continue;
+    }
+
+    // the torn tail is cut off, a shorter next chunk would leave its garbage behind;
+    // seek also switches the stream to writing
+    if (truncateFile(file_, chunk_end) != 0 || seekFile(file_, chunk_end, SEEK_SET) != 0) {
+      break;
+    }
+    *resume_position = position;
+    records_count_ = candidates_records[i];
+    return common::Error();
+  }
+
+  Close();
+  return Create(path);
+}
+
+common::Error DumpArchiveWriter::Create(const std::string& path) {
+  file_ = fopen(path.c_str(), "w+b");
+  if (!file_) {
+    return common::make_error_value("Can't create backup archive: " + path, common::ErrorValue::E_ERROR);
+  }
+
+  const std::string header = makeArchiveHeader(type_, encoding_);
+  if (fwrite(header.data(), 1, header.size(), file_) != header.size()) {
+    Close();
+    return common::make_error_value("Can't write backup archive: " + path, common::ErrorValue::E_ERROR);
+  }
+
+  records_count_ = 0;
+  return common::Error();
+}
+
+common::Error DumpArchiveWriter::Append(const NDbKValue& record, const std::string& resume_position) {
+  if (!file_) {
+    return common::make_error_value("Backup archive not opened", common::ErrorValue::E_ERROR);
+  }
+
+  const NKey cur = record.GetKey();
+  const std::string key = cur.GetKey().ToBytes();
+  const std::string value = record.ValueString();
+  PutVarint(key.size(), &chunk_);
+  chunk_.append(key);
+  PutVarint(value.size(), &chunk_);
+  chunk_.append(value);
+  PutVarint(ZigzagEncode(cur.GetTTL()), &chunk_);
+  chunk_records_++;
+  records_count_++;
+  chunk_position_ = resume_position;
+
+  const bool full = chunk_.size() >= DUMP_ARCHIVE_CHUNK_SIZE;
+  if ((full && !resume_position.empty()) || chunk_.size() >= DUMP_ARCHIVE_MAX_CHUNK_SIZE) {
+    return WriteChunk();
+  }
+
+  return common::Error();
+}
+
+common::Error DumpArchiveWriter::Finish() {
+  if (!file_) {
+    return common::make_error_value("Backup archive not opened", common::ErrorValue::E_ERROR);
+  }
+
+  if (chunk_records_) {
+    common::Error err = WriteChunk();
+    if (err && err->IsError()) {
+      return err;
+    }
+  }
+
+  return WriteChunk();  // empty chunk is the end mark
+}
+
+void DumpArchiveWriter::Close() {
+  if (file_) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+
+  chunk_.clear();
+  chunk_records_ = 0;
+  chunk_position_.clear();
+}
+
+uint64_t DumpArchiveWriter::RecordsCount() const {
+  return records_count_;
+}
+
+common::Error DumpArchiveWriter::WriteChunk() {
+  std::string packed;
+  if (!chunk_.empty()) {
+    uLongf packed_size = compressBound(chunk_.size());
+    packed.resize(packed_size);
+    if (compress2(reinterpret_cast<Bytef*>(&packed[0]), &packed_size, reinterpret_cast<const Bytef*>(chunk_.data()),
+                  chunk_.size(), Z_BEST_SPEED) != Z_OK) {
+      return common::make_error_value("Can't compress backup archive chunk", common::ErrorValue::E_ERROR);
+    }
+    packed.resize(packed_size);
+  }
+
+  std::string header;
+  PutFixed32(0, &header);  // crc is filled when the rest is known
+  PutFixed32(chunk_records_, &header);
+  PutFixed32(static_cast<uint32_t>(chunk_.size()), &header);
+  PutFixed32(static_cast<uint32_t>(packed.size()), &header);
+  PutFixed32(static_cast<uint32_t>(chunk_position_.size()), &header);
+  const uint32_t crc = chunkCrc(header, chunk_position_, packed);
+  for (size_t i = 0; i < 4; ++i) {
+    header[i] = static_cast<char>((crc >> (8 * i)) & 0xFF);
+  }
+
+  if (fwrite(header.data(), 1, header.size(), file_) != header.size() ||
+      fwrite(chunk_position_.data(), 1, chunk_position_.size(), file_) != chunk_position_.size() ||
+      fwrite(packed.data(), 1, packed.size(), file_) != packed.size() || fflush(file_) != 0) {
+    return common::make_error_value("Can't write backup archive chunk", common::ErrorValue::E_ERROR);
+  }
+
+  chunk_.clear();
+  chunk_records_ = 0;
+  chunk_position_.clear();
+  return common::Error();
+}
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,135 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint64_t
+#include <stdio.h>   // for FILE
+
+#include <functional>  // for function
+#include <string>      // for string
+#include <vector>      // for vector
+
+#include <common/error.h>   // for Error
+#include <common/macros.h>  // for WARN_UNUSED_RESULT
+
+#include "core/connection_types.h"  // for connectionTypes
+#include "core/db_key.h"            // for NDbKValue
+
+#define DUMP_READ_BUFFER_SIZE 65536
+#define DUMP_ARCHIVE_EXTENSION ".fnbackup"
+#define DUMP_ARCHIVE_CHUNK_SIZE 1048576  // raw records bytes per chunk
+
+namespace fastonosql {
+namespace core {
+
+// Key/value files which can be imported into any database:
+// RESP - redis protocol or inline commands, SET/SETEX/PSETEX (AOF rewrites, redis-cli --pipe input)
+// JSON lines - one {"key": "...", "value": "...", "ttl": 10} object per line
+// CSV - key,value[,ttl] rows with RFC 4180 quoting
+// archive - backup written by DumpArchiveWriter
+enum DumpFormat { DUMP_RESP = 0, DUMP_JSON_LINES, DUMP_CSV, DUMP_ARCHIVE };
+
+// raw values can be written into any database, redis values are DUMP payloads for RESTORE
+enum DumpValueEncoding { DUMP_RAW_VALUES = 0, DUMP_REDIS_VALUES };
+
+bool DumpFormatFromPath(const std::string& path, DumpFormat* format);  // by extension
+
+// Visits every key of a database for backup. The resume position is not empty
+// where the walk can be continued from later, the walk stops on the first error.
+typedef std::function<common::Error(const NDbKValue& record, const std::string& resume_position)> walk_callback_t;
+
+// Streams records of a dump file through a fixed size read buffer,
+// so files bigger than memory can be imported.
+class DumpReader {
+ public:
+  explicit DumpReader(DumpFormat format);
+  ~DumpReader();
+
+  common::Error Open(const std::string& path) WARN_UNUSED_RESULT;
+  void Close();
+
+  // eof is set instead of record when the file is over
+  common::Error Next(NDbKValue* record, bool* eof) WARN_UNUSED_RESULT;
+
+  uint64_t BytesRead() const;
+  uint64_t Size() const;
+  size_t LineNumber() const;
+  DumpValueEncoding ValueEncoding() const;  // raw for text formats
+
+ private:
+  bool ReadLine(std::string* line);  // without line break, false at the end of file
+  bool ReadBytes(size_t count, std::string* out);
+  bool FillBuffer();
+
+  common::Error NextResp(NDbKValue* record, bool* eof) WARN_UNUSED_RESULT;
+  common::Error NextJsonLine(NDbKValue* record, bool* eof) WARN_UNUSED_RESULT;
+  common::Error NextCsv(NDbKValue* record, bool* eof) WARN_UNUSED_RESULT;
+  common::Error NextArchive(NDbKValue* record, bool* eof) WARN_UNUSED_RESULT;
+  common::Error MakeParseError(const std::string& reason) const WARN_UNUSED_RESULT;
+
+  const DumpFormat format_;
+  FILE* file_;
+  std::vector<char> buffer_;
+  size_t buffer_pos_;
+  size_t buffer_len_;
+  uint64_t bytes_read_;
+  uint64_t size_;
+  size_t line_number_;
+
+  // archive
+  DumpValueEncoding encoding_;
+  std::string chunk_;
+  size_t chunk_pos_;
+};
+
+// Backup archive: a header with the database type and value encoding, then
+// zlib compressed chunks of records. Every chunk has a crc32 and the walk
+// position after its last record, the end mark chunk has no records.
+// An unfinished archive is continued from its last valid chunk, so memory
+// doesn't depend on database size and an interrupted backup can be resumed.
+class DumpArchiveWriter {
+ public:
+  DumpArchiveWriter(connectionTypes type, DumpValueEncoding encoding);
+  ~DumpArchiveWriter();
+
+  // resume_position is empty if a new archive was started
+  common::Error Open(const std::string& path, std::string* resume_position) WARN_UNUSED_RESULT;
+  // chunk is written when full and the record has resume position
+  common::Error Append(const NDbKValue& record, const std::string& resume_position) WARN_UNUSED_RESULT;
+  common::Error Finish() WARN_UNUSED_RESULT;  // writes the rest and the end mark
+  void Close();
+
+  uint64_t RecordsCount() const;  // resumed records too
+
+ private:
+  common::Error Create(const std::string& path) WARN_UNUSED_RESULT;
+  common::Error WriteChunk() WARN_UNUSED_RESULT;
+
+  const connectionTypes type_;
+  const DumpValueEncoding encoding_;
+  FILE* file_;
+  std::string chunk_;
+  uint32_t chunk_records_;
+  std::string chunk_position_;
+  uint64_t records_count_;
+};
+
+}  // namespace core
+}  // namespace fastonosql
@@ -18,8 +18,7 @@
 
 #include "core/database/idatabase_info.h"
 
-#include <algorithm>  // for remove_if
-#include <string>     // for string
+#include <string>  // for string
 
 namespace fastonosql {
 namespace core {
@@ -29,7 +28,27 @@ IDataBaseInfo::IDataBaseInfo(const std::string& name,
                              connectionTypes type,
                              size_t dbkcount,
                              const keys_container_t& keys)
-    : name_(name), is_default_(isDefault), db_kcount_(dbkcount), keys_(keys), type_(type) {}
+    : name_(name),
+      is_default_(isDefault),
+      db_kcount_(dbkcount),
+      db_kcount_exact_(true),
+      keys_(),
+      keys_index_(),
+      type_(type) {
+  ResetKeys(keys);
+}
+
+IDataBaseInfo::IDataBaseInfo(const IDataBaseInfo& other)
+    : common::ClonableBase<IDataBaseInfo>(other),
+      name_(other.name_),
+      is_default_(other.is_default_),
+      db_kcount_(other.db_kcount_),
+      db_kcount_exact_(other.db_kcount_exact_),
+      keys_(),
+      keys_index_(),
+      type_(other.type_) {
+  ResetKeys(other.Keys());
+}
 
 IDataBaseInfo::~IDataBaseInfo() {}
 
@@ -49,6 +68,14 @@ void IDataBaseInfo::SetDBKeysCount(size_t size) {
   db_kcount_ = size;
 }
 
+bool IDataBaseInfo::IsDBKeysCountExact() const {
+  return db_kcount_exact_;
+}
+
+void IDataBaseInfo::SetDBKeysCountExact(bool exact) {
+  db_kcount_exact_ = exact;
+}
+
 size_t IDataBaseInfo::LoadedKeysCount() const {
   return keys_.size();
 }
@@ -62,76 +89,103 @@ void IDataBaseInfo::SetIsDefault(bool isDef) {
 }
 
 void IDataBaseInfo::SetKeys(const keys_container_t& keys) {
-  keys_ = keys;
+  ResetKeys(keys);
 }
 
 void IDataBaseInfo::ClearKeys() {
   keys_.clear();
+  keys_index_.clear();
 }
 
 bool IDataBaseInfo::RenameKey(const NKey& okey, const key_t& new_name) {
-  for (auto& kv : keys_) {
-    NKey cur_key = kv.GetKey();
-    if (cur_key.GetKey() == okey.GetKey()) {
-      NKey okv = kv.GetKey();
-      okv.SetKey(new_name);
-      kv.SetKey(okv);
-      return true;
-    }
+  auto it = FindKey(okey.GetKey());
+  if (it == keys_.end()) {
+    return false;
+  }
+
+  auto exist = FindKey(new_name);
+  if (exist != keys_.end() && exist != it) {  // rename overwrites destination key
+    keys_index_.erase(new_name.ToBytes());
+    keys_.erase(exist);
+    db_kcount_--;
   }
 
-  return false;
+  keys_index_.erase(okey.GetKey().ToBytes());
+  NKey okv = it->GetKey();
+  okv.SetKey(new_name);
+  it->SetKey(okv);
+  keys_index_[new_name.ToBytes()] = it;
+  return true;
 }
 
 bool IDataBaseInfo::InsertKey(const NDbKValue& key) {
   const NKey in_key = key.GetKey();
-  for (auto& kv : keys_) {
-    NKey cur_key = kv.GetKey();
-    if (cur_key.GetKey() == in_key.GetKey()) {
-      kv.SetValue(key.GetValue());
-      return false;
-    }
+  auto it = FindKey(in_key.GetKey());
+  if (it != keys_.end()) {
+    it->SetValue(key.GetValue());
+    return false;
   }
 
-  keys_.push_back(key);
+  keys_index_[in_key.GetKey().ToBytes()] = keys_.insert(keys_.end(), key);
   db_kcount_++;
   return true;
 }
 
 bool IDataBaseInfo::UpdateKeyTTL(const NKey& key, ttl_t ttl) {
-  for (auto& kv : keys_) {
-    NKey cur_key = kv.GetKey();
-    if (cur_key.GetKey() == key.GetKey()) {
-      NKey okv = kv.GetKey();
-      if (okv.GetTTL() == ttl) {
-        return false;
-      }
-
-      okv.SetTTL(ttl);
-      kv.SetKey(okv);
-      return true;
-    }
+  auto it = FindKey(key.GetKey());
+  if (it == keys_.end()) {
+    return false;
+  }
+
+  NKey okv = it->GetKey();
+  if (okv.GetTTL() == ttl) {
+    return false;
   }
 
-  return false;
+  okv.SetTTL(ttl);
+  it->SetKey(okv);
+  return true;
 }
 
 bool IDataBaseInfo::RemoveKey(const NKey& key) {
-  auto it = std::remove_if(keys_.begin(), keys_.end(), [key](NDbKValue kv) {
-    const NKey in_key = kv.GetKey();
-    return in_key.GetKey() == key.GetKey();
-  });
-  if (it == keys_.end()) {
+  const std::string raw_key = key.GetKey().ToBytes();
+  auto found = keys_index_.find(raw_key);
+  if (found == keys_index_.end()) {
     return false;
   }
 
-  keys_.erase(it);
+  keys_.erase(found->second);
+  keys_index_.erase(found);
   db_kcount_--;
   return true;
 }
 
 IDataBaseInfo::keys_container_t IDataBaseInfo::Keys() const {
-  return keys_;
+  return keys_container_t(keys_.begin(), keys_.end());
+}
+
+void IDataBaseInfo::ResetKeys(const keys_container_t& keys) {
+  ClearKeys();
+  keys_index_.reserve(keys.size());
+  for (const NDbKValue& key : keys) {
+    const std::string raw_key = key.GetKey().GetKey().ToBytes();
+    auto found = keys_index_.find(raw_key);
+    if (found != keys_index_.end()) {  // duplicate in source, keep first position
+      found->second->SetValue(key.GetValue());
+      continue;
+    }
+
+    keys_index_[raw_key] = keys_.insert(keys_.end(), key);
+  }
+}
+
+IDataBaseInfo::ordered_keys_t::iterator IDataBaseInfo::FindKey(const key_t& key) {
+  auto found = keys_index_.find(key.ToBytes());
+  if (found == keys_index_.end()) {
+    return keys_.end();
+  }
+
+  return found->second;
 }
 
 }  // namespace core
@@ -20,9 +20,11 @@
 
 #include <stddef.h>  // for size_t
 
-#include <memory>  // for shared_ptr
-#include <string>  // for string
-#include <vector>  // for vector
+#include <list>           // for list
+#include <memory>         // for shared_ptr
+#include <string>         // for string
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
 
 #include <common/macros.h>  // for WARN_UNUSED_RESULT
 #include <common/types.h>   // for ClonableBase
@@ -40,6 +42,8 @@ class IDataBaseInfo : public common::ClonableBase<IDataBaseInfo> {
   std::string Name() const;
   size_t DBKeysCount() const;
   void SetDBKeysCount(size_t size);
+  bool IsDBKeysCountExact() const;  // false if count taken from engine statistics
+  void SetDBKeysCountExact(bool exact);
   size_t LoadedKeysCount() const;
 
   bool IsDefault() const;
@@ -64,12 +68,22 @@ class IDataBaseInfo : public common::ClonableBase<IDataBaseInfo> {
                 connectionTypes type,
                 size_t dbkcount,
                 const keys_container_t& keys);
+  IDataBaseInfo(const IDataBaseInfo& other);  // index points into own keys list, rebuilt on copy
 
  private:
+  // loaded keys in load order, plus index by raw key bytes for O(1) lookups
+  typedef std::list<NDbKValue> ordered_keys_t;
+  typedef std::unordered_map<std::string, ordered_keys_t::iterator> keys_index_t;
+
+  void ResetKeys(const keys_container_t& keys);
+  ordered_keys_t::iterator FindKey(const key_t& key);
+
   const std::string name_;
   bool is_default_;
   size_t db_kcount_;
-  keys_container_t keys_;
+  bool db_kcount_exact_;
+  ordered_keys_t keys_;
+  keys_index_t keys_index_;
 
   const connectionTypes type_;
 };
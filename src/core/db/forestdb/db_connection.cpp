@@ -262,17 +262,25 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
                                      uint64_t count_keys,
                                      std::vector<std::string>* keys_out,
                                      uint64_t* cursor_out) {
+  std::string last_key;
+  if (cursor_in != 0 && !scan_cursors_.Find(cursor_in, &last_key)) {
+    return internal::MakeInvalidScanCursorError(cursor_in);
+  }
+
+  const std::string prefix = internal::GetKeysPatternPrefix(pattern);
+  const std::string& start_key = cursor_in != 0 ? last_key : prefix;
   fdb_iterator* it = NULL;
   fdb_iterator_opt_t opt = FDB_ITR_NONE;
 
-  fdb_status rc = fdb_iterator_init(connection_.handle_->kvs, &it, NULL, 0, NULL, 0, opt);
+  fdb_status rc = fdb_iterator_init(connection_.handle_->kvs, &it, start_key.empty() ? NULL : start_key.c_str(),
+                                    start_key.size(), NULL, 0, opt);
   if (rc != FDB_RESULT_SUCCESS) {
     std::string buff = common::MemSPrintf("Keys function error: %s", fdb_error_msg(rc));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
   fdb_doc* doc = NULL;
-  uint64_t offset_pos = cursor_in;
+  bool skip_last_key = cursor_in != 0;
   uint64_t lcursor_out = 0;
   std::vector<std::string> lkeys_out;
   do {
@@ -281,20 +289,27 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
       break;
     }
 
-    if (lkeys_out.size() < count_keys) {
-      std::string skey = std::string(static_cast<const char*>(doc->key), doc->keylen);
-      if (common::MatchPattern(skey, pattern)) {
-        if (offset_pos == 0) {
-          lkeys_out.push_back(skey);
-        } else {
-          offset_pos--;
-        }
-      }
-    } else {
-      lcursor_out = cursor_in + count_keys;
+    std::string skey = std::string(static_cast<const char*>(doc->key), doc->keylen);
+    fdb_doc_free(doc);
+    const bool already_returned = skip_last_key && skey == last_key;  // on previous page
+    skip_last_key = false;
+    if (already_returned) {
+      continue;
+    }
+
+    if (!internal::IsKeyHasPrefix(skey, prefix)) {
       break;
     }
-    fdb_doc_free(doc);
+
+    if (lkeys_out.size() >= count_keys) {
+      lcursor_out = scan_cursors_.Save(last_key);
+      break;
+    }
+
+    if (common::MatchPattern(skey, pattern)) {
+      lkeys_out.push_back(skey);
+    }
+    last_key = skey;
   } while (fdb_iterator_next(it) != FDB_RESULT_ITERATOR_FAIL);
   fdb_iterator_close(it);
 
@@ -339,29 +354,14 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
 }
 
 common::Error DBConnection::DBkcountImpl(size_t* size) {
-  fdb_iterator* it = NULL;
-  fdb_iterator_opt_t opt = FDB_ITR_NONE;
-
-  fdb_status rc = fdb_iterator_init(connection_.handle_->kvs, &it, NULL, 0, NULL, 0, opt);
+  fdb_kvs_info info;
+  fdb_status rc = fdb_get_kvs_info(connection_.handle_->kvs, &info);  // live documents count, no need to walk
   if (rc != FDB_RESULT_SUCCESS) {
-    std::string buff = common::MemSPrintf("Keys function error: %s", fdb_error_msg(rc));
+    std::string buff = common::MemSPrintf("DBKCOUNT function error: %s", fdb_error_msg(rc));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
-  size_t sz = 0;
-  fdb_doc* doc = NULL;
-  do {
-    rc = fdb_iterator_get(it, &doc);
-    if (rc != FDB_RESULT_SUCCESS) {
-      break;
-    }
-
-    sz++;
-    fdb_doc_free(doc);
-  } while (fdb_iterator_next(it) != FDB_RESULT_ITERATOR_FAIL);
-  fdb_iterator_close(it);
-
-  *size = sz;
+  *size = info.doc_count;
   return common::Error();
 }
 
@@ -382,14 +382,18 @@ common::Error DBConnection::FlushDBImpl() {
       break;
     }
 
-    std::string key;
-    rc = fdb_del_kv(connection_.handle_->kvs, key.c_str(), key.size());
+    rc = fdb_del_kv(connection_.handle_->kvs, doc->key, doc->keylen);
+    fdb_doc_free(doc);
     if (rc != FDB_RESULT_SUCCESS) {
       fdb_iterator_close(it);
       std::string buff = common::MemSPrintf("del function error: %s", fdb_error_msg(rc));
       return common::make_error_value(buff, common::ErrorValue::E_ERROR);
     }
-    fdb_doc_free(doc);
+
+    if (IsInterrupted()) {
+      fdb_iterator_close(it);
+      return common::make_error_value("Interrupted.", common::ErrorValue::E_INTERRUPTED);
+    }
   } while (fdb_iterator_next(it) != FDB_RESULT_ITERATOR_FAIL);
   fdb_iterator_close(it);
 
@@ -434,18 +438,69 @@ common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
   return common::Error();
 }
 
+common::Error DBConnection::ExistsImpl(const NKeys& keys, NKeys* existing_keys) {
+  // metadata only lookups, values aren't read
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const string_key_t key_slice = keys[i].GetKey().ToBytes();
+    fdb_doc* doc = NULL;
+    fdb_doc_create(&doc, key_slice.data(), key_slice.size(), NULL, 0, NULL, 0);
+    fdb_status rc = fdb_get_metaonly(connection_.handle_->kvs, doc);
+    fdb_doc_free(doc);
+    if (rc == FDB_RESULT_KEY_NOT_FOUND) {
+      continue;
+    }
+
+    if (rc != FDB_RESULT_SUCCESS) {
+      std::string buff = common::MemSPrintf("exists function error: %s", fdb_error_msg(rc));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    existing_keys->push_back(keys[i]);
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
+  fdb_status rc = fdb_begin_transaction(connection_.handle_->handle, FDB_ISOLATION_READ_COMMITTED);
+  if (rc != FDB_RESULT_SUCCESS) {
+    std::string buff = common::MemSPrintf("delete function error: %s", fdb_error_msg(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  // metadata only existence checks, all deletes in one transaction
+  NKeys exists_keys;
   for (size_t i = 0; i < keys.size(); ++i) {
     NKey key = keys[i];
-    key_t key_str = key.GetKey();
-    common::Error err = DelInner(key_str);
-    if (err && err->IsError()) {
+    const string_key_t key_slice = key.GetKey().ToBytes();
+    fdb_doc* doc = NULL;
+    fdb_doc_create(&doc, key_slice.data(), key_slice.size(), NULL, 0, NULL, 0);
+    rc = fdb_get_metaonly(connection_.handle_->kvs, doc);
+    fdb_doc_free(doc);
+    if (rc == FDB_RESULT_KEY_NOT_FOUND) {
       continue;
     }
 
-    deleted_keys->push_back(key);
+    if (rc == FDB_RESULT_SUCCESS) {
+      rc = fdb_del_kv(connection_.handle_->kvs, key_slice.data(), key_slice.size());
+    }
+
+    if (rc != FDB_RESULT_SUCCESS) {
+      fdb_abort_transaction(connection_.handle_->handle);
+      std::string buff = common::MemSPrintf("delete function error: %s", fdb_error_msg(rc));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    exists_keys.push_back(key);
+  }
+
+  rc = fdb_end_transaction(connection_.handle_->handle, FDB_COMMIT_NORMAL);
+  if (rc != FDB_RESULT_SUCCESS) {
+    std::string buff = common::MemSPrintf("commit function error: %s", fdb_error_msg(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
+  deleted_keys->insert(deleted_keys->end(), exists_keys.begin(), exists_keys.end());
   return common::Error();
 }
 
@@ -18,9 +18,12 @@
 
 #include "core/db/leveldb/db_connection.h"
 
+#include <algorithm>  // for max
+
 #include <leveldb/c.h>  // for leveldb_major_version, etc
 #include <leveldb/db.h>
-#include <leveldb/options.h>  // for ReadOptions, WriteOptions
+#include <leveldb/options.h>      // for ReadOptions, WriteOptions
+#include <leveldb/write_batch.h>  // for WriteBatch
 
 #include <common/convert2string.h>  // for ConvertFromString
 #include <common/file_system.h>
@@ -33,6 +36,9 @@
 
 #include "core/global.h"  // for FastoObject, etc
 
+#define KCOUNT_ESTIMATE_SAMPLE_SIZE 1024
+#define FLUSHDB_BATCH_SIZE 10000
+
 #define LEVELDB_HEADER_STATS                             \
   "                               Compactions\n"         \
   "Level  Files Size(MB) Time(sec) Read(MB) Write(MB)\n" \
@@ -131,7 +137,39 @@ common::Error TestConnection(const Config& config) {
 }
 
 DBConnection::DBConnection(CDBConnectionClient* client)
-    : base_class(client, new CommandTranslator(base_class::Commands())) {}
+    : base_class(client, new CommandTranslator(base_class::Commands())), snapshot_(nullptr) {}
+
+DBConnection::~DBConnection() {
+  common::Error err = Disconnect();
+  if (err && err->IsError()) {
+    DNOTREACHED();
+  }
+}
+
+common::Error DBConnection::Disconnect() {
+  if (IsConnected()) {
+    scan_cursors_.Clear();  // cursors hold snapshots of the handle
+    if (snapshot_) {
+      connection_.handle_->ReleaseSnapshot(snapshot_);
+      snapshot_ = nullptr;
+    }
+  }
+
+  return base_class::Disconnect();
+}
+
+::leveldb::ReadOptions DBConnection::MakeReadOptions(bool bulk) const {
+  ::leveldb::ReadOptions ro;
+  ro.snapshot = snapshot_;
+  ro.fill_cache = !bulk;
+  return ro;
+}
+
+internal::scan_snapshot_t DBConnection::MakeScanSnapshot() {
+  ::leveldb::DB* db = connection_.handle_;
+  return internal::scan_snapshot_t(db->GetSnapshot(),
+                                   [db](const ::leveldb::Snapshot* snap) { db->ReleaseSnapshot(snap); });
+}
 
 common::Error DBConnection::Info(const std::string& args, ServerInfo::Stats* statsout) {
   UNUSED(args);
@@ -250,7 +288,7 @@ common::Error DBConnection::GetInner(key_t key, std::string* ret_val) {
 
   const string_key_t key_str = key.ToBytes();
   const ::leveldb::Slice key_slice(key_str.data(), key_str.size());
-  ::leveldb::ReadOptions ro;
+  const ::leveldb::ReadOptions ro = MakeReadOptions(false);
   auto st = connection_.handle_->Get(ro, key_slice, ret_val);
   if (!st.ok()) {
     std::string buff = common::MemSPrintf("get function error: %s", st.ToString());
@@ -265,35 +303,72 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
                                      uint64_t count_keys,
                                      std::vector<std::string>* keys_out,
                                      uint64_t* cursor_out) {
-  ::leveldb::ReadOptions ro;
+  std::string last_key;
+  internal::scan_snapshot_t scan_snapshot;
+  if (cursor_in != 0 && !scan_cursors_.Find(cursor_in, &last_key, &scan_snapshot)) {
+    return internal::MakeInvalidScanCursorError(cursor_in);
+  }
+
+  // prefix range is contiguous only in bytewise order
+  const std::string prefix =
+      connection_.config_.comparator == COMP_BYTEWISE ? internal::GetKeysPatternPrefix(pattern) : std::string();
+  if (cursor_in == 0) {  // pages of one pagination see the database as of its first page
+    if (!snapshot_) {
+      scan_snapshot = MakeScanSnapshot();
+    }
+  }
+
+  ::leveldb::ReadOptions ro = MakeReadOptions(true);
+  if (scan_snapshot) {
+    ro.snapshot = static_cast<const ::leveldb::Snapshot*>(scan_snapshot.get());
+  }
   ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);
-  uint64_t offset_pos = cursor_in;
+  if (cursor_in == 0) {
+    if (prefix.empty()) {
+      it->SeekToFirst();
+    } else {
+      it->Seek(prefix);
+    }
+  } else {
+    it->Seek(last_key);
+    if (it->Valid() && it->key().ToString() == last_key) {
+      it->Next();
+    }
+  }
+
   uint64_t lcursor_out = 0;
   std::vector<std::string> lkeys_out;
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+  for (; it->Valid(); it->Next()) {
     std::string key = it->key().ToString();
-    if (lkeys_out.size() < count_keys) {
-      if (common::MatchPattern(key, pattern)) {
-        if (offset_pos == 0) {
-          lkeys_out.push_back(key);
-        } else {
-          offset_pos--;
-        }
-      }
-    } else {
-      lcursor_out = cursor_in + count_keys;
+    if (!internal::IsKeyHasPrefix(key, prefix)) {
+      break;
+    }
+
+    if (lkeys_out.size() >= count_keys) {
+      lcursor_out = scan_cursors_.Save(last_key, scan_snapshot);
       break;
     }
+
+    if (common::MatchPattern(key, pattern)) {
+      lkeys_out.push_back(key);
+    }
+    last_key = key;
   }
 
   auto st = it->status();
   delete it;
 
   if (!st.ok()) {
+    if (lcursor_out != 0) {
+      scan_cursors_.Erase(lcursor_out);
+    }
     std::string buff = common::MemSPrintf("SCAN function error: %s", st.ToString());
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
+  if (cursor_in != 0) {  // pagination went on with the new cursor, last page drops the snapshot
+    scan_cursors_.Erase(cursor_in);
+  }
   *keys_out = lkeys_out;
   *cursor_out = lcursor_out;
   return common::Error();
@@ -306,7 +381,7 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
   std::string skey_start = common::ConvertToString(key_start);
   std::string skey_end = common::ConvertToString(key_end);
 
-  ::leveldb::ReadOptions ro;
+  const ::leveldb::ReadOptions ro = MakeReadOptions(true);
   ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);  // keys(key_start, key_end, limit, ret);
   for (it->Seek(skey_start); it->Valid(); it->Next()) {
     std::string key = it->key().ToString();
@@ -330,10 +405,14 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
 }
 
 common::Error DBConnection::DBkcountImpl(size_t* size) {
-  ::leveldb::ReadOptions ro;
+  const ::leveldb::ReadOptions ro = MakeReadOptions(true);
   ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);
   size_t sz = 0;
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    if (IsInterrupted()) {
+      delete it;
+      return common::make_error_value("Interrupted.", common::ErrorValue::E_INTERRUPTED);
+    }
     sz++;
   }
 
@@ -349,18 +428,92 @@ common::Error DBConnection::DBkcountImpl(size_t* size) {
   return common::Error();
 }
 
+common::Error DBConnection::DBkcountEstimateImpl(size_t* size, bool* is_exact) {
+  ::leveldb::ReadOptions ro;
+  ro.fill_cache = false;
+  ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);
+  size_t sampled = 0;
+  uint64_t sampled_bytes = 0;
+  std::string first_key;
+  for (it->SeekToFirst(); it->Valid() && sampled < KCOUNT_ESTIMATE_SAMPLE_SIZE; it->Next()) {
+    if (sampled == 0) {
+      first_key = it->key().ToString();
+    }
+    sampled_bytes += it->key().size() + it->value().size();
+    sampled++;
+  }
+
+  if (!it->Valid()) {  // whole database fits into sample
+    auto st = it->status();
+    delete it;
+    if (!st.ok()) {
+      std::string buff = common::MemSPrintf("Couldn't determine DBKCOUNT error: %s", st.ToString());
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    *size = sampled;
+    *is_exact = true;
+    return common::Error();
+  }
+
+  it->SeekToLast();
+  std::string last_key = it->Valid() ? it->key().ToString() : first_key;
+  auto st = it->status();
+  delete it;
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("Couldn't determine DBKCOUNT error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  // approximate on-disk size of key range divided by average sampled entry size
+  ::leveldb::Range range(first_key, last_key);
+  uint64_t approximate_bytes = 0;
+  connection_.handle_->GetApproximateSizes(&range, 1, &approximate_bytes);
+  uint64_t average_entry_size = std::max<uint64_t>(sampled_bytes / sampled, 1);
+  *size = std::max<size_t>(approximate_bytes / average_entry_size, sampled);
+  *is_exact = false;
+  return common::Error();
+}
+
 common::Error DBConnection::FlushDBImpl() {
+  size_t total = 0;
+  bool is_exact = true;
+  common::Error err = DBkcountEstimate(&total, &is_exact);
+  if (err && err->IsError()) {
+    return err;
+  }
+
   ::leveldb::ReadOptions ro;
+  ro.fill_cache = false;
   ::leveldb::WriteOptions wo;
   ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);
+  ::leveldb::WriteBatch batch;
+  size_t batched = 0;
+  size_t removed = 0;
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    std::string key = it->key().ToString();
-    auto st = connection_.handle_->Delete(wo, key);
+    batch.Delete(it->key());
+    if (++batched < FLUSHDB_BATCH_SIZE) {
+      continue;
+    }
+
+    auto st = connection_.handle_->Write(wo, &batch);
     if (!st.ok()) {
       delete it;
       std::string buff = common::MemSPrintf("del function error: %s", st.ToString());
       return common::make_error_value(buff, common::ErrorValue::E_ERROR);
     }
+
+    removed += batched;
+    batched = 0;
+    batch.Clear();
+    if (total) {
+      NotifyProgress(std::min<size_t>(removed * 100 / total, 99));
+    }
+
+    if (IsInterrupted()) {
+      delete it;
+      return common::make_error_value("Interrupted.", common::ErrorValue::E_INTERRUPTED);
+    }
   }
 
   auto st = it->status();
@@ -370,6 +523,14 @@ common::Error DBConnection::FlushDBImpl() {
     std::string buff = common::MemSPrintf("Keys function error: %s", st.ToString());
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
+
+  if (batched) {
+    st = connection_.handle_->Write(wo, &batch);
+    if (!st.ok()) {
+      std::string buff = common::MemSPrintf("del function error: %s", st.ToString());
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+  }
   return common::Error();
 }
 
@@ -379,24 +540,54 @@ common::Error DBConnection::SelectImpl(const std::string& name, IDataBaseInfo**
   }
 
   size_t kcount = 0;
-  common::Error err = DBkcount(&kcount);
+  bool is_exact = true;
+  common::Error err = DBkcountEstimate(&kcount, &is_exact);
   DCHECK(!err);
-  *info = new DataBaseInfo(name, true, kcount);
+  DataBaseInfo* linfo = new DataBaseInfo(name, true, kcount);
+  linfo->SetDBKeysCountExact(is_exact);
+  *info = linfo;
   return common::Error();
 }
 
 common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
+  // existence checks against one snapshot, deletes applied as one atomic batch
+  ::leveldb::ReadOptions ro;
+  ro.snapshot = connection_.handle_->GetSnapshot();
+  ::leveldb::WriteBatch batch;
+  NKeys exists_keys;
   for (size_t i = 0; i < keys.size(); ++i) {
     NKey key = keys[i];
-    key_t key_str = key.GetKey();
-    common::Error err = DelInner(key_str);
-    if (err && err->IsError()) {
+    const string_key_t key_str = key.GetKey().ToBytes();
+    const ::leveldb::Slice key_slice(reinterpret_cast<const char*>(key_str.data()), key_str.size());
+    std::string exist_value;
+    auto st = connection_.handle_->Get(ro, key_slice, &exist_value);
+    if (st.IsNotFound()) {
       continue;
     }
 
-    deleted_keys->push_back(key);
+    if (!st.ok()) {
+      connection_.handle_->ReleaseSnapshot(ro.snapshot);
+      std::string buff = common::MemSPrintf("get function error: %s", st.ToString());
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    batch.Delete(key_slice);
+    exists_keys.push_back(key);
+  }
+  connection_.handle_->ReleaseSnapshot(ro.snapshot);
+
+  if (exists_keys.empty()) {
+    return common::Error();
+  }
+
+  ::leveldb::WriteOptions wo;
+  auto st = connection_.handle_->Write(wo, &batch);
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("del function error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
+  deleted_keys->insert(deleted_keys->end(), exists_keys.begin(), exists_keys.end());
   return common::Error();
 }
 
@@ -413,6 +604,68 @@ common::Error DBConnection::SetImpl(const NDbKValue& key, NDbKValue* added_key)
   return common::Error();
 }
 
+common::Error DBConnection::BulkSetImpl(const NDbKValues& keys) {
+  // one write and one WAL record for the whole batch
+  ::leveldb::WriteBatch batch;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const string_key_t key_str = keys[i].GetKey().GetKey().ToBytes();
+    batch.Put(::leveldb::Slice(key_str.data(), key_str.size()), keys[i].ValueString());
+  }
+
+  ::leveldb::WriteOptions wo;
+  auto st = connection_.handle_->Write(wo, &batch);
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("set function error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  return common::Error();
+}
+
+common::Error DBConnection::WalkImpl(const std::string& position, walk_callback_t cb) {
+  // consistent view of the whole database (SNAPSHOT CREATE one if any)
+  ::leveldb::ReadOptions ro = MakeReadOptions(true);
+  if (!snapshot_) {
+    ro.snapshot = connection_.handle_->GetSnapshot();
+  }
+  ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);
+  if (position.empty()) {
+    it->SeekToFirst();
+  } else {
+    it->Seek(position);
+    if (it->Valid() && it->key().ToString() == position) {
+      it->Next();
+    }
+  }
+
+  common::Error err;
+  for (; it->Valid(); it->Next()) {
+    const std::string key = it->key().ToString();
+    NValue val(common::Value::CreateStringValue(it->value().ToString()));
+    err = cb(NDbKValue(NKey(key_t(key)), val), key);  // keys are ordered, the last one is the position
+    if (err && err->IsError()) {
+      break;
+    }
+  }
+
+  auto st = it->status();
+  delete it;
+  if (!snapshot_) {
+    connection_.handle_->ReleaseSnapshot(ro.snapshot);
+  }
+
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("walk function error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
   key_t key_str = key.GetKey();
   std::string value_str;
@@ -426,6 +679,28 @@ common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
   return common::Error();
 }
 
+common::Error DBConnection::ExistsImpl(const NKeys& keys, NKeys* existing_keys) {
+  const ::leveldb::ReadOptions ro = MakeReadOptions(true);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const string_key_t key_str = keys[i].GetKey().ToBytes();
+    const ::leveldb::Slice key_slice(key_str.data(), key_str.size());
+    std::string value_str;
+    auto st = connection_.handle_->Get(ro, key_slice, &value_str);
+    if (st.IsNotFound()) {
+      continue;
+    }
+
+    if (!st.ok()) {
+      std::string buff = common::MemSPrintf("exists function error: %s", st.ToString());
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    existing_keys->push_back(keys[i]);
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::RenameImpl(const NKey& key, string_key_t new_key) {
   key_t key_str = key.GetKey();
   std::string value_str;
@@ -470,6 +745,24 @@ common::Error DBConnection::QuitImpl() {
   return common::Error();
 }
 
+common::Error DBConnection::CreateSnapshotImpl() {
+  if (snapshot_) {
+    connection_.handle_->ReleaseSnapshot(snapshot_);
+  }
+  snapshot_ = connection_.handle_->GetSnapshot();
+  return common::Error();
+}
+
+common::Error DBConnection::ReleaseSnapshotImpl() {
+  if (!snapshot_) {
+    return common::make_error_value("Snapshot not created", common::ErrorValue::E_ERROR);
+  }
+
+  connection_.handle_->ReleaseSnapshot(snapshot_);
+  snapshot_ = nullptr;
+  return common::Error();
+}
+
 }  // namespace leveldb
 }  // namespace core
 }  // namespace fastonosql
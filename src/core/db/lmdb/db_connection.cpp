@@ -317,6 +317,12 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
                                      uint64_t count_keys,
                                      std::vector<std::string>* keys_out,
                                      uint64_t* cursor_out) {
+  std::string last_key;
+  if (cursor_in != 0 && !scan_cursors_.Find(cursor_in, &last_key)) {
+    return internal::MakeInvalidScanCursorError(cursor_in);
+  }
+
+  const std::string prefix = internal::GetKeysPatternPrefix(pattern);
   MDB_cursor* cursor = NULL;
   MDB_txn* txn = NULL;
   int rc = mdb_txn_begin(connection_.handle_->env, NULL, MDB_RDONLY, &txn);
@@ -332,23 +338,42 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
 
   MDB_val key;
   MDB_val data;
-  uint64_t offset_pos = cursor_in;
+  MDB_cursor_op op = MDB_FIRST;
+  bool skip_last_key = false;
+  if (cursor_in != 0) {
+    key = ConvertToLMDBSlice(last_key);
+    op = MDB_SET_RANGE;
+    skip_last_key = true;
+  } else if (!prefix.empty()) {
+    key = ConvertToLMDBSlice(prefix);
+    op = MDB_SET_RANGE;
+  }
+
   uint64_t lcursor_out = 0;
   std::vector<std::string> lkeys_out;
-  while ((mdb_cursor_get(cursor, &key, &data, MDB_NEXT) == LMDB_OK)) {
-    if (lkeys_out.size() < count_keys) {
-      std::string skey(reinterpret_cast<const char*>(key.mv_data), key.mv_size);
-      if (common::MatchPattern(skey, pattern)) {
-        if (offset_pos == 0) {
-          lkeys_out.push_back(skey);
-        } else {
-          offset_pos--;
-        }
+  for (rc = mdb_cursor_get(cursor, &key, &data, op); rc == LMDB_OK;
+       rc = mdb_cursor_get(cursor, &key, &data, MDB_NEXT)) {
+    std::string skey(reinterpret_cast<const char*>(key.mv_data), key.mv_size);
+    if (skip_last_key) {  // already returned on previous page
+      skip_last_key = false;
+      if (skey == last_key) {
+        continue;
       }
-    } else {
-      lcursor_out = cursor_in + count_keys;
+    }
+
+    if (!internal::IsKeyHasPrefix(skey, prefix)) {
+      break;
+    }
+
+    if (lkeys_out.size() >= count_keys) {
+      lcursor_out = scan_cursors_.Save(last_key);
       break;
     }
+
+    if (common::MatchPattern(skey, pattern)) {
+      lkeys_out.push_back(skey);
+    }
+    last_key = skey;
   }
 
   *keys_out = lkeys_out;
@@ -390,39 +415,29 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
 }
 
 common::Error DBConnection::DBkcountImpl(size_t* size) {
-  MDB_cursor* cursor = NULL;
   MDB_txn* txn = NULL;
+  MDB_stat stat;
   int rc = mdb_txn_begin(connection_.handle_->env, NULL, MDB_RDONLY, &txn);
   if (rc == LMDB_OK) {
-    rc = mdb_cursor_open(txn, connection_.handle_->dbir, &cursor);
+    rc = mdb_stat(txn, connection_.handle_->dbir, &stat);  // B+tree keeps entries count, no need to walk
   }
+  mdb_txn_abort(txn);
 
   if (rc != LMDB_OK) {
-    mdb_txn_abort(txn);
     std::string buff = common::MemSPrintf("DBKCOUNT function error: %s", mdb_strerror(rc));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
-  MDB_val key;
-  MDB_val data;
-  size_t sz = 0;
-  while (mdb_cursor_get(cursor, &key, &data, MDB_NEXT) == LMDB_OK) {
-    sz++;
-  }
-  mdb_cursor_close(cursor);
-  mdb_txn_abort(txn);
-
-  *size = sz;
+  *size = stat.ms_entries;
   return common::Error();
 }
 
 common::Error DBConnection::FlushDBImpl() {
-  MDB_cursor* cursor = NULL;
   MDB_txn* txn = NULL;
   int env_flags = connection_.config_.env_flags;
   int rc = mdb_txn_begin(connection_.handle_->env, NULL, lmdb_db_flag_from_env_flags(env_flags), &txn);
   if (rc == LMDB_OK) {
-    rc = mdb_cursor_open(txn, connection_.handle_->dbir, &cursor);
+    rc = mdb_drop(txn, connection_.handle_->dbir, 0);  // empty database, keep handle open
   }
 
   if (rc != LMDB_OK) {
@@ -431,31 +446,11 @@ common::Error DBConnection::FlushDBImpl() {
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
-  MDB_val key;
-  MDB_val data;
-  size_t sz = 0;
-  while (mdb_cursor_get(cursor, &key, &data, MDB_NEXT) == LMDB_OK) {
-    sz++;
-    rc = mdb_del(txn, connection_.handle_->dbir, &key, NULL);
-    if (rc != LMDB_OK) {
-      mdb_cursor_close(cursor);
-      mdb_txn_abort(txn);
-      std::string buff = common::MemSPrintf("del function error: %s", mdb_strerror(rc));
-      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
-    }
-  }
-
-  mdb_cursor_close(cursor);
-  if (sz != 0) {
-    rc = mdb_txn_commit(txn);
-    if (rc != LMDB_OK) {
-      std::string buff = common::MemSPrintf("commit function error: %s", mdb_strerror(rc));
-      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
-    }
-    return common::Error();
+  rc = mdb_txn_commit(txn);
+  if (rc != LMDB_OK) {
+    std::string buff = common::MemSPrintf("commit function error: %s", mdb_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
-
-  mdb_txn_abort(txn);
   return common::Error();
 }
 
@@ -484,6 +479,87 @@ common::Error DBConnection::SetImpl(const NDbKValue& key, NDbKValue* added_key)
   return common::Error();
 }
 
+common::Error DBConnection::BulkSetImpl(const NDbKValues& keys) {
+  // single write transaction, so one commit (and sync) per batch instead of per key
+  MDB_txn* txn = NULL;
+  int env_flags = connection_.config_.env_flags;
+  int rc = mdb_txn_begin(connection_.handle_->env, NULL, lmdb_db_flag_from_env_flags(env_flags), &txn);
+  for (size_t i = 0; i < keys.size() && rc == LMDB_OK; ++i) {
+    const string_key_t key_str = keys[i].GetKey().GetKey().ToBytes();
+    const std::string value_str = keys[i].ValueString();
+    MDB_val key_slice = ConvertToLMDBSlice(key_str);
+    MDB_val mval;
+    mval.mv_size = value_str.size();
+    mval.mv_data = const_cast<char*>(value_str.c_str());
+    rc = mdb_put(txn, connection_.handle_->dbir, &key_slice, &mval, 0);
+  }
+
+  if (rc == LMDB_OK) {
+    rc = mdb_txn_commit(txn);
+  } else if (txn) {
+    mdb_txn_abort(txn);
+  }
+
+  if (rc != LMDB_OK) {
+    std::string buff = common::MemSPrintf("set function error: %s", mdb_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  return common::Error();
+}
+
+common::Error DBConnection::WalkImpl(const std::string& position, walk_callback_t cb) {
+  // read only transaction is a snapshot and doesn't block writers
+  MDB_cursor* cursor = NULL;
+  MDB_txn* txn = NULL;
+  int rc = mdb_txn_begin(connection_.handle_->env, NULL, MDB_RDONLY, &txn);
+  if (rc == LMDB_OK) {
+    rc = mdb_cursor_open(txn, connection_.handle_->dbir, &cursor);
+  }
+
+  if (rc != LMDB_OK) {
+    mdb_txn_abort(txn);
+    std::string buff = common::MemSPrintf("walk function error: %s", mdb_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  MDB_val key;
+  MDB_val data;
+  MDB_cursor_op op = MDB_FIRST;
+  if (!position.empty()) {
+    key = ConvertToLMDBSlice(position);
+    op = MDB_SET_RANGE;
+  }
+
+  common::Error err;
+  for (rc = mdb_cursor_get(cursor, &key, &data, op); rc == LMDB_OK;
+       rc = mdb_cursor_get(cursor, &key, &data, MDB_NEXT)) {
+    std::string skey(reinterpret_cast<const char*>(key.mv_data), key.mv_size);
+    if (!position.empty() && skey == position) {  // written before interruption
+      continue;
+    }
+
+    NValue val(common::Value::CreateStringValue(std::string(reinterpret_cast<const char*>(data.mv_data), data.mv_size)));
+    err = cb(NDbKValue(NKey(key_t(skey)), val), skey);
+    if (err && err->IsError()) {
+      break;
+    }
+  }
+
+  mdb_cursor_close(cursor);
+  mdb_txn_abort(txn);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  if (rc != MDB_NOTFOUND) {
+    std::string buff = common::MemSPrintf("walk function error: %s", mdb_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
   key_t key_str = key.GetKey();
   std::string value_str;
@@ -497,18 +573,78 @@ common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
   return common::Error();
 }
 
+common::Error DBConnection::ExistsImpl(const NKeys& keys, NKeys* existing_keys) {
+  MDB_txn* txn = NULL;
+  int rc = mdb_txn_begin(connection_.handle_->env, NULL, MDB_RDONLY, &txn);
+  if (rc != LMDB_OK) {
+    std::string buff = common::MemSPrintf("Exists function error: %s", mdb_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  // all lookups in one read transaction
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const string_key_t key_str = keys[i].GetKey().ToBytes();
+    MDB_val key_slice = ConvertToLMDBSlice(key_str);
+    MDB_val mval;
+    rc = mdb_get(txn, connection_.handle_->dbir, &key_slice, &mval);
+    if (rc == MDB_NOTFOUND) {
+      continue;
+    }
+
+    if (rc != LMDB_OK) {
+      mdb_txn_abort(txn);
+      std::string buff = common::MemSPrintf("Exists function error: %s", mdb_strerror(rc));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    existing_keys->push_back(keys[i]);
+  }
+
+  mdb_txn_abort(txn);
+  return common::Error();
+}
+
 common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
+  MDB_txn* txn = NULL;
+  int env_flags = connection_.config_.env_flags;
+  int rc = mdb_txn_begin(connection_.handle_->env, NULL, lmdb_db_flag_from_env_flags(env_flags), &txn);
+  if (rc != LMDB_OK) {
+    std::string buff = common::MemSPrintf("Delete function error: %s", mdb_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  // all deletes in one write transaction, missing keys reported by mdb_del itself
+  NKeys exists_keys;
   for (size_t i = 0; i < keys.size(); ++i) {
     NKey key = keys[i];
-    key_t key_str = key.GetKey();
-    common::Error err = DelInner(key_str);
-    if (err && err->IsError()) {
+    const string_key_t key_str = key.GetKey().ToBytes();
+    MDB_val key_slice = ConvertToLMDBSlice(key_str);
+    rc = mdb_del(txn, connection_.handle_->dbir, &key_slice, NULL);
+    if (rc == MDB_NOTFOUND) {
       continue;
     }
 
-    deleted_keys->push_back(key);
+    if (rc != LMDB_OK) {
+      mdb_txn_abort(txn);
+      std::string buff = common::MemSPrintf("Delete function error: %s", mdb_strerror(rc));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    exists_keys.push_back(key);
+  }
+
+  if (exists_keys.empty()) {
+    mdb_txn_abort(txn);
+    return common::Error();
+  }
+
+  rc = mdb_txn_commit(txn);
+  if (rc != LMDB_OK) {
+    std::string buff = common::MemSPrintf("commit function error: %s", mdb_strerror(rc));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
+  deleted_keys->insert(deleted_keys->end(), exists_keys.begin(), exists_keys.end());
   return common::Error();
 }
 
@@ -147,6 +147,13 @@ memcached_return_t memcached_dump_ttl_callback(const memcached_st* ptr,
   return holder->CheckKey(key, key_length, exp);
 }
 
+// the replies of buffered requests are never read, so only set is buffered: it has no
+// NOT_STORED/NOT_FOUND outcome, while add, replace, append, prepend, delete, incr and decr
+// can fail on the key state and are sent one by one
+bool isBufferedCommand(const fastonosql::core::commands_args_t& argv) {
+  return argv.size() > 1 && strcasecmp(argv[0].c_str(), "set") == 0;
+}
+
 }  // namespace
 
 namespace fastonosql {
@@ -340,7 +347,7 @@ common::Error DBConnection::AddIfNotExist(const NKey& key,
   const char* key_slice_ptr = reinterpret_cast<const char*>(key_slice.data());
   memcached_return_t error = memcached_add(connection_.handle_, key_slice_ptr, key_slice.size(), value.c_str(),
                                            value.length(), expiration, flags);
-  if (error != MEMCACHED_SUCCESS) {
+  if (error != MEMCACHED_SUCCESS && error != MEMCACHED_BUFFERED) {
     std::string buff = common::MemSPrintf("Add function error: %s", memcached_strerror(connection_.handle_, error));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
@@ -361,7 +368,7 @@ common::Error DBConnection::Replace(const NKey& key, const std::string& value, t
   const char* key_slice_ptr = reinterpret_cast<const char*>(key_slice.data());
   memcached_return_t error = memcached_replace(connection_.handle_, key_slice_ptr, key_slice.size(), value.c_str(),
                                                value.length(), expiration, flags);
-  if (error != MEMCACHED_SUCCESS) {
+  if (error != MEMCACHED_SUCCESS && error != MEMCACHED_BUFFERED) {
     std::string buff = common::MemSPrintf("Replace function error: %s", memcached_strerror(connection_.handle_, error));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
@@ -382,7 +389,7 @@ common::Error DBConnection::Append(const NKey& key, const std::string& value, ti
   const char* key_slice_ptr = reinterpret_cast<const char*>(key_slice.data());
   memcached_return_t error = memcached_append(connection_.handle_, key_slice_ptr, key_slice.size(), value.c_str(),
                                               value.length(), expiration, flags);
-  if (error != MEMCACHED_SUCCESS) {
+  if (error != MEMCACHED_SUCCESS && error != MEMCACHED_BUFFERED) {
     std::string buff = common::MemSPrintf("Append function error: %s", memcached_strerror(connection_.handle_, error));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
@@ -403,7 +410,7 @@ common::Error DBConnection::Prepend(const NKey& key, const std::string& value, t
   const char* key_slice_ptr = reinterpret_cast<const char*>(key_slice.data());
   memcached_return_t error = memcached_prepend(connection_.handle_, key_slice_ptr, key_slice.size(), value.c_str(),
                                                value.length(), expiration, flags);
-  if (error != MEMCACHED_SUCCESS) {
+  if (error != MEMCACHED_SUCCESS && error != MEMCACHED_BUFFERED) {
     std::string buff = common::MemSPrintf("Prepend function error: %s", memcached_strerror(connection_.handle_, error));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
@@ -480,7 +487,7 @@ common::Error DBConnection::DelInner(key_t key, time_t expiration) {
   const string_key_t key_slice = key.ToBytes();
   const char* key_slice_ptr = reinterpret_cast<const char*>(key_slice.data());
   memcached_return_t error = memcached_delete(connection_.handle_, key_slice_ptr, key_slice.size(), expiration);
-  if (error != MEMCACHED_SUCCESS) {
+  if (error != MEMCACHED_SUCCESS && error != MEMCACHED_BUFFERED) {
     std::string buff = common::MemSPrintf("Delete function error: %s", memcached_strerror(connection_.handle_, error));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
@@ -497,7 +504,7 @@ common::Error DBConnection::SetInner(key_t key, const std::string& value, time_t
   const char* key_slice_ptr = reinterpret_cast<const char*>(key_slice.data());
   memcached_return_t error = memcached_set(connection_.handle_, key_slice_ptr, key_slice.size(), value.c_str(),
                                            value.length(), expiration, flags);
-  if (error != MEMCACHED_SUCCESS) {
+  if (error != MEMCACHED_SUCCESS && error != MEMCACHED_BUFFERED) {
     std::string buff = common::MemSPrintf("Set function error: %s", memcached_strerror(connection_.handle_, error));
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
@@ -559,6 +566,53 @@ common::Error DBConnection::ExpireInner(key_t key, ttl_t expiration) {
   return common::Error();
 }
 
+common::Error DBConnection::ExecuteAsPipeline(const std::vector<FastoObjectCommandIPtr>& cmds,
+                                              void (*log_command_cb)(FastoObjectCommandIPtr command)) {
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  bool buffering = false;
+  for (size_t i = 0; i <= cmds.size(); ++i) {
+    commands_args_t argv;
+    const bool buffered =
+        i < cmds.size() && ParseCommandLine(cmds[i]->InputCommand(), &argv) && isBufferedCommand(argv);
+    if (buffering != buffered) {
+      memcached_return_t error = MEMCACHED_SUCCESS;
+      if (buffered) {
+        error = memcached_behavior_set(connection_.handle_, MEMCACHED_BEHAVIOR_BUFFER_REQUESTS, 1);
+      } else {
+        error = memcached_flush_buffers(connection_.handle_);
+        memcached_behavior_set(connection_.handle_, MEMCACHED_BEHAVIOR_BUFFER_REQUESTS, 0);
+      }
+      if (error != MEMCACHED_SUCCESS) {
+        std::string buff =
+            common::MemSPrintf("Pipeline function error: %s", memcached_strerror(connection_.handle_, error));
+        return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+      }
+      buffering = buffered;
+    }
+
+    if (i == cmds.size()) {
+      break;
+    }
+
+    if (log_command_cb) {
+      log_command_cb(cmds[i]);
+    }
+    common::Error err = Execute(cmds[i]->InputCommand(), cmds[i].get());
+    if (err && err->IsError()) {
+      if (buffering) {
+        memcached_flush_buffers(connection_.handle_);
+        memcached_behavior_set(connection_.handle_, MEMCACHED_BEHAVIOR_BUFFER_REQUESTS, 0);
+      }
+      return err;
+    }
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::TTL(key_t key, ttl_t* expiration) {
   if (!IsConnected()) {
     return common::make_error_value("Not connected", common::Value::E_ERROR);
@@ -713,6 +767,31 @@ common::Error DBConnection::SetImpl(const NDbKValue& key, NDbKValue* added_key)
   return common::Error();
 }
 
+common::Error DBConnection::BulkSetImpl(const NDbKValues& keys) {
+  // buffered sets are sent on flush without waiting for a reply per key
+  memcached_return_t error = memcached_behavior_set(connection_.handle_, MEMCACHED_BEHAVIOR_BUFFER_REQUESTS, 1);
+  for (size_t i = 0; i < keys.size() && (error == MEMCACHED_SUCCESS || error == MEMCACHED_BUFFERED); ++i) {
+    const NKey cur = keys[i].GetKey();
+    const string_key_t key_slice = cur.GetKey().ToBytes();
+    const std::string value_str = keys[i].ValueString();
+    const time_t expiration = cur.GetTTL() > 0 ? cur.GetTTL() : 0;
+    error = memcached_set(connection_.handle_, reinterpret_cast<const char*>(key_slice.data()), key_slice.size(),
+                          value_str.c_str(), value_str.length(), expiration, 0);
+  }
+
+  if (error == MEMCACHED_SUCCESS || error == MEMCACHED_BUFFERED) {
+    error = memcached_flush_buffers(connection_.handle_);
+  }
+  memcached_behavior_set(connection_.handle_, MEMCACHED_BEHAVIOR_BUFFER_REQUESTS, 0);
+
+  if (error != MEMCACHED_SUCCESS) {
+    std::string buff = common::MemSPrintf("Set function error: %s", memcached_strerror(connection_.handle_, error));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::RenameImpl(const NKey& key, string_key_t new_key) {
   key_t key_str = key.GetKey();
   std::string value_str;
@@ -742,6 +821,26 @@ common::Error DBConnection::GetTTLImpl(const NKey& key, ttl_t* ttl) {
   return TTL(key.GetKey(), ttl);
 }
 
+common::Error DBConnection::ExistsImpl(const NKeys& keys, NKeys* existing_keys) {
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const string_key_t key_slice = keys[i].GetKey().ToBytes();
+    const char* key_slice_ptr = reinterpret_cast<const char*>(key_slice.data());
+    memcached_return_t error = memcached_exist(connection_.handle_, key_slice_ptr, key_slice.size());
+    if (error == MEMCACHED_NOTFOUND) {
+      continue;
+    }
+
+    if (error != MEMCACHED_SUCCESS) {
+      std::string buff = common::MemSPrintf("Exist function error: %s", memcached_strerror(connection_.handle_, error));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    existing_keys->push_back(keys[i]);
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::QuitImpl() {
   common::Error err = Disconnect();
   if (err && err->IsError()) {
@@ -21,6 +21,7 @@
 #include <stdint.h>  // for uint32_t, uint64_t
 #include <time.h>    // for time_t
 #include <string>    // for string
+#include <vector>    // for vector
 
 #include <common/error.h>   // for Error
 #include <common/macros.h>  // for WARN_UNUSED_RESULT
@@ -30,6 +31,7 @@
 #include "core/db/memcached/config.h"
 #include "core/db/memcached/server_info.h"
 #include "core/db_key.h"                   // for NDbKValue, NKey, NKeys
+#include "core/global.h"                   // for FastoObjectCommandIPtr
 #include "core/internal/cdb_connection.h"  // for CDBConnection
 
 namespace fastonosql {
@@ -84,6 +86,11 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
 
   common::Error TTL(key_t key, ttl_t* expiration) WARN_UNUSED_RESULT;
 
+  // runs of set commands are buffered and written with one flush, other commands are sent unbuffered
+  // so that their NOT_STORED/NOT_FOUND replies are read
+  common::Error ExecuteAsPipeline(const std::vector<FastoObjectCommandIPtr>& cmds,
+                                  void (*log_command_cb)(FastoObjectCommandIPtr)) WARN_UNUSED_RESULT;
+
  private:
   common::Error DelInner(key_t key, time_t expiration) WARN_UNUSED_RESULT;
   common::Error GetInner(key_t key, std::string* ret_val) WARN_UNUSED_RESULT;
@@ -105,9 +112,11 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   virtual common::Error DeleteImpl(const NKeys& keys, NKeys* deleted_keys) override;
   virtual common::Error GetImpl(const NKey& key, NDbKValue* loaded_key) override;
   virtual common::Error SetImpl(const NDbKValue& key, NDbKValue* added_key) override;
+  virtual common::Error BulkSetImpl(const NDbKValues& keys) override;
   virtual common::Error RenameImpl(const NKey& key, string_key_t new_key) override;
   virtual common::Error SetTTLImpl(const NKey& key, ttl_t ttl) override;
   virtual common::Error GetTTLImpl(const NKey& key, ttl_t* ttl) override;
+  virtual common::Error ExistsImpl(const NKeys& keys, NKeys* existing_keys) override;
   virtual common::Error QuitImpl() override;
 
   ServerInfo::Stats current_info_;
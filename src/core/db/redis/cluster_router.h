@@ -0,0 +1,94 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint16_t
+
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include <common/error.h>      // for Error
+#include <common/macros.h>     // for WARN_UNUSED_RESULT
+#include <common/net/types.h>  // for HostAndPort
+
+#include "core/types.h"  // for commands_args_t
+
+#define REDIS_CLUSTER_SLOTS_COUNT 16384
+#define REDIS_CLUSTER_MAX_REDIRECTS 5
+
+namespace fastonosql {
+namespace core {
+namespace redis {
+
+// CRC16 of the key (or of its {hash tag}) modulo slots count, as the cluster computes it
+uint16_t KeyHashSlot(const char* key, size_t len);
+uint16_t KeyHashSlot(const std::string& key);
+
+// "MOVED 3999 127.0.0.1:6381" or "ASK 3999 127.0.0.1:6381" error replies
+struct ClusterRedirect {
+  ClusterRedirect();
+
+  bool ask;
+  uint16_t slot;
+  common::net::HostAndPort host;
+};
+
+bool ParseClusterRedirect(const std::string& error, ClusterRedirect* redirect);
+
+// key positions of a command as COMMAND INFO reports them, a negative last_key counts from the end
+struct ClusterKeySpec {
+  ClusterKeySpec();
+  ClusterKeySpec(int first_key, int last_key, int step);
+
+  int first_key;  // 0 if the command is keyless or its keys can't be found by position
+  int last_key;
+  int step;
+};
+
+// slot all keys of argv hash to, has_keys is false for keyless commands;
+// keys spread over several slots are an error, commands are not split between nodes
+common::Error CommandKeysSlot(const commands_args_t& argv,
+                              const ClusterKeySpec& spec,
+                              bool* has_keys,
+                              uint16_t* slot) WARN_UNUSED_RESULT;
+
+class ClusterSlotsMap {
+ public:
+  typedef std::vector<common::net::HostAndPort> nodes_t;
+
+  ClusterSlotsMap();
+
+  bool IsEmpty() const;
+  void Clear();
+
+  void SetSlots(uint16_t first, uint16_t last, const common::net::HostAndPort& host);
+  bool FindNode(uint16_t slot, common::net::HostAndPort* host) const;
+  nodes_t Nodes() const;
+
+ private:
+  size_t NodeIndex(const common::net::HostAndPort& host);
+
+  nodes_t nodes_;
+  std::vector<int> slots_;  // index in nodes_, -1 for unassigned slot
+};
+
+}  // namespace redis
+}  // namespace core
+}  // namespace fastonosql
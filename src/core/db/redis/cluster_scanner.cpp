@@ -0,0 +1,196 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/db/redis/cluster_scanner.h"
+
+#include <algorithm>  // for min
+#include <memory>     // for shared_ptr
+#include <thread>     // for thread
+
+#include <common/macros.h>  // for UNUSED
+#include <common/value.h>   // for ErrorValue
+
+#include "core/db/redis/cluster_infos.h"  // for ServerDiscoveryClusterInfoSPtr
+
+namespace fastonosql {
+namespace core {
+namespace redis {
+
+common::Error DiscoveryClusterMasters(const RConfig& rconfig, std::vector<RConfig>* masters) {
+  if (!masters) {
+    return common::make_inval_error_value(common::ErrorValue::E_ERROR);
+  }
+
+  std::vector<ServerDiscoveryClusterInfoSPtr> infos;
+  common::Error err = DiscoveryClusterConnection(rconfig, &infos);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  std::vector<RConfig> lmasters;
+  for (ServerDiscoveryClusterInfoSPtr inf : infos) {
+    const ServerCommonInfo info = inf->info();
+    if (info.type != MASTER || info.state == SDOWN) {
+      continue;
+    }
+
+    const common::net::HostAndPortAndSlot host = inf->host();
+    RConfig node = rconfig;
+    node.host.host = host.host;
+    node.host.port = host.port;
+    node.dbnum = 0;  // cluster has only one database
+    lmasters.push_back(node);
+  }
+
+  *masters = lmasters;
+  return common::Error();
+}
+
+ClusterKeysScanner::ClusterKeysScanner(const std::vector<RConfig>& nodes, const std::string& pattern, uint64_t limit)
+    : nodes_(nodes),
+      pattern_(pattern),
+      limit_(limit),
+      keys_cb_(),
+      progress_cb_(),
+      interrupted_cb_(),
+      found_(0),
+      nodes_keys_(0),
+      stopped_(false),
+      lock_(),
+      error_() {}
+
+size_t ClusterKeysScanner::NodesCount() const {
+  return nodes_.size();
+}
+
+uint64_t ClusterKeysScanner::FoundKeysCount() const {
+  return found_;
+}
+
+uint64_t ClusterKeysScanner::NodesKeysCount() const {
+  return nodes_keys_;
+}
+
+common::Error ClusterKeysScanner::Scan(keys_callback_t keys_cb,
+                                       progress_callback_t progress_cb,
+                                       interrupted_callback_t interrupted_cb) {
+  keys_cb_ = keys_cb;
+  progress_cb_ = progress_cb;
+  interrupted_cb_ = interrupted_cb;
+  found_ = 0;
+  nodes_keys_ = 0;
+  stopped_ = false;
+  error_ = common::Error();
+
+  std::vector<std::thread> workers;
+  workers.reserve(nodes_.size());
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    workers.push_back(std::thread(&ClusterKeysScanner::ScanNode, this, i));
+  }
+
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  return error_;
+}
+
+void ClusterKeysScanner::ScanNode(size_t index) {
+  DBConnection connection(nullptr);
+  common::Error err = connection.Connect(nodes_[index]);
+  if (err && err->IsError()) {
+    SetError(err);
+    return;
+  }
+
+  size_t dbsize = 0;
+  err = connection.DBkcount(&dbsize);
+  if (!err) {
+    nodes_keys_ += dbsize;
+  }
+
+  uint64_t node_keys = 0;
+  uint64_t cursor = 0;
+  do {
+    if (IsStopped()) {
+      break;
+    }
+
+    std::vector<std::string> keys;
+    uint64_t cursor_out = 0;
+    err = connection.Scan(cursor, pattern_, CLUSTER_SCAN_BATCH_SIZE, &keys, &cursor_out);
+    if (err && err->IsError()) {
+      SetError(err);
+      break;
+    }
+
+    cursor = cursor_out;
+    const size_t reserved = ReserveKeys(keys.size());
+    if (reserved < keys.size()) {
+      keys.resize(reserved);
+      cursor = 0;  // limit reached
+      stopped_ = true;
+    }
+
+    if (!keys.empty()) {
+      err = keys_cb_(index, &connection, keys);
+      if (err && err->IsError()) {
+        SetError(err);
+        break;
+      }
+
+      node_keys += keys.size();
+      std::lock_guard<std::mutex> lock(lock_);
+      progress_cb_(index, node_keys, false);
+    }
+  } while (cursor != 0);
+
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    progress_cb_(index, node_keys, true);
+  }
+  err = connection.Disconnect();
+  UNUSED(err);
+}
+
+size_t ClusterKeysScanner::ReserveKeys(size_t count) {
+  uint64_t found = found_;
+  while (true) {
+    const uint64_t left = found < limit_ ? limit_ - found : 0;
+    const uint64_t take = std::min<uint64_t>(left, count);
+    if (found_.compare_exchange_weak(found, found + take)) {
+      return take;
+    }
+  }
+}
+
+bool ClusterKeysScanner::IsStopped() const {
+  return stopped_ || found_ >= limit_ || interrupted_cb_();
+}
+
+void ClusterKeysScanner::SetError(common::Error err) {
+  std::lock_guard<std::mutex> lock(lock_);
+  if (!error_) {
+    error_ = err;
+  }
+  stopped_ = true;
+}
+
+}  // namespace redis
+}  // namespace core
+}  // namespace fastonosql
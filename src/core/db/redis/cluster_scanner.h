@@ -0,0 +1,89 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>  // for uint64_t
+
+#include <atomic>      // for atomic
+#include <functional>  // for function
+#include <mutex>       // for mutex
+#include <string>      // for string
+#include <vector>      // for vector
+
+#include <common/error.h>  // for Error
+
+#include "core/db/redis/db_connection.h"  // for RConfig, DBConnection
+
+#define CLUSTER_SCAN_BATCH_SIZE 1000  // COUNT hint of every SCAN sent to a node
+
+namespace fastonosql {
+namespace core {
+namespace redis {
+
+// configs of all master nodes of the cluster reachable from rconfig, empty if
+// the instance has cluster support disabled
+common::Error DiscoveryClusterMasters(const RConfig& rconfig, std::vector<RConfig>* masters) WARN_UNUSED_RESULT;
+
+// Scans every node concurrently, each on its own connection and cursor, until
+// all cursors are exhausted or the keys limit for the whole cluster is reached.
+class ClusterKeysScanner {
+ public:
+  // called concurrently from node threads with a batch already counted against
+  // the limit, connection is the node one and can be used for follow-up commands
+  typedef std::function<common::Error(size_t node, DBConnection* connection, const std::vector<std::string>& keys)>
+      keys_callback_t;
+  // serialized, node_keys is the count of keys delivered from this node so far
+  typedef std::function<void(size_t node, uint64_t node_keys, bool finished)> progress_callback_t;
+  typedef std::function<bool()> interrupted_callback_t;
+
+  ClusterKeysScanner(const std::vector<RConfig>& nodes, const std::string& pattern, uint64_t limit);
+
+  size_t NodesCount() const;
+  uint64_t FoundKeysCount() const;
+  uint64_t NodesKeysCount() const;  // DBSIZE sum of the scanned nodes
+
+  // blocks until every node finished, returns first error of any node
+  common::Error Scan(keys_callback_t keys_cb,
+                     progress_callback_t progress_cb,
+                     interrupted_callback_t interrupted_cb) WARN_UNUSED_RESULT;
+
+ private:
+  void ScanNode(size_t index);
+  size_t ReserveKeys(size_t count);
+  bool IsStopped() const;
+  void SetError(common::Error err);
+
+  const std::vector<RConfig> nodes_;
+  const std::string pattern_;
+  const uint64_t limit_;
+
+  keys_callback_t keys_cb_;
+  progress_callback_t progress_cb_;
+  interrupted_callback_t interrupted_cb_;
+
+  std::atomic<uint64_t> found_;
+  std::atomic<uint64_t> nodes_keys_;
+  std::atomic<bool> stopped_;
+  std::mutex lock_;  // guards error_ and progress_cb_
+  common::Error error_;
+};
+
+}  // namespace redis
+}  // namespace core
+}  // namespace fastonosql
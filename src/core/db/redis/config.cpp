@@ -64,6 +64,16 @@ Config parseOptions(int argc, char** argv) {
       }
     } else if (!strcmp(argv[i], "-a") && !lastarg) {
       cfg.auth = argv[++i];
+    } else if (!strcmp(argv[i], "-pw") && !lastarg) {
+      uint32_t lwindow;
+      if (common::ConvertFromString(std::string(argv[++i]), &lwindow) && lwindow) {
+        cfg.pipeline_window = lwindow;
+      }
+    } else if (!strcmp(argv[i], "-vp") && !lastarg) {
+      uint32_t lpreview;
+      if (common::ConvertFromString(std::string(argv[++i]), &lpreview)) {
+        cfg.value_preview_size = lpreview;
+      }
     } else if (!strcmp(argv[i], "-d") && !lastarg) {
       cfg.delimiter = argv[++i];
     } else if (!strcmp(argv[i], "-ns") && !lastarg) {
@@ -92,7 +102,9 @@ Config::Config()
     : RemoteConfig(common::net::HostAndPort::CreateLocalHost(DEFAULT_REDIS_SERVER_PORT)),
       hostsocket(),
       dbnum(0),
-      auth() {}
+      auth(),
+      pipeline_window(REDIS_DEFAULT_PIPELINE_WINDOW_SIZE),
+      value_preview_size(REDIS_DEFAULT_VALUE_PREVIEW_SIZE) {}
 
 }  // namespace redis
 }  // namespace core
@@ -117,6 +129,16 @@ std::string ConvertToString(const fastonosql::core::redis::Config& conf) {
     argv.push_back(conf.auth);
   }
 
+  if (conf.pipeline_window != REDIS_DEFAULT_PIPELINE_WINDOW_SIZE) {
+    argv.push_back("-pw");
+    argv.push_back(ConvertToString(conf.pipeline_window));
+  }
+
+  if (conf.value_preview_size != REDIS_DEFAULT_VALUE_PREVIEW_SIZE) {
+    argv.push_back("-vp");
+    argv.push_back(ConvertToString(conf.value_preview_size));
+  }
+
   return fastonosql::core::ConvertToStringConfigArgs(argv);
 }
 
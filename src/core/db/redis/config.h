@@ -18,12 +18,15 @@
 
 #pragma once
 
-#include <stdint.h>  // for uint64_t
+#include <stdint.h>  // for uint32_t, uint64_t
 
 #include <string>  // for string
 
 #include "core/config/config.h"  // for RemoteConfig
 
+#define REDIS_DEFAULT_PIPELINE_WINDOW_SIZE 512  // commands in flight
+#define REDIS_DEFAULT_VALUE_PREVIEW_SIZE 256    // 0 disables string values preview
+
 namespace fastonosql {
 namespace core {
 namespace redis {
@@ -34,6 +37,8 @@ struct Config : public RemoteConfig {
   std::string hostsocket;
   int dbnum;
   std::string auth;
+  uint32_t pipeline_window;     // explorer key loading and cluster scan pipelines
+  uint32_t value_preview_size;  // string values up to this size are loaded with the keys
 };
 
 }  // namespace redis
@@ -34,6 +34,8 @@
 #include <stdlib.h>  // for free, malloc, realloc, etc
 #include <string.h>  // for strcasecmp, NULL, strcmp, etc
 
+#include <algorithm>  // for transform
+#include <deque>
 #include <memory>  // for __shared_ptr
 #include <sstream>
 #include <string>
@@ -60,6 +62,7 @@ extern "C" {
 #include "core/icommand_translator.h"  // for translator_t, etc
 
 #include "core/command_holder.h"  // for CommandHolder
+#include "core/types.h"           // for ParseCommandLine
 
 #include "core/internal/cdb_connection_client.h"
 #include "core/internal/connection.h"  // for Connection<>::config_t, etc
@@ -184,6 +187,52 @@ bool isPipeLineCommand(const char* command) {
   return !skip;
 }
 
+// connection state is kept on the client side for these, so they go through their handlers
+bool isConnectionStateCommand(const char* command) {
+  return strcasecmp(command, "select") == 0 || strcasecmp(command, "auth") == 0 || strcasecmp(command, "multi") == 0 ||
+         strcasecmp(command, "exec") == 0 || strcasecmp(command, "discard") == 0 ||
+         strcasecmp(command, "watch") == 0 || strcasecmp(command, "unwatch") == 0 ||
+         strcasecmp(command, "client") == 0 || strcasecmp(command, "readonly") == 0 ||
+         strcasecmp(command, "readwrite") == 0 || strcasecmp(command, "flushdb") == 0 ||
+         strcasecmp(command, "flushall") == 0 || strcasecmp(command, "swapdb") == 0;
+}
+
+bool isPipeLineCommand(const fastonosql::core::command_buffer_t& command) {
+  const fastonosql::core::command_buffer_t name = command.substr(0, command.find(' '));
+  return !name.empty() && isPipeLineCommand(name.c_str()) && !isConnectionStateCommand(name.c_str());
+}
+
+bool appendPipelineCommand(redisContext* context,
+                           fastonosql::core::FastoObjectCommandIPtr cmd,
+                           void (*log_command_cb)(fastonosql::core::FastoObjectCommandIPtr command)) {
+  fastonosql::core::command_buffer_t command = cmd->InputCommand();
+  if (command.empty()) {
+    return false;
+  }
+
+  if (log_command_cb) {
+    log_command_cb(cmd);
+  }
+
+  int argc = 0;
+  sds* argv = sdssplitargslong(command.data(), &argc);
+  if (!argv) {
+    return false;
+  }
+
+  bool appended = false;
+  if (argc > 0 && isPipeLineCommand(argv[0])) {
+    size_t* argvlen = reinterpret_cast<size_t*>(malloc(argc * sizeof(size_t)));
+    for (int i = 0; i < argc; ++i) {
+      argvlen[i] = sdslen(argv[i]);
+    }
+    appended = redisAppendCommandArgv(context, argc, const_cast<const char**>(argv), argvlen) == REDIS_OK;
+    free(argvlen);
+  }
+  sdsfreesplitres(argv, argc);
+  return appended;
+}
+
 }  // namespace
 
 namespace fastonosql {
@@ -242,6 +291,21 @@ ConstantCommandsArray CDBConnection<redis::NativeConnection, redis::RConfig, RED
 namespace redis {
 namespace {
 
+void appendCommandArgv(redisContext* context, const commands_args_t& argv) {
+  const char** argvc = static_cast<const char**>(calloc(sizeof(const char*), argv.size()));
+  int argcc = 0;
+  size_t* argvlen = reinterpret_cast<size_t*>(malloc(argv.size() * sizeof(size_t)));
+  for (size_t i = 0; i < argv.size(); ++i) {
+    argvc[i] = argv[i].c_str();
+    argvlen[i] = argv[i].size();
+    argcc++;
+  }
+
+  redisAppendCommandArgv(context, argcc, argvc, argvlen);
+  free(argvlen);
+  free(argvc);
+}
+
 redisReply* ExecRedisCommand(redisContext* c, command_buffer_t command) {
   if (command.empty()) {
     return NULL;
@@ -545,7 +609,17 @@ common::Error DiscoverySentinelConnection(const RConfig& rconfig, std::vector<Se
 }
 
 DBConnection::DBConnection(CDBConnectionClient* client)
-    : base_class(client, new CommandTranslator(base_class::Commands())), isAuth_(false), cur_db_(-1) {}
+    : base_class(client, new CommandTranslator(base_class::Commands())),
+      isAuth_(false),
+      cur_db_(-1),
+      cluster_mode_(false),
+      cluster_slots_(),
+      cluster_nodes_(),
+      cluster_key_specs_() {}
+
+DBConnection::~DBConnection() {
+  CloseClusterNodes();
+}
 
 bool DBConnection::IsAuthenticated() const {
   if (!IsConnected()) {
@@ -575,6 +649,32 @@ common::Error DBConnection::Connect(const config_t& config) {
   return common::Error();
 }
 
+common::Error DBConnection::Disconnect() {
+  CloseClusterNodes();
+  cluster_mode_ = false;
+  cluster_slots_.Clear();
+  cluster_key_specs_.clear();
+  return base_class::Disconnect();
+}
+
+common::Error DBConnection::EnableClusterMode() {
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  common::Error err = RefreshClusterSlots();
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  cluster_mode_ = true;
+  return common::Error();
+}
+
+bool DBConnection::IsClusterMode() const {
+  return cluster_mode_;
+}
+
 std::string DBConnection::CurrentDBName() const {
   if (cur_db_ != -1) {
     return common::ConvertToString(cur_db_);
@@ -668,7 +768,7 @@ common::Error DBConnection::SlaveMode(FastoObject* out) {
   /* Now we can use hiredis to read the incoming protocol.
    */
   while (!IsInterrupted()) {
-    err = CliReadReply(out);
+    err = CliReadStreamReply(out);
     if (err && err->IsError()) {
       return err;
     }
@@ -809,9 +909,10 @@ common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
       return err;
     }
 
-    redisReply* reply = ExecRedisCommand(connection_.handle_, del_cmd);
-    if (!reply) {
-      return cliPrintContextError(connection_.handle_);
+    redisReply* reply = NULL;
+    err = ExecKeyCommand(del_cmd, &reply);
+    if (err && err->IsError()) {
+      return err;
     }
 
     if (reply->type == REDIS_REPLY_INTEGER && reply->integer == 1) {
@@ -831,9 +932,10 @@ common::Error DBConnection::SetImpl(const NDbKValue& key, NDbKValue* added_key)
     return err;
   }
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, set_cmd);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  err = ExecKeyCommand(set_cmd, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   if (reply->type == REDIS_REPLY_ERROR) {
@@ -847,6 +949,167 @@ common::Error DBConnection::SetImpl(const NDbKValue& key, NDbKValue* added_key)
   return common::Error();
 }
 
+common::Error DBConnection::BulkSetImpl(const NDbKValues& keys) {
+  std::vector<commands_args_t> cmds(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const NKey cur = keys[i].GetKey();
+    commands_args_t& argv = cmds[i];
+    argv.push_back("SET");
+    argv.push_back(cur.GetKey().ToBytes());
+    argv.push_back(keys[i].ValueString());
+    if (cur.GetTTL() > 0) {
+      argv.push_back("EX");
+      argv.push_back(common::ConvertToString(cur.GetTTL()));
+    }
+  }
+
+  return ExecuteArgvBatch(cmds);
+}
+
+common::Error DBConnection::Restore(const NDbKValues& keys) {
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  std::vector<commands_args_t> cmds(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const NKey cur = keys[i].GetKey();
+    const ttl_t ttl_msec = cur.GetTTL() > 0 ? cur.GetTTL() * 1000 : 0;
+    commands_args_t& argv = cmds[i];
+    argv.push_back("RESTORE");
+    argv.push_back(cur.GetKey().ToBytes());
+    argv.push_back(common::ConvertToString(ttl_msec));
+    argv.push_back(keys[i].ValueString());
+    argv.push_back("REPLACE");
+  }
+
+  return ExecuteArgvBatch(cmds);
+}
+
+common::Error DBConnection::WalkImpl(const std::string& position, walk_callback_t cb) {
+  if (cluster_mode_) {
+    return common::make_error_value("Backup of a cluster isn't supported, back up every master separately",
+                                    common::ErrorValue::E_ERROR);
+  }
+
+  uint64_t cursor = 0;
+  if (!position.empty()) {
+    if (!common::ConvertFromString(position, &cursor)) {
+      return common::make_error_value("Invalid backup position: " + position, common::ErrorValue::E_ERROR);
+    }
+    if (cursor == 0) {  // walk was finished
+      return common::Error();
+    }
+  }
+
+  NativeConnection* context = connection_.handle_;
+  do {
+    commands_args_t scan_cmd = {"SCAN", common::ConvertToString(cursor), "COUNT",
+                                common::ConvertToString(WALK_KEYS_PAGE_SIZE)};
+    appendCommandArgv(context, scan_cmd);
+    void* reply_ptr = NULL;
+    if (redisGetReply(context, &reply_ptr) == REDIS_ERR) {
+      return cliPrintContextError(context);
+    }
+
+    redisReply* reply = static_cast<redisReply*>(reply_ptr);
+    if (reply->type != REDIS_REPLY_ARRAY || reply->elements != 2 || reply->element[0]->type != REDIS_REPLY_STRING ||
+        reply->element[1]->type != REDIS_REPLY_ARRAY ||
+        !common::ConvertFromString(std::string(reply->element[0]->str, reply->element[0]->len), &cursor)) {
+      freeReplyObject(reply);
+      return common::make_error_value("Invalid SCAN reply", common::ErrorValue::E_ERROR);
+    }
+
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < reply->element[1]->elements; ++i) {
+      redisReply* key = reply->element[1]->element[i];
+      if (key->type == REDIS_REPLY_STRING) {
+        keys.push_back(std::string(key->str, key->len));
+      }
+    }
+    freeReplyObject(reply);
+
+    // the page is one round trip: DUMP and PTTL of every key
+    for (size_t i = 0; i < keys.size(); ++i) {
+      appendCommandArgv(context, {"DUMP", keys[i]});
+      appendCommandArgv(context, {"PTTL", keys[i]});
+    }
+
+    NDbKValues records;
+    common::Error first_err;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (redisGetReply(context, &reply_ptr) == REDIS_ERR) {
+        return cliPrintContextError(context);
+      }
+      redisReply* dump = static_cast<redisReply*>(reply_ptr);
+      if (redisGetReply(context, &reply_ptr) == REDIS_ERR) {
+        freeReplyObject(dump);
+        return cliPrintContextError(context);
+      }
+      redisReply* pttl = static_cast<redisReply*>(reply_ptr);
+      if (dump->type == REDIS_REPLY_ERROR && !first_err) {
+        first_err = common::make_error_value(std::string(dump->str, dump->len), common::ErrorValue::E_ERROR);
+      } else if (dump->type == REDIS_REPLY_STRING && pttl->type == REDIS_REPLY_INTEGER &&
+                 pttl->integer != -2) {  // -2 and nil dump: removed since scan
+        const ttl_t ttl = pttl->integer > 0 ? (pttl->integer + 999) / 1000 : NO_TTL;
+        NValue val(common::Value::CreateStringValue(std::string(dump->str, dump->len)));
+        records.push_back(NDbKValue(NKey(key_t(keys[i]), ttl), val));
+      }
+      freeReplyObject(dump);
+      freeReplyObject(pttl);
+    }
+
+    if (first_err) {
+      return first_err;
+    }
+
+    // SCAN has no position inside a page, so only the last record continues the walk
+    const std::string next_position = common::ConvertToString(cursor);
+    for (size_t i = 0; i < records.size(); ++i) {
+      common::Error err = cb(records[i], i == records.size() - 1 ? next_position : std::string());
+      if (err && err->IsError()) {
+        return err;
+      }
+    }
+  } while (cursor != 0);
+
+  return common::Error();
+}
+
+common::Error DBConnection::ExecuteArgvBatch(const std::vector<commands_args_t>& cmds) {
+  std::map<NativeConnection*, std::vector<size_t>> batches;  // one pipeline per node in cluster mode
+  for (size_t i = 0; i < cmds.size(); ++i) {
+    NativeConnection* context = connection_.handle_;
+    if (cluster_mode_) {
+      common::Error err = ClusterRoute(cmds[i], &context);
+      if (err && err->IsError()) {
+        return err;
+      }
+    }
+    batches[context].push_back(i);
+  }
+
+  std::vector<size_t> redirected;
+  for (auto it = batches.begin(); it != batches.end(); ++it) {
+    common::Error err = ExecuteArgvAsPipeline(it->first, cmds, it->second, connection_.config_.pipeline_window,
+                                              cluster_mode_ ? &redirected : nullptr);
+    if (err && err->IsError()) {
+      return err;
+    }
+  }
+
+  // slots moved while the batch was sent, the slots map is refreshed by the first MOVED
+  for (size_t index : redirected) {
+    FastoObjectIPtr root(FastoObject::CreateRoot(cmds[index][0]));
+    common::Error err = ClusterExec(cmds[index], root.get());
+    if (err && err->IsError()) {
+      return err;
+    }
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
   command_buffer_t get_cmd;
   translator_t tran = Translator();
@@ -855,9 +1118,10 @@ common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
     return err;
   }
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, get_cmd);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  err = ExecKeyCommand(get_cmd, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   common::Value* val = nullptr;
@@ -885,9 +1149,10 @@ common::Error DBConnection::RenameImpl(const NKey& key, string_key_t new_key) {
     return err;
   }
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, rename_cmd);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  err = ExecKeyCommand(rename_cmd, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   if (reply->type == REDIS_REPLY_ERROR) {
@@ -909,9 +1174,10 @@ common::Error DBConnection::SetTTLImpl(const NKey& key, ttl_t ttl) {
     return err;
   }
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, ttl_cmd);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  err = ExecKeyCommand(ttl_cmd, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   if (reply->type == REDIS_REPLY_ERROR) {
@@ -939,9 +1205,10 @@ common::Error DBConnection::GetTTLImpl(const NKey& key, ttl_t* ttl) {
     return err;
   }
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, ttl_cmd);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  err = ExecKeyCommand(ttl_cmd, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   if (reply->type == REDIS_REPLY_ERROR) {
@@ -967,8 +1234,7 @@ common::Error DBConnection::QuitImpl() {
   }
 
   freeReplyObject(reply);
-  base_class::Disconnect();
-  return common::Error();
+  return Disconnect();
 }
 
 common::Error DBConnection::CliFormatReplyRaw(FastoObjectArray* ar, redisReply* r) {
@@ -1083,36 +1349,87 @@ common::Error DBConnection::CliFormatReplyRaw(FastoObject* out, redisReply* r) {
 }
 
 common::Error DBConnection::CliReadReply(FastoObject* out) {
+  return CliReadReply(connection_.handle_, out);
+}
+
+common::Error DBConnection::CliReadReply(NativeConnection* context, FastoObject* out) {
   if (!out) {
     DNOTREACHED();
     return common::make_inval_error_value(common::ErrorValue::E_ERROR);
   }
 
+  redisReply* reply = NULL;
+  common::Error er = CliGetReply(context, &reply);
+  if (er && er->IsError()) {
+    return er;
+  }
+
+  er = CliFormatReplyRaw(out, reply);
+  freeReplyObject(reply);
+  return er;
+}
+
+common::Error DBConnection::CliGetReply(NativeConnection* context, redisReply** reply) {
   if (!IsConnected()) {
     return common::make_error_value("Not connected", common::Value::E_ERROR);
   }
 
   void* _reply = NULL;
-  if (redisGetReply(connection_.handle_, &_reply) != REDIS_OK) {
+  if (redisGetReply(context, &_reply) != REDIS_OK) {
     /* Filter cases where we should reconnect */
-    if (connection_.handle_->err == REDIS_ERR_IO && errno == ECONNRESET) {
+    if (context->err == REDIS_ERR_IO && errno == ECONNRESET) {
       return common::make_error_value("Needed reconnect.", common::ErrorValue::E_ERROR);
     }
-    if (connection_.handle_->err == REDIS_ERR_EOF) {
+    if (context->err == REDIS_ERR_EOF) {
       return common::make_error_value("Needed reconnect.", common::ErrorValue::E_ERROR);
     }
 
-    return cliPrintContextError(connection_.handle_); /* avoid compiler warning */
+    return cliPrintContextError(context); /* avoid compiler warning */
+  }
+
+  *reply = static_cast<redisReply*>(_reply);
+  return common::Error();
+}
+
+common::Error DBConnection::CliFormatStreamReply(FastoObject* out, redisReply* r) {
+  if (r->type != REDIS_REPLY_ARRAY) {  // scalar replies are complete when added
+    return CliFormatReplyRaw(out, r);
+  }
+
+  common::ArrayValue* arv = common::Value::CreateArrayValue();
+  FastoObjectIPtr child(new FastoObjectArray(out, arv, Delimiter()));
+  FastoObjectArray* child_array = static_cast<FastoObjectArray*>(child.get());
+  for (size_t i = 0; i < r->elements; ++i) {
+    common::Error er = CliFormatReplyRaw(child_array, r->element[i]);
+    if (er && er->IsError()) {
+      return er;
+    }
+  }
+
+  out->AddChildren(child);
+  return common::Error();
+}
+
+common::Error DBConnection::CliReadStreamReply(FastoObject* out) {
+  if (!out) {
+    DNOTREACHED();
+    return common::make_inval_error_value(common::ErrorValue::E_ERROR);
+  }
+
+  redisReply* reply = NULL;
+  common::Error er = CliGetReply(connection_.handle_, &reply);
+  if (er && er->IsError()) {
+    return er;
   }
 
-  redisReply* reply = static_cast<redisReply*>(_reply);
-  common::Error er = CliFormatReplyRaw(out, reply);
+  er = CliFormatStreamReply(out, reply);
   freeReplyObject(reply);
   return er;
 }
 
 common::Error DBConnection::ExecuteAsPipeline(const std::vector<FastoObjectCommandIPtr>& cmds,
-                                              void (*log_command_cb)(FastoObjectCommandIPtr command)) {
+                                              void (*log_command_cb)(FastoObjectCommandIPtr command),
+                                              size_t window) {
   if (cmds.empty()) {
     DNOTREACHED();
     return common::make_error_value("Invalid input command", common::ErrorValue::E_ERROR);
@@ -1122,45 +1439,122 @@ common::Error DBConnection::ExecuteAsPipeline(const std::vector<FastoObjectComma
     return common::make_error_value("Not connected", common::Value::E_ERROR);
   }
 
-  // start piplene mode
-  std::vector<FastoObjectCommandIPtr> valid_cmds;
-  for (size_t i = 0; i < cmds.size(); ++i) {
-    FastoObjectCommandIPtr cmd = cmds[i];
-    command_buffer_t command = cmd->InputCommand();
-    if (command.empty()) {
+  if (window == 0) {
+    window = connection_.config_.pipeline_window;
+  }
+
+  // runs of plain commands are pipelined, the rest run alone in their place
+  std::vector<FastoObjectCommandIPtr> run;
+  for (size_t i = 0; i <= cmds.size(); ++i) {
+    if (i < cmds.size() && isPipeLineCommand(cmds[i]->InputCommand())) {
+      run.push_back(cmds[i]);
       continue;
     }
 
-    if (log_command_cb) {
-      log_command_cb(cmd);
+    if (!run.empty()) {
+      common::Error err = cluster_mode_ ? ClusterExecuteAsPipeline(run, log_command_cb, window)
+                                        : ExecuteAsPipeline(connection_.handle_, run, log_command_cb, window, nullptr);
+      if (err && err->IsError()) {
+        return err;
+      }
+      run.clear();
     }
 
-    int argc = 0;
-    sds* argv = sdssplitargslong(command.data(), &argc);
-    if (argv) {
-      if (isPipeLineCommand(argv[0])) {
-        valid_cmds.push_back(cmd);
-        size_t* argvlen = reinterpret_cast<size_t*>(malloc(argc * sizeof(size_t)));
-        for (int i = 0; i < argc; ++i) {
-          argvlen[i] = sdslen(argv[i]);
-        }
-        redisAppendCommandArgv(connection_.handle_, argc, const_cast<const char**>(argv), argvlen);
-        free(argvlen);
+    if (i < cmds.size()) {
+      if (log_command_cb) {
+        log_command_cb(cmds[i]);
+      }
+      common::Error err = Execute(cmds[i]->InputCommand(), cmds[i].get());
+      if (err && err->IsError()) {
+        return err;
       }
-      sdsfreesplitres(argv, argc);
     }
   }
 
-  for (size_t i = 0; i < valid_cmds.size(); ++i) {
-    FastoObjectCommandIPtr cmd = cmds[i];
-    common::Error er = CliReadReply(cmd.get());
+  return common::Error();
+}
+
+common::Error DBConnection::ExecuteAsPipeline(NativeConnection* context,
+                                              const std::vector<FastoObjectCommandIPtr>& cmds,
+                                              void (*log_command_cb)(FastoObjectCommandIPtr command),
+                                              size_t window,
+                                              std::vector<size_t>* redirected) {
+  // start piplene mode
+  common::Error first_err;
+  std::deque<size_t> in_flight;
+  size_t next = 0;
+  while (next < cmds.size() || !in_flight.empty()) {
+    while (next < cmds.size() && in_flight.size() < window) {
+      const size_t index = next++;
+      if (appendPipelineCommand(context, cmds[index], log_command_cb)) {
+        in_flight.push_back(index);
+      }
+    }
+
+    if (in_flight.empty()) {
+      break;
+    }
+
+    // redisGetReply flushes the appended commands before reading
+    const size_t index = in_flight.front();
+    in_flight.pop_front();
+    common::Error er = CliReadReply(context, cmds[index].get());
     if (er && er->IsError()) {
-      return er;
+      if (context->err) {  // nothing more can be read
+        return er;
+      }
+
+      ClusterRedirect redirect;
+      if (redirected && ParseClusterRedirect(er->Description(), &redirect)) {
+        redirected->push_back(index);
+        continue;
+      }
+
+      // replies of sent commands are still read to keep the connection in sync, nothing new is sent
+      if (!first_err) {
+        first_err = er;
+      }
+      next = cmds.size();
     }
   }
   // end piplene
 
-  return common::Error();
+  return first_err;
+}
+
+common::Error DBConnection::ExecuteArgvAsPipeline(NativeConnection* context,
+                                                  const std::vector<commands_args_t>& cmds,
+                                                  const std::vector<size_t>& indexes,
+                                                  size_t window,
+                                                  std::vector<size_t>* redirected) {
+  common::Error first_err;
+  size_t next = 0;
+  size_t done = 0;
+  while (done < indexes.size()) {
+    while (next < indexes.size() && next - done < window) {
+      appendCommandArgv(context, cmds[indexes[next++]]);
+    }
+
+    void* reply_ptr = NULL;
+    if (redisGetReply(context, &reply_ptr) == REDIS_ERR) {
+      return cliPrintContextError(context);
+    }
+
+    redisReply* reply = static_cast<redisReply*>(reply_ptr);
+    const size_t index = indexes[done++];
+    if (reply->type == REDIS_REPLY_ERROR) {
+      const std::string str(reply->str, reply->len);
+      ClusterRedirect redirect;
+      if (redirected && ParseClusterRedirect(str, &redirect)) {
+        redirected->push_back(index);
+      } else if (!first_err) {
+        first_err = common::make_error_value(str, common::ErrorValue::E_ERROR);
+      }
+    }
+    freeReplyObject(reply);
+  }
+
+  return first_err;
 }
 
 common::Error DBConnection::CommonExec(commands_args_t argv, FastoObject* out) {
@@ -1173,19 +1567,11 @@ common::Error DBConnection::CommonExec(commands_args_t argv, FastoObject* out) {
     return common::make_error_value("Not connected", common::Value::E_ERROR);
   }
 
-  const char** argvc = static_cast<const char**>(calloc(sizeof(const char*), argv.size()));
-  int argcc = 0;
-  size_t* argvlen = reinterpret_cast<size_t*>(malloc(argv.size() * sizeof(size_t)));
-  for (size_t i = 0; i < argv.size(); ++i) {
-    argvc[i] = argv[i].c_str();
-    argvlen[i] = argv[i].size();
-    argcc++;
+  if (cluster_mode_) {
+    return ClusterExec(argv, out);
   }
 
-  redisAppendCommandArgv(connection_.handle_, argcc, argvc, argvlen);
-  free(argvlen);
-  free(argvc);
-
+  appendCommandArgv(connection_.handle_, argv);
   common::Error err = CliReadReply(out);
   if (err && err->IsError()) {
     return err;
@@ -1194,6 +1580,308 @@ common::Error DBConnection::CommonExec(commands_args_t argv, FastoObject* out) {
   return common::Error();
 }
 
+common::Error DBConnection::RefreshClusterSlots() {
+  redisReply* reply = reinterpret_cast<redisReply*>(redisCommand(connection_.handle_, GET_CLUSTER_SLOTS));
+  if (!reply) {
+    return cliPrintContextError(connection_.handle_);
+  }
+
+  if (reply->type == REDIS_REPLY_ERROR) {
+    common::Error err = common::make_error_value(std::string(reply->str, reply->len), common::ErrorValue::E_ERROR);
+    freeReplyObject(reply);
+    return err;
+  }
+
+  // every entry is [first slot, last slot, [master host, port, ...], replicas...]
+  ClusterSlotsMap slots;
+  if (reply->type == REDIS_REPLY_ARRAY) {
+    for (size_t i = 0; i < reply->elements; ++i) {
+      redisReply* range = reply->element[i];
+      if (range->type != REDIS_REPLY_ARRAY || range->elements < 3) {
+        continue;
+      }
+
+      redisReply* master = range->element[2];
+      if (range->element[0]->type != REDIS_REPLY_INTEGER || range->element[1]->type != REDIS_REPLY_INTEGER ||
+          master->type != REDIS_REPLY_ARRAY || master->elements < 2 || master->element[0]->type != REDIS_REPLY_STRING ||
+          master->element[1]->type != REDIS_REPLY_INTEGER) {
+        continue;
+      }
+
+      common::net::HostAndPort host = connection_.config_.host;
+      const std::string master_host(master->element[0]->str, master->element[0]->len);
+      if (!master_host.empty() && !common::net::IsLocalHost(master_host)) {  // for direct connection
+        host.host = master_host;
+      }
+      host.port = static_cast<uint16_t>(master->element[1]->integer);
+      slots.SetSlots(static_cast<uint16_t>(range->element[0]->integer),
+                     static_cast<uint16_t>(range->element[1]->integer), host);
+    }
+  }
+  freeReplyObject(reply);
+
+  if (slots.IsEmpty()) {
+    return common::make_error_value("Cluster slots are not assigned", common::ErrorValue::E_ERROR);
+  }
+
+  cluster_slots_ = slots;
+  return common::Error();
+}
+
+common::Error DBConnection::ClusterNodeConnection(const common::net::HostAndPort& host, NativeConnection** context) {
+  const common::net::HostAndPort main_host = connection_.config_.host;
+  if (host.host == main_host.host && host.port == main_host.port) {
+    *context = connection_.handle_;
+    return common::Error();
+  }
+
+  const std::string node_key = common::ConvertToString(host);
+  auto it = cluster_nodes_.find(node_key);
+  if (it != cluster_nodes_.end()) {
+    *context = it->second;
+    return common::Error();
+  }
+
+  RConfig node_config = connection_.config_;
+  node_config.host = host;
+  NativeConnection* node = nullptr;
+  common::Error err = CreateConnection(node_config, &node);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  err = authContext(common::utils::c_strornull(connection_.config_.auth), node);
+  if (err && err->IsError()) {
+    redisFree(node);
+    return err;
+  }
+
+  cluster_nodes_[node_key] = node;
+  *context = node;
+  return common::Error();
+}
+
+common::Error DBConnection::ClusterRoute(const commands_args_t& argv, NativeConnection** context) {
+  *context = connection_.handle_;
+  if (argv.empty()) {
+    return common::Error();
+  }
+
+  // key positions come from the server itself, so modules and new commands are routed too
+  std::string name = argv[0];
+  std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+  ClusterKeySpec spec;
+  auto it = cluster_key_specs_.find(name);
+  if (it != cluster_key_specs_.end()) {
+    spec = it->second;
+  } else {
+    redisReply* reply =
+        reinterpret_cast<redisReply*>(redisCommand(connection_.handle_, GET_COMMAND_INFO_1ARGS_S, name.c_str()));
+    if (!reply) {
+      return cliPrintContextError(connection_.handle_);
+    }
+
+    if (reply->type == REDIS_REPLY_ARRAY && reply->elements == 1) {
+      redisReply* info = reply->element[0];
+      if (info->type == REDIS_REPLY_ARRAY && info->elements > 5 && info->element[3]->type == REDIS_REPLY_INTEGER &&
+          info->element[4]->type == REDIS_REPLY_INTEGER && info->element[5]->type == REDIS_REPLY_INTEGER) {
+        spec = ClusterKeySpec(static_cast<int>(info->element[3]->integer), static_cast<int>(info->element[4]->integer),
+                              static_cast<int>(info->element[5]->integer));
+      }
+    }
+    freeReplyObject(reply);
+    cluster_key_specs_[name] = spec;
+  }
+
+  bool has_keys = false;
+  uint16_t slot = 0;
+  common::Error err = CommandKeysSlot(argv, spec, &has_keys, &slot);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  common::net::HostAndPort host;
+  if (!has_keys || !cluster_slots_.FindNode(slot, &host)) {
+    return common::Error();
+  }
+
+  return ClusterNodeConnection(host, context);
+}
+
+common::Error DBConnection::FollowClusterRedirect(const std::string& error,
+                                                  NativeConnection** context,
+                                                  bool* asking,
+                                                  bool* redirected) {
+  ClusterRedirect redirect;
+  *redirected = ParseClusterRedirect(error, &redirect);
+  if (!*redirected) {
+    return common::Error();
+  }
+
+  // MOVED means the slots were resharded, ASK only migrates this slot for one command
+  if (!redirect.ask) {
+    common::Error err = RefreshClusterSlots();
+    if (err && err->IsError()) {
+      cluster_slots_.SetSlots(redirect.slot, redirect.slot, redirect.host);
+    }
+  }
+
+  *asking = redirect.ask;
+  return ClusterNodeConnection(redirect.host, context);
+}
+
+common::Error DBConnection::ClusterExec(const commands_args_t& argv, FastoObject* out) {
+  NativeConnection* context = nullptr;
+  common::Error err = ClusterRoute(argv, &context);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  bool asking = false;
+  for (size_t i = 0; i <= REDIS_CLUSTER_MAX_REDIRECTS; ++i) {
+    if (asking) {
+      redisReply* reply = reinterpret_cast<redisReply*>(redisCommand(context, CLUSTER_ASKING));
+      if (!reply) {
+        return cliPrintContextError(context);
+      }
+      freeReplyObject(reply);
+    }
+
+    appendCommandArgv(context, argv);
+    err = CliReadReply(context, out);
+    if (!err || !err->IsError()) {
+      return common::Error();
+    }
+
+    bool redirected = false;
+    common::Error rerr = FollowClusterRedirect(err->Description(), &context, &asking, &redirected);
+    if (rerr && rerr->IsError()) {
+      return rerr;
+    }
+
+    if (!redirected) {
+      return err;
+    }
+  }
+
+  return common::make_error_value("Too many cluster redirects", common::ErrorValue::E_ERROR);
+}
+
+common::Error DBConnection::ClusterExecuteAsPipeline(const std::vector<FastoObjectCommandIPtr>& cmds,
+                                                     void (*log_command_cb)(FastoObjectCommandIPtr command),
+                                                     size_t window) {
+  // one pipeline per node, commands keep their order inside a node
+  std::vector<std::pair<NativeConnection*, std::vector<FastoObjectCommandIPtr>>> batches;
+  std::vector<std::vector<size_t>> batches_indexes;
+  std::vector<commands_args_t> args(cmds.size());
+  for (size_t i = 0; i < cmds.size(); ++i) {
+    NativeConnection* context = connection_.handle_;
+    if (ParseCommandLine(cmds[i]->InputCommand(), &args[i])) {
+      common::Error err = ClusterRoute(args[i], &context);
+      if (err && err->IsError()) {
+        return err;
+      }
+    }
+
+    size_t batch = 0;
+    while (batch < batches.size() && batches[batch].first != context) {
+      batch++;
+    }
+    if (batch == batches.size()) {
+      batches.push_back(std::make_pair(context, std::vector<FastoObjectCommandIPtr>()));
+      batches_indexes.push_back(std::vector<size_t>());
+    }
+    batches[batch].second.push_back(cmds[i]);
+    batches_indexes[batch].push_back(i);
+  }
+
+  std::vector<size_t> redirected;
+  for (size_t i = 0; i < batches.size(); ++i) {
+    std::vector<size_t> batch_redirected;
+    common::Error err =
+        ExecuteAsPipeline(batches[i].first, batches[i].second, log_command_cb, window, &batch_redirected);
+    if (err && err->IsError()) {
+      return err;
+    }
+
+    for (size_t index : batch_redirected) {
+      redirected.push_back(batches_indexes[i][index]);
+    }
+  }
+
+  // slots moved while the batch was built, rare enough to resend one by one
+  for (size_t index : redirected) {
+    common::Error err = ClusterExec(args[index], cmds[index].get());
+    if (err && err->IsError()) {
+      return err;
+    }
+  }
+
+  return common::Error();
+}
+
+common::Error DBConnection::ExecKeyCommand(const command_buffer_t& command, redisReply** out) {
+  commands_args_t argv;
+  if (!cluster_mode_ || !ParseCommandLine(command, &argv)) {
+    redisReply* reply = ExecRedisCommand(connection_.handle_, command);
+    if (!reply) {
+      return cliPrintContextError(connection_.handle_);
+    }
+
+    *out = reply;
+    return common::Error();
+  }
+
+  NativeConnection* context = nullptr;
+  common::Error err = ClusterRoute(argv, &context);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  bool asking = false;
+  for (size_t i = 0; i <= REDIS_CLUSTER_MAX_REDIRECTS; ++i) {
+    if (asking) {
+      redisReply* reply = reinterpret_cast<redisReply*>(redisCommand(context, CLUSTER_ASKING));
+      if (!reply) {
+        return cliPrintContextError(context);
+      }
+      freeReplyObject(reply);
+    }
+
+    redisReply* reply = ExecRedisCommand(context, command);
+    if (!reply) {
+      return cliPrintContextError(context);
+    }
+
+    if (reply->type != REDIS_REPLY_ERROR) {
+      *out = reply;
+      return common::Error();
+    }
+
+    bool redirected = false;
+    err = FollowClusterRedirect(std::string(reply->str, reply->len), &context, &asking, &redirected);
+    if (err && err->IsError()) {
+      freeReplyObject(reply);
+      return err;
+    }
+
+    if (!redirected) {
+      *out = reply;
+      return common::Error();
+    }
+    freeReplyObject(reply);
+  }
+
+  return common::make_error_value("Too many cluster redirects", common::ErrorValue::E_ERROR);
+}
+
+void DBConnection::CloseClusterNodes() {
+  for (auto it = cluster_nodes_.begin(); it != cluster_nodes_.end(); ++it) {
+    redisFree(it->second);
+  }
+  cluster_nodes_.clear();
+}
+
 common::Error DBConnection::Auth(const std::string& password) {
   if (!IsConnected()) {
     DNOTREACHED();
@@ -1235,13 +1923,13 @@ common::Error DBConnection::Monitor(commands_args_t argv, FastoObject* out) {
   free(argvlen);
   free(argvc);
 
-  common::Error err = CliReadReply(out);
+  common::Error err = CliReadStreamReply(out);
   if (err && err->IsError()) {
     return err;
   }
 
   while (true) {
-    common::Error er = CliReadReply(out);
+    common::Error er = CliReadStreamReply(out);
     if (er && er->IsError()) {
       return er;
     }
@@ -1275,13 +1963,13 @@ common::Error DBConnection::Subscribe(commands_args_t argv, FastoObject* out) {
   free(argvlen);
   free(argvc);
 
-  common::Error err = CliReadReply(out);
+  common::Error err = CliReadStreamReply(out);
   if (err && err->IsError()) {
     return err;
   }
 
   while (true) {
-    common::Error er = CliReadReply(out);
+    common::Error er = CliReadStreamReply(out);
     if (er && er->IsError()) {
       return er;
     }
@@ -1300,9 +1988,10 @@ common::Error DBConnection::SetEx(const NDbKValue& key, ttl_t ttl) {
   wr << "SETEX " << key_str.GetKeyData() << " " << ttl << " " << value_str;
   const command_buffer_t setex_cmd = wr.str();
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, setex_cmd);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  common::Error err = ExecKeyCommand(setex_cmd, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   if (reply->type == REDIS_REPLY_ERROR) {
@@ -1329,9 +2018,10 @@ common::Error DBConnection::SetNX(const NDbKValue& key, long long* result) {
   wr << "SETNX " << key_str.GetKeyData() << " " << value_str;
   const command_buffer_t setnx_cmd = wr.str();
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, setnx_cmd);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  common::Error err = ExecKeyCommand(setnx_cmd, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   if (reply->type == REDIS_REPLY_INTEGER) {
@@ -1371,9 +2061,10 @@ common::Error DBConnection::Lpush(const NKey& key, NValue arr, long long* list_l
     return err;
   }
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, lpush_cmd);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  err = ExecKeyCommand(lpush_cmd, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   if (reply->type == REDIS_REPLY_INTEGER) {
@@ -1404,9 +2095,10 @@ common::Error DBConnection::Lrange(const NKey& key, int start, int stop, NDbKVal
   wr << "LRANGE " << key_str.GetKeyData() << " " << start << " " << common::ConvertToString(stop);
   const command_buffer_t lrange_cmd = wr.str();
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, lrange_cmd);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  common::Error err = ExecKeyCommand(lrange_cmd, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   if (reply->type == REDIS_REPLY_ARRAY) {
@@ -1453,9 +2145,10 @@ common::Error DBConnection::Sadd(const NKey& key, NValue set, long long* added)
     return err;
   }
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, sadd_cmd);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  err = ExecKeyCommand(sadd_cmd, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   if (reply->type == REDIS_REPLY_INTEGER) {
@@ -1490,9 +2183,10 @@ common::Error DBConnection::Smembers(const NKey& key, NDbKValue* loaded_key) {
   wr << "SMEMBERS " << key_str.GetKeyData();
   const command_buffer_t smembers_cmd = wr.str();
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, smembers_cmd);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  common::Error err = ExecKeyCommand(smembers_cmd, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   if (reply->type == REDIS_REPLY_ARRAY) {
@@ -1555,9 +2249,10 @@ common::Error DBConnection::Zadd(const NKey& key, NValue scores, long long* adde
     return err;
   }
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, zadd_cmd);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  err = ExecKeyCommand(zadd_cmd, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   if (reply->type == REDIS_REPLY_INTEGER) {
@@ -1595,9 +2290,10 @@ common::Error DBConnection::Zrange(const NKey& key, int start, int stop, bool wi
   }
   const command_buffer_t line = wr.str();
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, line);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  common::Error err = ExecKeyCommand(line, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   if (reply->type == REDIS_REPLY_ARRAY) {
@@ -1670,9 +2366,10 @@ common::Error DBConnection::Hmset(const NKey& key, NValue hash) {
     return err;
   }
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, hmset_cmd);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  err = ExecKeyCommand(hmset_cmd, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   if (reply->type == REDIS_REPLY_STATUS) {
@@ -1706,9 +2403,10 @@ common::Error DBConnection::Hgetall(const NKey& key, NDbKValue* loaded_key) {
   wr << "HGETALL " << key_str.GetKeyData();
   const command_buffer_t hgetall_cmd = wr.str();
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, hgetall_cmd);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  common::Error err = ExecKeyCommand(hgetall_cmd, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   if (reply->type == REDIS_REPLY_ARRAY) {
@@ -1768,9 +2466,10 @@ common::Error DBConnection::Decr(const NKey& key, long long* decr) {
   wr << "DECR " << key_str.GetKeyData();
   const command_buffer_t decr_cmd = wr.str();
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, decr_cmd);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  common::Error err = ExecKeyCommand(decr_cmd, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   if (reply->type == REDIS_REPLY_INTEGER) {
@@ -1806,9 +2505,10 @@ common::Error DBConnection::DecrBy(const NKey& key, int dec, long long* decr) {
   wr << "DECRBY " << key_str.GetKeyData() << " " << dec;
   const command_buffer_t decrby_cmd = wr.str();
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, decrby_cmd);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  common::Error err = ExecKeyCommand(decrby_cmd, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   if (reply->type == REDIS_REPLY_INTEGER) {
@@ -1844,9 +2544,10 @@ common::Error DBConnection::Incr(const NKey& key, long long* incr) {
   wr << "INCR " << key_str.GetKeyData();
   const command_buffer_t incr_cmd = wr.str();
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, incr_cmd);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  common::Error err = ExecKeyCommand(incr_cmd, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   if (reply->type == REDIS_REPLY_INTEGER) {
@@ -1882,9 +2583,10 @@ common::Error DBConnection::IncrBy(const NKey& key, int inc, long long* incr) {
   wr << "INCRBY " << key_str.GetKeyData() << " " << inc;
   const command_buffer_t incrby_cmd = wr.str();
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, incrby_cmd);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  common::Error err = ExecKeyCommand(incrby_cmd, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   if (reply->type == REDIS_REPLY_INTEGER) {
@@ -1920,9 +2622,10 @@ common::Error DBConnection::IncrByFloat(const NKey& key, double inc, std::string
   wr << "INCRBYFLOAT " << key_str.GetKeyData() << " " << inc;
   const command_buffer_t incrfloat_cmd = wr.str();
 
-  redisReply* reply = ExecRedisCommand(connection_.handle_, incrfloat_cmd);
-  if (!reply) {
-    return cliPrintContextError(connection_.handle_);
+  redisReply* reply = NULL;
+  common::Error err = ExecKeyCommand(incrfloat_cmd, &reply);
+  if (err && err->IsError()) {
+    return err;
   }
 
   if (reply->type == REDIS_REPLY_STRING) {
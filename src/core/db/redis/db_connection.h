@@ -21,6 +21,7 @@
 #include <stddef.h>  // for size_t
 #include <stdint.h>  // for uint64_t
 
+#include <map>     // for map
 #include <string>  // for string
 #include <vector>  // for vector
 
@@ -28,6 +29,7 @@
 #include <common/macros.h>  // for PROJECT_VERSION_GENERATE, etc
 
 #include "core/connection_types.h"         // for connectionTypes::REDIS
+#include "core/db/redis/cluster_router.h"  // for ClusterSlotsMap
 #include "core/db/redis/config.h"          // for Config
 #include "core/db_key.h"                   // for NDbKValue, NKey, etc
 #include "core/global.h"                   // for FastoObject (ptr only), etc
@@ -51,6 +53,9 @@ struct redisReply;    // lines 50-50
 
 #define INFO_REQUEST "INFO"
 #define GET_SERVER_TYPE "CLUSTER NODES"
+#define GET_CLUSTER_SLOTS "CLUSTER SLOTS"
+#define GET_COMMAND_INFO_1ARGS_S "COMMAND INFO %s"
+#define CLUSTER_ASKING "ASKING"
 #define GET_SENTINEL_MASTERS "SENTINEL MASTERS"
 #define GET_SENTINEL_SLAVES_PATTERN_1ARGS_S "SENTINEL SLAVES %s"
 
@@ -83,17 +88,29 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, RCon
  public:
   typedef core::internal::CDBConnection<NativeConnection, RConfig, REDIS> base_class;
   explicit DBConnection(CDBConnectionClient* client);
+  ~DBConnection();
 
   bool IsAuthenticated() const;
 
   common::Error Connect(const config_t& config);
+  common::Error Disconnect();  // closes cluster nodes connections too
+
+  // routes every keyed command to the node owning its slot and follows
+  // MOVED/ASK redirects, fails if the server has cluster support disabled
+  common::Error EnableClusterMode() WARN_UNUSED_RESULT;
+  bool IsClusterMode() const;
 
   std::string CurrentDBName() const;
 
   common::Error SlaveMode(FastoObject* out) WARN_UNUSED_RESULT;
 
+  // keeps up to window commands in flight (0 means the configured window), every read reply lets
+  // the next command be sent; commands which change the connection state run alone through their handlers.
+  // The first error reply stops sending and is returned once replies of already sent commands are read,
+  // so the connection stays in sync and these commands keep their replies.
   common::Error ExecuteAsPipeline(const std::vector<FastoObjectCommandIPtr>& cmds,
-                                  void (*log_command_cb)(FastoObjectCommandIPtr)) WARN_UNUSED_RESULT;
+                                  void (*log_command_cb)(FastoObjectCommandIPtr),
+                                  size_t window = 0) WARN_UNUSED_RESULT;
 
   common::Error CommonExec(commands_args_t argv, FastoObject* out) WARN_UNUSED_RESULT;
   common::Error Auth(const std::string& password) WARN_UNUSED_RESULT;
@@ -102,6 +119,9 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, RCon
   common::Error Subscribe(commands_args_t argv,
                           FastoObject* out) WARN_UNUSED_RESULT;  // interrupt
 
+  // RESTORE ... REPLACE of DUMP payloads written by backup, pipelined like BulkSet
+  common::Error Restore(const NDbKValues& keys) WARN_UNUSED_RESULT;
+
   common::Error SetEx(const NDbKValue& key, ttl_t ttl);
   common::Error SetNX(const NDbKValue& key, long long* result);
 
@@ -139,6 +159,9 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, RCon
   virtual common::Error SelectImpl(const std::string& name, IDataBaseInfo** info) override;
   virtual common::Error DeleteImpl(const NKeys& keys, NKeys* deleted_keys) override;
   virtual common::Error SetImpl(const NDbKValue& key, NDbKValue* added_key) override;
+  virtual common::Error BulkSetImpl(const NDbKValues& keys) override;
+  // SCAN pages with pipelined DUMP and PTTL, positions are SCAN cursors
+  virtual common::Error WalkImpl(const std::string& position, walk_callback_t cb) override;
   virtual common::Error GetImpl(const NKey& key, NDbKValue* loaded_key) override;
   virtual common::Error RenameImpl(const NKey& key, string_key_t new_key) override;
   virtual common::Error SetTTLImpl(const NKey& key, ttl_t ttl) override;
@@ -150,9 +173,53 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, RCon
   common::Error CliFormatReplyRaw(FastoObjectArray* ar, redisReply* r) WARN_UNUSED_RESULT;
   common::Error CliFormatReplyRaw(FastoObject* out, redisReply* r) WARN_UNUSED_RESULT;
   common::Error CliReadReply(FastoObject* out) WARN_UNUSED_RESULT;
+  common::Error CliReadReply(NativeConnection* context, FastoObject* out) WARN_UNUSED_RESULT;
+  common::Error CliGetReply(NativeConnection* context, redisReply** reply) WARN_UNUSED_RESULT;
+
+  // replies of MONITOR, SUBSCRIBE and SYNC are added to out only once fully built,
+  // observers hand them over to another thread as soon as they are added
+  common::Error CliFormatStreamReply(FastoObject* out, redisReply* r) WARN_UNUSED_RESULT;
+  common::Error CliReadStreamReply(FastoObject* out) WARN_UNUSED_RESULT;
+
+  // redirected is filled with indexes of commands answered by MOVED/ASK, nullptr makes them errors
+  common::Error ExecuteAsPipeline(NativeConnection* context,
+                                  const std::vector<FastoObjectCommandIPtr>& cmds,
+                                  void (*log_command_cb)(FastoObjectCommandIPtr),
+                                  size_t window,
+                                  std::vector<size_t>* redirected) WARN_UNUSED_RESULT;
+  // same for raw commands without reply objects, cmds are addressed by indexes, replies are always drained
+  common::Error ExecuteArgvAsPipeline(NativeConnection* context,
+                                      const std::vector<commands_args_t>& cmds,
+                                      const std::vector<size_t>& indexes,
+                                      size_t window,
+                                      std::vector<size_t>* redirected) WARN_UNUSED_RESULT;
+  // pipelines every command to its node, redirected ones are resent one by one
+  common::Error ExecuteArgvBatch(const std::vector<commands_args_t>& cmds) WARN_UNUSED_RESULT;
+
+  // cluster mode
+  common::Error RefreshClusterSlots() WARN_UNUSED_RESULT;
+  common::Error ClusterNodeConnection(const common::net::HostAndPort& host,
+                                      NativeConnection** context) WARN_UNUSED_RESULT;
+  common::Error ClusterRoute(const commands_args_t& argv, NativeConnection** context) WARN_UNUSED_RESULT;
+  common::Error FollowClusterRedirect(const std::string& error,
+                                      NativeConnection** context,
+                                      bool* asking,
+                                      bool* redirected) WARN_UNUSED_RESULT;
+  common::Error ClusterExec(const commands_args_t& argv, FastoObject* out) WARN_UNUSED_RESULT;
+  common::Error ClusterExecuteAsPipeline(const std::vector<FastoObjectCommandIPtr>& cmds,
+                                         void (*log_command_cb)(FastoObjectCommandIPtr),
+                                         size_t window) WARN_UNUSED_RESULT;
+  // routed in cluster mode, error replies other than redirects are returned in out
+  common::Error ExecKeyCommand(const command_buffer_t& command, redisReply** out) WARN_UNUSED_RESULT;
+  void CloseClusterNodes();
 
   bool isAuth_;
   int cur_db_;
+
+  bool cluster_mode_;
+  ClusterSlotsMap cluster_slots_;
+  std::map<std::string, NativeConnection*> cluster_nodes_;   // host:port -> connection, except the main one
+  std::map<std::string, ClusterKeySpec> cluster_key_specs_;  // command -> key positions
 };
 
 }  // namespace redis
@@ -18,14 +18,19 @@
 
 #include "core/db/redis/server_info.h"
 
+#include <limits.h>  // for INT_MAX
 #include <stddef.h>  // for size_t
+#include <stdint.h>  // for UINT32_MAX
+#include <stdlib.h>  // for strtod
+#include <string.h>  // for memchr, memcmp, strlen
 
-#include <sstream>  // for operator<<, basic_ostream, etc
-#include <string>   // for operator==, string, etc
-#include <utility>  // for make_pair
-#include <vector>   // for vector
+#include <algorithm>  // for lower_bound, sort
+#include <sstream>    // for operator<<, basic_ostream, etc
+#include <string>     // for operator==, string, etc
+#include <utility>    // for make_pair
+#include <vector>     // for vector
 
-#include <common/convert2string.h>  // for ConvertFromString, etc
+#include <common/convert2string.h>  // for ConvertVersionNumberFromString
 #include <common/macros.h>          // for NOTREACHED, UNUSED
 #include <common/value.h>           // for FundamentalValue, Value, etc
 
@@ -158,85 +163,6 @@ ServerInfo::Server::Server::Server()
       hz_(0),
       lru_clock_(0) {}
 
-ServerInfo::Server::Server(const std::string& server_text)
-    : redis_version_(),
-      redis_git_sha1_(),
-      redis_git_dirty_(),
-      redis_mode_(),
-      os_(),
-      arch_bits_(0),
-      multiplexing_api_(),
-      gcc_version_(),
-      process_id_(0),
-      run_id_(),
-      tcp_port_(0),
-      uptime_in_seconds_(0),
-      uptime_in_days_(0),
-      hz_(0),
-      lru_clock_(0) {
-  size_t pos = 0;
-  size_t start = 0;
-  while ((pos = server_text.find("\r\n", start)) != std::string::npos) {
-    std::string line = server_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == REDIS_VERSION_LABEL) {
-      redis_version_ = value;
-    } else if (field == REDIS_GIT_SHA1_LABEL) {
-      redis_git_sha1_ = value;
-    } else if (field == REDIS_GIT_DIRTY_LABEL) {
-      redis_git_dirty_ = value;
-    } else if (field == REDIS_MODE_LABEL) {
-      redis_mode_ = value;
-    } else if (field == REDIS_OS_LABEL) {
-      os_ = value;
-    } else if (field == REDIS_ARCH_BITS_LABEL) {
-      uint32_t arch_bits;
-      if (common::ConvertFromString(value, &arch_bits)) {
-        arch_bits_ = arch_bits;
-      }
-    } else if (field == REDIS_MULTIPLEXING_API_LABEL) {
-      multiplexing_api_ = value;
-    } else if (field == REDIS_GCC_VERSION_LABEL) {
-      gcc_version_ = value;
-    } else if (field == REDIS_PROCESS_ID_LABEL) {
-      uint32_t process_id;
-      if (common::ConvertFromString(value, &process_id)) {
-        process_id_ = process_id;
-      }
-    } else if (field == REDIS_RUN_ID_LABEL) {
-      run_id_ = value;
-    } else if (field == REDIS_TCP_PORT_LABEL) {
-      uint32_t tcp_port;
-      if (common::ConvertFromString(value, &tcp_port)) {
-        tcp_port_ = tcp_port;
-      }
-    } else if (field == REDIS_UPTIME_IN_SECONDS_LABEL) {
-      uint32_t uptime_in_seconds;
-      if (common::ConvertFromString(value, &uptime_in_seconds)) {
-        uptime_in_seconds_ = uptime_in_seconds;
-      }
-    } else if (field == REDIS_UPTIME_IN_DAYS_LABEL) {
-      uint32_t uptime_in_days;
-      if (common::ConvertFromString(value, &uptime_in_days)) {
-        uptime_in_days_ = uptime_in_days;
-      }
-    } else if (field == REDIS_HZ_LABEL) {
-      uint32_t hz;
-      if (common::ConvertFromString(value, &hz)) {
-        hz_ = hz;
-      }
-    } else if (field == REDIS_LRU_CLOCK_LABEL) {
-      uint32_t lru_clock;
-      if (common::ConvertFromString(value, &lru_clock)) {
-        lru_clock_ = lru_clock;
-      }
-    }
-    start = pos + 2;
-  }
-}
-
 common::Value* ServerInfo::Server::ValueByIndex(unsigned char index) const {
   switch (index) {
     case 0:
@@ -282,40 +208,6 @@ common::Value* ServerInfo::Server::ValueByIndex(unsigned char index) const {
 ServerInfo::Clients::Clients()
     : connected_clients_(0), client_longest_output_list_(0), client_biggest_input_buf_(0), blocked_clients_(0) {}
 
-ServerInfo::Clients::Clients(const std::string& client_text)
-    : connected_clients_(0), client_longest_output_list_(0), client_biggest_input_buf_(0), blocked_clients_(0) {
-  size_t pos = 0;
-  size_t start = 0;
-  while ((pos = client_text.find(("\r\n"), start)) != std::string::npos) {
-    std::string line = client_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == REDIS_CONNECTED_CLIENTS_LABEL) {
-      uint32_t connected_clients;
-      if (common::ConvertFromString(value, &connected_clients)) {
-        connected_clients_ = connected_clients;
-      }
-    } else if (field == REDIS_CLIENT_LONGEST_OUTPUT_LIST_LABEL) {
-      uint32_t client_longest_output_list;
-      if (common::ConvertFromString(value, &client_longest_output_list)) {
-        client_longest_output_list_ = client_longest_output_list;
-      }
-    } else if (field == REDIS_CLIENT_BIGGEST_INPUT_BUF_LABEL) {
-      uint32_t client_biggest_input_buf;
-      if (common::ConvertFromString(value, &client_biggest_input_buf)) {
-        client_biggest_input_buf_ = client_biggest_input_buf;
-      }
-    } else if (field == REDIS_BLOCKED_CLIENTS_LABEL) {
-      uint32_t blocked_clients;
-      if (common::ConvertFromString(value, &blocked_clients)) {
-        blocked_clients_ = blocked_clients;
-      }
-    }
-    start = pos + 2;
-  }
-}
-
 common::Value* ServerInfo::Clients::ValueByIndex(unsigned char index) const {
   switch (index) {
     case 0:
@@ -344,58 +236,6 @@ ServerInfo::Memory::Memory()
       mem_fragmentation_ratio_(0),
       mem_allocator_() {}
 
-ServerInfo::Memory::Memory(const std::string& memory_text)
-    : used_memory_(0),
-      used_memory_human_(),
-      used_memory_rss_(0),
-      used_memory_peak_(0),
-      used_memory_peak_human_(),
-      used_memory_lua_(0),
-      mem_fragmentation_ratio_(0),
-      mem_allocator_() {
-  size_t pos = 0;
-  size_t start = 0;
-  while ((pos = memory_text.find(("\r\n"), start)) != std::string::npos) {
-    std::string line = memory_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == REDIS_USED_MEMORY_LABEL) {
-      uint32_t used_memory;
-      if (common::ConvertFromString(value, &used_memory)) {
-        used_memory_ = used_memory;
-      }
-    } else if (field == REDIS_USED_MEMORY_HUMAN_LABEL) {
-      used_memory_human_ = value;
-    } else if (field == REDIS_USED_MEMORY_RSS_LABEL) {
-      uint32_t used_memory_rss;
-      if (common::ConvertFromString(value, &used_memory_rss)) {
-        used_memory_rss_ = used_memory_rss;
-      }
-    } else if (field == REDIS_USED_MEMORY_PEAK_LABEL) {
-      uint32_t used_memory_peak;
-      if (common::ConvertFromString(value, &used_memory_peak)) {
-        used_memory_peak_ = used_memory_peak;
-      }
-    } else if (field == REDIS_USED_MEMORY_PEAK_HUMAN_LABEL) {
-      used_memory_peak_human_ = value;
-    } else if (field == REDIS_USED_MEMORY_LUA_LABEL) {
-      uint32_t used_memory_lua;
-      if (common::ConvertFromString(value, &used_memory_lua)) {
-        used_memory_lua_ = used_memory_lua;
-      }
-    } else if (field == REDIS_MEM_FRAGMENTATION_RATIO_LABEL) {
-      float mem_fragmentation_ratio;
-      if (common::ConvertFromString(value, &mem_fragmentation_ratio)) {
-        mem_fragmentation_ratio_ = mem_fragmentation_ratio;
-      }
-    } else if (field == REDIS_MEM_ALLOCATOR_LABEL) {
-      mem_allocator_ = value;
-    }
-    start = pos + 2;
-  }
-}
-
 common::Value* ServerInfo::Memory::ValueByIndex(unsigned char index) const {
   switch (index) {
     case 0:
@@ -438,94 +278,6 @@ ServerInfo::Persistence::Persistence()
       aof_last_bgrewrite_status_(),
       aof_last_write_status_() {}
 
-ServerInfo::Persistence::Persistence(const std::string& persistence_text)
-    : loading_(0),
-      rdb_changes_since_last_save_(0),
-      rdb_bgsave_in_progress_(0),
-      rdb_last_save_time_(0),
-      rdb_last_bgsave_status_(),
-      rdb_last_bgsave_time_sec_(0),
-      rdb_current_bgsave_time_sec_(0),
-      aof_enabled_(0),
-      aof_rewrite_in_progress_(0),
-      aof_rewrite_scheduled_(0),
-      aof_last_rewrite_time_sec_(0),
-      aof_current_rewrite_time_sec_(0),
-      aof_last_bgrewrite_status_(),
-      aof_last_write_status_() {
-  size_t pos = 0;
-  size_t start = 0;
-  while ((pos = persistence_text.find(("\r\n"), start)) != std::string::npos) {
-    std::string line = persistence_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == REDIS_LOADING_LABEL) {
-      uint32_t loading;
-      if (common::ConvertFromString(value, &loading)) {
-        loading_ = loading;
-      }
-    } else if (field == REDIS_RDB_CHANGES_SINCE_LAST_SAVE_LABEL) {
-      uint32_t rdb_changes_since_last_save;
-      if (common::ConvertFromString(value, &rdb_changes_since_last_save)) {
-        rdb_changes_since_last_save_ = rdb_changes_since_last_save;
-      }
-    } else if (field == REDIS_RDB_DGSAVE_IN_PROGRESS_LABEL) {
-      uint32_t rdb_bgsave_in_progress;
-      if (common::ConvertFromString(value, &rdb_bgsave_in_progress)) {
-        rdb_bgsave_in_progress_ = rdb_bgsave_in_progress;
-      }
-    } else if (field == REDIS_RDB_LAST_SAVE_TIME_LABEL) {
-      uint32_t rdb_last_save_time;
-      if (common::ConvertFromString(value, &rdb_last_save_time)) {
-        rdb_last_save_time_ = rdb_last_save_time;
-      }
-    } else if (field == REDIS_RDB_LAST_DGSAVE_STATUS_LABEL) {
-      rdb_last_bgsave_status_ = value;
-    } else if (field == REDIS_RDB_LAST_DGSAVE_TIME_SEC_LABEL) {
-      int rdb_last_bgsave_time_sec;
-      if (common::ConvertFromString(value, &rdb_last_bgsave_time_sec)) {
-        rdb_last_bgsave_time_sec_ = rdb_last_bgsave_time_sec;
-      }
-    } else if (field == REDIS_RDB_CURRENT_DGSAVE_TIME_SEC_LABEL) {
-      int rdb_current_bgsave_time_sec;
-      if (common::ConvertFromString(value, &rdb_current_bgsave_time_sec)) {
-        rdb_current_bgsave_time_sec_ = rdb_current_bgsave_time_sec;
-      }
-    } else if (field == REDIS_AOF_ENABLED_LABEL) {
-      uint32_t aof_enabled;
-      if (common::ConvertFromString(value, &aof_enabled)) {
-        aof_enabled_ = aof_enabled;
-      }
-    } else if (field == REDIS_AOF_REWRITE_IN_PROGRESS_LABEL) {
-      uint32_t aof_rewrite_in_progress;
-      if (common::ConvertFromString(value, &aof_rewrite_in_progress)) {
-        aof_rewrite_in_progress_ = aof_rewrite_in_progress;
-      }
-    } else if (field == REDIS_AOF_REWRITE_SHEDULED_LABEL) {
-      uint32_t aof_rewrite_scheduled;
-      if (common::ConvertFromString(value, &aof_rewrite_scheduled)) {
-        aof_rewrite_scheduled_ = aof_rewrite_scheduled;
-      }
-    } else if (field == REDIS_AOF_LAST_REWRITE_TIME_SEC_LABEL) {
-      int aof_last_rewrite_time_sec;
-      if (common::ConvertFromString(value, &aof_last_rewrite_time_sec)) {
-        aof_last_rewrite_time_sec_ = aof_last_rewrite_time_sec;
-      }
-    } else if (field == REDIS_AOF_CURRENT_REWRITE_TIME_SEC_LABEL) {
-      int aof_current_rewrite_time_sec;
-      if (common::ConvertFromString(value, &aof_current_rewrite_time_sec)) {
-        aof_current_rewrite_time_sec_ = aof_current_rewrite_time_sec;
-      }
-    } else if (field == REDIS_AOF_LAST_DGREWRITE_STATUS_LABEL) {
-      aof_last_bgrewrite_status_ = value;
-    } else if (field == REDIS_AOF_LAST_WRITE_STATUS_LABEL) {
-      aof_last_write_status_ = value;
-    }
-    start = pos + 2;
-  }
-}
-
 common::Value* ServerInfo::Persistence::ValueByIndex(unsigned char index) const {
   switch (index) {
     case 0:
@@ -580,103 +332,6 @@ ServerInfo::Stats::Stats()
       pubsub_patterns_(0),
       latest_fork_usec_(0) {}
 
-ServerInfo::Stats::Stats(const std::string& stats_text)
-    : total_connections_received_(0),
-      total_commands_processed_(0),
-      instantaneous_ops_per_sec_(0),
-      rejected_connections_(0),
-      sync_full_(0),
-      sync_partial_ok_(0),
-      sync_partial_err_(0),
-      expired_keys_(0),
-      evicted_keys_(0),
-      keyspace_hits_(0),
-      keyspace_misses_(0),
-      pubsub_channels_(0),
-      pubsub_patterns_(0),
-      latest_fork_usec_(0) {
-  size_t pos = 0;
-  size_t start = 0;
-  while ((pos = stats_text.find(("\r\n"), start)) != std::string::npos) {
-    std::string line = stats_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == REDIS_TOTAL_CONNECTIONS_RECEIVED_LABEL) {
-      uint32_t total_connections_received;
-      if (common::ConvertFromString(value, &total_connections_received)) {
-        total_connections_received_ = total_connections_received;
-      }
-    } else if (field == REDIS_TOTAL_COMMANDS_PROCESSED_LABEL) {
-      uint32_t total_commands_processed;
-      if (common::ConvertFromString(value, &total_commands_processed)) {
-        total_commands_processed_ = total_commands_processed;
-      }
-    } else if (field == REDIS_INSTANTANEOUS_OPS_PER_SEC_LABEL) {
-      uint32_t instantaneous_ops_per_sec;
-      if (common::ConvertFromString(value, &instantaneous_ops_per_sec)) {
-        instantaneous_ops_per_sec_ = instantaneous_ops_per_sec;
-      }
-    } else if (field == REDIS_REJECTED_CONNECTIONS_LABEL) {
-      uint32_t rejected_connections;
-      if (common::ConvertFromString(value, &rejected_connections)) {
-        rejected_connections_ = rejected_connections;
-      }
-    } else if (field == REDIS_SYNC_FULL_LABEL) {
-      uint32_t sync_full;
-      if (common::ConvertFromString(value, &sync_full)) {
-        sync_full_ = sync_full;
-      }
-    } else if (field == REDIS_SYNC_PARTIAL_OK_LABEL) {
-      uint32_t sync_partial_ok;
-      if (common::ConvertFromString(value, &sync_partial_ok)) {
-        sync_partial_ok_ = sync_partial_ok;
-      }
-    } else if (field == REDIS_SYNC_PARTIAL_ERR_LABEL) {
-      uint32_t sync_partial_err;
-      if (common::ConvertFromString(value, &sync_partial_err)) {
-        sync_partial_err_ = sync_partial_err;
-      }
-    } else if (field == REDIS_EXPIRED_KEYS_LABEL) {
-      uint32_t expired_keys;
-      if (common::ConvertFromString(value, &expired_keys)) {
-        expired_keys_ = expired_keys;
-      }
-    } else if (field == REDIS_EVICTED_KEYS_LABEL) {
-      uint32_t evicted_keys;
-      if (common::ConvertFromString(value, &evicted_keys)) {
-        evicted_keys_ = evicted_keys;
-      }
-    } else if (field == REDIS_KEYSPACE_HITS_LABEL) {
-      uint32_t keyspace_hits;
-      if (common::ConvertFromString(value, &keyspace_hits)) {
-        keyspace_hits_ = keyspace_hits;
-      }
-    } else if (field == REDIS_KEYSPACE_MISSES_LABEL) {
-      uint32_t keyspace_misses;
-      if (common::ConvertFromString(value, &keyspace_misses)) {
-        keyspace_misses_ = keyspace_misses;
-      }
-    } else if (field == REDIS_PUBSUB_CHANNELS_LABEL) {
-      uint32_t pubsub_channels;
-      if (common::ConvertFromString(value, &pubsub_channels)) {
-        pubsub_channels_ = pubsub_channels;
-      }
-    } else if (field == REDIS_PUBSUB_PATTERNS_LABEL) {
-      uint32_t pubsub_patterns;
-      if (common::ConvertFromString(value, &pubsub_patterns)) {
-        pubsub_patterns_ = pubsub_patterns;
-      }
-    } else if (field == REDIS_LATEST_FORK_USEC_LABEL) {
-      uint32_t latest_fork_usec;
-      if (common::ConvertFromString(value, &latest_fork_usec)) {
-        latest_fork_usec_ = latest_fork_usec;
-      }
-    }
-    start = pos + 2;
-  }
-}
-
 common::Value* ServerInfo::Stats::ValueByIndex(unsigned char index) const {
   switch (index) {
     case 0:
@@ -724,59 +379,6 @@ ServerInfo::Replication::Replication()
       backlog_first_byte_offset_(0),
       backlog_histen_(0) {}
 
-ServerInfo::Replication::Replication(const std::string& replication_text)
-    : role_(),
-      connected_slaves_(0),
-      master_repl_offset_(0),
-      backlog_active_(0),
-      backlog_size_(0),
-      backlog_first_byte_offset_(0),
-      backlog_histen_(0) {
-  size_t pos = 0;
-  size_t start = 0;
-
-  while ((pos = replication_text.find(("\r\n"), start)) != std::string::npos) {
-    std::string line = replication_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == REDIS_ROLE_LABEL) {
-      role_ = value;
-    } else if (field == REDIS_CONNECTED_SLAVES_LABEL) {
-      uint32_t connected_slaves;
-      if (common::ConvertFromString(value, &connected_slaves)) {
-        connected_slaves_ = connected_slaves;
-      }
-    } else if (field == REDIS_MASTER_REPL_OFFSET_LABEL) {
-      uint32_t master_repl_offset;
-      if (common::ConvertFromString(value, &master_repl_offset)) {
-        master_repl_offset_ = master_repl_offset;
-      }
-    } else if (field == REDIS_BACKLOG_ACTIVE_LABEL) {
-      uint32_t backlog_active;
-      if (common::ConvertFromString(value, &backlog_active)) {
-        backlog_active_ = backlog_active;
-      }
-    } else if (field == REDIS_BACKLOG_SIZE_LABEL) {
-      uint32_t backlog_size;
-      if (common::ConvertFromString(value, &backlog_size)) {
-        backlog_size_ = backlog_size;
-      }
-    } else if (field == REDIS_BACKLOG_FIRST_BYTE_OFFSET_LABEL) {
-      uint32_t backlog_first_byte_offset;
-      if (common::ConvertFromString(value, &backlog_first_byte_offset)) {
-        backlog_first_byte_offset_ = backlog_first_byte_offset;
-      }
-    } else if (field == REDIS_BACKLOG_HISTEN_LABEL) {
-      uint32_t backlog_histen;
-      if (common::ConvertFromString(value, &backlog_histen)) {
-        backlog_histen_ = backlog_histen;
-      }
-    }
-    start = pos + 2;
-  }
-}
-
 common::Value* ServerInfo::Replication::ValueByIndex(unsigned char index) const {
   switch (index) {
     case 0:
@@ -803,40 +405,6 @@ common::Value* ServerInfo::Replication::ValueByIndex(unsigned char index) const
 
 ServerInfo::Cpu::Cpu() : used_cpu_sys_(0), used_cpu_user_(0), used_cpu_sys_children_(0), used_cpu_user_children_(0) {}
 
-ServerInfo::Cpu::Cpu(const std::string& cpu_text)
-    : used_cpu_sys_(0), used_cpu_user_(0), used_cpu_sys_children_(0), used_cpu_user_children_(0) {
-  size_t pos = 0;
-  size_t start = 0;
-  while ((pos = cpu_text.find(("\r\n"), start)) != std::string::npos) {
-    std::string line = cpu_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == (REDIS_USED_CPU_SYS_LABEL)) {
-      float used_cpu_sys;
-      if (common::ConvertFromString(value, &used_cpu_sys)) {
-        used_cpu_sys_ = used_cpu_sys;
-      }
-    } else if (field == REDIS_USED_CPU_USER_LABEL) {
-      float used_cpu_user;
-      if (common::ConvertFromString(value, &used_cpu_user)) {
-        used_cpu_user_ = used_cpu_user;
-      }
-    } else if (field == REDIS_USED_CPU_SYS_CHILDREN_LABEL) {
-      float used_cpu_sys_children;
-      if (common::ConvertFromString(value, &used_cpu_sys_children)) {
-        used_cpu_sys_children_ = used_cpu_sys_children;
-      }
-    } else if (field == REDIS_USED_CPU_USER_CHILDREN_LABEL) {
-      float used_cpu_user_children;
-      if (common::ConvertFromString(value, &used_cpu_user_children)) {
-        used_cpu_user_children_ = used_cpu_user_children;
-      }
-    }
-    start = pos + 2;
-  }
-}
-
 common::Value* ServerInfo::Cpu::ValueByIndex(unsigned char index) const {
   switch (index) {
     case 0:
@@ -994,6 +562,23 @@ std::string ServerInfo::ToString() const {
       << stats_ << REDIS_REPLICATION_LABEL "\r\n"
       << replication_ << REDIS_CPU_LABEL "\r\n"
       << cpu_ << REDIS_KEYSPACE_LABEL "\r\n";
+  const section_fields_t* keyspace = OtherSection(REDIS_KEYSPACE_LABEL + 2);
+  if (keyspace) {
+    for (size_t i = 0; i < keyspace->size(); ++i) {
+      str << (*keyspace)[i].first << ":" << (*keyspace)[i].second << "\r\n";
+    }
+  }
+  for (size_t i = 0; i < other_sections_.size(); ++i) {
+    if (&other_sections_[i].second == keyspace) {
+      continue;
+    }
+
+    str << "# " << other_sections_[i].first << "\r\n";
+    const section_fields_t& fields = other_sections_[i].second;
+    for (size_t j = 0; j < fields.size(); ++j) {
+      str << fields[j].first << ":" << fields[j].second << "\r\n";
+    }
+  }
   return str.str();
 }
 
@@ -1009,58 +594,252 @@ std::ostream& operator<<(std::ostream& out, const ServerInfo& value) {
   return out << value.ToString();
 }
 
+const ServerInfo::section_fields_t* ServerInfo::OtherSection(const std::string& name) const {
+  for (size_t i = 0; i < other_sections_.size(); ++i) {
+    if (other_sections_[i].first == name) {
+      return &other_sections_[i].second;
+    }
+  }
+  return nullptr;
+}
+
+namespace {
+
+bool parseInfoValue(const char* value, size_t len, uint32_t* out) {
+  if (len == 0) {
+    return false;
+  }
+
+  uint64_t res = 0;
+  for (size_t i = 0; i < len; ++i) {
+    const char ch = value[i];
+    if (ch < '0' || ch > '9') {
+      return false;
+    }
+    res = res * 10 + static_cast<uint64_t>(ch - '0');
+    if (res > UINT32_MAX) {
+      return false;
+    }
+  }
+  *out = static_cast<uint32_t>(res);
+  return true;
+}
+
+bool parseInfoValue(const char* value, size_t len, int* out) {
+  const bool negative = len != 0 && value[0] == '-';
+  uint32_t abs = 0;
+  if (!parseInfoValue(value + negative, len - negative, &abs) || abs > static_cast<uint32_t>(INT_MAX) + negative) {
+    return false;
+  }
+  *out = negative ? static_cast<int>(-static_cast<int64_t>(abs)) : static_cast<int>(abs);
+  return true;
+}
+
+bool parseInfoValue(const char* value, size_t len, float* out) {
+  // the reply buffer is null terminated and lines end with \r\n, so strtod stops within the line
+  char* end = nullptr;
+  const double res = strtod(value, &end);
+  if (len == 0 || end != value + len) {
+    return false;
+  }
+  *out = static_cast<float>(res);
+  return true;
+}
+
+bool parseInfoValue(const char* value, size_t len, std::string* out) {
+  out->assign(value, len);
+  return true;
+}
+
+typedef void (*info_field_parser_t)(ServerInfo* info, const char* value, size_t len);
+
+template <typename Section, Section ServerInfo::*section, typename T, T Section::*field>
+void parseInfoField(ServerInfo* info, const char* value, size_t len) {
+  T val;
+  if (parseInfoValue(value, len, &val)) {
+    (info->*section).*field = val;
+  }
+}
+
+struct InfoFieldEntry {
+  const char* label;
+  size_t label_len;
+  info_field_parser_t parser;
+};
+
+#define INFO_FIELD(LABEL, SECTION_TYPE, SECTION, FIELD)                             \
+  {                                                                                \
+    LABEL, sizeof(LABEL) - 1,                                                      \
+        &parseInfoField<ServerInfo::SECTION_TYPE, &ServerInfo::SECTION,            \
+                        decltype(ServerInfo::SECTION_TYPE::FIELD), &ServerInfo::SECTION_TYPE::FIELD> \
+  }
+
+const InfoFieldEntry info_fields[] = {
+    INFO_FIELD(REDIS_VERSION_LABEL, Server, server_, redis_version_),
+    INFO_FIELD(REDIS_GIT_SHA1_LABEL, Server, server_, redis_git_sha1_),
+    INFO_FIELD(REDIS_GIT_DIRTY_LABEL, Server, server_, redis_git_dirty_),
+    INFO_FIELD(REDIS_BUILD_ID_LABEL, Server, server_, redis_build_id_),
+    INFO_FIELD(REDIS_MODE_LABEL, Server, server_, redis_mode_),
+    INFO_FIELD(REDIS_OS_LABEL, Server, server_, os_),
+    INFO_FIELD(REDIS_ARCH_BITS_LABEL, Server, server_, arch_bits_),
+    INFO_FIELD(REDIS_MULTIPLEXING_API_LABEL, Server, server_, multiplexing_api_),
+    INFO_FIELD(REDIS_GCC_VERSION_LABEL, Server, server_, gcc_version_),
+    INFO_FIELD(REDIS_PROCESS_ID_LABEL, Server, server_, process_id_),
+    INFO_FIELD(REDIS_RUN_ID_LABEL, Server, server_, run_id_),
+    INFO_FIELD(REDIS_TCP_PORT_LABEL, Server, server_, tcp_port_),
+    INFO_FIELD(REDIS_UPTIME_IN_SECONDS_LABEL, Server, server_, uptime_in_seconds_),
+    INFO_FIELD(REDIS_UPTIME_IN_DAYS_LABEL, Server, server_, uptime_in_days_),
+    INFO_FIELD(REDIS_HZ_LABEL, Server, server_, hz_),
+    INFO_FIELD(REDIS_LRU_CLOCK_LABEL, Server, server_, lru_clock_),
+
+    INFO_FIELD(REDIS_CONNECTED_CLIENTS_LABEL, Clients, clients_, connected_clients_),
+    INFO_FIELD(REDIS_CLIENT_LONGEST_OUTPUT_LIST_LABEL, Clients, clients_, client_longest_output_list_),
+    INFO_FIELD(REDIS_CLIENT_BIGGEST_INPUT_BUF_LABEL, Clients, clients_, client_biggest_input_buf_),
+    INFO_FIELD(REDIS_BLOCKED_CLIENTS_LABEL, Clients, clients_, blocked_clients_),
+
+    INFO_FIELD(REDIS_USED_MEMORY_LABEL, Memory, memory_, used_memory_),
+    INFO_FIELD(REDIS_USED_MEMORY_HUMAN_LABEL, Memory, memory_, used_memory_human_),
+    INFO_FIELD(REDIS_USED_MEMORY_RSS_LABEL, Memory, memory_, used_memory_rss_),
+    INFO_FIELD(REDIS_USED_MEMORY_PEAK_LABEL, Memory, memory_, used_memory_peak_),
+    INFO_FIELD(REDIS_USED_MEMORY_PEAK_HUMAN_LABEL, Memory, memory_, used_memory_peak_human_),
+    INFO_FIELD(REDIS_USED_MEMORY_LUA_LABEL, Memory, memory_, used_memory_lua_),
+    INFO_FIELD(REDIS_MEM_FRAGMENTATION_RATIO_LABEL, Memory, memory_, mem_fragmentation_ratio_),
+    INFO_FIELD(REDIS_MEM_ALLOCATOR_LABEL, Memory, memory_, mem_allocator_),
+
+    INFO_FIELD(REDIS_LOADING_LABEL, Persistence, persistence_, loading_),
+    INFO_FIELD(REDIS_RDB_CHANGES_SINCE_LAST_SAVE_LABEL, Persistence, persistence_, rdb_changes_since_last_save_),
+    INFO_FIELD(REDIS_RDB_DGSAVE_IN_PROGRESS_LABEL, Persistence, persistence_, rdb_bgsave_in_progress_),
+    INFO_FIELD(REDIS_RDB_LAST_SAVE_TIME_LABEL, Persistence, persistence_, rdb_last_save_time_),
+    INFO_FIELD(REDIS_RDB_LAST_DGSAVE_STATUS_LABEL, Persistence, persistence_, rdb_last_bgsave_status_),
+    INFO_FIELD(REDIS_RDB_LAST_DGSAVE_TIME_SEC_LABEL, Persistence, persistence_, rdb_last_bgsave_time_sec_),
+    INFO_FIELD(REDIS_RDB_CURRENT_DGSAVE_TIME_SEC_LABEL, Persistence, persistence_, rdb_current_bgsave_time_sec_),
+    INFO_FIELD(REDIS_AOF_ENABLED_LABEL, Persistence, persistence_, aof_enabled_),
+    INFO_FIELD(REDIS_AOF_REWRITE_IN_PROGRESS_LABEL, Persistence, persistence_, aof_rewrite_in_progress_),
+    INFO_FIELD(REDIS_AOF_REWRITE_SHEDULED_LABEL, Persistence, persistence_, aof_rewrite_scheduled_),
+    INFO_FIELD(REDIS_AOF_LAST_REWRITE_TIME_SEC_LABEL, Persistence, persistence_, aof_last_rewrite_time_sec_),
+    INFO_FIELD(REDIS_AOF_CURRENT_REWRITE_TIME_SEC_LABEL, Persistence, persistence_, aof_current_rewrite_time_sec_),
+    INFO_FIELD(REDIS_AOF_LAST_DGREWRITE_STATUS_LABEL, Persistence, persistence_, aof_last_bgrewrite_status_),
+    INFO_FIELD(REDIS_AOF_LAST_WRITE_STATUS_LABEL, Persistence, persistence_, aof_last_write_status_),
+
+    INFO_FIELD(REDIS_TOTAL_CONNECTIONS_RECEIVED_LABEL, Stats, stats_, total_connections_received_),
+    INFO_FIELD(REDIS_TOTAL_COMMANDS_PROCESSED_LABEL, Stats, stats_, total_commands_processed_),
+    INFO_FIELD(REDIS_INSTANTANEOUS_OPS_PER_SEC_LABEL, Stats, stats_, instantaneous_ops_per_sec_),
+    INFO_FIELD(REDIS_REJECTED_CONNECTIONS_LABEL, Stats, stats_, rejected_connections_),
+    INFO_FIELD(REDIS_SYNC_FULL_LABEL, Stats, stats_, sync_full_),
+    INFO_FIELD(REDIS_SYNC_PARTIAL_OK_LABEL, Stats, stats_, sync_partial_ok_),
+    INFO_FIELD(REDIS_SYNC_PARTIAL_ERR_LABEL, Stats, stats_, sync_partial_err_),
+    INFO_FIELD(REDIS_EXPIRED_KEYS_LABEL, Stats, stats_, expired_keys_),
+    INFO_FIELD(REDIS_EVICTED_KEYS_LABEL, Stats, stats_, evicted_keys_),
+    INFO_FIELD(REDIS_KEYSPACE_HITS_LABEL, Stats, stats_, keyspace_hits_),
+    INFO_FIELD(REDIS_KEYSPACE_MISSES_LABEL, Stats, stats_, keyspace_misses_),
+    INFO_FIELD(REDIS_PUBSUB_CHANNELS_LABEL, Stats, stats_, pubsub_channels_),
+    INFO_FIELD(REDIS_PUBSUB_PATTERNS_LABEL, Stats, stats_, pubsub_patterns_),
+    INFO_FIELD(REDIS_LATEST_FORK_USEC_LABEL, Stats, stats_, latest_fork_usec_),
+
+    INFO_FIELD(REDIS_ROLE_LABEL, Replication, replication_, role_),
+    INFO_FIELD(REDIS_CONNECTED_SLAVES_LABEL, Replication, replication_, connected_slaves_),
+    INFO_FIELD(REDIS_MASTER_REPL_OFFSET_LABEL, Replication, replication_, master_repl_offset_),
+    INFO_FIELD(REDIS_BACKLOG_ACTIVE_LABEL, Replication, replication_, backlog_active_),
+    INFO_FIELD(REDIS_BACKLOG_SIZE_LABEL, Replication, replication_, backlog_size_),
+    INFO_FIELD(REDIS_BACKLOG_FIRST_BYTE_OFFSET_LABEL, Replication, replication_, backlog_first_byte_offset_),
+    INFO_FIELD(REDIS_BACKLOG_HISTEN_LABEL, Replication, replication_, backlog_histen_),
+
+    INFO_FIELD(REDIS_USED_CPU_SYS_LABEL, Cpu, cpu_, used_cpu_sys_),
+    INFO_FIELD(REDIS_USED_CPU_USER_LABEL, Cpu, cpu_, used_cpu_user_),
+    INFO_FIELD(REDIS_USED_CPU_SYS_CHILDREN_LABEL, Cpu, cpu_, used_cpu_sys_children_),
+    INFO_FIELD(REDIS_USED_CPU_USER_CHILDREN_LABEL, Cpu, cpu_, used_cpu_user_children_)};
+
+#undef INFO_FIELD
+
+const char* const known_sections[] = {REDIS_SERVER_LABEL,      REDIS_CLIENTS_LABEL, REDIS_MEMORY_LABEL,
+                                      REDIS_PERSISTENCE_LABEL, REDIS_STATS_LABEL,   REDIS_REPLICATION_LABEL,
+                                      REDIS_CPU_LABEL};
+
+bool infoLabelLess(const char* left, size_t left_len, const char* right, size_t right_len) {
+  const int res = memcmp(left, right, std::min(left_len, right_len));
+  return res < 0 || (res == 0 && left_len < right_len);
+}
+
+std::vector<InfoFieldEntry> makeSortedInfoFields() {
+  std::vector<InfoFieldEntry> fields(info_fields, info_fields + SIZEOFMASS(info_fields));
+  std::sort(fields.begin(), fields.end(), [](const InfoFieldEntry& left, const InfoFieldEntry& right) {
+    return infoLabelLess(left.label, left.label_len, right.label, right.label_len);
+  });
+  return fields;
+}
+
+info_field_parser_t findInfoFieldParser(const char* label, size_t len) {
+  static const std::vector<InfoFieldEntry> fields = makeSortedInfoFields();
+  auto it = std::lower_bound(fields.begin(), fields.end(), std::make_pair(label, len),
+                             [](const InfoFieldEntry& entry, const std::pair<const char*, size_t>& key) {
+                               return infoLabelLess(entry.label, entry.label_len, key.first, key.second);
+                             });
+  if (it == fields.end() || it->label_len != len || memcmp(it->label, label, len) != 0) {
+    return nullptr;
+  }
+  return it->parser;
+}
+
+bool isKnownInfoSection(const char* line, size_t len) {
+  for (size_t i = 0; i < SIZEOFMASS(known_sections); ++i) {
+    if (strlen(known_sections[i]) == len && memcmp(known_sections[i], line, len) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
 ServerInfo* MakeRedisServerInfo(const std::string& content) {
   if (content.empty()) {
     return nullptr;
   }
 
   ServerInfo* result = new ServerInfo;
-  size_t j = 0;
-  std::string word;
-  size_t pos = 0;
-  static const std::vector<core::info_field_t> fields = DBTraits<REDIS>::InfoFields();
-  for (size_t i = 0; i < content.size(); ++i) {
-    char ch = content[i];
-    word += ch;
-    if (word == fields[j].first) {
-      if (j + 1 != fields.size()) {
-        pos = content.find(fields[j + 1].first, pos);
-      } else {
-        break;
-      }
+  ServerInfo::section_fields_t* other_section = nullptr;
+  const char* ptr = content.c_str();
+  const char* const end = ptr + content.size();
+  while (ptr < end) {
+    const char* line_end = static_cast<const char*>(memchr(ptr, '\n', end - ptr));
+    const char* next = line_end ? line_end + 1 : end;
+    if (!line_end) {
+      line_end = end;
+    }
+    if (line_end != ptr && line_end[-1] == '\r') {
+      --line_end;
+    }
 
-      if (pos != std::string::npos) {
-        std::string part = content.substr(i + 1, pos - i - 1);
-        switch (j) {
-          case 0:
-            result->server_ = ServerInfo::Server(part);
-            break;
-          case 1:
-            result->clients_ = ServerInfo::Clients(part);
-            break;
-          case 2:
-            result->memory_ = ServerInfo::Memory(part);
-            break;
-          case 3:
-            result->persistence_ = ServerInfo::Persistence(part);
-            break;
-          case 4:
-            result->stats_ = ServerInfo::Stats(part);
-            break;
-          case 5:
-            result->replication_ = ServerInfo::Replication(part);
-            break;
-          case 6:
-            result->cpu_ = ServerInfo::Cpu(part);
-            break;
-          default:
-            break;
+    const size_t len = line_end - ptr;
+    if (len == 0) {
+      ptr = next;
+      continue;
+    }
+
+    if (ptr[0] == '#') {
+      other_section = nullptr;
+      if (!isKnownInfoSection(ptr, len)) {
+        const char* name = ptr + 1;
+        while (name != line_end && *name == ' ') {
+          ++name;
+        }
+        result->other_sections_.push_back(std::make_pair(std::string(name, line_end), ServerInfo::section_fields_t()));
+        other_section = &result->other_sections_.back().second;
+      }
+    } else {
+      const char* delem = static_cast<const char*>(memchr(ptr, ':', len));
+      if (delem) {
+        if (other_section) {
+          other_section->push_back(std::make_pair(std::string(ptr, delem), std::string(delem + 1, line_end)));
+        } else {
+          info_field_parser_t parser = findInfoFieldParser(ptr, delem - ptr);
+          if (parser) {
+            parser(result, delem + 1, line_end - delem - 1);
+          }
         }
-        i = pos - 1;
-        ++j;
       }
-      word.clear();
     }
+    ptr = next;
   }
 
   return result;
@@ -20,8 +20,10 @@
 
 #include <stdint.h>  // for uint32_t
 
-#include <iosfwd>  // for ostream
-#include <string>  // for string, basic_string
+#include <iosfwd>   // for ostream
+#include <string>   // for string, basic_string
+#include <utility>  // for pair
+#include <vector>   // for vector
 
 #include <common/value.h>  // for Value
 
@@ -125,7 +127,6 @@ namespace redis {
 struct ServerInfo : public IServerInfo {
   struct Server : IStateField {
     Server();
-    explicit Server(const std::string& server_text);
     common::Value* ValueByIndex(unsigned char index) const override;
 
     std::string redis_version_;
@@ -148,7 +149,6 @@ struct ServerInfo : public IServerInfo {
 
   struct Clients : IStateField {
     Clients();
-    explicit Clients(const std::string& client_text);
     common::Value* ValueByIndex(unsigned char index) const override;
 
     uint32_t connected_clients_;
@@ -159,7 +159,6 @@ struct ServerInfo : public IServerInfo {
 
   struct Memory : IStateField {
     Memory();
-    explicit Memory(const std::string& memory_text);
     common::Value* ValueByIndex(unsigned char index) const override;
 
     uint32_t used_memory_;
@@ -174,7 +173,6 @@ struct ServerInfo : public IServerInfo {
 
   struct Persistence : IStateField {
     Persistence();
-    explicit Persistence(const std::string& persistence_text);
     common::Value* ValueByIndex(unsigned char index) const override;
 
     uint32_t loading_;
@@ -195,7 +193,6 @@ struct ServerInfo : public IServerInfo {
 
   struct Stats : IStateField {
     Stats();
-    explicit Stats(const std::string& stats_text);
     common::Value* ValueByIndex(unsigned char index) const override;
 
     uint32_t total_connections_received_;
@@ -216,7 +213,6 @@ struct ServerInfo : public IServerInfo {
 
   struct Replication : IStateField {
     Replication();
-    explicit Replication(const std::string& replication_text);
     common::Value* ValueByIndex(unsigned char index) const override;
 
     std::string role_;
@@ -230,7 +226,6 @@ struct ServerInfo : public IServerInfo {
 
   struct Cpu : IStateField {
     Cpu();
-    explicit Cpu(const std::string& cpu_text);
     common::Value* ValueByIndex(unsigned char index) const override;
 
     float used_cpu_sys_;
@@ -243,6 +238,10 @@ struct ServerInfo : public IServerInfo {
     common::Value* ValueByIndex(unsigned char index) const override;
   } keySp_;
 
+  typedef std::vector<std::pair<std::string, std::string>> section_fields_t;
+  typedef std::vector<std::pair<std::string, section_fields_t>> sections_t;
+  sections_t other_sections_;  // sections without own struct (Keyspace, Commandstats, ...) in reply order
+
   ServerInfo();
   ServerInfo(const Server& serv,
              const Clients& clients,
@@ -256,10 +255,15 @@ struct ServerInfo : public IServerInfo {
   virtual common::Value* ValueByIndexes(unsigned char property, unsigned char field) const override;
   virtual std::string ToString() const override;
   virtual uint32_t Version() const override;
+
+  const section_fields_t* OtherSection(const std::string& name) const;  // name without "# ", nullptr if absent
 };
 
 std::ostream& operator<<(std::ostream& out, const ServerInfo& value);
 
+// Single pass over the INFO reply: fields of known sections are dispatched
+// through a sorted label table straight into the section structs, other
+// sections are kept as key/value pairs.
 ServerInfo* MakeRedisServerInfo(const std::string& content);
 
 }  // namespace redis
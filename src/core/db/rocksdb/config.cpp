@@ -58,6 +58,35 @@ Config parseOptions(int argc, char** argv) {
       if (common::ConvertFromString(argv[++i], &lcomparator)) {
         cfg.comparator = lcomparator;
       }
+    } else if (!strcmp(argv[i], "-mode") && !lastarg) {
+      OpenMode lmode;
+      if (common::ConvertFromString(argv[++i], &lmode)) {
+        cfg.open_mode = lmode;
+      }
+    } else if (!strcmp(argv[i], "-sp") && !lastarg) {
+      cfg.secondary_path = argv[++i];
+    } else if (!strcmp(argv[i], "-bc") && !lastarg) {
+      uint32_t lblock_cache_mb;
+      if (common::ConvertFromString(argv[++i], &lblock_cache_mb)) {
+        cfg.block_cache_mb = lblock_cache_mb;
+      }
+    } else if (!strcmp(argv[i], "-bloom") && !lastarg) {
+      int lbloom_bits;
+      if (common::ConvertFromString(argv[++i], &lbloom_bits)) {
+        cfg.bloom_bits_per_key = lbloom_bits;
+      }
+    } else if (!strcmp(argv[i], "-mof") && !lastarg) {
+      int lmax_open_files;
+      if (common::ConvertFromString(argv[++i], &lmax_open_files)) {
+        cfg.max_open_files = lmax_open_files;
+      }
+    } else if (!strcmp(argv[i], "-mmap")) {
+      cfg.allow_mmap_reads = true;
+    } else if (!strcmp(argv[i], "-mbj") && !lastarg) {
+      int lmax_background_jobs;
+      if (common::ConvertFromString(argv[++i], &lmax_background_jobs)) {
+        cfg.max_background_jobs = lmax_background_jobs;
+      }
     } else {
       if (argv[i][0] == '-') {
         const std::string buff = common::MemSPrintf(
@@ -80,7 +109,14 @@ Config parseOptions(int argc, char** argv) {
 Config::Config()
     : LocalConfig(common::file_system::prepare_path("~/test.rocksdb")),
       create_if_missing(false),
-      comparator(COMP_BYTEWISE) {}
+      comparator(COMP_BYTEWISE),
+      open_mode(OPEN_READ_WRITE),
+      secondary_path(),
+      block_cache_mb(0),
+      bloom_bits_per_key(0),
+      max_open_files(-1),
+      allow_mmap_reads(false),
+      max_background_jobs(0) {}
 
 }  // namespace rocksdb
 }  // namespace core
@@ -97,6 +133,37 @@ std::string ConvertToString(const fastonosql::core::rocksdb::Config& conf) {
 
   argv.push_back("-comp");
   argv.push_back(common::ConvertToString(conf.comparator));
+
+  argv.push_back("-mode");
+  argv.push_back(common::ConvertToString(conf.open_mode));
+  if (conf.open_mode == fastonosql::core::rocksdb::OPEN_SECONDARY && !conf.secondary_path.empty()) {
+    argv.push_back("-sp");
+    argv.push_back(conf.secondary_path);
+  }
+
+  if (conf.block_cache_mb) {
+    argv.push_back("-bc");
+    argv.push_back(common::ConvertToString(conf.block_cache_mb));
+  }
+
+  if (conf.bloom_bits_per_key) {
+    argv.push_back("-bloom");
+    argv.push_back(common::ConvertToString(conf.bloom_bits_per_key));
+  }
+
+  if (conf.max_open_files != -1) {
+    argv.push_back("-mof");
+    argv.push_back(common::ConvertToString(conf.max_open_files));
+  }
+
+  if (conf.allow_mmap_reads) {
+    argv.push_back("-mmap");
+  }
+
+  if (conf.max_background_jobs) {
+    argv.push_back("-mbj");
+    argv.push_back(common::ConvertToString(conf.max_background_jobs));
+  }
   return fastonosql::core::ConvertToStringConfigArgs(argv);
 }
 
@@ -136,4 +203,23 @@ bool ConvertFromString(const std::string& from, fastonosql::core::rocksdb::Compa
   return false;
 }
 
+std::string ConvertToString(fastonosql::core::rocksdb::OpenMode mode) {
+  return fastonosql::core::rocksdb::g_open_modes[mode];
+}
+
+bool ConvertFromString(const std::string& from, fastonosql::core::rocksdb::OpenMode* out) {
+  if (!out) {
+    return false;
+  }
+
+  for (size_t i = 0; i < SIZEOFMASS(fastonosql::core::rocksdb::g_open_modes); ++i) {
+    if (from == fastonosql::core::rocksdb::g_open_modes[i]) {
+      *out = static_cast<fastonosql::core::rocksdb::OpenMode>(i);
+      return true;
+    }
+  }
+
+  return false;
+}
+
 }  // namespace common
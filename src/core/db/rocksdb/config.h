@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <stdint.h>  // for uint32_t
+
 #include <string>
 
 #include "core/config/config.h"
@@ -29,11 +31,26 @@ namespace rocksdb {
 enum ComparatorType { COMP_BYTEWISE, COMP_REVERSE_BYTEWISE };
 static const char* g_comparator_types[] = {"BYTEWISE", "REVERSE_BYTEWISE"};
 
+// read only and secondary instances don't take the database lock, so they can
+// be attached to a running process; secondary follows its writes on refresh
+enum OpenMode { OPEN_READ_WRITE, OPEN_READ_ONLY, OPEN_SECONDARY };
+static const char* g_open_modes[] = {"READ_WRITE", "READ_ONLY", "SECONDARY"};
+
 struct Config : public LocalConfig {
   Config();
 
   bool create_if_missing;
   ComparatorType comparator;
+
+  OpenMode open_mode;
+  std::string secondary_path;  // own info log and manifest copy of secondary instance, empty - "<db_path>.secondary"
+
+  // 0 or -1 keeps rocksdb defaults
+  uint32_t block_cache_mb;  // LRU block cache, shared by connections with the same size
+  int bloom_bits_per_key;   // 0 - no bloom filter
+  int max_open_files;       // -1 - unlimited
+  bool allow_mmap_reads;
+  int max_background_jobs;  // 0 - rocksdb default
 };
 
 }  // namespace rocksdb
@@ -46,4 +63,7 @@ bool ConvertFromString(const std::string& from, fastonosql::core::rocksdb::Confi
 
 std::string ConvertToString(fastonosql::core::rocksdb::ComparatorType comp);
 bool ConvertFromString(const std::string& from, fastonosql::core::rocksdb::ComparatorType* out);
+
+std::string ConvertToString(fastonosql::core::rocksdb::OpenMode mode);
+bool ConvertFromString(const std::string& from, fastonosql::core::rocksdb::OpenMode* out);
 }  // namespace common
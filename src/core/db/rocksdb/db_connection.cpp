@@ -20,11 +20,17 @@
 
 #include <string.h>  // for strtok
 
+#include <map>     // for map
 #include <memory>  // for __shared_ptr
+#include <mutex>   // for mutex, lock_guard
 #include <string>  // for string, operator<, etc
 #include <vector>  // for vector
 
+#include <rocksdb/cache.h>  // for NewLRUCache
 #include <rocksdb/db.h>
+#include <rocksdb/filter_policy.h>  // for NewBloomFilterPolicy
+#include <rocksdb/table.h>          // for BlockBasedTableOptions
+#include <rocksdb/write_batch.h>    // for WriteBatch
 
 #include <common/convert2string.h>  // for ConvertFromString
 #include <common/file_system.h>     // for is_directory
@@ -107,6 +113,24 @@ ConstantCommandsArray CDBConnection<rocksdb::NativeConnection, rocksdb::Config,
 }  // namespace internal
 namespace rocksdb {
 
+namespace {
+
+// connections opened with the same cache size share one cache,
+// so every opened database doesn't add its own block cache
+std::shared_ptr< ::rocksdb::Cache> sharedBlockCache(size_t capacity) {
+  static std::mutex caches_mutex;
+  static std::map<size_t, std::weak_ptr< ::rocksdb::Cache> > caches;
+  std::lock_guard<std::mutex> lock(caches_mutex);
+  std::shared_ptr< ::rocksdb::Cache> cache = caches[capacity].lock();
+  if (!cache) {
+    cache = ::rocksdb::NewLRUCache(capacity);
+    caches[capacity] = cache;
+  }
+  return cache;
+}
+
+}  // namespace
+
 common::Error CreateConnection(const Config& config, NativeConnection** context) {
   if (!context) {
     return common::make_inval_error_value(common::ErrorValue::E_ERROR);
@@ -121,13 +145,41 @@ common::Error CreateConnection(const Config& config, NativeConnection** context)
   }
 
   ::rocksdb::Options rs;
-  rs.create_if_missing = config.create_if_missing;
+  rs.create_if_missing = config.create_if_missing && config.open_mode == OPEN_READ_WRITE;
   if (config.comparator == COMP_BYTEWISE) {
     rs.comparator = ::rocksdb::BytewiseComparator();
   } else if (config.comparator == COMP_REVERSE_BYTEWISE) {
     rs.comparator = ::rocksdb::ReverseBytewiseComparator();
   }
-  auto st = ::rocksdb::DB::Open(rs, folder, &lcontext);
+
+  rs.max_open_files = config.max_open_files;
+  rs.allow_mmap_reads = config.allow_mmap_reads;
+  if (config.max_background_jobs > 0) {
+    rs.max_background_jobs = config.max_background_jobs;
+  }
+
+  if (config.block_cache_mb || config.bloom_bits_per_key > 0) {
+    ::rocksdb::BlockBasedTableOptions table_options;
+    if (config.block_cache_mb) {
+      table_options.block_cache = sharedBlockCache(static_cast<size_t>(config.block_cache_mb) << 20);
+    }
+    if (config.bloom_bits_per_key > 0) {
+      table_options.filter_policy.reset(::rocksdb::NewBloomFilterPolicy(config.bloom_bits_per_key));
+    }
+    rs.table_factory.reset(::rocksdb::NewBlockBasedTableFactory(table_options));
+  }
+
+  ::rocksdb::Status st;
+  if (config.open_mode == OPEN_READ_ONLY) {
+    st = ::rocksdb::DB::OpenForReadOnly(rs, folder, &lcontext);
+  } else if (config.open_mode == OPEN_SECONDARY) {
+    rs.max_open_files = -1;  // secondary instance keeps every table file opened
+    // each database gets its own secondary folder unless one is given
+    const std::string secondary_path = config.secondary_path.empty() ? folder + ".secondary" : config.secondary_path;
+    st = ::rocksdb::DB::OpenAsSecondary(rs, folder, secondary_path, &lcontext);
+  } else {
+    st = ::rocksdb::DB::Open(rs, folder, &lcontext);
+  }
   if (!st.ok()) {
     std::string buff = common::MemSPrintf("Fail open database: %s!", st.ToString());
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
@@ -149,7 +201,57 @@ common::Error TestConnection(const Config& config) {
 }
 
 DBConnection::DBConnection(CDBConnectionClient* client)
-    : base_class(client, new CommandTranslator(base_class::Commands())) {}
+    : base_class(client, new CommandTranslator(base_class::Commands())), snapshot_(nullptr) {}
+
+DBConnection::~DBConnection() {
+  common::Error err = Disconnect();
+  if (err && err->IsError()) {
+    DNOTREACHED();
+  }
+}
+
+common::Error DBConnection::Disconnect() {
+  if (IsConnected()) {
+    scan_cursors_.Clear();  // cursors hold snapshots of the handle
+    if (snapshot_) {
+      connection_.handle_->ReleaseSnapshot(snapshot_);
+      snapshot_ = nullptr;
+    }
+  }
+
+  return base_class::Disconnect();
+}
+
+::rocksdb::ReadOptions DBConnection::MakeReadOptions(bool bulk) const {
+  ::rocksdb::ReadOptions ro;
+  ro.snapshot = snapshot_;
+  ro.fill_cache = !bulk;
+  return ro;
+}
+
+bool DBConnection::IsSnapshotSupported() const {
+  return connection_.config_.open_mode != OPEN_SECONDARY;
+}
+
+common::Error DBConnection::CatchUpWithPrimary() {
+  if (connection_.config_.open_mode != OPEN_SECONDARY) {
+    return common::Error();
+  }
+
+  auto st = connection_.handle_->TryCatchUpWithPrimary();
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("catch up with primary error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  return common::Error();
+}
+
+internal::scan_snapshot_t DBConnection::MakeScanSnapshot() {
+  ::rocksdb::DB* db = connection_.handle_;
+  return internal::scan_snapshot_t(db->GetSnapshot(),
+                                   [db](const ::rocksdb::Snapshot* snap) { db->ReleaseSnapshot(snap); });
+}
 
 common::Error DBConnection::Info(const std::string& args, ServerInfo::Stats* statsout) {
   UNUSED(args);
@@ -235,7 +337,7 @@ common::Error DBConnection::GetInner(key_t key, std::string* ret_val) {
     return common::make_error_value("Not connected", common::Value::E_ERROR);
   }
 
-  ::rocksdb::ReadOptions ro;
+  const ::rocksdb::ReadOptions ro = MakeReadOptions(false);
   const string_key_t key_str = key.ToBytes();
   const ::rocksdb::Slice key_slice(reinterpret_cast<const char*>(key_str.data()), key_str.size());
   auto st = connection_.handle_->Get(ro, key_slice, ret_val);
@@ -256,7 +358,7 @@ common::Error DBConnection::Mget(const std::vector<std::string>& keys, std::vect
   for (auto key : keys) {
     rslice.push_back(key);
   }
-  ::rocksdb::ReadOptions ro;
+  const ::rocksdb::ReadOptions ro = MakeReadOptions(false);
   auto sts = connection_.handle_->MultiGet(ro, rslice, ret);
   for (size_t i = 0; i < sts.size(); ++i) {
     auto st = sts[i];
@@ -327,35 +429,77 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
                                      uint64_t count_keys,
                                      std::vector<std::string>* keys_out,
                                      uint64_t* cursor_out) {
-  ::rocksdb::ReadOptions ro;
-  ::rocksdb::Iterator* it = connection_.handle_->NewIterator(ro);  // keys(key_start, key_end, limit, ret);
-  uint64_t offset_pos = cursor_in;
+  std::string last_key;
+  internal::scan_snapshot_t scan_snapshot;
+  if (cursor_in != 0 && !scan_cursors_.Find(cursor_in, &last_key, &scan_snapshot)) {
+    return internal::MakeInvalidScanCursorError(cursor_in);
+  }
+
+  // prefix range is contiguous only in bytewise order
+  const std::string prefix =
+      connection_.config_.comparator == COMP_BYTEWISE ? internal::GetKeysPatternPrefix(pattern) : std::string();
+  if (cursor_in == 0) {  // pages of one pagination see the database as of its first page
+    common::Error err = CatchUpWithPrimary();
+    if (err && err->IsError()) {
+      return err;
+    }
+
+    if (!snapshot_ && IsSnapshotSupported()) {
+      scan_snapshot = MakeScanSnapshot();
+    }
+  }
+
+  ::rocksdb::ReadOptions ro = MakeReadOptions(true);
+  if (scan_snapshot) {
+    ro.snapshot = static_cast<const ::rocksdb::Snapshot*>(scan_snapshot.get());
+  }
+  ::rocksdb::Iterator* it = connection_.handle_->NewIterator(ro);
+  if (cursor_in == 0) {
+    if (prefix.empty()) {
+      it->SeekToFirst();
+    } else {
+      it->Seek(prefix);
+    }
+  } else {
+    it->Seek(last_key);
+    if (it->Valid() && it->key().ToString() == last_key) {
+      it->Next();
+    }
+  }
+
   uint64_t lcursor_out = 0;
   std::vector<std::string> lkeys_out;
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+  for (; it->Valid(); it->Next()) {
     std::string key = it->key().ToString();
-    if (lkeys_out.size() < count_keys) {
-      if (common::MatchPattern(key, pattern)) {
-        if (offset_pos == 0) {
-          lkeys_out.push_back(key);
-        } else {
-          offset_pos--;
-        }
-      }
-    } else {
-      lcursor_out = cursor_in + count_keys;
+    if (!internal::IsKeyHasPrefix(key, prefix)) {
       break;
     }
+
+    if (lkeys_out.size() >= count_keys) {
+      lcursor_out = scan_cursors_.Save(last_key, scan_snapshot);
+      break;
+    }
+
+    if (common::MatchPattern(key, pattern)) {
+      lkeys_out.push_back(key);
+    }
+    last_key = key;
   }
 
   auto st = it->status();
   delete it;
 
   if (!st.ok()) {
+    if (lcursor_out != 0) {
+      scan_cursors_.Erase(lcursor_out);
+    }
     std::string buff = common::MemSPrintf("Keys function error: %s", st.ToString());
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
+  if (cursor_in != 0) {  // pagination went on with the new cursor, last page drops the snapshot
+    scan_cursors_.Erase(cursor_in);
+  }
   *keys_out = lkeys_out;
   *cursor_out = lcursor_out;
   return common::Error();
@@ -365,7 +509,7 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
                                      const std::string& key_end,
                                      uint64_t limit,
                                      std::vector<std::string>* ret) {
-  ::rocksdb::ReadOptions ro;
+  const ::rocksdb::ReadOptions ro = MakeReadOptions(true);
   ::rocksdb::Iterator* it = connection_.handle_->NewIterator(ro);  // keys(key_start, key_end, limit, ret);
   for (it->Seek(key_start); it->Valid(); it->Next()) {
     std::string key = it->key().ToString();
@@ -389,10 +533,14 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
 }
 
 common::Error DBConnection::DBkcountImpl(size_t* size) {
-  ::rocksdb::ReadOptions ro;
+  const ::rocksdb::ReadOptions ro = MakeReadOptions(true);
   ::rocksdb::Iterator* it = connection_.handle_->NewIterator(ro);
   size_t sz = 0;
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    if (IsInterrupted()) {
+      delete it;
+      return common::make_error_value("Interrupted.", common::ErrorValue::E_INTERRUPTED);
+    }
     sz++;
   }
 
@@ -408,27 +556,66 @@ common::Error DBConnection::DBkcountImpl(size_t* size) {
   return common::Error();
 }
 
+common::Error DBConnection::DBkcountEstimateImpl(size_t* size, bool* is_exact) {
+  uint64_t estimate = 0;
+  if (!connection_.handle_->GetIntProperty(::rocksdb::DB::Properties::kEstimateNumKeys, &estimate)) {
+    return common::make_error_value("Couldn't determine DBKCOUNT estimate.", common::ErrorValue::E_ERROR);
+  }
+
+  *size = estimate;
+  *is_exact = false;
+  return common::Error();
+}
+
 common::Error DBConnection::FlushDBImpl() {
   ::rocksdb::ReadOptions ro;
-  ::rocksdb::WriteOptions wo;
+  ro.fill_cache = false;
   ::rocksdb::Iterator* it = connection_.handle_->NewIterator(ro);
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    std::string key = it->key().ToString();
-    auto st = connection_.handle_->Delete(wo, key);
+  it->SeekToFirst();
+  if (!it->Valid()) {  // empty or error
+    auto st = it->status();
+    delete it;
     if (!st.ok()) {
-      delete it;
-      std::string buff = common::MemSPrintf("del function error: %s", st.ToString());
+      std::string buff = common::MemSPrintf("Keys function error: %s", st.ToString());
       return common::make_error_value(buff, common::ErrorValue::E_ERROR);
     }
+    return common::Error();
   }
 
+  const std::string first_key = it->key().ToString();
+  it->SeekToLast();
+  const std::string last_key = it->Valid() ? it->key().ToString() : first_key;
   auto st = it->status();
   delete it;
-
   if (!st.ok()) {
     std::string buff = common::MemSPrintf("Keys function error: %s", st.ToString());
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
+
+  // range tombstone instead of one write per key, end of range is exclusive
+  ::rocksdb::ColumnFamilyHandle* fam = connection_.handle_->DefaultColumnFamily();
+  ::rocksdb::WriteBatch batch;
+  batch.DeleteRange(fam, first_key, last_key);
+  batch.Delete(fam, last_key);
+  ::rocksdb::WriteOptions wo;
+  st = connection_.handle_->Write(wo, &batch);
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("del function error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  NotifyProgress(50);
+  if (IsInterrupted()) {  // keys already removed, only space reclaim skipped
+    return common::make_error_value("Interrupted.", common::ErrorValue::E_INTERRUPTED);
+  }
+
+  ::rocksdb::Slice begin(first_key);
+  ::rocksdb::Slice end(last_key);
+  st = connection_.handle_->CompactRange(::rocksdb::CompactRangeOptions(), fam, &begin, &end);
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("compact function error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
   return common::Error();
 }
 
@@ -437,10 +624,18 @@ common::Error DBConnection::SelectImpl(const std::string& name, IDataBaseInfo**
     return ICommandTranslator::InvalidInputArguments("SELECT");
   }
 
+  common::Error err = CatchUpWithPrimary();
+  if (err && err->IsError()) {
+    return err;
+  }
+
   size_t kcount = 0;
-  common::Error err = DBkcount(&kcount);
+  bool is_exact = true;
+  err = DBkcountEstimate(&kcount, &is_exact);
   DCHECK(!err);
-  *info = new DataBaseInfo(name, true, kcount);
+  DataBaseInfo* linfo = new DataBaseInfo(name, true, kcount);
+  linfo->SetDBKeysCountExact(is_exact);
+  *info = linfo;
   return common::Error();
 }
 
@@ -457,6 +652,68 @@ common::Error DBConnection::SetImpl(const NDbKValue& key, NDbKValue* added_key)
   return common::Error();
 }
 
+common::Error DBConnection::BulkSetImpl(const NDbKValues& keys) {
+  // one write and one WAL record for the whole batch
+  ::rocksdb::WriteBatch batch;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const string_key_t key_str = keys[i].GetKey().GetKey().ToBytes();
+    batch.Put(::rocksdb::Slice(key_str.data(), key_str.size()), keys[i].ValueString());
+  }
+
+  ::rocksdb::WriteOptions wo;
+  auto st = connection_.handle_->Write(wo, &batch);
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("set function error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  return common::Error();
+}
+
+common::Error DBConnection::WalkImpl(const std::string& position, walk_callback_t cb) {
+  // consistent view of the whole database (SNAPSHOT CREATE one if any)
+  ::rocksdb::ReadOptions ro = MakeReadOptions(true);
+  if (!snapshot_ && IsSnapshotSupported()) {
+    ro.snapshot = connection_.handle_->GetSnapshot();
+  }
+  ::rocksdb::Iterator* it = connection_.handle_->NewIterator(ro);
+  if (position.empty()) {
+    it->SeekToFirst();
+  } else {
+    it->Seek(position);
+    if (it->Valid() && it->key().ToString() == position) {
+      it->Next();
+    }
+  }
+
+  common::Error err;
+  for (; it->Valid(); it->Next()) {
+    const std::string key = it->key().ToString();
+    NValue val(common::Value::CreateStringValue(it->value().ToString()));
+    err = cb(NDbKValue(NKey(key_t(key)), val), key);  // keys are ordered, the last one is the position
+    if (err && err->IsError()) {
+      break;
+    }
+  }
+
+  auto st = it->status();
+  delete it;
+  if (!snapshot_ && ro.snapshot) {
+    connection_.handle_->ReleaseSnapshot(ro.snapshot);
+  }
+
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("walk function error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
   key_t key_str = key.GetKey();
   std::string value_str;
@@ -470,18 +727,81 @@ common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
   return common::Error();
 }
 
+common::Error DBConnection::ExistsImpl(const NKeys& keys, NKeys* existing_keys) {
+  std::vector<string_key_t> keys_str;
+  std::vector< ::rocksdb::Slice> rslice;
+  keys_str.reserve(keys.size());
+  rslice.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    keys_str.push_back(keys[i].GetKey().ToBytes());
+    const string_key_t& key_str = keys_str.back();
+    rslice.push_back(::rocksdb::Slice(reinterpret_cast<const char*>(key_str.data()), key_str.size()));
+  }
+
+  const ::rocksdb::ReadOptions ro = MakeReadOptions(true);
+  std::vector<std::string> values;
+  auto sts = connection_.handle_->MultiGet(ro, rslice, &values);
+  for (size_t i = 0; i < sts.size(); ++i) {
+    auto st = sts[i];
+    if (st.IsNotFound()) {
+      continue;
+    }
+
+    if (!st.ok()) {
+      std::string buff = common::MemSPrintf("exists function error: %s", st.ToString());
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    existing_keys->push_back(keys[i]);
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
+  // existence checks with one MultiGet, deletes applied as one atomic batch
+  std::vector<string_key_t> keys_str;
+  std::vector< ::rocksdb::Slice> rslice;
+  keys_str.reserve(keys.size());
+  rslice.reserve(keys.size());
   for (size_t i = 0; i < keys.size(); ++i) {
-    NKey key = keys[i];
-    key_t key_str = key.GetKey();
-    common::Error err = DelInner(key_str);
-    if (err && err->IsError()) {
+    keys_str.push_back(keys[i].GetKey().ToBytes());
+    const string_key_t& key_str = keys_str.back();
+    rslice.push_back(::rocksdb::Slice(reinterpret_cast<const char*>(key_str.data()), key_str.size()));
+  }
+
+  ::rocksdb::ReadOptions ro;
+  std::vector<std::string> values;
+  auto sts = connection_.handle_->MultiGet(ro, rslice, &values);
+  ::rocksdb::WriteBatch batch;
+  NKeys exists_keys;
+  for (size_t i = 0; i < sts.size(); ++i) {
+    auto st = sts[i];
+    if (st.IsNotFound()) {
       continue;
     }
 
-    deleted_keys->push_back(key);
+    if (!st.ok()) {
+      std::string buff = common::MemSPrintf("get function error: %s", st.ToString());
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    batch.Delete(rslice[i]);
+    exists_keys.push_back(keys[i]);
+  }
+
+  if (exists_keys.empty()) {
+    return common::Error();
+  }
+
+  ::rocksdb::WriteOptions wo;
+  auto st = connection_.handle_->Write(wo, &batch);
+  if (!st.ok()) {
+    std::string buff = common::MemSPrintf("del function error: %s", st.ToString());
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
+  deleted_keys->insert(deleted_keys->end(), exists_keys.begin(), exists_keys.end());
   return common::Error();
 }
 
@@ -529,6 +849,29 @@ common::Error DBConnection::QuitImpl() {
   return common::Error();
 }
 
+common::Error DBConnection::CreateSnapshotImpl() {
+  if (!IsSnapshotSupported()) {
+    return common::make_error_value("Snapshots aren't supported in secondary mode, reads change only on refresh",
+                                    common::ErrorValue::E_ERROR);
+  }
+
+  if (snapshot_) {
+    connection_.handle_->ReleaseSnapshot(snapshot_);
+  }
+  snapshot_ = connection_.handle_->GetSnapshot();
+  return common::Error();
+}
+
+common::Error DBConnection::ReleaseSnapshotImpl() {
+  if (!snapshot_) {
+    return common::make_error_value("Snapshot not created", common::ErrorValue::E_ERROR);
+  }
+
+  connection_.handle_->ReleaseSnapshot(snapshot_);
+  snapshot_ = nullptr;
+  return common::Error();
+}
+
 }  // namespace rocksdb
 }  // namespace core
 }  // namespace fastonosql
@@ -37,6 +37,8 @@
 
 namespace rocksdb {
 class DB;
+class Snapshot;
+struct ReadOptions;
 }
 
 namespace fastonosql {
@@ -52,6 +54,9 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
  public:
   typedef core::internal::CDBConnection<NativeConnection, Config, ROCKSDB> base_class;
   explicit DBConnection(CDBConnectionClient* client);
+  ~DBConnection();
+
+  common::Error Disconnect();  // releases snapshots before the database is closed
 
   std::string CurrentDBName() const;
 
@@ -64,6 +69,12 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   common::Error GetInner(key_t key, std::string* ret_val) WARN_UNUSED_RESULT;
   common::Error DelInner(key_t key) WARN_UNUSED_RESULT;
 
+  // reads go through the explicit snapshot if any, bulk reads don't fill the block cache
+  ::rocksdb::ReadOptions MakeReadOptions(bool bulk) const;
+  core::internal::scan_snapshot_t MakeScanSnapshot();  // released with the last cursor of pagination
+  bool IsSnapshotSupported() const;                       // not by secondary instance
+  common::Error CatchUpWithPrimary() WARN_UNUSED_RESULT;  // refresh of secondary instance
+
   virtual common::Error ScanImpl(uint64_t cursor_in,
                                  const std::string& pattern,
                                  uint64_t count_keys,
@@ -74,15 +85,23 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
                                  uint64_t limit,
                                  std::vector<std::string>* ret) override;
   virtual common::Error DBkcountImpl(size_t* size) override;
+  virtual common::Error DBkcountEstimateImpl(size_t* size, bool* is_exact) override;
   virtual common::Error FlushDBImpl() override;
   virtual common::Error SelectImpl(const std::string& name, IDataBaseInfo** info) override;
   virtual common::Error SetImpl(const NDbKValue& key, NDbKValue* added_key) override;
+  virtual common::Error BulkSetImpl(const NDbKValues& keys) override;
+  virtual common::Error WalkImpl(const std::string& position, walk_callback_t cb) override;
   virtual common::Error GetImpl(const NKey& key, NDbKValue* loaded_key) override;
+  virtual common::Error ExistsImpl(const NKeys& keys, NKeys* existing_keys) override;
   virtual common::Error DeleteImpl(const NKeys& keys, NKeys* deleted_keys) override;
   virtual common::Error RenameImpl(const NKey& key, string_key_t new_key) override;
   virtual common::Error SetTTLImpl(const NKey& key, ttl_t ttl) override;
   virtual common::Error GetTTLImpl(const NKey& key, ttl_t* ttl) override;
   virtual common::Error QuitImpl() override;
+  virtual common::Error CreateSnapshotImpl() override;
+  virtual common::Error ReleaseSnapshotImpl() override;
+
+  const ::rocksdb::Snapshot* snapshot_;       // SNAPSHOT CREATE, until SNAPSHOT RELEASE
 };
 
 }  // namespace rocksdb
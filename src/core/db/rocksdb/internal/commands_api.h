@@ -179,6 +179,22 @@ static const internal::ConstantCommandsArray g_commands = {CommandHolder("HELP",
                                                                          1,
                                                                          0,
                                                                          &CommandsApi::GetTTL),
+                                                           CommandHolder("SNAPSHOT CREATE",
+                                                                         "-",
+                                                                         "Read keys as of this moment until SNAPSHOT RELEASE",
+                                                                         UNDEFINED_SINCE,
+                                                                         UNDEFINED_EXAMPLE_STR,
+                                                                         0,
+                                                                         0,
+                                                                         &CommandsApi::CreateSnapshot),
+                                                           CommandHolder("SNAPSHOT RELEASE",
+                                                                         "-",
+                                                                         "Release snapshot created by SNAPSHOT CREATE",
+                                                                         UNDEFINED_SINCE,
+                                                                         UNDEFINED_EXAMPLE_STR,
+                                                                         0,
+                                                                         0,
+                                                                         &CommandsApi::ReleaseSnapshot),
                                                            CommandHolder("QUIT",
                                                                          "-",
                                                                          "Close the connection",
@@ -18,7 +18,11 @@
 
 #include "core/db/ssdb/db_connection.h"
 
-#include <memory>  // for __shared_ptr
+#include <string.h>  // for strcasecmp
+
+#include <algorithm>  // for transform
+#include <memory>     // for __shared_ptr
+#include <vector>     // for vector
 
 #include <SSDB.h>  // for Status, Client
 
@@ -31,6 +35,7 @@
 #include "core/db/ssdb/config.h"  // for Config
 #include "core/db/ssdb/database_info.h"
 #include "core/db/ssdb/internal/commands_api.h"
+#include "core/types.h"  // for ParseCommandLine
 
 namespace fastonosql {
 namespace core {
@@ -47,6 +52,28 @@ namespace {
 std::string ConvertToSSDBSlice(const key_t& key) {
   return key.ToBytes();
 }
+
+// shell syntax of these is the server one, so they can be sent as typed
+bool isPipelineCommand(const commands_args_t& argv) {
+  static const char* commands[] = {"set", "setx", "get", "incr", "expire", "hset", "hget", "hdel", "hincr",
+                                   "zset", "zget", "zdel", "zincr", "qpush", "multi_set", "multi_get",
+                                   "multi_hset", "multi_hget"};
+  if (argv.empty()) {
+    return false;
+  }
+
+  const char* name = argv[0].c_str();
+  if (strcasecmp(name, "del") == 0) {
+    return argv.size() == 2;  // single key in the protocol
+  }
+
+  for (size_t i = 0; i < SIZEOFMASS(commands); ++i) {
+    if (strcasecmp(name, commands[i]) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
 }  // namespace
 namespace internal {
 template <>
@@ -800,6 +827,82 @@ common::Error DBConnection::Expire(key_t key, ttl_t ttl) {
   return common::Error();
 }
 
+common::Error DBConnection::ExecuteAsPipeline(const std::vector<FastoObjectCommandIPtr>& cmds,
+                                              void (*log_command_cb)(FastoObjectCommandIPtr command)) {
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  std::vector<FastoObjectCommandIPtr> run;
+  std::vector<std::vector<std::string>> requests;
+  for (size_t i = 0; i <= cmds.size(); ++i) {
+    commands_args_t argv;
+    if (i < cmds.size() && ParseCommandLine(cmds[i]->InputCommand(), &argv) && isPipelineCommand(argv)) {
+      if (log_command_cb) {
+        log_command_cb(cmds[i]);
+      }
+      std::transform(argv[0].begin(), argv[0].end(), argv[0].begin(), ::tolower);
+      requests.push_back(std::vector<std::string>(argv.begin(), argv.end()));
+      run.push_back(cmds[i]);
+      continue;
+    }
+
+    if (!run.empty()) {
+      std::vector<std::vector<std::string>> responses;
+      auto st = connection_.handle_->pipeline(requests, &responses);
+      if (st.error()) {
+        std::string buff = common::MemSPrintf("pipeline function error: %s", st.code());
+        return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+      }
+
+      // every request was answered, the first failed one is the error of the run
+      common::Error first_err;
+      for (size_t j = 0; j < run.size(); ++j) {
+        const std::vector<std::string>& resp = responses[j];
+        if (resp.empty() || resp[0] != "ok") {
+          if (!first_err) {
+            std::string buff = common::MemSPrintf("%s function error: %s", requests[j][0],
+                                                  resp.empty() ? std::string("error") : resp[0]);
+            first_err = common::make_error_value(buff, common::ErrorValue::E_ERROR);
+          }
+          continue;
+        }
+
+        FastoObjectCommand* out = run[j].get();
+        if (resp.size() <= 2) {
+          common::StringValue* val = common::Value::CreateStringValue(resp.size() == 2 ? resp[1] : "OK");
+          out->AddChildren(new FastoObject(out, val, Delimiter()));
+          continue;
+        }
+
+        common::ArrayValue* ar = common::Value::CreateArrayValue();
+        for (size_t k = 1; k < resp.size(); ++k) {
+          ar->Append(common::Value::CreateStringValue(resp[k]));
+        }
+        out->AddChildren(new FastoObjectArray(out, ar, Delimiter()));
+      }
+
+      if (first_err) {
+        return first_err;
+      }
+      run.clear();
+      requests.clear();
+    }
+
+    if (i < cmds.size()) {
+      if (log_command_cb) {
+        log_command_cb(cmds[i]);
+      }
+      common::Error err = Execute(cmds[i]->InputCommand(), cmds[i].get());
+      if (err && err->IsError()) {
+        return err;
+      }
+    }
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::TTL(key_t key, ttl_t* ttl) {
   if (!IsConnected()) {
     return common::make_error_value("Not connected", common::Value::E_ERROR);
@@ -877,21 +980,13 @@ common::Error DBConnection::DBkcountImpl(size_t* size) {
 }
 
 common::Error DBConnection::FlushDBImpl() {
-  std::vector<std::string> ret;
-  auto st = connection_.handle_->keys(std::string(), std::string(), 0, &ret);
+  const std::vector<std::string>* resp = connection_.handle_->request("flushdb");  // server side, no keys listing
+  ::ssdb::Status st(resp);
   if (st.error()) {
     std::string buff = common::MemSPrintf("Flushdb function error: %s", st.code());
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
-  for (size_t i = 0; i < ret.size(); ++i) {
-    key_t key(ret[i]);
-    common::Error err = DelInner(key);
-    if (err && err->IsError()) {
-      return err;
-    }
-  }
-
   return common::Error();
 }
 
@@ -956,6 +1051,30 @@ common::Error DBConnection::SetImpl(const NDbKValue& key, NDbKValue* added_key)
   return common::Error();
 }
 
+common::Error DBConnection::BulkSetImpl(const NDbKValues& keys) {
+  std::map<std::string, std::string> kvs;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    kvs[ConvertToSSDBSlice(keys[i].GetKey().GetKey())] = keys[i].ValueString();
+  }
+
+  common::Error err = MultiSet(kvs);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const NKey cur = keys[i].GetKey();
+    if (cur.GetTTL() > 0) {
+      err = Expire(cur.GetKey(), cur.GetTTL());
+      if (err && err->IsError()) {
+        return err;
+      }
+    }
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
   key_t key_str = key.GetKey();
   std::string value_str;
@@ -989,6 +1108,24 @@ common::Error DBConnection::GetTTLImpl(const NKey& key, ttl_t* ttl) {
   return common::Error();
 }
 
+common::Error DBConnection::ExistsImpl(const NKeys& keys, NKeys* existing_keys) {
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const std::string key_slice = ConvertToSSDBSlice(keys[i].GetKey());
+    const std::vector<std::string>* resp = connection_.handle_->request("exists", key_slice);
+    ::ssdb::Status st(resp);
+    if (st.error() || resp->size() < 2) {
+      std::string buff = common::MemSPrintf("Exists function error: %s", st.code());
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    if ((*resp)[1] == "1") {
+      existing_keys->push_back(keys[i]);
+    }
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::QuitImpl() {
   common::Error err = Disconnect();
   if (err && err->IsError()) {
@@ -34,6 +34,7 @@
 #include "core/db/ssdb/config.h"
 #include "core/db/ssdb/server_info.h"
 #include "core/db_key.h"  // for ttl_t, NKey (ptr only), etc
+#include "core/global.h"  // for FastoObjectCommandIPtr
 
 namespace ssdb {
 class Client;
@@ -139,6 +140,10 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   common::Error Expire(key_t key, ttl_t ttl) WARN_UNUSED_RESULT;
   common::Error TTL(key_t key, ttl_t* ttl) WARN_UNUSED_RESULT;
 
+  // simple key commands are sent together and their replies read after, the rest run through their handlers
+  common::Error ExecuteAsPipeline(const std::vector<FastoObjectCommandIPtr>& cmds,
+                                  void (*log_command_cb)(FastoObjectCommandIPtr)) WARN_UNUSED_RESULT;
+
  private:
   common::Error SetInner(key_t key, const std::string& value) WARN_UNUSED_RESULT;
   common::Error GetInner(key_t key, std::string* ret_val) WARN_UNUSED_RESULT;
@@ -157,11 +162,13 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   virtual common::Error FlushDBImpl() override;
   virtual common::Error SelectImpl(const std::string& name, IDataBaseInfo** info) override;
   virtual common::Error SetImpl(const NDbKValue& key, NDbKValue* added_key) override;
+  virtual common::Error BulkSetImpl(const NDbKValues& keys) override;
   virtual common::Error GetImpl(const NKey& key, NDbKValue* loaded_key) override;
   virtual common::Error DeleteImpl(const NKeys& keys, NKeys* deleted_keys) override;
   virtual common::Error RenameImpl(const NKey& key, string_key_t new_key) override;
   virtual common::Error SetTTLImpl(const NKey& key, ttl_t ttl) override;
   virtual common::Error GetTTLImpl(const NKey& key, ttl_t* ttl) override;
+  virtual common::Error ExistsImpl(const NKeys& keys, NKeys* existing_keys) override;
   virtual common::Error QuitImpl() override;
 };
 
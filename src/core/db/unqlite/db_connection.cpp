@@ -429,6 +429,26 @@ common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
   return common::Error();
 }
 
+common::Error DBConnection::ExistsImpl(const NKeys& keys, NKeys* existing_keys) {
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const string_key_t key_slice = keys[i].GetKey().ToBytes();
+    unqlite_int64 value_size = 0;  // without buffer only the record size is fetched
+    int rc = unqlite_kv_fetch(connection_.handle_, key_slice.data(), key_slice.size(), NULL, &value_size);
+    if (rc == UNQLITE_NOTFOUND) {
+      continue;
+    }
+
+    if (rc != UNQLITE_OK) {
+      std::string buff = common::MemSPrintf("exists function error: %s", unqlite_strerror(rc));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    existing_keys->push_back(keys[i]);
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::RenameImpl(const NKey& key, string_key_t new_key) {
   key_t key_str = key.GetKey();
   std::string value_str;
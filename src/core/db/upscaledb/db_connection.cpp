@@ -302,6 +302,12 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
                                      uint64_t count_keys,
                                      std::vector<std::string>* keys_out,
                                      uint64_t* cursor_out) {
+  std::string last_key;
+  if (cursor_in != 0 && !scan_cursors_.Find(cursor_in, &last_key)) {
+    return internal::MakeInvalidScanCursorError(cursor_in);
+  }
+
+  const std::string prefix = internal::GetKeysPatternPrefix(pattern);
   ups_cursor_t* cursor; /* upscaledb cursor object */
   ups_key_t key;
   ups_record_t rec;
@@ -316,32 +322,50 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
     return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
-  uint64_t offset_pos = cursor_in;
+  /* position cursor on the first key not less than resume point */
+  bool skip_last_key = false;
+  if (cursor_in != 0) {
+    key = ConvertToUpscaleDBSlice(last_key);
+    st = ups_cursor_find(cursor, &key, &rec, UPS_FIND_GEQ_MATCH);
+    skip_last_key = true;
+  } else if (!prefix.empty()) {
+    key = ConvertToUpscaleDBSlice(prefix);
+    st = ups_cursor_find(cursor, &key, &rec, UPS_FIND_GEQ_MATCH);
+  } else {
+    st = ups_cursor_move(cursor, &key, &rec, UPS_CURSOR_FIRST | UPS_SKIP_DUPLICATES);
+  }
+
   uint64_t lcursor_out = 0;
   std::vector<std::string> lkeys_out;
   while (st == UPS_SUCCESS) {
-    if (lkeys_out.size() < count_keys) {
-      /* fetch the next item, and repeat till we've reached the end
-       * of the database */
-      st = ups_cursor_move(cursor, &key, &rec, UPS_CURSOR_NEXT | UPS_SKIP_DUPLICATES);
-      if (st == UPS_SUCCESS) {
-        std::string skey(reinterpret_cast<const char*>(key.data), key.size);
-        if (common::MatchPattern(skey, pattern)) {
-          if (offset_pos == 0) {
-            lkeys_out.push_back(skey);
-          } else {
-            offset_pos--;
-          }
-        }
-      } else if (st && st != UPS_KEY_NOT_FOUND) {
-        ups_cursor_close(cursor);
-        std::string buff = common::MemSPrintf("SCAN function error: %s", ups_strerror(st));
-        return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    std::string skey(reinterpret_cast<const char*>(key.data), key.size);
+    const bool already_returned = skip_last_key && skey == last_key;  // on previous page
+    skip_last_key = false;
+    if (!already_returned) {
+      if (!internal::IsKeyHasPrefix(skey, prefix)) {
+        break;
+      }
+
+      if (lkeys_out.size() >= count_keys) {
+        lcursor_out = scan_cursors_.Save(last_key);
+        break;
+      }
+
+      if (common::MatchPattern(skey, pattern)) {
+        lkeys_out.push_back(skey);
       }
-    } else {
-      lcursor_out = cursor_in + count_keys;
-      break;
+      last_key = skey;
     }
+
+    /* fetch the next item, and repeat till we've reached the end
+     * of the database */
+    st = ups_cursor_move(cursor, &key, &rec, UPS_CURSOR_NEXT | UPS_SKIP_DUPLICATES);
+  }
+
+  if (st != UPS_SUCCESS && st != UPS_KEY_NOT_FOUND) {
+    ups_cursor_close(cursor);
+    std::string buff = common::MemSPrintf("SCAN function error: %s", ups_strerror(st));
+    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
   }
 
   ups_cursor_close(cursor);
@@ -483,15 +507,44 @@ common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
   return common::Error();
 }
 
+common::Error DBConnection::ExistsImpl(const NKeys& keys, NKeys* existing_keys) {
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const string_key_t key_str = keys[i].GetKey().ToBytes();
+    ups_key_t key_slice = ConvertToUpscaleDBSlice(key_str);
+    ups_record_t rec;
+    memset(&rec, 0, sizeof(rec));
+    ups_status_t st = ups_db_find(connection_.handle_->db, NULL, &key_slice, &rec, 0);
+    if (st == UPS_KEY_NOT_FOUND) {
+      continue;
+    }
+
+    if (st != UPS_SUCCESS) {
+      std::string buff = common::MemSPrintf("EXISTS function error: %s", ups_strerror(st));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
+    existing_keys->push_back(keys[i]);
+  }
+
+  return common::Error();
+}
+
 common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
+  // environment opened without UPS_ENABLE_TRANSACTIONS, so erase directly without extra existence lookups
   for (size_t i = 0; i < keys.size(); ++i) {
     NKey key = keys[i];
-    key_t key_str = key.GetKey();
-    common::Error err = DelInner(key_str);
-    if (err && err->IsError()) {
+    const string_key_t key_str = key.GetKey().ToBytes();
+    ups_key_t key_slice = ConvertToUpscaleDBSlice(key_str);
+    ups_status_t st = ups_db_erase(connection_.handle_->db, 0, &key_slice, 0);
+    if (st == UPS_KEY_NOT_FOUND) {
       continue;
     }
 
+    if (st != UPS_SUCCESS) {
+      std::string buff = common::MemSPrintf("DEL function error: %s", ups_strerror(st));
+      return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+    }
+
     deleted_keys->push_back(key);
   }
 
@@ -18,11 +18,9 @@
 
 #include "core/icommand_translator.h"
 
+#include <algorithm>  // for count, max
 #include <sstream>
-
-extern "C" {
-#include "sds.h"
-}
+#include <utility>  // for make_pair, move
 
 #include <common/convert2string.h>
 #include <common/sprintf.h>
@@ -31,6 +29,14 @@ extern "C" {
 
 #include "core/types.h"
 
+namespace {
+void AppendLowerCase(const std::string& word, std::string* out) {
+  for (char c : word) {
+    out->push_back((c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c);
+  }
+}
+}  // namespace
+
 namespace fastonosql {
 namespace core {
 
@@ -46,19 +52,28 @@ common::Error ParseCommands(const command_buffer_t& cmd, std::vector<command_buf
   }
 
   std::vector<command_buffer_t> stable_commands;
-  for (command_buffer_t input : commands) {
+  for (const command_buffer_t& input : commands) {
     command_buffer_t stable_input = StableCommand(input);
     if (stable_input.empty()) {
       continue;
     }
-    stable_commands.push_back(stable_input);
+    stable_commands.push_back(std::move(stable_input));
   }
 
-  *cmds = stable_commands;
+  cmds->swap(stable_commands);
   return common::Error();
 }
 
-ICommandTranslator::ICommandTranslator(const std::vector<CommandHolder>& commands) : commands_(commands) {}
+ICommandTranslator::ICommandTranslator(const std::vector<CommandHolder>& commands)
+    : commands_(commands), commands_index_(), max_command_words_(0) {
+  for (size_t i = 0; i < commands_.size(); ++i) {
+    std::string name;
+    AppendLowerCase(commands_[i].name, &name);
+    commands_index_.insert(std::make_pair(name, i));  // first one in table order wins
+    const size_t words = std::count(name.begin(), name.end(), ' ') + 1;
+    max_command_words_ = std::max(max_command_words_, words);
+  }
+}
 
 ICommandTranslator::~ICommandTranslator() {}
 
@@ -139,37 +154,23 @@ bool ICommandTranslator::IsLoadKeyCommand(const command_buffer_t& cmd, string_ke
     return false;
   }
 
-  command_buffer_t stabled_command = StableCommand(cmd);
-  if (stabled_command.empty()) {
-    return false;
-  }
-
-  int argc;
-  sds* argv = sdssplitargslong(stabled_command.data(), &argc);
-  if (!argv) {
-    return false;
-  }
-
   commands_args_t standart_argv;
-  for (int i = 0; i < argc; ++i) {
-    standart_argv.push_back(command_buffer_t(argv[i], sdslen(argv[i])));
+  if (!ParseCommandLine(cmd, &standart_argv)) {
+    return false;
   }
 
   const CommandHolder* cmdh = nullptr;
   size_t off = 0;
   common::Error err = TestCommandLineArgs(standart_argv, &cmdh, &off);
   if (err && err->IsError()) {
-    sdsfreesplitres(argv, argc);
     return false;
   }
 
   if (IsLoadKeyCommandImpl(*cmdh)) {
-    *key = command_buffer_t(argv[off], strlen(argv[off]));
-    sdsfreesplitres(argv, argc);
+    *key = standart_argv[off];
     return true;
   }
 
-  sdsfreesplitres(argv, argc);
   return false;
 }
 
@@ -201,7 +202,7 @@ common::Error ICommandTranslator::NotSupported(const std::string& cmd) {
   return common::make_error_value(buff, common::ErrorValue::E_ERROR);
 }
 
-common::Error ICommandTranslator::UnknownSequence(commands_args_t argv) {
+common::Error ICommandTranslator::UnknownSequence(const commands_args_t& argv) {
   std::string result;
   for (size_t i = 0; i < argv.size(); ++i) {
     result += common::ConvertToString(argv[i]);
@@ -222,25 +223,45 @@ std::vector<CommandInfo> ICommandTranslator::Commands() const {
   return cmds;
 }
 
-common::Error ICommandTranslator::FindCommand(commands_args_t argv, const CommandHolder** info, size_t* off) const {
+common::Error ICommandTranslator::FindCommand(const commands_args_t& argv,
+                                              const CommandHolder** info,
+                                              size_t* off) const {
   if (!info || !off) {
     return common::make_inval_error_value(common::ErrorValue::E_ERROR);
   }
 
-  for (size_t i = 0; i < commands_.size(); ++i) {
-    const CommandHolder* cmd = &commands_[i];
-    size_t loff = 0;
-    if (cmd->IsCommand(argv, &loff)) {
-      *info = cmd;
-      *off = loff;
-      return common::Error();
+  if (argv.empty()) {
+    return UnknownSequence(argv);
+  }
+
+  // look up every word prefix of argv by full name, the one earliest in the table matches like a linear scan would
+  const CommandHolder* cmd = nullptr;
+  size_t cmd_pos = commands_.size();
+  size_t cmd_off = 0;
+  std::string name;
+  for (size_t words = 1; words <= max_command_words_ && words <= argv.size(); ++words) {
+    if (words > 1) {
+      name.push_back(' ');
+    }
+    AppendLowerCase(argv[words - 1], &name);
+    auto found = commands_index_.find(name);
+    if (found != commands_index_.end() && found->second < cmd_pos) {
+      cmd_pos = found->second;
+      cmd = &commands_[cmd_pos];
+      cmd_off = words;
     }
   }
 
-  return UnknownSequence(argv);
+  if (!cmd) {
+    return UnknownSequence(argv);
+  }
+
+  *info = cmd;
+  *off = cmd_off;
+  return common::Error();
 }
 
-common::Error ICommandTranslator::TestCommandArgs(const CommandHolder* cmd, commands_args_t argv) const {
+common::Error ICommandTranslator::TestCommandArgs(const CommandHolder* cmd, const commands_args_t& argv) const {
   if (!cmd) {
     return common::make_inval_error_value(common::ErrorValue::E_ERROR);
   }
@@ -249,33 +270,17 @@ common::Error ICommandTranslator::TestCommandArgs(const CommandHolder* cmd, comm
 }
 
 common::Error ICommandTranslator::TestCommandLine(const command_buffer_t& cmd) const {
-  command_buffer_t stabled_command = StableCommand(cmd);
-  if (stabled_command.empty()) {
-    return common::make_inval_error_value(common::ErrorValue::E_ERROR);
-  }
-
-  int argc;
-  sds* argv = sdssplitargslong(stabled_command.data(), &argc);
-  if (!argv) {
+  commands_args_t standart_argv;
+  if (!ParseCommandLine(cmd, &standart_argv)) {
     return common::make_inval_error_value(common::ErrorValue::E_ERROR);
   }
 
-  commands_args_t standart_argv;
-  for (int i = 0; i < argc; ++i) {
-    standart_argv.push_back(command_buffer_t(argv[i], sdslen(argv[i])));
-  }
   const CommandHolder* cmdh = nullptr;
   size_t loff = 0;
-  common::Error err = TestCommandLineArgs(standart_argv, &cmdh, &loff);
-  if (err && err->IsError()) {
-    sdsfreesplitres(argv, argc);
-    return err;
-  }
-
-  return common::Error();
+  return TestCommandLineArgs(standart_argv, &cmdh, &loff);
 }
 
-common::Error ICommandTranslator::TestCommandLineArgs(commands_args_t argv,
+common::Error ICommandTranslator::TestCommandLineArgs(const commands_args_t& argv,
                                                       const CommandHolder** info,
                                                       size_t* off) const {
   const CommandHolder* cmd = nullptr;
@@ -285,10 +290,7 @@ common::Error ICommandTranslator::TestCommandLineArgs(commands_args_t argv,
     return err;
   }
 
-  commands_args_t stabled;
-  for (size_t i = loff; i < argv.size(); ++i) {
-    stabled.push_back(argv[i]);
-  }
+  const commands_args_t stabled(argv.begin() + loff, argv.end());
   err = TestCommandArgs(cmd, stabled);
   if (err && err->IsError()) {
     return err;
@@ -18,8 +18,10 @@
 
 #pragma once
 
-#include <memory>  // for shared_ptr
-#include <string>  // for string
+#include <memory>         // for shared_ptr
+#include <string>         // for string
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
 
 #include <common/error.h>  // for Error
 
@@ -69,17 +71,19 @@ class ICommandTranslator {
   common::Error SubscribeCommand(const NDbPSChannel& channel, command_buffer_t* cmdstring) const WARN_UNUSED_RESULT;
 
   std::vector<CommandInfo> Commands() const;
-  common::Error FindCommand(commands_args_t argv, const CommandHolder** info, size_t* off) const WARN_UNUSED_RESULT;
+  common::Error FindCommand(const commands_args_t& argv,
+                            const CommandHolder** info,
+                            size_t* off) const WARN_UNUSED_RESULT;
 
-  common::Error TestCommandArgs(const CommandHolder* cmd, commands_args_t argv) const WARN_UNUSED_RESULT;
+  common::Error TestCommandArgs(const CommandHolder* cmd, const commands_args_t& argv) const WARN_UNUSED_RESULT;
   common::Error TestCommandLine(const command_buffer_t& cmd) const WARN_UNUSED_RESULT;
-  common::Error TestCommandLineArgs(commands_args_t argv,
+  common::Error TestCommandLineArgs(const commands_args_t& argv,
                                     const CommandHolder** info,
                                     size_t* off) const WARN_UNUSED_RESULT;
 
   static common::Error InvalidInputArguments(const std::string& cmd);
   static common::Error NotSupported(const std::string& cmd);
-  static common::Error UnknownSequence(commands_args_t argv);
+  static common::Error UnknownSequence(const commands_args_t& argv);
 
  private:
   virtual common::Error CreateKeyCommandImpl(const NDbKValue& key, command_buffer_t* cmdstring) const = 0;
@@ -99,7 +103,12 @@ class ICommandTranslator {
 
   virtual bool IsLoadKeyCommandImpl(const CommandInfo& cmd) const = 0;
 
+  // lower cased full command name -> position of its first occurrence in commands_
+  typedef std::unordered_map<std::string, size_t> commands_index_t;
+
   const std::vector<CommandHolder> commands_;
+  commands_index_t commands_index_;
+  size_t max_command_words_;
 };
 
 typedef std::shared_ptr<ICommandTranslator> translator_t;
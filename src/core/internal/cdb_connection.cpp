@@ -23,6 +23,8 @@
 #include <common/convert2string.h>
 
 #define GET_KEYS_PATTERN_3ARGS_ISI "SCAN %" PRIu64 " MATCH %s COUNT %" PRIu64
+#define MAX_SCAN_CURSORS 1024
+#define GLOB_SPECIAL_CHARS "*?[\\"
 
 namespace fastonosql {
 namespace core {
@@ -38,6 +40,67 @@ command_buffer_t GetKeysPattern(uint64_t cursor_in, const std::string& pattern,
   return wr.str();
 }
 
+std::string GetKeysPatternPrefix(const std::string& pattern) {
+  size_t pos = pattern.find_first_of(GLOB_SPECIAL_CHARS);
+  if (pos == std::string::npos) {
+    return pattern;
+  }
+
+  return pattern.substr(0, pos);
+}
+
+bool IsKeyHasPrefix(const std::string& key, const std::string& prefix) {
+  return key.size() >= prefix.size() && key.compare(0, prefix.size(), prefix) == 0;
+}
+
+ScanCursorCache::ScanCursorCache() : positions_(), next_cursor_(1) {}
+
+uint64_t ScanCursorCache::Save(const std::string& last_key, scan_snapshot_t snapshot) {
+  const uint64_t cursor = next_cursor_++;
+  if (next_cursor_ == 0) {  // zero cursor reserved for start/end of iteration
+    next_cursor_ = 1;
+  }
+
+  Position& pos = positions_[cursor];
+  pos.last_key = last_key;
+  pos.snapshot = snapshot;
+  while (positions_.size() > MAX_SCAN_CURSORS) {  // drop oldest abandoned iterations
+    positions_.erase(positions_.begin());
+  }
+  return cursor;
+}
+
+bool ScanCursorCache::Find(uint64_t cursor, std::string* last_key, scan_snapshot_t* snapshot) const {
+  if (!last_key) {
+    DNOTREACHED();
+    return false;
+  }
+
+  auto it = positions_.find(cursor);
+  if (it == positions_.end()) {
+    return false;
+  }
+
+  *last_key = it->second.last_key;
+  if (snapshot) {
+    *snapshot = it->second.snapshot;
+  }
+  return true;
+}
+
+void ScanCursorCache::Erase(uint64_t cursor) {
+  positions_.erase(cursor);
+}
+
+void ScanCursorCache::Clear() {
+  positions_.clear();
+}
+
+common::Error MakeInvalidScanCursorError(uint64_t cursor) {
+  std::string buff = common::MemSPrintf("Invalid or expired SCAN cursor: %" PRIu64, cursor);
+  return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+}
+
 }  // namespace internal
 }  // namespace core
 }  // namespace fastonosql
@@ -21,6 +21,10 @@
 #include <inttypes.h>
 #include <stddef.h>  // for size_t
 #include <stdint.h>  // for uint64_t, UINT64_MAX
+#include <map>       // for map
+#include <memory>    // for shared_ptr
+#include <set>       // for set
+#include <string>    // for string
 #include <vector>    // for vector
 
 #include <common/error.h>   // for Error, make_error_value
@@ -30,6 +34,7 @@
 
 #include "core/command_info.h"
 #include "core/connection_types.h"     // for connectionTypes
+#include "core/data_dump.h"            // for walk_callback_t
 #include "core/db_key.h"               // for NDbKValue, NKey, etc
 #include "core/icommand_translator.h"  // for translator_t, etc
 
@@ -42,6 +47,7 @@
 #define ALL_COMMANDS "*"
 #define ALL_KEYS_PATTERNS "*"
 #define NO_KEYS_LIMIT UINT64_MAX
+#define WALK_KEYS_PAGE_SIZE 1000
 
 namespace fastonosql {
 namespace core {
@@ -71,6 +77,37 @@ class ConstantCommandsArray : public std::vector<CommandHolder> {
 };
 
 command_buffer_t GetKeysPattern(uint64_t cursor_in, const std::string& pattern, uint64_t count_keys);  // for SCAN
+std::string GetKeysPatternPrefix(const std::string& pattern);  // longest literal prefix of glob pattern
+bool IsKeyHasPrefix(const std::string& key, const std::string& prefix);
+
+// engine snapshot of one SCAN pagination, the deleter releases it
+typedef std::shared_ptr<const void> scan_snapshot_t;
+
+// SCAN cursors of ordered local engines are opaque tokens of the last returned key,
+// so next page seeks directly to it instead of rescanning keyspace from the first key.
+// Every cursor keeps the snapshot of its pagination, so the snapshot lives until the
+// pagination ends or its cursor is evicted.
+class ScanCursorCache {
+ public:
+  ScanCursorCache();
+
+  uint64_t Save(const std::string& last_key,
+                scan_snapshot_t snapshot = scan_snapshot_t());  // returns new not zero cursor
+  bool Find(uint64_t cursor, std::string* last_key, scan_snapshot_t* snapshot = nullptr) const;
+  void Erase(uint64_t cursor);  // cursor was used up by the next page
+  void Clear();
+
+ private:
+  struct Position {
+    std::string last_key;
+    scan_snapshot_t snapshot;
+  };
+
+  std::map<uint64_t, Position> positions_;
+  uint64_t next_cursor_;
+};
+
+common::Error MakeInvalidScanCursorError(uint64_t cursor) WARN_UNUSED_RESULT;
 
 template <typename NConnection, typename Config, connectionTypes ContType>
 class CDBConnection : public DBConnection<NConnection, Config, ContType>,
@@ -99,18 +136,28 @@ class CDBConnection : public DBConnection<NConnection, Config, ContType>,
                      uint64_t limit,
                      std::vector<std::string>* ret) WARN_UNUSED_RESULT;                    // nvi
   common::Error DBkcount(size_t* size) WARN_UNUSED_RESULT;                                 // nvi
+  common::Error DBkcountEstimate(size_t* size, bool* is_exact) WARN_UNUSED_RESULT;         // nvi
   common::Error FlushDB() WARN_UNUSED_RESULT;                                              // nvi
   common::Error Select(const std::string& name, IDataBaseInfo** info) WARN_UNUSED_RESULT;  // nvi
   common::Error Delete(const NKeys& keys, NKeys* deleted_keys) WARN_UNUSED_RESULT;         // nvi
   common::Error Set(const NDbKValue& key, NDbKValue* added_key) WARN_UNUSED_RESULT;        // nvi
+  common::Error BulkSet(const NDbKValues& keys) WARN_UNUSED_RESULT;                        // nvi, for import
+  common::Error Walk(const std::string& position, walk_callback_t cb) WARN_UNUSED_RESULT;  // nvi, for backup
   common::Error Get(const NKey& key, NDbKValue* loaded_key) WARN_UNUSED_RESULT;            // nvi
   common::Error Rename(const NKey& key, const string_key_t& new_key) WARN_UNUSED_RESULT;   // nvi
   common::Error SetTTL(const NKey& key, ttl_t ttl) WARN_UNUSED_RESULT;                     // nvi
   common::Error GetTTL(const NKey& key, ttl_t* ttl) WARN_UNUSED_RESULT;                    // nvi
+  common::Error Exists(const NKeys& keys, NKeys* existing_keys) WARN_UNUSED_RESULT;        // nvi, for keys cache
   common::Error Quit() WARN_UNUSED_RESULT;                                                 // nvi
+  // reads see one point in time until released, a new snapshot replaces the previous one
+  common::Error CreateSnapshot() WARN_UNUSED_RESULT;   // nvi
+  common::Error ReleaseSnapshot() WARN_UNUSED_RESULT;  // nvi
 
  protected:
+  void NotifyProgress(int value);
+
   CDBConnectionClient* client_;
+  ScanCursorCache scan_cursors_;
 
  private:
   virtual common::Error ScanImpl(uint64_t cursor_in,
@@ -123,15 +170,23 @@ class CDBConnection : public DBConnection<NConnection, Config, ContType>,
                                  uint64_t limit,
                                  std::vector<std::string>* ret) = 0;
   virtual common::Error DBkcountImpl(size_t* size) = 0;
+  virtual common::Error DBkcountEstimateImpl(size_t* size, bool* is_exact);  // exact DBkcountImpl by default
   virtual common::Error FlushDBImpl() = 0;
   virtual common::Error SelectImpl(const std::string& name, IDataBaseInfo** info) = 0;
   virtual common::Error DeleteImpl(const NKeys& keys, NKeys* deleted_keys) = 0;
   virtual common::Error SetImpl(const NDbKValue& key, NDbKValue* added_key) = 0;
+  virtual common::Error BulkSetImpl(const NDbKValues& keys);  // SetImpl one by one by default
+  // ScanImpl pages and GetImpl by default, without resume positions
+  virtual common::Error WalkImpl(const std::string& position, walk_callback_t cb);
   virtual common::Error GetImpl(const NKey& key, NDbKValue* loaded_key) = 0;
   virtual common::Error RenameImpl(const NKey& key, string_key_t new_key) = 0;
   virtual common::Error SetTTLImpl(const NKey& key, ttl_t ttl) = 0;
   virtual common::Error GetTTLImpl(const NKey& key, ttl_t* ttl) = 0;
+  // engines tell missing keys from failed lookups, not supported by default
+  virtual common::Error ExistsImpl(const NKeys& keys, NKeys* existing_keys);
   virtual common::Error QuitImpl() = 0;
+  virtual common::Error CreateSnapshotImpl();  // not supported by default
+  virtual common::Error ReleaseSnapshotImpl();
 };
 
 template <typename NConnection, typename Config, connectionTypes ContType>
@@ -249,6 +304,38 @@ common::Error CDBConnection<NConnection, Config, ContType>::DBkcount(size_t* siz
   return common::Error();
 }
 
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::DBkcountEstimate(size_t* size, bool* is_exact) {
+  if (!size || !is_exact) {
+    DNOTREACHED();
+    return common::make_inval_error_value(common::ErrorValue::E_ERROR);
+  }
+
+  if (!CDBConnection<NConnection, Config, ContType>::IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  common::Error err = DBkcountEstimateImpl(size, is_exact);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  return common::Error();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::DBkcountEstimateImpl(size_t* size, bool* is_exact) {
+  *is_exact = true;
+  return DBkcountImpl(size);
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+void CDBConnection<NConnection, Config, ContType>::NotifyProgress(int value) {
+  if (client_) {
+    client_->OnProgressChanged(value);
+  }
+}
+
 template <typename NConnection, typename Config, connectionTypes ContType>
 common::Error CDBConnection<NConnection, Config, ContType>::FlushDB() {
   if (!CDBConnection<NConnection, Config, ContType>::IsConnected()) {
@@ -279,6 +366,8 @@ common::Error CDBConnection<NConnection, Config, ContType>::Select(const std::st
     return err;
   }
 
+  scan_cursors_.Clear();
+
   if (client_) {
     client_->OnCurrentDataBaseChanged(linfo);
   }
@@ -303,7 +392,16 @@ common::Error CDBConnection<NConnection, Config, ContType>::Delete(const NKeys&
     return common::make_error_value("Not connected", common::Value::E_ERROR);
   }
 
-  common::Error err = DeleteImpl(keys, deleted_keys);
+  // engines build one batch from the keys, a key repeated in the request must be deleted and reported once
+  NKeys unique_keys;
+  std::set<string_key_t> seen_keys;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (seen_keys.insert(keys[i].GetKey().ToBytes()).second) {
+      unique_keys.push_back(keys[i]);
+    }
+  }
+
+  common::Error err = DeleteImpl(unique_keys, deleted_keys);
   if (err && err->IsError()) {
     return err;
   }
@@ -338,6 +436,89 @@ common::Error CDBConnection<NConnection, Config, ContType>::Set(const NDbKValue&
   return common::Error();
 }
 
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::BulkSet(const NDbKValues& keys) {
+  if (!CDBConnection<NConnection, Config, ContType>::IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  if (keys.empty()) {
+    return common::Error();
+  }
+
+  // no per key notifications, an import can be millions of keys
+  common::Error err = BulkSetImpl(keys);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  return common::Error();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::BulkSetImpl(const NDbKValues& keys) {
+  for (size_t i = 0; i < keys.size(); ++i) {
+    NDbKValue added_key;
+    common::Error err = SetImpl(keys[i], &added_key);
+    if (err && err->IsError()) {
+      return err;
+    }
+  }
+
+  return common::Error();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::Walk(const std::string& position, walk_callback_t cb) {
+  if (!cb) {
+    DNOTREACHED();
+    return common::make_inval_error_value(common::ErrorValue::E_ERROR);
+  }
+
+  if (!CDBConnection<NConnection, Config, ContType>::IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  // no per key notifications, same as BulkSet
+  common::Error err = WalkImpl(position, cb);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  return common::Error();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::WalkImpl(const std::string& position,
+                                                                     walk_callback_t cb) {
+  UNUSED(position);
+  uint64_t cursor = 0;
+  do {
+    std::vector<std::string> keys;
+    uint64_t next_cursor = 0;
+    common::Error err = ScanImpl(cursor, ALL_KEYS_PATTERNS, WALK_KEYS_PAGE_SIZE, &keys, &next_cursor);
+    if (err && err->IsError()) {
+      return err;
+    }
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+      NDbKValue record;
+      err = GetImpl(NKey(key_t(keys[i])), &record);
+      if (err && err->IsError()) {  // removed since scan
+        continue;
+      }
+
+      err = cb(record, std::string());
+      if (err && err->IsError()) {
+        return err;
+      }
+    }
+    cursor = next_cursor;
+  } while (cursor != 0);
+
+  return common::Error();
+}
+
 template <typename NConnection, typename Config, connectionTypes ContType>
 common::Error CDBConnection<NConnection, Config, ContType>::Get(const NKey& key, NDbKValue* loaded_key) {
   if (!loaded_key) {
@@ -419,6 +600,37 @@ common::Error CDBConnection<NConnection, Config, ContType>::GetTTL(const NKey& k
   return common::Error();
 }
 
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::Exists(const NKeys& keys, NKeys* existing_keys) {
+  if (!existing_keys) {
+    DNOTREACHED();
+    return common::make_inval_error_value(common::ErrorValue::E_ERROR);
+  }
+
+  if (!CDBConnection<NConnection, Config, ContType>::IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  // no per key notifications, the keys are only checked, not loaded
+  NKeys existing;
+  common::Error err = ExistsImpl(keys, &existing);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  *existing_keys = existing;
+  return common::Error();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::ExistsImpl(const NKeys& keys, NKeys* existing_keys) {
+  UNUSED(keys);
+  UNUSED(existing_keys);
+  return common::make_error_value(
+      common::MemSPrintf("Existence checks aren't supported by %s", connection_traits_class::BasedOn()),
+      common::ErrorValue::E_ERROR);
+}
+
 template <typename NConnection, typename Config, connectionTypes ContType>
 common::Error CDBConnection<NConnection, Config, ContType>::Quit() {
   if (!CDBConnection<NConnection, Config, ContType>::IsConnected()) {
@@ -436,6 +648,48 @@ common::Error CDBConnection<NConnection, Config, ContType>::Quit() {
 
   return common::Error();
 }
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::CreateSnapshot() {
+  if (!CDBConnection<NConnection, Config, ContType>::IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  common::Error err = CreateSnapshotImpl();
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  return common::Error();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::ReleaseSnapshot() {
+  if (!CDBConnection<NConnection, Config, ContType>::IsConnected()) {
+    return common::make_error_value("Not connected", common::Value::E_ERROR);
+  }
+
+  common::Error err = ReleaseSnapshotImpl();
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  return common::Error();
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::CreateSnapshotImpl() {
+  return common::make_error_value(
+      common::MemSPrintf("Snapshots aren't supported by %s", connection_traits_class::BasedOn()),
+      common::ErrorValue::E_ERROR);
+}
+
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::ReleaseSnapshotImpl() {
+  return common::make_error_value(
+      common::MemSPrintf("Snapshots aren't supported by %s", connection_traits_class::BasedOn()),
+      common::ErrorValue::E_ERROR);
+}
 }  // namespace internal
 }  // namespace core
 }  // namespace fastonosql
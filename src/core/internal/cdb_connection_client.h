@@ -42,6 +42,7 @@ class CDBConnectionClient {
   virtual void OnKeyTTLChanged(const NKey& key, ttl_t ttl) = 0;
   virtual void OnKeyTTLLoaded(const NKey& key, ttl_t ttl) = 0;
   virtual void OnQuited() = 0;
+  virtual void OnProgressChanged(int value) = 0;  // long running commands, value in [0, 100]
   virtual ~CDBConnectionClient();
 };
 
@@ -21,15 +21,14 @@
 #include <stddef.h>  // for size_t
 #include <stdint.h>  // for uint16_t
 
-#include <string>  // for string
-
-extern "C" {
-#include "sds.h"
-}
+#include <string>   // for string
+#include <utility>  // for move
 
 #include <common/utils.h>
 #include <common/value.h>  // for ErrorValue, etc
 
+#include "core/types.h"  // for ParseCommandLine
+
 namespace fastonosql {
 namespace core {
 namespace internal {
@@ -37,40 +36,30 @@ namespace internal {
 CommandHandler::CommandHandler(ICommandTranslator* translator) : translator_(translator) {}
 
 common::Error CommandHandler::Execute(const command_buffer_t& command, FastoObject* out) {
-  command_buffer_t stabled_command = StableCommand(command);
-  if (stabled_command.empty()) {
-    return common::make_inval_error_value(common::ErrorValue::E_ERROR);
-  }
-
-  int argc;
-  sds* argv = sdssplitargslong(stabled_command.data(), &argc);
-  if (!argv) {
+  commands_args_t argv;
+  if (!ParseCommandLine(command, &argv)) {
     return common::make_inval_error_value(common::ErrorValue::E_ERROR);
   }
 
-  commands_args_t argvv;
-  for (int i = 0; i < argc; ++i) {
-    std::string str(argv[i], sdslen(argv[i]));
-    argvv.push_back(str);
-  }
-  common::Error err = Execute(argvv, out);
-  sdsfreesplitres(argv, argc);
-  return err;
+  return Execute(std::move(argv), out);
 }
 
 common::Error CommandHandler::Execute(commands_args_t argv, FastoObject* out) {
   const command_t* cmd = nullptr;
   size_t off = 0;
-  common::Error err = translator_->TestCommandLineArgs(argv, &cmd, &off);
+  common::Error err = translator_->FindCommand(argv, &cmd, &off);
   if (err && err->IsError()) {
     return err;
   }
 
-  commands_args_t stabled;
-  for (size_t i = off; i < argv.size(); ++i) {
-    stabled.push_back(argv[i]);
+  // drop command name in place and hand arguments over without copying them
+  argv.erase(argv.begin(), argv.begin() + off);
+  err = translator_->TestCommandArgs(cmd, argv);
+  if (err && err->IsError()) {
+    return err;
   }
-  return cmd->func_(this, stabled, out);
+
+  return cmd->func_(this, std::move(argv), out);
 }
 
 }  // namespace internal
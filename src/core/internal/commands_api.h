@@ -62,6 +62,8 @@ struct ApiTraits {
   static common::Error SetTTL(CommandHandler* handler, commands_args_t argv, FastoObject* out);
   static common::Error GetTTL(CommandHandler* handler, commands_args_t argv, FastoObject* out);
   static common::Error Quit(CommandHandler* handler, commands_args_t argv, FastoObject* out);
+  static common::Error CreateSnapshot(CommandHandler* handler, commands_args_t argv, FastoObject* out);
+  static common::Error ReleaseSnapshot(CommandHandler* handler, commands_args_t argv, FastoObject* out);
 };
 
 template <class CDBConnection>
@@ -351,6 +353,42 @@ common::Error ApiTraits<CDBConnection>::Quit(internal::CommandHandler* handler,
   return common::Error();
 }
 
+template <class CDBConnection>
+common::Error ApiTraits<CDBConnection>::CreateSnapshot(internal::CommandHandler* handler,
+                                                       commands_args_t argv,
+                                                       FastoObject* out) {
+  UNUSED(argv);
+
+  CDBConnection* cdb = static_cast<CDBConnection*>(handler);
+  common::Error err = cdb->CreateSnapshot();
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  common::StringValue* val = common::Value::CreateStringValue("OK");
+  FastoObject* child = new FastoObject(out, val, cdb->Delimiter());
+  out->AddChildren(child);
+  return common::Error();
+}
+
+template <class CDBConnection>
+common::Error ApiTraits<CDBConnection>::ReleaseSnapshot(internal::CommandHandler* handler,
+                                                        commands_args_t argv,
+                                                        FastoObject* out) {
+  UNUSED(argv);
+
+  CDBConnection* cdb = static_cast<CDBConnection*>(handler);
+  common::Error err = cdb->ReleaseSnapshot();
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  common::StringValue* val = common::Value::CreateStringValue("OK");
+  FastoObject* child = new FastoObject(out, val, cdb->Delimiter());
+  out->AddChildren(child);
+  return common::Error();
+}
+
 }  // namespace internal
 }  // namespace core
 }  // namespace fastonosql
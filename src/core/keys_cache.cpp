@@ -0,0 +1,338 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "core/keys_cache.h"
+
+#include <map>  // for map
+
+#include "core/binary_coding.h"  // for PutVarint, GetVarint
+#include "core/mapped_file.h"    // for MappedFile
+
+#define KEYS_CACHE_MAGIC "FNSK"
+#define KEYS_CACHE_VERSION 1
+#define KEYS_CACHE_HEADER_SIZE 12  // magic, version, connection type
+
+namespace fastonosql {
+namespace core {
+namespace {
+
+enum RecordType { PUT_RECORD = 1, REMOVE_RECORD = 2, RESET_RECORD = 3 };
+
+typedef std::map<std::string, KeysCacheEntry> db_entries_t;  // raw key -> entry
+typedef std::map<std::string, db_entries_t> databases_entries_t;
+
+std::string makeHeader(connectionTypes type) {
+  std::string header(KEYS_CACHE_MAGIC);
+  PutFixed32(KEYS_CACHE_VERSION, &header);
+  PutFixed32(static_cast<uint32_t>(type), &header);
+  return header;
+}
+
+bool isValidHeader(const uint8_t* data, size_t size, connectionTypes type) {
+  const std::string header = makeHeader(type);
+  return size >= KEYS_CACHE_HEADER_SIZE && header.compare(0, header.size(), reinterpret_cast<const char*>(data),
+                                                          KEYS_CACHE_HEADER_SIZE) == 0;
+}
+
+std::string makeRecordPrefix(RecordType rtype, const std::string& db, size_t count) {
+  std::string record;
+  record.push_back(static_cast<char>(rtype));
+  PutVarint(db.size(), &record);
+  record += db;
+  PutVarint(count, &record);
+  return record;
+}
+
+void putEntry(const KeysCacheEntry& entry, std::string* out) {
+  PutVarint(entry.key.size(), out);
+  *out += entry.key;
+  out->push_back(static_cast<char>(entry.type));
+  PutVarint(ZigzagEncode(entry.ttl), out);
+  PutVarint(entry.size, out);
+  PutVarint(ZigzagEncode(entry.loaded_msec), out);
+}
+
+bool getBytes(const uint8_t** data, const uint8_t* end, std::string* out) {
+  uint64_t size = 0;
+  if (!GetVarint(data, end, &size) || size > static_cast<uint64_t>(end - *data)) {
+    return false;
+  }
+
+  out->assign(reinterpret_cast<const char*>(*data), size);
+  *data += size;
+  return true;
+}
+
+bool getEntry(const uint8_t** data, const uint8_t* end, KeysCacheEntry* entry) {
+  if (!getBytes(data, end, &entry->key) || *data == end) {
+    return false;
+  }
+
+  entry->type = static_cast<common::Value::Type>(**data);
+  ++(*data);
+  uint64_t ttl = 0;
+  uint64_t size = 0;
+  uint64_t loaded = 0;
+  if (!GetVarint(data, end, &ttl) || !GetVarint(data, end, &size) || !GetVarint(data, end, &loaded)) {
+    return false;
+  }
+
+  entry->ttl = ZigzagDecode(ttl);
+  entry->size = size;
+  entry->loaded_msec = ZigzagDecode(loaded);
+  return true;
+}
+
+// applies one record to the entries, only_db limits it to one database,
+// a damaged or truncated record is not applied at all
+bool replayRecord(const uint8_t** data, const uint8_t* end, const std::string* only_db, databases_entries_t* out) {
+  const uint8_t rtype = **data;
+  ++(*data);
+  std::string db;
+  uint64_t count = 0;
+  if (!getBytes(data, end, &db) || !GetVarint(data, end, &count)) {
+    return false;
+  }
+
+  if (rtype == RESET_RECORD) {
+    if (count != 0) {
+      return false;
+    }
+    if (!only_db || *only_db == db) {
+      (*out)[db].clear();
+    }
+    return true;
+  }
+
+  if (rtype != PUT_RECORD && rtype != REMOVE_RECORD) {
+    return false;
+  }
+
+  keys_cache_entries_t entries;
+  for (uint64_t i = 0; i < count; ++i) {
+    KeysCacheEntry entry;
+    const bool ok = rtype == PUT_RECORD ? getEntry(data, end, &entry) : getBytes(data, end, &entry.key);
+    if (!ok) {
+      return false;
+    }
+    entries.push_back(entry);
+  }
+
+  if (only_db && *only_db != db) {
+    return true;
+  }
+
+  db_entries_t& db_entries = (*out)[db];
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (rtype == PUT_RECORD) {
+      db_entries[entries[i].key] = entries[i];
+    } else {
+      db_entries.erase(entries[i].key);
+    }
+  }
+  return true;
+}
+
+// records are replayed up to the first damaged one, the tail of an interrupted write
+bool replay(const MappedFile& file, connectionTypes type, const std::string* only_db, databases_entries_t* out) {
+  if (!isValidHeader(file.Data(), file.Size(), type)) {
+    return false;
+  }
+
+  const uint8_t* data = file.Data() + KEYS_CACHE_HEADER_SIZE;
+  const uint8_t* end = file.Data() + file.Size();
+  while (data < end) {
+    if (!replayRecord(&data, end, only_db, out)) {
+      break;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+KeysCacheEntry::KeysCacheEntry() : key(), type(common::Value::TYPE_NULL), ttl(NO_TTL), size(0), loaded_msec(0) {}
+
+KeysCacheEntry::KeysCacheEntry(const NDbKValue& key, common::time64_t loaded_msec)
+    : key(key.GetKey().GetKey().ToBytes()),
+      type(key.GetType()),
+      ttl(key.GetKey().GetTTL()),
+      size(0),
+      loaded_msec(loaded_msec) {
+  std::string value;
+  NValue val = key.GetValue();
+  if (val && val->GetType() == common::Value::TYPE_STRING && val->GetAsString(&value)) {
+    size = value.size();
+  }
+}
+
+NDbKValue KeysCacheEntry::ToKey(common::time64_t now_msec) const {
+  ttl_t left = ttl;
+  if (ttl >= 0) {
+    const ttl_t passed_sec = now_msec > loaded_msec ? (now_msec - loaded_msec) / 1000 : 0;
+    left = ttl > passed_sec ? ttl - passed_sec : EXPIRED_TTL;
+  }
+
+  NValue val;
+  if (type != common::Value::TYPE_NULL) {
+    val.reset(common::Value::CreateEmptyValueFromType(type));
+  }
+  return NDbKValue(NKey(key_t(key), left), val);
+}
+
+KeysCacheWriter::KeysCacheWriter(const std::string& path, connectionTypes type)
+    : path_(path), type_(type), file_(nullptr) {}
+
+KeysCacheWriter::~KeysCacheWriter() {
+  Close();
+}
+
+common::Error KeysCacheWriter::Open() {
+  if (file_) {
+    return common::Error();
+  }
+
+  databases_entries_t databases;
+  {
+    MappedFile file;
+    if (file.Open(path_)) {
+      replay(file, type_, nullptr, &databases);
+    }
+  }
+
+  std::string content = makeHeader(type_);
+  for (auto it = databases.begin(); it != databases.end(); ++it) {
+    if (it->second.empty()) {
+      continue;
+    }
+
+    content += makeRecordPrefix(PUT_RECORD, it->first, it->second.size());
+    for (auto kit = it->second.begin(); kit != it->second.end(); ++kit) {
+      putEntry(kit->second, &content);
+    }
+  }
+
+  // the compacted file replaces the old one only once written, a crash keeps the previous cache
+  const std::string tmp_path = path_ + ".tmp";
+  FILE* tmp = fopen(tmp_path.c_str(), "wb");
+  if (!tmp) {
+    return common::make_error_value("Can't create keys cache file: " + tmp_path, common::ErrorValue::E_ERROR);
+  }
+
+  const bool written = fwrite(content.data(), 1, content.size(), tmp) == content.size() && fflush(tmp) == 0;
+  if (fclose(tmp) != 0 || !written) {
+    remove(tmp_path.c_str());
+    return common::make_error_value("Can't write keys cache file: " + tmp_path, common::ErrorValue::E_ERROR);
+  }
+
+#ifdef OS_WIN
+  remove(path_.c_str());  // rename doesn't replace an existing file there
+#endif
+  if (rename(tmp_path.c_str(), path_.c_str()) != 0) {
+    remove(tmp_path.c_str());
+    return common::make_error_value("Can't replace keys cache file: " + path_, common::ErrorValue::E_ERROR);
+  }
+
+  file_ = fopen(path_.c_str(), "ab");
+  if (!file_) {
+    return common::make_error_value("Can't open keys cache file: " + path_, common::ErrorValue::E_ERROR);
+  }
+  return common::Error();
+}
+
+bool KeysCacheWriter::IsOpened() const {
+  return file_ != nullptr;
+}
+
+common::Error KeysCacheWriter::Put(const std::string& db, const keys_cache_entries_t& entries) {
+  if (entries.empty()) {
+    return common::Error();
+  }
+
+  std::string record = makeRecordPrefix(PUT_RECORD, db, entries.size());
+  for (size_t i = 0; i < entries.size(); ++i) {
+    putEntry(entries[i], &record);
+  }
+  return Append(record);
+}
+
+common::Error KeysCacheWriter::Remove(const std::string& db, const std::vector<std::string>& keys) {
+  if (keys.empty()) {
+    return common::Error();
+  }
+
+  std::string record = makeRecordPrefix(REMOVE_RECORD, db, keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    PutVarint(keys[i].size(), &record);
+    record += keys[i];
+  }
+  return Append(record);
+}
+
+common::Error KeysCacheWriter::Reset(const std::string& db) {
+  return Append(makeRecordPrefix(RESET_RECORD, db, 0));
+}
+
+void KeysCacheWriter::Close() {
+  if (file_) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+}
+
+common::Error KeysCacheWriter::Append(const std::string& record) {
+  if (!file_) {
+    return common::make_error_value("Keys cache file not opened", common::ErrorValue::E_ERROR);
+  }
+
+  if (fwrite(record.data(), 1, record.size(), file_) != record.size() || fflush(file_) != 0) {
+    return common::make_error_value("Can't write keys cache file: " + path_, common::ErrorValue::E_ERROR);
+  }
+  return common::Error();
+}
+
+common::Error ReadKeysCache(const std::string& path,
+                            connectionTypes type,
+                            const std::string& db,
+                            keys_cache_entries_t* out) {
+  if (!out) {
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  MappedFile file;
+  if (!file.Open(path)) {
+    return common::make_error_value("Keys cache file not found", common::ErrorValue::E_ERROR);
+  }
+
+  databases_entries_t databases;
+  if (!replay(file, type, &db, &databases)) {
+    return common::make_error_value("Invalid keys cache file format", common::ErrorValue::E_ERROR);
+  }
+
+  out->clear();
+  const db_entries_t& entries = databases[db];
+  out->reserve(entries.size());
+  for (auto it = entries.begin(); it != entries.end(); ++it) {
+    out->push_back(it->second);
+  }
+  return common::Error();
+}
+
+}  // namespace core
+}  // namespace fastonosql
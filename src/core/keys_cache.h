@@ -0,0 +1,87 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <stdint.h>  // for uint64_t
+#include <stdio.h>   // for FILE
+
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include <common/error.h>   // for Error
+#include <common/macros.h>  // for WARN_UNUSED_RESULT
+#include <common/types.h>   // for time64_t
+#include <common/value.h>   // for Value::Type
+
+#include "core/connection_types.h"  // for connectionTypes
+#include "core/db_key.h"            // for NDbKValue, ttl_t
+
+namespace fastonosql {
+namespace core {
+
+// Metadata of a loaded key, what the explorer needs to show it without the server.
+struct KeysCacheEntry {
+  KeysCacheEntry();
+  KeysCacheEntry(const NDbKValue& key, common::time64_t loaded_msec);
+
+  // ttl is counted down from the load time, EXPIRED_TTL once it is over
+  NDbKValue ToKey(common::time64_t now_msec) const;
+
+  std::string key;  // raw bytes
+  common::Value::Type type;
+  ttl_t ttl;
+  uint64_t size;  // estimated value size in bytes, 0 if unknown
+  common::time64_t loaded_msec;
+};
+
+typedef std::vector<KeysCacheEntry> keys_cache_entries_t;
+
+// Log of loaded keys changes, kept per database: batches of put and remove
+// records and resets of the whole database list. Opening an existing file
+// rewrites it with the live entries only, so it doesn't grow between sessions.
+class KeysCacheWriter {
+ public:
+  KeysCacheWriter(const std::string& path, connectionTypes type);
+  ~KeysCacheWriter();
+
+  common::Error Open() WARN_UNUSED_RESULT;  // starts a new file if the existing one is of other layout
+  bool IsOpened() const;
+  common::Error Put(const std::string& db, const keys_cache_entries_t& entries) WARN_UNUSED_RESULT;
+  common::Error Remove(const std::string& db, const std::vector<std::string>& keys) WARN_UNUSED_RESULT;
+  common::Error Reset(const std::string& db) WARN_UNUSED_RESULT;
+  void Close();
+
+ private:
+  common::Error Append(const std::string& record) WARN_UNUSED_RESULT;
+
+  const std::string path_;
+  const connectionTypes type_;
+  FILE* file_;
+};
+
+// Maps the cache file into memory and replays the records of the database,
+// entries are ordered by key. A torn tail after a crash is skipped.
+common::Error ReadKeysCache(const std::string& path,
+                            connectionTypes type,
+                            const std::string& db,
+                            keys_cache_entries_t* out) WARN_UNUSED_RESULT;
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,61 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint8_t
+
+#include <string>  // for string
+
+#include <common/macros.h>  // for DISALLOW_COPY_AND_ASSIGN
+
+#ifdef OS_WIN
+#include <windows.h>
+#endif
+
+namespace fastonosql {
+namespace core {
+
+// Read-only memory mapping of a whole file, an empty file maps to nullptr data.
+class MappedFile {
+ public:
+  MappedFile();
+  ~MappedFile();
+
+  bool Open(const std::string& path);
+
+  const uint8_t* Data() const;
+  size_t Size() const;
+
+ private:
+#ifdef OS_WIN
+  HANDLE file_;
+  HANDLE mapping_;
+#else
+  int fd_;
+#endif
+  const uint8_t* data_;
+  size_t size_;
+
+  DISALLOW_COPY_AND_ASSIGN(MappedFile);
+};
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,183 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "core/script_reader.h"
+
+#include <inttypes.h>  // for PRIu64
+#include <string.h>    // for memchr
+
+#include <common/sprintf.h>  // for MemSPrintf
+
+namespace {
+
+// 64 bit offsets, command logs are often bigger than 2 GiB
+uint64_t fileSize(FILE* file) {
+#ifdef OS_WIN
+  if (_fseeki64(file, 0, SEEK_END) != 0) {
+    return 0;
+  }
+  const int64_t size = _ftelli64(file);
+#else
+  if (fseeko(file, 0, SEEK_END) != 0) {
+    return 0;
+  }
+  const int64_t size = ftello(file);
+#endif
+  rewind(file);
+  return size > 0 ? static_cast<uint64_t>(size) : 0;
+}
+
+}  // namespace
+
+namespace fastonosql {
+namespace core {
+
+ScriptReader::ScriptReader()
+    : file_(nullptr),
+      buffer_(SCRIPT_READ_BUFFER_SIZE),
+      buffer_pos_(0),
+      buffer_len_(0),
+      bytes_read_(0),
+      size_(0),
+      line_number_(0) {}
+
+ScriptReader::~ScriptReader() {
+  Close();
+}
+
+common::Error ScriptReader::Open(const std::string& path) {
+  Close();
+  file_ = fopen(path.c_str(), "rb");
+  if (!file_) {
+    return common::make_error_value("Can't open script file: " + path, common::ErrorValue::E_ERROR);
+  }
+
+  size_ = fileSize(file_);
+  return common::Error();
+}
+
+void ScriptReader::Close() {
+  if (file_) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+
+  buffer_pos_ = 0;
+  buffer_len_ = 0;
+  bytes_read_ = 0;
+  size_ = 0;
+  line_number_ = 0;
+}
+
+common::Error ScriptReader::SkipTo(size_t first_line) {
+  if (!file_) {
+    return common::make_error_value("Script file not opened", common::ErrorValue::E_ERROR);
+  }
+
+  while (line_number_ + 1 < first_line) {
+    if (!ReadLine(nullptr)) {
+      std::string msg = common::MemSPrintf("Script has only %" PRIu64 " lines, can't start from line %" PRIu64 ".",
+                                           static_cast<uint64_t>(line_number_), static_cast<uint64_t>(first_line));
+      return common::make_error_value(msg, common::ErrorValue::E_ERROR);
+    }
+  }
+
+  return common::Error();
+}
+
+common::Error ScriptReader::Next(command_buffer_t* command, bool* eof) {
+  if (!command || !eof) {
+    DNOTREACHED();
+    return common::make_inval_error_value(common::ErrorValue::E_ERROR);
+  }
+
+  if (!file_) {
+    return common::make_error_value("Script file not opened", common::ErrorValue::E_ERROR);
+  }
+
+  *eof = false;
+  command_buffer_t line;
+  while (ReadLine(&line)) {
+    command_buffer_t stable_line = StableCommand(line);
+    if (!stable_line.empty()) {
+      *command = std::move(stable_line);
+      return common::Error();
+    }
+  }
+
+  *eof = true;
+  return common::Error();
+}
+
+uint64_t ScriptReader::BytesRead() const {
+  return bytes_read_;
+}
+
+uint64_t ScriptReader::Size() const {
+  return size_;
+}
+
+size_t ScriptReader::LineNumber() const {
+  return line_number_;
+}
+
+bool ScriptReader::FillBuffer() {
+  buffer_pos_ = 0;
+  buffer_len_ = fread(buffer_.data(), 1, buffer_.size(), file_);
+  return buffer_len_ != 0;
+}
+
+bool ScriptReader::ReadLine(command_buffer_t* line) {
+  if (line) {
+    line->clear();
+  }
+
+  bool has_data = false;
+  while (true) {
+    if (buffer_pos_ == buffer_len_ && !FillBuffer()) {
+      if (!has_data) {
+        return false;
+      }
+      break;
+    }
+
+    has_data = true;
+    const char* start = buffer_.data() + buffer_pos_;
+    const size_t avail = buffer_len_ - buffer_pos_;
+    const char* end = static_cast<const char*>(memchr(start, '\n', avail));
+    const size_t len = end ? end - start : avail;
+    if (line) {
+      line->append(start, len);
+    }
+    if (end) {
+      buffer_pos_ += len + 1;
+      bytes_read_ += len + 1;
+      break;
+    }
+
+    buffer_pos_ = buffer_len_;
+    bytes_read_ += avail;
+  }
+
+  line_number_++;
+  return true;
+}
+
+}  // namespace core
+}  // namespace fastonosql
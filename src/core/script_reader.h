@@ -0,0 +1,73 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint64_t
+#include <stdio.h>   // for FILE
+
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include <common/error.h>   // for Error
+#include <common/macros.h>  // for WARN_UNUSED_RESULT
+
+#include "core/types.h"  // for command_buffer_t
+
+#define SCRIPT_READ_BUFFER_SIZE 65536
+
+namespace fastonosql {
+namespace core {
+
+// Commands script (one command per line, as in the shell) read through a fixed
+// size buffer, so command logs bigger than memory can be executed line by line.
+// Lines are numbered from 1, empty lines are skipped but counted.
+class ScriptReader {
+ public:
+  ScriptReader();
+  ~ScriptReader();
+
+  common::Error Open(const std::string& path) WARN_UNUSED_RESULT;
+  void Close();
+
+  // skips lines before first_line, to resume an interrupted execution
+  common::Error SkipTo(size_t first_line) WARN_UNUSED_RESULT;
+  // stabled command of the next not empty line, eof is set when the file is over
+  common::Error Next(command_buffer_t* command, bool* eof) WARN_UNUSED_RESULT;
+
+  uint64_t BytesRead() const;
+  uint64_t Size() const;
+  size_t LineNumber() const;  // of the last read line
+
+ private:
+  bool ReadLine(command_buffer_t* line);  // nullptr only skips, false at the end of file
+  bool FillBuffer();
+
+  FILE* file_;
+  std::vector<char> buffer_;
+  size_t buffer_pos_;
+  size_t buffer_len_;
+  uint64_t bytes_read_;
+  uint64_t size_;
+  size_t line_number_;
+};
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,562 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/server/server_info_history.h"
+
+#include <stdint.h>  // for uint64_t, uint32_t
+#include <string.h>  // for memcpy
+
+#include <algorithm>  // for lower_bound, max
+#include <cmath>      // for llround, isfinite
+
+#include <common/sprintf.h>  // for MemSPrintf
+#include <common/value.h>    // for Value
+
+#include "core/binary_coding.h"  // for PutVarint, GetVarint
+#include "core/db_traits.h"      // for InfoFieldsFromType
+#include "core/mapped_file.h"    // for MappedFile
+
+namespace fastonosql {
+namespace core {
+namespace {
+
+const char kHistoryMagic[] = {'F', 'N', 'S', 'H'};
+const uint32_t kHistoryVersion = 1;
+const size_t kHeaderFixedSize = 20;   // magic, version, connection type, block size, columns count
+const size_t kColumnDescSize = 4;     // property, field, floating, reserved
+const size_t kBlockHeaderSize = 24;   // rows count, payload size, first and last stamps
+const size_t kMaxVarintSize = 10;
+
+uint64_t columnBits(const ServerInfoHistoryColumn& column, double value) {
+  if (column.floating) {
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+
+  if (!std::isfinite(value)) {
+    return 0;
+  }
+  return static_cast<uint64_t>(static_cast<int64_t>(std::llround(value)));
+}
+
+double columnValue(const ServerInfoHistoryColumn& column, uint64_t bits) {
+  if (column.floating) {
+    double value = 0;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+  return static_cast<double>(static_cast<int64_t>(bits));
+}
+
+// integers are stored as zigzag deltas, doubles as xor with the previous bits
+uint64_t encodeDelta(const ServerInfoHistoryColumn& column, uint64_t prev, uint64_t cur) {
+  return column.floating ? prev ^ cur : ZigzagEncode(static_cast<int64_t>(cur - prev));
+}
+
+uint64_t decodeDelta(const ServerInfoHistoryColumn& column, uint64_t prev, uint64_t delta) {
+  return column.floating ? prev ^ delta : prev + static_cast<uint64_t>(ZigzagDecode(delta));
+}
+
+std::string makeHeader(connectionTypes type, size_t block_size, const server_info_history_columns_t& columns) {
+  std::string header(kHistoryMagic, sizeof(kHistoryMagic));
+  PutFixed32(kHistoryVersion, &header);
+  PutFixed32(static_cast<uint32_t>(type), &header);
+  PutFixed32(static_cast<uint32_t>(block_size), &header);
+  PutFixed32(static_cast<uint32_t>(columns.size()), &header);
+  for (size_t i = 0; i < columns.size(); ++i) {
+    header.push_back(static_cast<char>(columns[i].property));
+    header.push_back(static_cast<char>(columns[i].field));
+    header.push_back(columns[i].floating ? 1 : 0);
+    header.push_back(0);
+  }
+  return header;
+}
+
+bool parseHeader(const uint8_t* data,
+                 size_t size,
+                 connectionTypes* type,
+                 size_t* block_size,
+                 server_info_history_columns_t* columns,
+                 size_t* data_offset) {
+  if (size < kHeaderFixedSize || memcmp(data, kHistoryMagic, sizeof(kHistoryMagic)) != 0) {
+    return false;
+  }
+
+  if (GetFixed32(data + 4) != kHistoryVersion) {
+    return false;
+  }
+
+  *type = static_cast<connectionTypes>(GetFixed32(data + 8));
+  *block_size = GetFixed32(data + 12);
+  const size_t columns_count = GetFixed32(data + 16);
+  *data_offset = kHeaderFixedSize + kColumnDescSize * columns_count;
+  if (*block_size <= kBlockHeaderSize || size < *data_offset) {
+    return false;
+  }
+
+  columns->clear();
+  for (size_t i = 0; i < columns_count; ++i) {
+    const uint8_t* desc = data + kHeaderFixedSize + kColumnDescSize * i;
+    columns->push_back(ServerInfoHistoryColumn(desc[0], desc[1], desc[2] != 0));
+  }
+  return true;
+}
+
+// returns false if rows don't fit into one block
+bool encodeBlock(const std::vector<ServerInfoHistoryRow>& rows,
+                 const server_info_history_columns_t& columns,
+                 size_t block_size,
+                 std::string* out) {
+  std::string payload;
+  for (size_t i = 1; i < rows.size(); ++i) {
+    PutVarint(ZigzagEncode(rows[i].msec - rows[i - 1].msec), &payload);
+  }
+
+  for (size_t c = 0; c < columns.size(); ++c) {
+    uint64_t prev = 0;
+    for (size_t i = 0; i < rows.size(); ++i) {
+      const uint64_t cur = columnBits(columns[c], rows[i].values[c]);
+      PutVarint(encodeDelta(columns[c], prev, cur), &payload);
+      prev = cur;
+    }
+  }
+
+  if (kBlockHeaderSize + payload.size() > block_size) {
+    return false;
+  }
+
+  out->clear();
+  PutFixed32(static_cast<uint32_t>(rows.size()), out);
+  PutFixed32(static_cast<uint32_t>(payload.size()), out);
+  PutFixed64(static_cast<uint64_t>(rows.front().msec), out);
+  PutFixed64(static_cast<uint64_t>(rows.back().msec), out);
+  out->append(payload);
+  out->resize(block_size, '\0');
+  return true;
+}
+
+struct BlockIndexEntry {
+  const uint8_t* data;
+  size_t rows;
+  size_t payload_size;
+  common::time64_t first_msec;
+  common::time64_t last_msec;
+};
+
+bool readBlockHeader(const uint8_t* data, size_t block_size, BlockIndexEntry* entry) {
+  entry->data = data;
+  entry->rows = GetFixed32(data);
+  entry->payload_size = GetFixed32(data + 4);
+  entry->first_msec = static_cast<common::time64_t>(GetFixed64(data + 8));
+  entry->last_msec = static_cast<common::time64_t>(GetFixed64(data + 16));
+  return entry->rows != 0 && kBlockHeaderSize + entry->payload_size <= block_size;
+}
+
+bool decodeBlock(const BlockIndexEntry& block,
+                 const server_info_history_columns_t& columns,
+                 std::vector<ServerInfoHistoryRow>* rows) {
+  const uint8_t* ptr = block.data + kBlockHeaderSize;
+  const uint8_t* end = ptr + block.payload_size;
+  rows->resize(block.rows);
+  (*rows)[0].msec = block.first_msec;
+  for (size_t i = 1; i < block.rows; ++i) {
+    uint64_t delta = 0;
+    if (!GetVarint(&ptr, end, &delta)) {
+      return false;
+    }
+    (*rows)[i].msec = (*rows)[i - 1].msec + ZigzagDecode(delta);
+  }
+
+  for (size_t i = 0; i < block.rows; ++i) {
+    (*rows)[i].values.resize(columns.size());
+  }
+
+  for (size_t c = 0; c < columns.size(); ++c) {
+    uint64_t prev = 0;
+    for (size_t i = 0; i < block.rows; ++i) {
+      uint64_t delta = 0;
+      if (!GetVarint(&ptr, end, &delta)) {
+        return false;
+      }
+      prev = decodeDelta(columns[c], prev, delta);
+      (*rows)[i].values[c] = columnValue(columns[c], prev);
+    }
+  }
+  return true;
+}
+
+class HistoryDownsampler {
+ public:
+  HistoryDownsampler(common::time64_t origin, common::time64_t resolution, ServerInfoHistory* out)
+      : origin_(origin), resolution_(resolution), out_(out), bucket_(0), count_(0), sum_() {}
+
+  void Add(const ServerInfoHistoryRow& row) {
+    if (resolution_ <= 0) {
+      out_->AddRow(row);
+      return;
+    }
+
+    if (origin_ == 0) {
+      origin_ = row.msec;
+    }
+
+    const common::time64_t bucket = (row.msec - origin_) / resolution_;
+    if (count_ && bucket != bucket_) {
+      Flush();
+    }
+
+    if (count_ == 0) {
+      bucket_ = bucket;
+      sum_ = row;
+    } else {
+      for (size_t i = 0; i < sum_.values.size(); ++i) {
+        sum_.values[i] += row.values[i];
+      }
+    }
+    count_++;
+  }
+
+  void Flush() {
+    if (count_ == 0) {
+      return;
+    }
+
+    for (size_t i = 0; i < sum_.values.size(); ++i) {
+      sum_.values[i] /= count_;
+    }
+    out_->AddRow(sum_);
+    count_ = 0;
+  }
+
+ private:
+  common::time64_t origin_;
+  const common::time64_t resolution_;
+  ServerInfoHistory* const out_;
+  common::time64_t bucket_;
+  size_t count_;
+  ServerInfoHistoryRow sum_;
+};
+
+
+}  // namespace
+
+ServerInfoHistoryColumn::ServerInfoHistoryColumn() : property(0), field(0), floating(false) {}
+
+ServerInfoHistoryColumn::ServerInfoHistoryColumn(unsigned char property, unsigned char field, bool floating)
+    : property(property), field(field), floating(floating) {}
+
+bool ServerInfoHistoryColumn::operator==(const ServerInfoHistoryColumn& other) const {
+  return property == other.property && field == other.field && floating == other.floating;
+}
+
+server_info_history_columns_t ServerInfoHistoryColumnsFromType(connectionTypes type) {
+  server_info_history_columns_t columns;
+  const std::vector<info_field_t> fields = InfoFieldsFromType(type);
+  for (size_t i = 0; i < fields.size(); ++i) {
+    const std::vector<Field>& group = fields[i].second;
+    for (size_t j = 0; j < group.size(); ++j) {
+      if (group[j].IsIntegral()) {
+        const bool floating = group[j].type == common::Value::TYPE_DOUBLE;
+        columns.push_back(
+            ServerInfoHistoryColumn(static_cast<unsigned char>(i), static_cast<unsigned char>(j), floating));
+      }
+    }
+  }
+  return columns;
+}
+
+ServerInfoHistoryRow::ServerInfoHistoryRow() : msec(0), values() {}
+
+ServerInfoHistoryRow MakeServerInfoHistoryRow(const IServerInfo* info,
+                                              const server_info_history_columns_t& columns,
+                                              common::time64_t msec) {
+  ServerInfoHistoryRow row;
+  row.msec = msec;
+  row.values.resize(columns.size(), 0);
+  if (!info) {
+    return row;
+  }
+
+  for (size_t i = 0; i < columns.size(); ++i) {
+    common::Value* value = info->ValueByIndexes(columns[i].property, columns[i].field);  // allocate
+    if (value) {
+      double val = 0;
+      if (value->GetAsDouble(&val)) {
+        row.values[i] = val;
+      }
+      delete value;
+    }
+  }
+  return row;
+}
+
+ServerInfoHistory::ServerInfoHistory() : columns_(), stamps_(), values_() {}
+
+ServerInfoHistory::ServerInfoHistory(const server_info_history_columns_t& columns)
+    : columns_(columns), stamps_(), values_(columns.size()) {}
+
+server_info_history_columns_t ServerInfoHistory::Columns() const {
+  return columns_;
+}
+
+size_t ServerInfoHistory::RowsCount() const {
+  return stamps_.size();
+}
+
+const ServerInfoHistory::stamps_t& ServerInfoHistory::Stamps() const {
+  return stamps_;
+}
+
+const ServerInfoHistory::values_t* ServerInfoHistory::ColumnValues(unsigned char property, unsigned char field) const {
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    if (columns_[i].property == property && columns_[i].field == field) {
+      return &values_[i];
+    }
+  }
+  return nullptr;
+}
+
+void ServerInfoHistory::AddRow(const ServerInfoHistoryRow& row) {
+  if (row.values.size() != columns_.size()) {
+    DNOTREACHED();
+    return;
+  }
+
+  stamps_.push_back(row.msec);
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    values_[i].push_back(row.values[i]);
+  }
+}
+
+void ServerInfoHistory::Clear() {
+  stamps_.clear();
+  for (size_t i = 0; i < values_.size(); ++i) {
+    values_[i].clear();
+  }
+}
+
+ServerInfoHistoryWriter::ServerInfoHistoryWriter(const std::string& path,
+                                                 connectionTypes type,
+                                                 const server_info_history_columns_t& columns)
+    : path_(path),
+      type_(type),
+      columns_(columns),
+      block_size_(std::max<size_t>(SERVER_INFO_HISTORY_BLOCK_SIZE,
+                                   kBlockHeaderSize + kMaxVarintSize * (columns.size() + 1))),
+      file_(nullptr),
+      data_offset_(kHeaderFixedSize + kColumnDescSize * columns.size()),
+      blocks_count_(0),
+      last_block_rows_() {}
+
+ServerInfoHistoryWriter::~ServerInfoHistoryWriter() {
+  Close();
+}
+
+common::Error ServerInfoHistoryWriter::Open() {
+  if (file_) {
+    return common::Error();
+  }
+
+  file_ = fopen(path_.c_str(), "r+b");
+  if (!file_) {
+    return Create();
+  }
+
+  const std::string expected = makeHeader(type_, block_size_, columns_);
+  std::string header(expected.size(), '\0');
+  if (fread(&header[0], 1, header.size(), file_) != header.size() || header != expected) {
+    fclose(file_);
+    file_ = nullptr;
+    return Create();
+  }
+
+  if (fseek(file_, 0, SEEK_END) != 0) {
+    Close();
+    return common::make_error_value("Can't seek history file: " + path_, common::ErrorValue::E_ERROR);
+  }
+
+  const size_t file_size = static_cast<size_t>(ftell(file_));
+  blocks_count_ = (file_size - data_offset_) / block_size_;
+  last_block_rows_.clear();
+  if (blocks_count_ == 0) {
+    return common::Error();
+  }
+
+  // continue the last block, a damaged one is overwritten by the next append
+  std::vector<uint8_t> block(block_size_);
+  BlockIndexEntry entry;
+  if (fseek(file_, static_cast<long>(data_offset_ + (blocks_count_ - 1) * block_size_), SEEK_SET) == 0 &&
+      fread(block.data(), 1, block.size(), file_) == block.size() && readBlockHeader(block.data(), block_size_, &entry)) {
+    if (!decodeBlock(entry, columns_, &last_block_rows_)) {
+      last_block_rows_.clear();
+    }
+  }
+  return common::Error();
+}
+
+bool ServerInfoHistoryWriter::IsOpened() const {
+  return file_ != nullptr;
+}
+
+server_info_history_columns_t ServerInfoHistoryWriter::Columns() const {
+  return columns_;
+}
+
+common::Error ServerInfoHistoryWriter::Append(const ServerInfoHistoryRow& row) {
+  if (!file_) {
+    return common::make_error_value("History file not opened", common::ErrorValue::E_ERROR);
+  }
+
+  if (row.values.size() != columns_.size()) {
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  if (blocks_count_ == 0) {
+    blocks_count_ = 1;
+  }
+
+  std::string block;
+  last_block_rows_.push_back(row);
+  if (!encodeBlock(last_block_rows_, columns_, block_size_, &block)) {
+    // previous rows are already on disk, start the next block
+    last_block_rows_.assign(1, row);
+    blocks_count_++;
+    if (!encodeBlock(last_block_rows_, columns_, block_size_, &block)) {
+      DNOTREACHED();
+      return common::make_error_value("History row doesn't fit into block", common::ErrorValue::E_ERROR);
+    }
+  }
+
+  return WriteLastBlock(block);
+}
+
+common::Error ServerInfoHistoryWriter::Clear() {
+  Close();
+  return Create();
+}
+
+void ServerInfoHistoryWriter::Close() {
+  if (file_) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+  blocks_count_ = 0;
+  last_block_rows_.clear();
+}
+
+common::Error ServerInfoHistoryWriter::Create() {
+  file_ = fopen(path_.c_str(), "w+b");
+  if (!file_) {
+    return common::make_error_value("Can't create history file: " + path_, common::ErrorValue::E_ERROR);
+  }
+
+  const std::string header = makeHeader(type_, block_size_, columns_);
+  if (fwrite(header.data(), 1, header.size(), file_) != header.size() || fflush(file_) != 0) {
+    Close();
+    return common::make_error_value("Can't write history file: " + path_, common::ErrorValue::E_ERROR);
+  }
+
+  blocks_count_ = 0;
+  last_block_rows_.clear();
+  return common::Error();
+}
+
+common::Error ServerInfoHistoryWriter::WriteLastBlock(const std::string& block) {
+  const size_t offset = data_offset_ + (blocks_count_ - 1) * block_size_;
+  if (fseek(file_, static_cast<long>(offset), SEEK_SET) != 0 ||
+      fwrite(block.data(), 1, block.size(), file_) != block.size() || fflush(file_) != 0) {
+    return common::make_error_value("Can't write history file: " + path_, common::ErrorValue::E_ERROR);
+  }
+  return common::Error();
+}
+
+common::Error ReadServerInfoHistory(const std::string& path,
+                                    connectionTypes type,
+                                    common::time64_t from_msec,
+                                    common::time64_t to_msec,
+                                    common::time64_t resolution_msec,
+                                    ServerInfoHistory* out) {
+  if (!out) {
+    return common::make_error_value("Invalid input argument(s)", common::ErrorValue::E_ERROR);
+  }
+
+  MappedFile file;
+  if (!file.Open(path)) {
+    return common::make_error_value("History file not found", common::ErrorValue::E_ERROR);
+  }
+
+  connectionTypes file_type;
+  size_t block_size = 0;
+  size_t data_offset = 0;
+  server_info_history_columns_t columns;
+  if (!parseHeader(file.Data(), file.Size(), &file_type, &block_size, &columns, &data_offset)) {
+    return common::make_error_value("Invalid history file format", common::ErrorValue::E_ERROR);
+  }
+
+  if (file_type != type) {
+    return common::make_error_value("History file of other connection type", common::ErrorValue::E_ERROR);
+  }
+
+  // block index: only block headers are touched, stamps grow from block to block
+  std::vector<BlockIndexEntry> index;
+  const size_t blocks_count = (file.Size() - data_offset) / block_size;
+  index.reserve(blocks_count);
+  for (size_t i = 0; i < blocks_count; ++i) {
+    BlockIndexEntry entry;
+    if (readBlockHeader(file.Data() + data_offset + i * block_size, block_size, &entry)) {
+      index.push_back(entry);
+    }
+  }
+
+  auto it = index.begin();
+  if (from_msec) {
+    it = std::lower_bound(index.begin(), index.end(), from_msec,
+                          [](const BlockIndexEntry& entry, common::time64_t msec) { return entry.last_msec < msec; });
+  }
+
+  ServerInfoHistory history(columns);
+  HistoryDownsampler sampler(from_msec, resolution_msec, &history);
+  std::vector<ServerInfoHistoryRow> rows;
+  for (; it != index.end(); ++it) {
+    if (to_msec && it->first_msec > to_msec) {
+      break;
+    }
+
+    if (!decodeBlock(*it, columns, &rows)) {
+      return common::make_error_value(common::MemSPrintf("Damaged history block at offset %llu",
+                                                         static_cast<unsigned long long>(it->data - file.Data())),
+                                      common::ErrorValue::E_ERROR);
+    }
+
+    for (size_t i = 0; i < rows.size(); ++i) {
+      const ServerInfoHistoryRow& row = rows[i];
+      if ((from_msec && row.msec < from_msec) || (to_msec && row.msec > to_msec)) {
+        continue;
+      }
+      sampler.Add(row);
+    }
+  }
+  sampler.Flush();
+
+  *out = history;
+  return common::Error();
+}
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,131 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdio.h>   // for FILE
+
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include <common/error.h>   // for Error
+#include <common/macros.h>  // for WARN_UNUSED_RESULT
+#include <common/types.h>   // for time64_t
+
+#include "core/connection_types.h"    // for connectionTypes
+#include "core/server/iserver_info.h"  // for IServerInfo
+
+#define SERVER_INFO_HISTORY_BLOCK_SIZE 16384
+
+namespace fastonosql {
+namespace core {
+
+// Numeric field of the server info, addressed as in IServerInfo::ValueByIndexes.
+struct ServerInfoHistoryColumn {
+  ServerInfoHistoryColumn();
+  ServerInfoHistoryColumn(unsigned char property, unsigned char field, bool floating);
+
+  bool operator==(const ServerInfoHistoryColumn& other) const;
+
+  unsigned char property;
+  unsigned char field;
+  bool floating;  // stored as double bits, otherwise as integer
+};
+
+typedef std::vector<ServerInfoHistoryColumn> server_info_history_columns_t;
+
+// integral info fields of the connection type, the ones the history dialog can graph
+server_info_history_columns_t ServerInfoHistoryColumnsFromType(connectionTypes type);
+
+struct ServerInfoHistoryRow {
+  ServerInfoHistoryRow();
+
+  common::time64_t msec;
+  std::vector<double> values;  // one per column
+};
+
+ServerInfoHistoryRow MakeServerInfoHistoryRow(const IServerInfo* info,
+                                              const server_info_history_columns_t& columns,
+                                              common::time64_t msec);
+
+// Column oriented series of history rows.
+class ServerInfoHistory {
+ public:
+  typedef std::vector<common::time64_t> stamps_t;
+  typedef std::vector<double> values_t;
+
+  ServerInfoHistory();
+  explicit ServerInfoHistory(const server_info_history_columns_t& columns);
+
+  server_info_history_columns_t Columns() const;
+  size_t RowsCount() const;
+  const stamps_t& Stamps() const;
+  const values_t* ColumnValues(unsigned char property, unsigned char field) const;  // nullptr if not recorded
+
+  void AddRow(const ServerInfoHistoryRow& row);
+  void Clear();
+
+ private:
+  server_info_history_columns_t columns_;
+  stamps_t stamps_;
+  std::vector<values_t> values_;
+};
+
+// Appends rows to a history file made of a header followed by fixed-size
+// blocks. Every block starts with its rows count and first/last stamps, the
+// payload keeps stamps and each column as varint deltas from the previous row.
+// The last block is kept in memory and rewritten in place on every append.
+class ServerInfoHistoryWriter {
+ public:
+  ServerInfoHistoryWriter(const std::string& path, connectionTypes type, const server_info_history_columns_t& columns);
+  ~ServerInfoHistoryWriter();
+
+  common::Error Open() WARN_UNUSED_RESULT;  // starts a new file if the existing one has other layout
+  bool IsOpened() const;
+  server_info_history_columns_t Columns() const;
+  common::Error Append(const ServerInfoHistoryRow& row) WARN_UNUSED_RESULT;
+  common::Error Clear() WARN_UNUSED_RESULT;
+  void Close();
+
+ private:
+  common::Error Create() WARN_UNUSED_RESULT;
+  common::Error WriteLastBlock(const std::string& block) WARN_UNUSED_RESULT;
+
+  const std::string path_;
+  const connectionTypes type_;
+  const server_info_history_columns_t columns_;
+  const size_t block_size_;
+  FILE* file_;
+  size_t data_offset_;
+  size_t blocks_count_;
+  std::vector<ServerInfoHistoryRow> last_block_rows_;
+};
+
+// Maps the history file into memory and decodes only the blocks overlapping
+// [from_msec, to_msec], zero bounds are open. With a resolution rows are
+// averaged into buckets of resolution_msec.
+common::Error ReadServerInfoHistory(const std::string& path,
+                                    connectionTypes type,
+                                    common::time64_t from_msec,
+                                    common::time64_t to_msec,
+                                    common::time64_t resolution_msec,
+                                    ServerInfoHistory* out) WARN_UNUSED_RESULT;
+
+}  // namespace core
+}  // namespace fastonosql
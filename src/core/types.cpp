@@ -18,46 +18,76 @@
 
 #include "core/types.h"
 
-#include <common/string_util.h>
-
 #include <string>  // for string
 
+extern "C" {
+#include "sds.h"
+}
+
 namespace fastonosql {
 namespace core {
 
 command_buffer_t StableCommand(const command_buffer_t& command) {
-  if (command.empty()) {
-    return command_buffer_t();
-  }
-
-  std::vector<command_buffer_t> tokens;
-  size_t tok = common::Tokenize(command, " ", &tokens);
+  // single pass: collapse spaces between tokens and quote \x.. hex tokens, without temporary tokens
   command_buffer_t stabled_command;
-  if (tok > 0) {
-    command_buffer_t part = tokens[0];
-    if (part.size() % 4 == 0 && part[0] == '\\' && (part[1] == 'x' || part[1] == 'X')) {
-      stabled_command += "\"" + part + "\"";
-    } else {
-      stabled_command += part;
+  stabled_command.reserve(command.size());
+  size_t pos = 0;
+  while (pos < command.size()) {
+    size_t start = command.find_first_not_of(' ', pos);
+    if (start == command_buffer_t::npos) {
+      break;
     }
 
-    for (size_t i = 1; i < tok; ++i) {
-      command_buffer_t part = tokens[i];
-      stabled_command += " ";
-      if (part.size() % 4 == 0 && part[0] == '\\' && (part[1] == 'x' || part[1] == 'X')) {
-        stabled_command += "\"" + part + "\"";
-      } else {
-        stabled_command += part;
-      }
+    size_t end = command.find(' ', start);
+    if (end == command_buffer_t::npos) {
+      end = command.size();
+    }
+
+    const size_t len = end - start;
+    const bool is_hex =
+        len % 4 == 0 && command[start] == '\\' && (command[start + 1] == 'x' || command[start + 1] == 'X');
+    if (!stabled_command.empty()) {
+      stabled_command += ' ';
+    }
+    if (is_hex) {
+      stabled_command += '"';
+    }
+    stabled_command.append(command, start, len);
+    if (is_hex) {
+      stabled_command += '"';
     }
+    pos = end;
   }
 
-  if (stabled_command[stabled_command.size() - 1] == '\r') {
+  if (!stabled_command.empty() && stabled_command[stabled_command.size() - 1] == '\r') {
     stabled_command.pop_back();
   }
 
   return stabled_command;
 }
 
+bool ParseCommandLine(const command_buffer_t& command, commands_args_t* argv) {
+  if (!argv) {
+    return false;
+  }
+
+  command_buffer_t stabled_command = StableCommand(command);
+  if (stabled_command.empty()) {
+    return false;
+  }
+
+  int argc;
+  sds* sargv = sdssplitargslong(stabled_command.data(), &argc);
+  if (!sargv) {
+    return false;
+  }
+
+  for (int i = 0; i < argc; ++i) {
+    argv->emplace_back(sargv[i], sdslen(sargv[i]));
+  }
+  sdsfreesplitres(sargv, argc);
+  return true;
+}
+
 }  // namespace core
 }  // namespace fastonosql
@@ -30,6 +30,7 @@ typedef std::basic_stringstream<command_buffer_char_t> command_buffer_writer_t;
 typedef std::deque<command_buffer_t> commands_args_t;
 
 command_buffer_t StableCommand(const command_buffer_t& command);
+bool ParseCommandLine(const command_buffer_t& command, commands_args_t* argv);  // StableCommand + split into args
 
 }  // namespace core
 }  // namespace fastonosql
@@ -18,47 +18,103 @@
 
 #include "gui/base_lexer.h"
 
+#include <Qsci/qsciscintilla.h>
+
 #include <common/qt/convert2string.h>  // for ConvertFromString
 
-namespace fastonosql {
-namespace gui {
+namespace {
 
-BaseQsciApi::BaseQsciApi(QsciLexer* lexer) : QsciAbstractAPIs(lexer), filtered_version_(UNDEFINED_SINCE) {}
+const int keys_completion_limit = 100;
 
-bool BaseQsciApi::canSkipCommand(const core::CommandInfo& info) const {
-  if (filtered_version_ == UNDEFINED_SINCE) {
-    return false;
+std::vector<std::string> commandNames(const std::vector<fastonosql::core::CommandHolder>& commands) {
+  std::vector<std::string> names;
+  names.reserve(commands.size());
+  for (size_t i = 0; i < commands.size(); ++i) {
+    names.push_back(commands[i].name);
   }
+  return names;
+}
 
-  if (info.since == UNDEFINED_SINCE) {
-    return false;
-  }
+}  // namespace
 
-  return info.since > filtered_version_;
+namespace fastonosql {
+namespace gui {
+
+BaseQsciApi::BaseQsciApi(QsciLexer* lexer)
+    : QsciAbstractAPIs(lexer), filtered_version_(UNDEFINED_SINCE), keys_source_() {}
+
+uint32_t BaseQsciApi::filteredVersion() const {
+  return filtered_version_;
 }
 
 void BaseQsciApi::setFilteredVersion(uint32_t version) {
   filtered_version_ = version;
 }
 
+void BaseQsciApi::setKeysCompletionSource(keys_completion_source_t source) {
+  keys_source_ = source;
+}
+
+QStringList BaseQsciApi::completeKeys(const QString& prefix) const {
+  if (!keys_source_) {
+    return QStringList();
+  }
+
+  return keys_source_(prefix, keys_completion_limit);
+}
+
+QString BaseQsciApi::textBeforeCursor() const {
+  QsciLexer* lex = lexer();
+  if (!lex || !lex->editor()) {
+    return QString();
+  }
+
+  QsciScintilla* editor = lex->editor();
+  int line = 0;
+  int index = 0;
+  editor->getCursorPosition(&line, &index);
+  return editor->text(line).left(index);
+}
+
 BaseQsciApiCommandHolder::BaseQsciApiCommandHolder(const std::vector<core::CommandHolder>& commands, QsciLexer* lexer)
-    : BaseQsciApi(lexer), commands_(commands) {}
+    : BaseQsciApi(lexer), commands_(commands), index_(commands) {}
 
 void BaseQsciApiCommandHolder::updateAutoCompletionList(const QStringList& context, QStringList& list) {
-  for (auto it = context.begin(); it != context.end(); ++it) {
-    QString val = *it;
-    for (size_t i = 0; i < commands_.size(); ++i) {
-      core::CommandInfo cmd = commands_[i];
-      if (canSkipCommand(cmd)) {
-        continue;
-      }
+  if (context.isEmpty()) {
+    return;
+  }
 
-      QString jval;
-      common::ConvertFromString(cmd.name, &jval);
-      if (jval.startsWith(val, Qt::CaseInsensitive)) {
-        list.append(jval + "?1");
-      }
-    }
+  const QString word = context.last();
+  const QString lword = CommandsIndex::normalize(word);
+  if (lword.isEmpty()) {
+    return;
+  }
+
+  QString line = CommandsIndex::normalize(textBeforeCursor());
+  if (!line.endsWith(lword)) {
+    line = lword;
+  }
+
+  // only the word under cursor is replaced, so "config g" is completed with "GET"
+  const int word_pos = line.length() - lword.length();
+  CommandsIndex::indexes_t found;
+  index_.complete(line, filteredVersion(), &found);
+  for (size_t idx : found) {
+    list.append(index_.name(idx).mid(word_pos) + "?1");
+  }
+
+  if (!found.empty() || word_pos == 0) {
+    return;
+  }
+
+  size_t command_index = 0;
+  int command_length = 0;
+  if (!index_.findLongestPrefixOf(line, &command_index, &command_length)) {
+    return;
+  }
+
+  if (isKeyArgument(command_index, line.mid(command_length))) {
+    list.append(completeKeys(word));
   }
 }
 
@@ -70,22 +126,37 @@ QStringList BaseQsciApiCommandHolder::callTips(const QStringList& context,
   UNUSED(style);
   UNUSED(shifts);
 
+  size_t index = 0;
+  if (index_.findLongestPrefixOf(CommandsIndex::normalize(textBeforeCursor()), &index, nullptr)) {
+    return QStringList() << makeCallTip(commands_[index]);
+  }
+
   for (auto it = context.begin(); it != context.end(); ++it) {
-    QString val = *it;
-    for (size_t i = 0; i < commands_.size(); ++i) {
-      core::CommandInfo cmd = commands_[i];
-
-      QString jval;
-      common::ConvertFromString(cmd.name, &jval);
-      if (QString::compare(jval, val, Qt::CaseInsensitive) == 0) {
-        return QStringList() << makeCallTip(cmd);
-      }
+    if (index_.find(*it, &index)) {
+      return QStringList() << makeCallTip(commands_[index]);
     }
   }
 
   return QStringList();
 }
 
+bool BaseQsciApiCommandHolder::isKeyArgument(size_t command_index, const QString& args) const {
+  const QStringList typed = args.split(' ', QString::SkipEmptyParts);
+  if (typed.isEmpty()) {
+    return false;
+  }
+
+  QString params;
+  common::ConvertFromString(commands_[command_index].params, &params);
+  const QStringList params_names = params.split(' ', QString::SkipEmptyParts);
+  const int position = typed.size() - 1;
+  if (position >= params_names.size()) {
+    return false;
+  }
+
+  return params_names[position].contains("key", Qt::CaseInsensitive);
+}
+
 BaseQsciLexer::BaseQsciLexer(QObject* parent) : QsciLexerCustom(parent) {}
 
 QString BaseQsciLexer::description(int style) const {
@@ -118,7 +189,7 @@ BaseQsciApi* BaseQsciLexer::apis() const {
 
 BaseQsciLexerCommandHolder::BaseQsciLexerCommandHolder(const std::vector<core::CommandHolder>& commands,
                                                        QObject* parent)
-    : BaseQsciLexer(parent), commands_(commands) {}
+    : BaseQsciLexer(parent), commands_(commands), matcher_(commandNames(commands)) {}
 
 std::vector<uint32_t> BaseQsciLexerCommandHolder::supportedVersions() const {
   std::vector<uint32_t> result;
@@ -152,32 +223,40 @@ void BaseQsciLexerCommandHolder::styleText(int start, int end) {
     return;
   }
 
-  char* data = new char[end - start + 1];
-  editor()->SendScintilla(QsciScintilla::SCI_GETTEXTRANGE, start, end, data);
-  QString source(data);
-  delete[] data;
-
-  if (source.isEmpty()) {
+  // restyle whole lines only, scintilla reports the first unstyled position,
+  // line ends are styled too or scintilla keeps asking for them
+  const int first_line = editor()->SendScintilla(QsciScintilla::SCI_LINEFROMPOSITION, start);
+  const int last_line = editor()->SendScintilla(QsciScintilla::SCI_LINEFROMPOSITION, end);
+  const int length = editor()->SendScintilla(QsciScintilla::SCI_GETLENGTH);
+  start = editor()->SendScintilla(QsciScintilla::SCI_POSITIONFROMLINE, first_line);
+  end = editor()->SendScintilla(QsciScintilla::SCI_POSITIONFROMLINE, last_line + 1);
+  if (end < 0 || end > length) {  // no line after the last one
+    end = length;
+  }
+  if (end <= start) {
     return;
   }
 
-  paintCommands(source, start);
+  std::vector<char> data(end - start + 1);
+  editor()->SendScintilla(QsciScintilla::SCI_GETTEXTRANGE, start, end, data.data());
+  paintCommands(data.data(), end - start, start);
 }
 
-void BaseQsciLexerCommandHolder::paintCommands(const QString& source, int start) {
-  for (size_t i = 0; i < commands_.size(); ++i) {
-    core::CommandInfo cmd = commands_[i];
-    QString word;
-    common::ConvertFromString(cmd.name, &word);
-    int index = 0;
-    int begin = 0;
-    while ((begin = source.indexOf(word, index, Qt::CaseInsensitive)) != -1) {
-      index = begin + word.length();
-
-      startStyling(start + begin);
-      setStyling(word.length(), Command);
-      startStyling(start + begin);
+void BaseQsciLexerCommandHolder::paintCommands(const char* source, size_t size, int start) {
+  // positions are in bytes as scintilla expects, command names are ascii
+  const core::CommandMatcher::matches_t matches = matcher_.FindAll(source, size);
+  startStyling(start);
+  size_t styled = 0;
+  for (const core::CommandMatcher::Match& match : matches) {
+    if (match.offset > styled) {
+      setStyling(match.offset - styled, Default);
     }
+    setStyling(match.length, Command);
+    styled = match.offset + match.length;
+  }
+
+  if (size > styled) {
+    setStyling(size - styled, Default);
   }
 }
 
@@ -21,22 +21,35 @@
 #include <Qsci/qsciabstractapis.h>
 #include <Qsci/qscilexercustom.h>
 
+#include <functional>  // for function
+
 #include "core/command_holder.h"
+#include "core/command_matcher.h"
+
+#include "gui/commands_index.h"
 
 namespace fastonosql {
 namespace gui {
 
+// loaded key names starting with prefix, at most limit
+typedef std::function<QStringList(const QString& prefix, int limit)> keys_completion_source_t;
+
 class BaseQsciApi : public QsciAbstractAPIs {
   Q_OBJECT
  public:
   explicit BaseQsciApi(QsciLexer* lexer);
   void setFilteredVersion(uint32_t version);
+  void setKeysCompletionSource(keys_completion_source_t source);
 
  protected:
-  bool canSkipCommand(const core::CommandInfo& info) const;
+  uint32_t filteredVersion() const;
+  QStringList completeKeys(const QString& prefix) const;
+  // text of the current line before the cursor
+  QString textBeforeCursor() const;
 
  private:
   uint32_t filtered_version_;
+  keys_completion_source_t keys_source_;
 };
 
 class BaseQsciApiCommandHolder : public BaseQsciApi {
@@ -52,7 +65,10 @@ class BaseQsciApiCommandHolder : public BaseQsciApi {
   BaseQsciApiCommandHolder(const std::vector<core::CommandHolder>& commands, QsciLexer* lexer);
 
  private:
+  bool isKeyArgument(size_t command_index, const QString& args) const;
+
   const std::vector<core::CommandHolder> commands_;
+  const CommandsIndex index_;
 };
 
 class BaseQsciLexer : public QsciLexerCustom {
@@ -91,9 +107,10 @@ class BaseQsciLexerCommandHolder : public BaseQsciLexer {
 
  private:
   virtual void styleText(int start, int end) override;
-  void paintCommands(const QString& source, int start);
+  void paintCommands(const char* source, size_t size, int start);
 
   const std::vector<core::CommandHolder> commands_;
+  const core::CommandMatcher matcher_;
 };
 
 QString makeCallTip(const core::CommandInfo& info);
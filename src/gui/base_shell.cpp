@@ -157,6 +157,12 @@ void BaseShell::setFilteredVersion(uint32_t version) {
   api->setFilteredVersion(version);
 }
 
+void BaseShell::setKeysCompletionSource(keys_completion_source_t source) {
+  BaseQsciLexer* lex = lexer();
+  BaseQsciApi* api = lex->apis();
+  api->setKeysCompletionSource(source);
+}
+
 BaseShell* BaseShell::createFromType(core::connectionTypes type, bool showAutoCompl) {
   return new BaseShell(type, showAutoCompl);
 }
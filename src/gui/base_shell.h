@@ -20,14 +20,9 @@
 
 #include "core/connection_types.h"  // for connectionTypes
 
+#include "gui/base_lexer.h"                  // for keys_completion_source_t
 #include "gui/editor/fasto_editor_shell.h"  // for FastoEditorShell
 
-namespace fastonosql {
-namespace gui {
-class BaseQsciLexer;
-}
-}  // namespace fastonosql
-
 namespace fastonosql {
 namespace gui {
 
@@ -39,6 +34,7 @@ class BaseShell : public gui::FastoEditorShell {
   QString version() const;
   QString basedOn() const;
   void setFilteredVersion(uint32_t version);
+  void setKeysCompletionSource(keys_completion_source_t source);
 
   static BaseShell* createFromType(core::connectionTypes type, bool showAutoCompl);
 
@@ -0,0 +1,165 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "gui/commands_index.h"
+
+#include <algorithm>  // for lower_bound
+
+#include <common/qt/convert2string.h>  // for ConvertFromString
+
+namespace {
+const uint32_t root_node = 0;
+const uint32_t no_node = static_cast<uint32_t>(-1);
+const uint32_t max_version = static_cast<uint32_t>(-1);
+
+bool isAvailable(uint32_t since, uint32_t version) {
+  return version == UNDEFINED_SINCE || since == UNDEFINED_SINCE || since <= version;
+}
+}  // namespace
+
+namespace fastonosql {
+namespace gui {
+
+CommandsIndex::Node::Node() : edges(), commands(), min_since(max_version) {}
+
+CommandsIndex::CommandsIndex(const std::vector<core::CommandHolder>& commands) : nodes_(1), names_(), since_() {
+  for (size_t i = 0; i < commands.size(); ++i) {
+    const core::CommandHolder& cmd = commands[i];
+    QString qname;
+    common::ConvertFromString(cmd.name, &qname);
+    names_.append(qname);
+    since_.push_back(cmd.since);
+    insert(normalize(qname), i, cmd.since);
+  }
+}
+
+QString CommandsIndex::normalize(const QString& text) {
+  return text.toLower().simplified();
+}
+
+void CommandsIndex::complete(const QString& prefix, uint32_t version, indexes_t* out) const {
+  if (!out) {
+    return;
+  }
+
+  const uint32_t node = findNode(prefix);
+  if (node == no_node) {
+    return;
+  }
+
+  collect(node, version, out);
+}
+
+bool CommandsIndex::find(const QString& name, size_t* index) const {
+  const uint32_t node = findNode(normalize(name));
+  if (node == no_node || nodes_[node].commands.empty()) {
+    return false;
+  }
+
+  if (index) {
+    *index = nodes_[node].commands.front();
+  }
+  return true;
+}
+
+bool CommandsIndex::findLongestPrefixOf(const QString& text, size_t* index, int* length) const {
+  bool found = false;
+  uint32_t node = root_node;
+  for (int i = 0; i < text.length(); ++i) {
+    node = findEdge(node, text[i]);
+    if (node == no_node) {
+      break;
+    }
+
+    const bool word_end = i + 1 == text.length() || text[i + 1] == ' ';
+    if (word_end && !nodes_[node].commands.empty()) {
+      if (index) {
+        *index = nodes_[node].commands.front();
+      }
+      if (length) {
+        *length = i + 1;
+      }
+      found = true;
+    }
+  }
+  return found;
+}
+
+QString CommandsIndex::name(size_t index) const {
+  return names_[static_cast<int>(index)];
+}
+
+uint32_t CommandsIndex::findEdge(uint32_t node, QChar c) const {
+  const auto& edges = nodes_[node].edges;
+  auto it = std::lower_bound(edges.begin(), edges.end(), c,
+                             [](const std::pair<QChar, uint32_t>& edge, QChar ch) { return edge.first < ch; });
+  if (it == edges.end() || it->first != c) {
+    return no_node;
+  }
+
+  return it->second;
+}
+
+uint32_t CommandsIndex::findNode(const QString& key) const {
+  uint32_t node = root_node;
+  for (int i = 0; i < key.length() && node != no_node; ++i) {
+    node = findEdge(node, key[i]);
+  }
+  return node;
+}
+
+void CommandsIndex::insert(const QString& key, size_t index, uint32_t since) {
+  uint32_t node = root_node;
+  nodes_[node].min_since = std::min(nodes_[node].min_since, since);
+  for (int i = 0; i < key.length(); ++i) {
+    const QChar c = key[i];
+    uint32_t next = findEdge(node, c);
+    if (next == no_node) {
+      next = static_cast<uint32_t>(nodes_.size());
+      nodes_.push_back(Node());
+      auto& edges = nodes_[node].edges;
+      auto pos = std::lower_bound(edges.begin(), edges.end(), c,
+                                  [](const std::pair<QChar, uint32_t>& edge, QChar ch) { return edge.first < ch; });
+      edges.insert(pos, std::make_pair(c, next));
+    }
+    node = next;
+    nodes_[node].min_since = std::min(nodes_[node].min_since, since);
+  }
+  nodes_[node].commands.push_back(index);
+}
+
+void CommandsIndex::collect(uint32_t node, uint32_t version, indexes_t* out) const {
+  const Node& current = nodes_[node];
+  if (!isAvailable(current.min_since, version)) {
+    return;
+  }
+
+  for (size_t index : current.commands) {
+    if (isAvailable(since_[index], version)) {
+      out->push_back(index);
+    }
+  }
+
+  for (const auto& edge : current.edges) {
+    collect(edge.second, version, out);
+  }
+}
+
+}  // namespace gui
+}  // namespace fastonosql
@@ -0,0 +1,73 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <QStringList>
+
+#include <vector>  // for vector
+
+#include "core/command_holder.h"
+
+namespace fastonosql {
+namespace gui {
+
+// Prefix trie of command names (multi-word subcommands included), case-insensitive.
+// Every node keeps the lowest version of its subtree so filtered lookups skip whole
+// branches which are newer than the filter, completions cost is proportional to the matches.
+class CommandsIndex {
+ public:
+  typedef std::vector<size_t> indexes_t;
+
+  explicit CommandsIndex(const std::vector<core::CommandHolder>& commands);
+
+  // normalized text: lower-cased, leading spaces trimmed, spaces runs collapsed
+  static QString normalize(const QString& text);
+
+  // commands which names start with normalized prefix and available in version
+  // (UNDEFINED_SINCE means any version)
+  void complete(const QString& prefix, uint32_t version, indexes_t* out) const;
+  // exact case-insensitive lookup, returns false if not found
+  bool find(const QString& name, size_t* index) const;
+  // longest command name which is a whole-word prefix of normalized text
+  bool findLongestPrefixOf(const QString& text, size_t* index, int* length) const;
+
+  QString name(size_t index) const;
+
+ private:
+  struct Node {
+    Node();
+
+    std::vector<std::pair<QChar, uint32_t>> edges;  // sorted by char
+    indexes_t commands;
+    uint32_t min_since;
+  };
+
+  uint32_t findEdge(uint32_t node, QChar c) const;
+  uint32_t findNode(const QString& key) const;
+  void insert(const QString& key, size_t index, uint32_t since);
+  void collect(uint32_t node, uint32_t version, indexes_t* out) const;
+
+  std::vector<Node> nodes_;
+  QStringList names_;
+  std::vector<uint32_t> since_;
+};
+
+}  // namespace gui
+}  // namespace fastonosql
@@ -49,6 +49,8 @@ const QString trDBPath = QObject::tr("DB path");
 const QString trRemote = QObject::tr("Remote");
 const QString trLocal = QObject::tr("Local");
 const QString trDefaultDb = QObject::tr("Default database:");
+const QString trPipelineWindow = QObject::tr("Keys loading pipeline window:");
+const QString trValuePreviewSize = QObject::tr("Values preview size (0 disables):");
 }  // namespace
 
 namespace fastonosql {
@@ -100,6 +102,24 @@ ConnectionWidget::ConnectionWidget(QWidget* parent) : ConnectionBaseWidget(paren
   def_layout->addWidget(defaultDBNum_);
   addLayout(def_layout);
 
+  QHBoxLayout* pipeline_layout = new QHBoxLayout;
+  pipelineWindowLabel_ = new QLabel;
+  pipelineWindow_ = new QSpinBox;
+  pipelineWindow_->setRange(1, INT32_MAX);
+  pipelineWindow_->setValue(REDIS_DEFAULT_PIPELINE_WINDOW_SIZE);
+  pipeline_layout->addWidget(pipelineWindowLabel_);
+  pipeline_layout->addWidget(pipelineWindow_);
+  addLayout(pipeline_layout);
+
+  QHBoxLayout* preview_layout = new QHBoxLayout;
+  valuePreviewLabel_ = new QLabel;
+  valuePreviewSize_ = new QSpinBox;
+  valuePreviewSize_->setRange(0, INT32_MAX);
+  valuePreviewSize_->setValue(REDIS_DEFAULT_VALUE_PREVIEW_SIZE);
+  preview_layout->addWidget(valuePreviewLabel_);
+  preview_layout->addWidget(valuePreviewSize_);
+  addLayout(preview_layout);
+
   // ssh
 
   sshWidget_ = new SSHWidget;
@@ -140,6 +160,8 @@ void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection)
       passwordBox_->clear();
     }
     defaultDBNum_->setValue(config.dbnum);
+    pipelineWindow_->setValue(config.pipeline_window);
+    valuePreviewSize_->setValue(config.value_preview_size);
     core::SSHInfo ssh_info = redis->SSHInfo();
     sshWidget_->setInfo(ssh_info);
   }
@@ -152,6 +174,8 @@ void ConnectionWidget::retranslateUi() {
   local_->setText(trLocal);
   useAuth_->setText(tr("Use AUTH"));
   defaultDBLabel_->setText(trDefaultDb);
+  pipelineWindowLabel_->setText(trPipelineWindow);
+  valuePreviewLabel_->setText(trValuePreviewSize);
   ConnectionBaseWidget::retranslateUi();
 }
 
@@ -224,6 +248,8 @@ proxy::IConnectionSettingsBase* ConnectionWidget::createConnectionImpl(const pro
     config.auth = common::ConvertToString(passwordBox_->text());
   }
   config.dbnum = defaultDBNum_->value();
+  config.pipeline_window = pipelineWindow_->value();
+  config.value_preview_size = valuePreviewSize_->value();
   conn->SetInfo(config);
 
   core::SSHInfo info;
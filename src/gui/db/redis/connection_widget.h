@@ -66,6 +66,11 @@ class ConnectionWidget : public ConnectionBaseWidget {
   QLabel* defaultDBLabel_;
   QSpinBox* defaultDBNum_;
 
+  QLabel* pipelineWindowLabel_;
+  QSpinBox* pipelineWindow_;
+  QLabel* valuePreviewLabel_;
+  QSpinBox* valuePreviewSize_;
+
   SSHWidget* sshWidget_;
 };
 
@@ -22,9 +22,22 @@
 #include <QComboBox>
 #include <QHBoxLayout>
 #include <QLabel>
+#include <QSpinBox>
+
+#include <common/qt/convert2string.h>
 
 #include "proxy/db/rocksdb/connection_settings.h"
 
+#include "gui/widgets/path_widget.h"
+
+namespace {
+const QString trOpenMode = QObject::tr("Open mode:");
+const QString trSecondaryPath = QObject::tr("Secondary folder (empty - <database>.secondary):");
+const QString trSecondaryCaption = QObject::tr("Select secondary instance folder");
+const QString trBlockCache = QObject::tr("Block cache (MB, 0 - default):");
+const QString trBloomBits = QObject::tr("Bloom filter bits per key (0 - none):");
+}  // namespace
+
 namespace fastonosql {
 namespace gui {
 namespace rocksdb {
@@ -45,6 +58,42 @@ ConnectionWidget::ConnectionWidget(QWidget* parent)
   type_comp_layout->addWidget(compLabel_);
   type_comp_layout->addWidget(typeComparators_);
   addLayout(type_comp_layout);
+
+  QHBoxLayout* open_mode_layout = new QHBoxLayout;
+  openModes_ = new QComboBox;
+  for (uint32_t i = 0; i < SIZEOFMASS(core::rocksdb::g_open_modes); ++i) {
+    const char* om = core::rocksdb::g_open_modes[i];
+    openModes_->addItem(om, i);
+  }
+
+  openModeLabel_ = new QLabel;
+  open_mode_layout->addWidget(openModeLabel_);
+  open_mode_layout->addWidget(openModes_);
+  addLayout(open_mode_layout);
+
+  secondaryPath_ = new PathWidget(true, trSecondaryPath, trFilter, trSecondaryCaption);
+  secondaryPath_->layout()->setContentsMargins(0, 0, 0, 0);
+  addWidget(secondaryPath_);
+  typedef void (QComboBox::*ind)(int);
+  VERIFY(
+      connect(openModes_, static_cast<ind>(&QComboBox::currentIndexChanged), this, &ConnectionWidget::openModeChange));
+  openModeChange(openModes_->currentIndex());
+
+  QHBoxLayout* block_cache_layout = new QHBoxLayout;
+  blockCacheLabel_ = new QLabel;
+  blockCacheMb_ = new QSpinBox;
+  blockCacheMb_->setRange(0, INT32_MAX);
+  block_cache_layout->addWidget(blockCacheLabel_);
+  block_cache_layout->addWidget(blockCacheMb_);
+  addLayout(block_cache_layout);
+
+  QHBoxLayout* bloom_layout = new QHBoxLayout;
+  bloomBitsLabel_ = new QLabel;
+  bloomBits_ = new QSpinBox;
+  bloomBits_->setRange(0, 64);
+  bloom_layout->addWidget(bloomBitsLabel_);
+  bloom_layout->addWidget(bloomBits_);
+  addLayout(bloom_layout);
 }
 
 void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection) {
@@ -53,6 +102,12 @@ void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection)
     core::rocksdb::Config config = rock->Info();
     createDBIfMissing_->setChecked(config.create_if_missing);
     typeComparators_->setCurrentIndex(config.comparator);
+    openModes_->setCurrentIndex(config.open_mode);
+    QString secondary_path;
+    common::ConvertFromString(config.secondary_path, &secondary_path);
+    secondaryPath_->setPath(secondary_path);
+    blockCacheMb_->setValue(config.block_cache_mb);
+    bloomBits_->setValue(config.bloom_bits_per_key);
   }
   ConnectionLocalWidget::syncControls(rock);
 }
@@ -60,15 +115,26 @@ void ConnectionWidget::syncControls(proxy::IConnectionSettingsBase* connection)
 void ConnectionWidget::retranslateUi() {
   createDBIfMissing_->setText(trCreateDBIfMissing);
   compLabel_->setText(trComparator);
+  openModeLabel_->setText(trOpenMode);
+  blockCacheLabel_->setText(trBlockCache);
+  bloomBitsLabel_->setText(trBloomBits);
   ConnectionLocalWidget::retranslateUi();
 }
 
+void ConnectionWidget::openModeChange(int index) {
+  secondaryPath_->setEnabled(index == core::rocksdb::OPEN_SECONDARY);
+}
+
 proxy::IConnectionSettingsLocal* ConnectionWidget::createConnectionLocalImpl(
     const proxy::connection_path_t& path) const {
   proxy::rocksdb::ConnectionSettings* conn = new proxy::rocksdb::ConnectionSettings(path);
   core::rocksdb::Config config = conn->Info();
   config.create_if_missing = createDBIfMissing_->isChecked();
   config.comparator = static_cast<core::rocksdb::ComparatorType>(typeComparators_->currentIndex());
+  config.open_mode = static_cast<core::rocksdb::OpenMode>(openModes_->currentIndex());
+  config.secondary_path = common::ConvertToString(secondaryPath_->path());
+  config.block_cache_mb = blockCacheMb_->value();
+  config.bloom_bits_per_key = bloomBits_->value();
   conn->SetInfo(config);
   return conn;
 }
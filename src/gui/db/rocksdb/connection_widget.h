@@ -24,6 +24,8 @@
 
 namespace fastonosql {
 namespace gui {
+class PathWidget;
+
 namespace rocksdb {
 
 class ConnectionWidget : public ConnectionLocalWidget {
@@ -34,6 +36,9 @@ class ConnectionWidget : public ConnectionLocalWidget {
   virtual void syncControls(proxy::IConnectionSettingsBase* connection) override;
   virtual void retranslateUi() override;
 
+ private Q_SLOTS:
+  void openModeChange(int index);
+
  private:
   virtual proxy::IConnectionSettingsLocal* createConnectionLocalImpl(
       const proxy::connection_path_t& path) const override;
@@ -41,6 +46,13 @@ class ConnectionWidget : public ConnectionLocalWidget {
   QCheckBox* createDBIfMissing_;
   QLabel* compLabel_;
   QComboBox* typeComparators_;
+  QLabel* openModeLabel_;
+  QComboBox* openModes_;
+  PathWidget* secondaryPath_;
+  QLabel* blockCacheLabel_;
+  QSpinBox* blockCacheMb_;
+  QLabel* bloomBitsLabel_;
+  QSpinBox* bloomBits_;
 };
 
 }  // namespace rocksdb
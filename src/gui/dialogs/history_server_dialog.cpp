@@ -18,6 +18,8 @@
 
 #include "gui/dialogs/history_server_dialog.h"
 
+#include <algorithm>  // for max
+
 #include <QComboBox>
 #include <QHBoxLayout>
 #include <QPushButton>
@@ -26,6 +28,7 @@
 #include <common/qt/convert2string.h>         // for ConvertFromString
 #include <common/qt/gui/base/graph_widget.h>  // for GraphWidget, etc
 #include <common/qt/gui/glass_widget.h>       // for GlassWidget
+#include <common/time.h>                      // for current_mstime
 
 #include "core/db_traits.h"
 #include "proxy/server/iserver.h"  // for IServer
@@ -36,7 +39,14 @@
 
 namespace {
 const QString trHistoryTemplate_1S = QObject::tr("%1 history");
-}
+const QString trLastHour = QObject::tr("Last hour");
+const QString trLastDay = QObject::tr("Last 24 hours");
+const QString trLastWeek = QObject::tr("Last 7 days");
+const QString trWholeHistory = QObject::tr("Whole history");
+
+const common::time64_t hour_msec = 60 * 60 * 1000;
+const common::time64_t history_ranges_msec[] = {hour_msec, 24 * hour_msec, 7 * 24 * hour_msec, 0};
+}  // namespace
 
 namespace fastonosql {
 namespace gui {
@@ -53,6 +63,10 @@ ServerHistoryDialog::ServerHistoryDialog(proxy::IServerSPtr server, QWidget* par
 
   clearHistory_ = new QPushButton;
   VERIFY(connect(clearHistory_, &QPushButton::clicked, this, &ServerHistoryDialog::clearHistory));
+  historyRange_ = new QComboBox;
+  for (size_t i = 0; i < SIZEOFMASS(history_ranges_msec); ++i) {
+    historyRange_->addItem(QString(), static_cast<qlonglong>(history_ranges_msec[i]));
+  }
   serverInfoGroupsNames_ = new QComboBox;
   serverInfoFields_ = new QComboBox;
 
@@ -61,6 +75,8 @@ ServerHistoryDialog::ServerHistoryDialog(proxy::IServerSPtr server, QWidget* par
                  &ServerHistoryDialog::refreshInfoFields));
   VERIFY(connect(serverInfoFields_, static_cast<curc>(&QComboBox::currentIndexChanged), this,
                  &ServerHistoryDialog::refreshGraph));
+  VERIFY(connect(historyRange_, static_cast<curc>(&QComboBox::currentIndexChanged), this,
+                 &ServerHistoryDialog::changeHistoryRange));
 
   const auto fields = core::InfoFieldsFromType(server_->Type());
   for (size_t i = 0; i < fields.size(); ++i) {
@@ -72,6 +88,7 @@ ServerHistoryDialog::ServerHistoryDialog(proxy::IServerSPtr server, QWidget* par
   }
   QVBoxLayout* setingsLayout = new QVBoxLayout;
   setingsLayout->addWidget(clearHistory_);
+  setingsLayout->addWidget(historyRange_);
   setingsLayout->addWidget(serverInfoGroupsNames_);
   setingsLayout->addWidget(serverInfoFields_);
   settingsGraph_->setLayout(setingsLayout);
@@ -114,7 +131,7 @@ void ServerHistoryDialog::finishLoadServerHistoryInfo(const proxy::events_info::
     return;
   }
 
-  infos_ = res.infos();
+  history_ = res.history();
   reset();
 }
 
@@ -132,7 +149,14 @@ void ServerHistoryDialog::finishClearServerHistory(const proxy::events_info::Cle
 }
 
 void ServerHistoryDialog::snapShotAdd(core::ServerInfoSnapShoot snapshot) {
-  infos_.push_back(snapshot);
+  if (!snapshot.isValid()) {
+    return;
+  }
+
+  if (history_.Columns().empty()) {
+    history_ = core::ServerInfoHistory(core::ServerInfoHistoryColumnsFromType(server_->Type()));
+  }
+  history_.AddRow(core::MakeServerInfoHistoryRow(snapshot.info.get(), history_.Columns(), snapshot.msec));
   reset();
 }
 
@@ -170,25 +194,25 @@ void ServerHistoryDialog::refreshGraph(int index) {
   QVariant var = serverInfoFields_->itemData(index);
   uint32_t indexIn = qvariant_cast<uint32_t>(var);
   common::qt::gui::GraphWidget::nodes_container_type nodes;
-  for (auto it = infos_.begin(); it != infos_.end(); ++it) {
-    auto val = *it;
-    if (!val.isValid()) {
-      continue;
-    }
-
-    common::Value* value = val.info->ValueByIndexes(serverIndex, indexIn);  // allocate
-    if (value) {
-      qreal graphY = 0.0f;
-      if (value->GetAsDouble(&graphY)) {
-        nodes.push_back(std::make_pair(val.msec, graphY));
-      }
-      delete value;
+  const core::ServerInfoHistory::values_t* values = history_.ColumnValues(serverIndex, indexIn);
+  if (values) {
+    const core::ServerInfoHistory::stamps_t& stamps = history_.Stamps();
+    for (size_t i = 0; i < stamps.size(); ++i) {
+      nodes.push_back(std::make_pair(stamps[i], (*values)[i]));
     }
   }
 
   graphWidget_->setNodes(nodes);
 }
 
+void ServerHistoryDialog::changeHistoryRange(int index) {
+  if (index == -1) {
+    return;
+  }
+
+  requestHistoryInfo();
+}
+
 void ServerHistoryDialog::changeEvent(QEvent* e) {
   if (e->type() == QEvent::LanguageChange) {
     retranslateUi();
@@ -211,10 +235,22 @@ void ServerHistoryDialog::retranslateUi() {
     setWindowTitle(trHistoryTemplate_1S.arg(name));
   }
   clearHistory_->setText(translations::trClearHistory);
+  historyRange_->setItemText(0, trLastHour);
+  historyRange_->setItemText(1, trLastDay);
+  historyRange_->setItemText(2, trLastWeek);
+  historyRange_->setItemText(3, trWholeHistory);
 }
 
 void ServerHistoryDialog::requestHistoryInfo() {
-  proxy::events_info::ServerInfoHistoryRequest req(this);
+  // about one point per graph pixel, the whole history is read as recorded
+  const common::time64_t range = historyRange_->currentData().toLongLong();
+  common::time64_t from = 0;
+  common::time64_t resolution = 0;
+  if (range) {
+    from = common::time::current_mstime() - range;
+    resolution = range / std::max(graphWidget_->width(), 1);
+  }
+  proxy::events_info::ServerInfoHistoryRequest req(this, from, 0, resolution);
   server_->RequestHistoryInfo(req);
 }
 
@@ -63,6 +63,7 @@ class ServerHistoryDialog : public QDialog {
 
   void refreshInfoFields(int index);
   void refreshGraph(int index);
+  void changeHistoryRange(int index);
 
  protected:
   virtual void changeEvent(QEvent* e) override;
@@ -75,13 +76,14 @@ class ServerHistoryDialog : public QDialog {
 
   QWidget* settingsGraph_;
   QPushButton* clearHistory_;
+  QComboBox* historyRange_;
   QComboBox* serverInfoGroupsNames_;
   QComboBox* serverInfoFields_;
 
   common::qt::gui::GraphWidget* graphWidget_;
 
   common::qt::gui::GlassWidget* glassWidget_;
-  proxy::events_info::ServerInfoHistoryResponce::infos_container_type infos_;
+  core::ServerInfoHistory history_;
   const proxy::IServerSPtr server_;
 };
 }  // namespace gui
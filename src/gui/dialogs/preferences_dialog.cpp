@@ -47,11 +47,14 @@ const QString trShowAutoCompletion = QObject::tr("Show autocompletion");
 const QString trAutoOpenConsole = QObject::tr("Automatically open console");
 const QString trAutoConnectDb = QObject::tr("Automatically connect to db");
 const QString trFastViewValues = QObject::tr("Fast view values");
+const QString trLazyExplorer = QObject::tr("Load explorer tree lazily");
 const QString trLanguage = QObject::tr("Language:");
 const QString trSupportedUiStyles = QObject::tr("Supported UI styles:");
 const QString trSupportedFonts = QObject::tr("Supported fonts:");
 const QString trDefaultViews = QObject::tr("Default views:");
 const QString trHistoryDirectory = QObject::tr("History directory:");
+const QString trStreamingRetention = QObject::tr("Streaming output retention (replies):");
+const QString trConnectionLanes = QObject::tr("Separate connections for background loads and monitoring");
 }  // namespace
 
 namespace fastonosql {
@@ -88,6 +91,8 @@ PreferencesDialog::PreferencesDialog(QWidget* parent) : QDialog(parent) {
 
   autoConnectDB_ = new QCheckBox;
   generalLayout->addWidget(autoConnectDB_, 2, 0);
+  lazyExplorer_ = new QCheckBox;
+  generalLayout->addWidget(lazyExplorer_, 2, 1);
 
   stylesLabel_ = new QLabel;
   stylesComboBox_ = new QComboBox;
@@ -124,6 +129,16 @@ PreferencesDialog::PreferencesDialog(QWidget* parent) : QDialog(parent) {
   logDirLabel_ = new QLabel;
   generalLayout->addWidget(logDirLabel_, 7, 0);
   generalLayout->addWidget(logDirPath_, 7, 1);
+
+  streamingRetentionLabel_ = new QLabel;
+  streamingRetentionSpinBox_ = new QSpinBox;
+  streamingRetentionSpinBox_->setRange(100, 1000000);
+  streamingRetentionSpinBox_->setSingleStep(1000);
+  generalLayout->addWidget(streamingRetentionLabel_, 8, 0);
+  generalLayout->addWidget(streamingRetentionSpinBox_, 8, 1);
+
+  connectionLanes_ = new QCheckBox;
+  generalLayout->addWidget(connectionLanes_, 9, 0, 1, 2);
   generalBox_->setLayout(generalLayout);
 
   // main layout
@@ -168,6 +183,9 @@ void PreferencesDialog::accept() {
   proxy::SettingsManager::GetInstance().SetAutoOpenConsole(autoOpenConsole_->isChecked());
   proxy::SettingsManager::GetInstance().SetAutoConnectDB(autoConnectDB_->isChecked());
   proxy::SettingsManager::GetInstance().SetFastViewKeys(fastViewKeys_->isChecked());
+  proxy::SettingsManager::GetInstance().SetLazyExplorer(lazyExplorer_->isChecked());
+  proxy::SettingsManager::GetInstance().SetStreamingRetention(streamingRetentionSpinBox_->value());
+  proxy::SettingsManager::GetInstance().SetConnectionLanes(connectionLanes_->isChecked());
 
   return QDialog::accept();
 }
@@ -187,6 +205,9 @@ void PreferencesDialog::syncWithSettings() {
   autoOpenConsole_->setChecked(proxy::SettingsManager::GetInstance().AutoOpenConsole());
   autoConnectDB_->setChecked(proxy::SettingsManager::GetInstance().AutoConnectDB());
   fastViewKeys_->setChecked(proxy::SettingsManager::GetInstance().FastViewKeys());
+  lazyExplorer_->setChecked(proxy::SettingsManager::GetInstance().LazyExplorer());
+  streamingRetentionSpinBox_->setValue(proxy::SettingsManager::GetInstance().StreamingRetention());
+  connectionLanes_->setChecked(proxy::SettingsManager::GetInstance().ConnectionLanes());
 }
 
 void PreferencesDialog::changeEvent(QEvent* e) {
@@ -210,11 +231,14 @@ void PreferencesDialog::retranslateUi() {
   autoOpenConsole_->setText(trAutoOpenConsole);
   autoConnectDB_->setText(trAutoConnectDb);
   fastViewKeys_->setText(trFastViewValues);
+  lazyExplorer_->setText(trLazyExplorer);
   langLabel_->setText(trLanguage);
   stylesLabel_->setText(trSupportedUiStyles);
   fontLabel_->setText(trSupportedFonts);
   defaultViewLabel_->setText(trDefaultViews);
   logDirLabel_->setText(trHistoryDirectory);
+  streamingRetentionLabel_->setText(trStreamingRetention);
+  connectionLanes_->setText(trConnectionLanes);
 }
 
 }  // namespace gui
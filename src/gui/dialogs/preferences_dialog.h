@@ -73,6 +73,10 @@ class PreferencesDialog : public QDialog {
   QCheckBox* autoOpenConsole_;
   QCheckBox* autoConnectDB_;
   QCheckBox* fastViewKeys_;
+  QCheckBox* lazyExplorer_;
+  QLabel* streamingRetentionLabel_;
+  QSpinBox* streamingRetentionSpinBox_;
+  QCheckBox* connectionLanes_;
 };
 }  // namespace gui
 }  // namespace fastonosql
@@ -18,6 +18,8 @@
 
 #include "gui/explorer/explorer_tree_item.h"
 
+#include <algorithm>
+
 #include <QIcon>
 
 #include <common/net/types.h>  // for ConvertToString
@@ -39,8 +41,34 @@
 
 #include "gui/gui_factory.h"  // for GuiFactory
 
+#define EXPLORER_KEYS_PAGE_SIZE 1000
+#define EXPLORER_REVALIDATE_KEYS_BATCH_SIZE 500
+
 namespace fastonosql {
 namespace gui {
+KeysPageCursor::KeysPageCursor() : pattern(), count_keys(0), cursor(0), has_more(false), fetching(false) {}
+
+KeysPageCursor::KeysPageCursor(const std::string& pattern, uint32_t count_keys, uint64_t cursor)
+    : pattern(pattern), count_keys(count_keys), cursor(cursor), has_more(true), fetching(false) {}
+
+bool KeysPageCursor::CanFetchMore() const {
+  return has_more && !fetching;
+}
+
+bool KeysPageCursor::IsWaitingFor(uint64_t cursor_in) const {
+  return fetching && cursor == cursor_in;
+}
+
+void KeysPageCursor::SetCursorOut(uint64_t cursor_out) {
+  cursor = cursor_out;
+  has_more = cursor_out != 0;
+  fetching = false;
+}
+
+void KeysPageCursor::CancelFetch() {
+  fetching = false;
+}
+
 IExplorerTreeItem::IExplorerTreeItem(TreeItem* parent) : TreeItem(parent, nullptr) {}
 
 ExplorerServerItem::ExplorerServerItem(proxy::IServerSPtr server, TreeItem* parent)
@@ -118,7 +146,13 @@ proxy::IClusterSPtr ExplorerClusterItem::cluster() const {
 }
 
 ExplorerDatabaseItem::ExplorerDatabaseItem(proxy::IDatabaseSPtr db, ExplorerServerItem* parent)
-    : IExplorerTreeItem(parent), db_(db) {
+    : IExplorerTreeItem(parent),
+      db_(db),
+      content_cursor_(),
+      revalidate_keys_(),
+      revalidate_pos_(0),
+      keys_index_(),
+      namespaces_index_() {
   DCHECK(db_);
 }
 
@@ -141,18 +175,13 @@ size_t ExplorerDatabaseItem::totalKeysCount() const {
   return inf->DBKeysCount();
 }
 
-size_t ExplorerDatabaseItem::loadedKeysCount() const {
-  size_t sz = 0;
-  common::qt::gui::forEachRecursive(this, [&sz](const common::qt::gui::TreeItem* item) {
-    const ExplorerKeyItem* key_item = dynamic_cast<const ExplorerKeyItem*>(item);  // +
-    if (!key_item) {
-      return;
-    }
-
-    sz++;
-  });
+bool ExplorerDatabaseItem::isTotalKeysCountExact() const {
+  core::IDataBaseInfoSPtr inf = info();
+  return inf->IsDBKeysCountExact();
+}
 
-  return sz;
+size_t ExplorerDatabaseItem::loadedKeysCount() const {
+  return keys_index_.size();
 }
 
 proxy::IServerSPtr ExplorerDatabaseItem::server() const {
@@ -165,13 +194,51 @@ proxy::IDatabaseSPtr ExplorerDatabaseItem::db() const {
   return db_;
 }
 
-void ExplorerDatabaseItem::loadContent(const std::string& pattern, uint32_t countKeys) {
+void ExplorerDatabaseItem::loadContent(const std::string& pattern, uint32_t countKeys, uint64_t cursor) {
   proxy::IDatabaseSPtr dbs = db();
   CHECK(dbs);
-  proxy::events_info::LoadDatabaseContentRequest req(this, dbs->Info(), pattern, countKeys);
+  content_cursor_ = KeysPageCursor(pattern, countKeys, cursor);
+  content_cursor_.fetching = true;
+  proxy::events_info::LoadDatabaseContentRequest req(this, dbs->Info(), pattern, countKeys, cursor);
   dbs->LoadContent(req);
 }
 
+void ExplorerDatabaseItem::loadKeysCount() {
+  proxy::IDatabaseSPtr dbs = db();
+  CHECK(dbs);
+  proxy::events_info::LoadDatabaseKeysCountRequest req(this, dbs->Info());
+  dbs->LoadKeysCount(req);
+}
+
+void ExplorerDatabaseItem::loadKeysCache() {
+  proxy::IDatabaseSPtr dbs = db();
+  CHECK(dbs);
+  proxy::events_info::LoadKeysCacheRequest req(this, dbs->Info());
+  dbs->LoadKeysCache(req);
+}
+
+void ExplorerDatabaseItem::revalidateKeys(const std::vector<core::NDbKValue>& keys) {
+  revalidate_keys_ = keys;
+  revalidate_pos_ = 0;
+  revalidateNextKeys();
+}
+
+void ExplorerDatabaseItem::revalidateNextKeys() {
+  if (revalidate_pos_ >= revalidate_keys_.size()) {
+    revalidate_keys_.clear();
+    revalidate_pos_ = 0;
+    return;
+  }
+
+  proxy::IDatabaseSPtr dbs = db();
+  CHECK(dbs);
+  const size_t end = std::min<size_t>(revalidate_pos_ + EXPLORER_REVALIDATE_KEYS_BATCH_SIZE, revalidate_keys_.size());
+  std::vector<core::NDbKValue> batch(revalidate_keys_.begin() + revalidate_pos_, revalidate_keys_.begin() + end);
+  revalidate_pos_ = end;
+  proxy::events_info::RevalidateKeysRequest req(this, dbs->Info(), batch);
+  dbs->RevalidateKeys(req);
+}
+
 void ExplorerDatabaseItem::setDefault() {
   proxy::IDatabaseSPtr dbs = db();
   CHECK(dbs);
@@ -324,8 +391,89 @@ void ExplorerDatabaseItem::removeAllKeys() {
   dbs->Execute(req);
 }
 
+bool ExplorerDatabaseItem::canFetchMore() const {
+  return content_cursor_.CanFetchMore();
+}
+
+void ExplorerDatabaseItem::fetchMore() {
+  loadContent(content_cursor_.pattern, content_cursor_.count_keys, content_cursor_.cursor);
+}
+
+void ExplorerDatabaseItem::setContentCursor(uint64_t cursor_out) {
+  content_cursor_.SetCursorOut(cursor_out);
+}
+
+void ExplorerDatabaseItem::cancelContentFetch() {
+  content_cursor_.CancelFetch();
+}
+
+void ExplorerDatabaseItem::resetContentCursor() {
+  content_cursor_ = KeysPageCursor();
+}
+
+ExplorerKeyItem* ExplorerDatabaseItem::findKeyItem(const core::key_t& key) const {
+  auto it = keys_index_.find(key.ToBytes());
+  if (it == keys_index_.end()) {
+    return nullptr;
+  }
+
+  return it->second;
+}
+
+QStringList ExplorerDatabaseItem::loadedKeys(const QString& prefix, int limit) const {
+  QStringList result;
+  const std::string raw_prefix = common::ConvertToString(prefix);
+  for (auto it = keys_index_.lower_bound(raw_prefix); it != keys_index_.end() && result.size() < limit; ++it) {
+    if (it->first.compare(0, raw_prefix.size(), raw_prefix) != 0) {
+      break;
+    }
+
+    QString qkey;
+    common::ConvertFromString(it->first, &qkey);
+    result.append(qkey);
+  }
+  return result;
+}
+
+void ExplorerDatabaseItem::registerKeyItem(ExplorerKeyItem* item) {
+  CHECK(item);
+  const core::NKey key = item->key();
+  keys_index_[key.GetKey().ToBytes()] = item;
+}
+
+void ExplorerDatabaseItem::unregisterKeyItem(ExplorerKeyItem* item) {
+  CHECK(item);
+  const core::NKey key = item->key();
+  auto it = keys_index_.find(key.GetKey().ToBytes());
+  if (it != keys_index_.end() && it->second == item) {
+    keys_index_.erase(it);
+  }
+}
+
+ExplorerNSItem* ExplorerDatabaseItem::findNSItem(const QString& path) const {
+  return namespaces_index_.value(path, nullptr);
+}
+
+void ExplorerDatabaseItem::registerNSItem(ExplorerNSItem* item) {
+  CHECK(item);
+  namespaces_index_.insert(item->name(), item);
+}
+
+void ExplorerDatabaseItem::unregisterNSItem(ExplorerNSItem* item) {
+  CHECK(item);
+  auto it = namespaces_index_.find(item->name());
+  if (it != namespaces_index_.end() && it.value() == item) {
+    namespaces_index_.erase(it);
+  }
+}
+
+void ExplorerDatabaseItem::clearItemsIndex() {
+  keys_index_.clear();
+  namespaces_index_.clear();
+}
+
 ExplorerKeyItem::ExplorerKeyItem(const core::NDbKValue& dbv, IExplorerTreeItem* parent)
-    : IExplorerTreeItem(parent), dbv_(dbv) {}
+    : IExplorerTreeItem(parent), dbv_(dbv), stale_(false) {}
 
 ExplorerDatabaseItem* ExplorerKeyItem::db() const {
   TreeItem* par = parent();
@@ -420,8 +568,16 @@ void ExplorerKeyItem::setTTL(core::ttl_t ttl) {
   }
 }
 
+bool ExplorerKeyItem::isStale() const {
+  return stale_;
+}
+
+void ExplorerKeyItem::setStale(bool stale) {
+  stale_ = stale;
+}
+
 ExplorerNSItem::ExplorerNSItem(const QString& name, IExplorerTreeItem* parent)
-    : IExplorerTreeItem(parent), name_(name) {}
+    : IExplorerTreeItem(parent), name_(name), content_cursor_(), keys_count_hint_(0) {}
 
 QString ExplorerNSItem::name() const {
   return name_;
@@ -465,7 +621,7 @@ size_t ExplorerNSItem::keyCount() const {
     sz++;
   });
 
-  return sz;
+  return std::max(sz, keys_count_hint_);
 }
 
 void ExplorerNSItem::removeBranch() {
@@ -480,5 +636,43 @@ void ExplorerNSItem::removeBranch() {
     par->removeKey(key_item->key());
   });
 }
+
+void ExplorerNSItem::resetContent(const std::string& pattern) {
+  content_cursor_ = KeysPageCursor(pattern, EXPLORER_KEYS_PAGE_SIZE, 0);
+}
+
+bool ExplorerNSItem::canFetchMore() const {
+  return content_cursor_.CanFetchMore();
+}
+
+void ExplorerNSItem::fetchMore() {
+  ExplorerDatabaseItem* par = db();
+  CHECK(par);
+  proxy::IDatabaseSPtr dbs = par->db();
+  content_cursor_.fetching = true;
+  proxy::events_info::LoadDatabaseContentRequest req(this, dbs->Info(), content_cursor_.pattern,
+                                                     content_cursor_.count_keys, content_cursor_.cursor);
+  dbs->LoadContent(req);
+}
+
+bool ExplorerNSItem::isWaitingContent(uint64_t cursor_in) const {
+  return content_cursor_.IsWaitingFor(cursor_in);
+}
+
+void ExplorerNSItem::setContentCursor(uint64_t cursor_out) {
+  content_cursor_.SetCursorOut(cursor_out);
+}
+
+void ExplorerNSItem::cancelContentFetch() {
+  content_cursor_.CancelFetch();
+}
+
+size_t ExplorerNSItem::keysCountHint() const {
+  return keys_count_hint_;
+}
+
+void ExplorerNSItem::setKeysCountHint(size_t count) {
+  keys_count_hint_ = count;
+}
 }  // namespace gui
 }  // namespace fastonosql
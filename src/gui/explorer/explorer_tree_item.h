@@ -18,7 +18,11 @@
 
 #pragma once
 
-#include <QString>
+#include <map>
+#include <string>
+
+#include <QHash>
+#include <QStringList>
 
 #include <common/qt/gui/base/tree_item.h>  // for TreeItem
 
@@ -34,6 +38,23 @@ class IServer;
 
 namespace fastonosql {
 namespace gui {
+// position of a page by page content load, used by the lazy explorer tree
+struct KeysPageCursor {
+  KeysPageCursor();
+  KeysPageCursor(const std::string& pattern, uint32_t count_keys, uint64_t cursor);
+
+  bool CanFetchMore() const;
+  bool IsWaitingFor(uint64_t cursor_in) const;
+  void SetCursorOut(uint64_t cursor_out);
+  void CancelFetch();  // failed page, the same cursor can be fetched again
+
+  std::string pattern;
+  uint32_t count_keys;
+  uint64_t cursor;
+  bool has_more;
+  bool fetching;
+};
+
 class IExplorerTreeItem : public common::qt::gui::TreeItem {
  public:
   enum eColumn { eName = 0, eCountColumns };
@@ -86,6 +107,9 @@ class ExplorerClusterItem : public IExplorerTreeItem {
   const proxy::IClusterSPtr cluster_;
 };
 
+class ExplorerNSItem;
+class ExplorerKeyItem;
+
 class ExplorerDatabaseItem : public IExplorerTreeItem {
  public:
   ExplorerDatabaseItem(proxy::IDatabaseSPtr db, ExplorerServerItem* parent);
@@ -94,14 +118,27 @@ class ExplorerDatabaseItem : public IExplorerTreeItem {
   virtual eType type() const override;
   bool isDefault() const;
   size_t totalKeysCount() const;
+  bool isTotalKeysCountExact() const;
   size_t loadedKeysCount() const;
 
   proxy::IServerSPtr server() const;
   proxy::IDatabaseSPtr db() const;
 
-  void loadContent(const std::string& pattern, uint32_t countKeys);
+  void loadContent(const std::string& pattern, uint32_t countKeys, uint64_t cursor = 0);
+  void loadKeysCount();
   void setDefault();
 
+  // keys saved by the previous session, checked against the server in batches one after another
+  void loadKeysCache();
+  void revalidateKeys(const std::vector<core::NDbKValue>& keys);
+  void revalidateNextKeys();
+
+  bool canFetchMore() const;
+  void fetchMore();
+  void setContentCursor(uint64_t cursor_out);
+  void cancelContentFetch();
+  void resetContentCursor();
+
   core::IDataBaseInfoSPtr info() const;
 
   void renameKey(const core::NKey& key, const QString& newName);
@@ -114,8 +151,28 @@ class ExplorerDatabaseItem : public IExplorerTreeItem {
 
   void removeAllKeys();
 
+  // lookup indexes of the loaded subtree, maintained by ExplorerTreeModel
+  ExplorerKeyItem* findKeyItem(const core::key_t& key) const;
+  QStringList loadedKeys(const QString& prefix, int limit) const;
+  void registerKeyItem(ExplorerKeyItem* item);
+  void unregisterKeyItem(ExplorerKeyItem* item);
+
+  ExplorerNSItem* findNSItem(const QString& path) const;
+  void registerNSItem(ExplorerNSItem* item);
+  void unregisterNSItem(ExplorerNSItem* item);
+
+  void clearItemsIndex();
+
  private:
+  typedef std::map<std::string, ExplorerKeyItem*> keys_index_t;  // raw key bytes -> item, ordered for prefix lookups
+  typedef QHash<QString, ExplorerNSItem*> namespaces_index_t;              // joined namespace path -> item
+
   const proxy::IDatabaseSPtr db_;
+  KeysPageCursor content_cursor_;
+  std::vector<core::NDbKValue> revalidate_keys_;
+  size_t revalidate_pos_;
+  keys_index_t keys_index_;
+  namespaces_index_t namespaces_index_;
 };
 
 class ExplorerNSItem : public IExplorerTreeItem {
@@ -130,8 +187,21 @@ class ExplorerNSItem : public IExplorerTreeItem {
 
   void removeBranch();
 
+  // lazy mode: keys are fetched page by page with "<namespace><separator>*" pattern
+  void resetContent(const std::string& pattern);
+  bool canFetchMore() const;
+  void fetchMore();
+  bool isWaitingContent(uint64_t cursor_in) const;
+  void setContentCursor(uint64_t cursor_out);
+  void cancelContentFetch();
+
+  size_t keysCountHint() const;
+  void setKeysCountHint(size_t count);
+
  private:
   QString name_;
+  KeysPageCursor content_cursor_;
+  size_t keys_count_hint_;
 };
 
 class ExplorerKeyItem : public IExplorerTreeItem {
@@ -156,8 +226,13 @@ class ExplorerKeyItem : public IExplorerTreeItem {
   void loadValueFromDb();
   void setTTL(core::ttl_t ttl);
 
+  // shown from the keys cache, but not found on the server anymore
+  bool isStale() const;
+  void setStale(bool stale);
+
  private:
   core::NDbKValue dbv_;
+  bool stale_;
 };
 }  // namespace gui
 }  // namespace fastonosql
@@ -18,6 +18,8 @@
 
 #include "gui/explorer/explorer_tree_model.h"
 
+#include <QFont>
+#include <QHash>
 #include <QIcon>
 
 #include <common/net/types.h>  // for ConvertToString
@@ -56,11 +58,30 @@ const QString trLocalServerToolTipTemplate_2S = QObject::tr(
 const QString trDbToolTipTemplate_1S = QObject::tr("<b>Db size:</b> %1 keys<br/>");
 const QString trNamespace_1S = QObject::tr("<b>Group size:</b> %1 keys<br/>");
 const QString trKey_1S = QObject::tr("Key displayed in: <b>%1</b> format<br/>");
+const QString trStaleKey = QObject::tr("Key from the previous session, not found on the server anymore<br/>");
 }  // namespace
 
 namespace fastonosql {
 namespace gui {
-ExplorerTreeModel::ExplorerTreeModel(QObject* parent) : TreeModel(parent) {}
+namespace {
+QString totalKeysCountText(ExplorerDatabaseItem* db) {
+  QString count = QString::number(db->totalKeysCount());
+  return db->isTotalKeysCountExact() ? count : "~" + count;  // estimated by engine statistics
+}
+
+size_t namespaceLevel(ExplorerNSItem* ns) {
+  size_t level = 0;
+  for (common::qt::gui::TreeItem* par = ns; par; par = par->parent()) {
+    if (dynamic_cast<ExplorerNSItem*>(par)) {  // +
+      level++;
+    }
+  }
+
+  return level;
+}
+}  // namespace
+
+ExplorerTreeModel::ExplorerTreeModel(QObject* parent) : TreeModel(parent), lazy_loading_(false) {}
 
 QVariant ExplorerTreeModel::data(const QModelIndex& index, int role) const {
   if (!index.isValid()) {
@@ -103,7 +124,7 @@ QVariant ExplorerTreeModel::data(const QModelIndex& index, int role) const {
     } else if (type == IExplorerTreeItem::eDatabase) {
       ExplorerDatabaseItem* db = static_cast<ExplorerDatabaseItem*>(node);
       if (db->isDefault()) {
-        return trDbToolTipTemplate_1S.arg(db->totalKeysCount());
+        return trDbToolTipTemplate_1S.arg(totalKeysCountText(db));
       }
     } else if (type == IExplorerTreeItem::eNamespace) {
       ExplorerNSItem* ns = static_cast<ExplorerNSItem*>(node);
@@ -112,6 +133,9 @@ QVariant ExplorerTreeModel::data(const QModelIndex& index, int role) const {
       ExplorerKeyItem* key = static_cast<ExplorerKeyItem*>(node);
       core::NKey nkey = key->key();
       core::key_t key_str = nkey.GetKey();
+      if (key->isStale()) {
+        return trStaleKey;
+      }
       return trKey_1S.arg(key_str.GetType() == core::key_t::BINARY_KEY ? "hex" : "text");
     }
 
@@ -150,7 +174,7 @@ QVariant ExplorerTreeModel::data(const QModelIndex& index, int role) const {
         return node->name();
       } else if (type == IExplorerTreeItem::eDatabase) {
         ExplorerDatabaseItem* db = static_cast<ExplorerDatabaseItem*>(node);
-        return QString("%1 (%2/%3)").arg(node->name()).arg(db->loadedKeysCount()).arg(db->totalKeysCount());  // db
+        return QString("%1 (%2/%3)").arg(node->name()).arg(db->loadedKeysCount()).arg(totalKeysCountText(db));  // db
       } else if (type == IExplorerTreeItem::eNamespace) {
         ExplorerNSItem* ns = static_cast<ExplorerNSItem*>(node);
         return QString("%1 (%2)").arg(node->name()).arg(ns->keyCount());  // db
@@ -176,6 +200,15 @@ QVariant ExplorerTreeModel::data(const QModelIndex& index, int role) const {
     }
   }
 
+  if (role == Qt::FontRole && type == IExplorerTreeItem::eKey) {
+    ExplorerKeyItem* key = static_cast<ExplorerKeyItem*>(node);
+    if (key->isStale()) {
+      QFont font;
+      font.setStrikeOut(true);
+      return font;
+    }
+  }
+
   return QVariant();
 }  // namespace gui
 
@@ -207,6 +240,62 @@ int ExplorerTreeModel::columnCount(const QModelIndex& parent) const {
   return ExplorerServerItem::eCountColumns;
 }
 
+bool ExplorerTreeModel::hasChildren(const QModelIndex& parent) const {
+  if (lazy_loading_ && parent.isValid()) {
+    IExplorerTreeItem* node = common::qt::item<common::qt::gui::TreeItem*, IExplorerTreeItem*>(parent);
+    if (node && node->type() == IExplorerTreeItem::eNamespace) {
+      ExplorerNSItem* ns = static_cast<ExplorerNSItem*>(node);
+      return ns->childrenCount() != 0 || ns->canFetchMore();
+    }
+  }
+
+  return TreeModel::hasChildren(parent);
+}
+
+bool ExplorerTreeModel::canFetchMore(const QModelIndex& parent) const {
+  if (!lazy_loading_ || !parent.isValid()) {
+    return false;
+  }
+
+  IExplorerTreeItem* node = common::qt::item<common::qt::gui::TreeItem*, IExplorerTreeItem*>(parent);
+  if (!node) {
+    return false;
+  }
+
+  if (node->type() == IExplorerTreeItem::eDatabase) {
+    ExplorerDatabaseItem* db = static_cast<ExplorerDatabaseItem*>(node);
+    return db->canFetchMore();
+  } else if (node->type() == IExplorerTreeItem::eNamespace) {
+    ExplorerNSItem* ns = static_cast<ExplorerNSItem*>(node);
+    return ns->canFetchMore();
+  }
+
+  return false;
+}
+
+void ExplorerTreeModel::fetchMore(const QModelIndex& parent) {
+  if (!canFetchMore(parent)) {
+    return;
+  }
+
+  IExplorerTreeItem* node = common::qt::item<common::qt::gui::TreeItem*, IExplorerTreeItem*>(parent);
+  if (node->type() == IExplorerTreeItem::eDatabase) {
+    ExplorerDatabaseItem* db = static_cast<ExplorerDatabaseItem*>(node);
+    db->fetchMore();
+  } else if (node->type() == IExplorerTreeItem::eNamespace) {
+    ExplorerNSItem* ns = static_cast<ExplorerNSItem*>(node);
+    ns->fetchMore();
+  }
+}
+
+bool ExplorerTreeModel::isLazyLoading() const {
+  return lazy_loading_;
+}
+
+void ExplorerTreeModel::setLazyLoading(bool lazy) {
+  lazy_loading_ = lazy;
+}
+
 void ExplorerTreeModel::addCluster(proxy::IClusterSPtr cluster) {
   if (!cluster) {
     return;
@@ -374,10 +463,197 @@ void ExplorerTreeModel::addKey(proxy::IServer* server,
     common::qt::gui::TreeItem* parent_nitem = nitem->parent();
     QModelIndex parent_index = createIndex(parent_nitem->indexOf(nitem), 0, nitem);
     ExplorerKeyItem* item = new ExplorerKeyItem(dbv, nitem);
+    dbs->registerKeyItem(item);
     insertItem(parent_index, item);
   }
 }
 
+void ExplorerTreeModel::addKeys(proxy::IServer* server,
+                                core::IDataBaseInfoSPtr db,
+                                const std::vector<core::NDbKValue>& keys,
+                                const std::string& ns_separator) {
+  ExplorerServerItem* parent = findServerItem(server);
+  if (!parent) {
+    return;
+  }
+
+  ExplorerDatabaseItem* dbs = findDatabaseItem(parent, db);
+  if (!dbs) {
+    return;
+  }
+
+  // new key items grouped by parent, in order of first appearance
+  std::vector<std::pair<IExplorerTreeItem*, std::vector<ExplorerKeyItem*>>> groups;
+  QHash<IExplorerTreeItem*, size_t> groups_index;
+  for (const core::NDbKValue& dbv : keys) {
+    core::NKey key = dbv.GetKey();
+    ExplorerKeyItem* existing = findKeyItem(dbs, key);
+    if (existing) {
+      if (existing->isStale()) {  // loaded again, so it's back on the server
+        existing->setDbv(dbv);
+        existing->setStale(false);
+        updateKeyItem(existing);
+      }
+      continue;
+    }
+
+    IExplorerTreeItem* nitem = dbs;
+    proxy::KeyInfo kinf = proxy::MakeKeyInfo(key.GetKey(), ns_separator);
+    if (kinf.HasNamespace()) {
+      nitem = findOrCreateNSItem(dbs, kinf);
+    }
+
+    auto group = groups_index.find(nitem);
+    if (group == groups_index.end()) {
+      group = groups_index.insert(nitem, groups.size());
+      groups.push_back(std::make_pair(nitem, std::vector<ExplorerKeyItem*>()));
+    }
+
+    ExplorerKeyItem* item = new ExplorerKeyItem(dbv, nitem);
+    dbs->registerKeyItem(item);  // also dedups keys repeated inside the batch
+    groups[group.value()].second.push_back(item);
+  }
+
+  for (size_t i = 0; i < groups.size(); ++i) {
+    insertKeyItems(groups[i].first, groups[i].second);
+  }
+}
+
+void ExplorerTreeModel::addKeysPage(proxy::IServer* server,
+                                    core::IDataBaseInfoSPtr db,
+                                    const std::string& pattern,
+                                    uint64_t cursor_in,
+                                    uint64_t cursor_out,
+                                    const std::vector<core::NDbKValue>& keys,
+                                    const std::string& ns_separator) {
+  if (!lazy_loading_) {
+    addKeys(server, db, keys, ns_separator);
+    return;
+  }
+
+  ExplorerServerItem* parent = findServerItem(server);
+  if (!parent) {
+    return;
+  }
+
+  ExplorerDatabaseItem* dbs = findDatabaseItem(parent, db);
+  if (!dbs) {
+    return;
+  }
+
+  IExplorerTreeItem* owner = dbs;
+  size_t level = 0;
+  ExplorerNSItem* ns = findPageNSItem(dbs, pattern, ns_separator);
+  if (ns) {
+    if (!ns->isWaitingContent(cursor_in)) {  // collapsed or reloaded since the page was requested
+      return;
+    }
+
+    ns->setContentCursor(cursor_out);
+    owner = ns;
+    level = namespaceLevel(ns);
+  }
+
+  if (owner == dbs) {
+    dbs->setContentCursor(cursor_out);
+  }
+
+  // only direct children of the owner are materialized, deeper keys just bump the namespace count
+  std::vector<ExplorerKeyItem*> items;
+  for (const core::NDbKValue& dbv : keys) {
+    core::NKey key = dbv.GetKey();
+    ExplorerKeyItem* existing = findKeyItem(dbs, key);
+    if (existing) {
+      if (existing->isStale()) {  // loaded again, so it's back on the server
+        existing->setDbv(dbv);
+        existing->setStale(false);
+        updateKeyItem(existing);
+      }
+      continue;
+    }
+
+    proxy::KeyInfo kinf = proxy::MakeKeyInfo(key.GetKey(), ns_separator);
+    if (kinf.GetNspaceSize() > level) {
+      ExplorerNSItem* ns = findOrCreateLazyNSItem(dbs, owner, kinf, level, ns_separator);
+      ns->setKeysCountHint(ns->keysCountHint() + 1);
+      continue;
+    }
+
+    ExplorerKeyItem* item = new ExplorerKeyItem(dbv, owner);
+    dbs->registerKeyItem(item);
+    items.push_back(item);
+  }
+
+  insertKeyItems(owner, items);
+}
+
+void ExplorerTreeModel::cancelKeysPage(proxy::IServer* server,
+                                       core::IDataBaseInfoSPtr db,
+                                       const std::string& pattern,
+                                       uint64_t cursor_in,
+                                       const std::string& ns_separator) {
+  ExplorerServerItem* parent = findServerItem(server);
+  if (!parent) {
+    return;
+  }
+
+  ExplorerDatabaseItem* dbs = findDatabaseItem(parent, db);
+  if (!dbs) {
+    return;
+  }
+
+  ExplorerNSItem* ns = findPageNSItem(dbs, pattern, ns_separator);
+  if (!ns) {
+    dbs->cancelContentFetch();
+    return;
+  }
+
+  if (ns->isWaitingContent(cursor_in)) {
+    ns->cancelContentFetch();
+  }
+}
+
+void ExplorerTreeModel::unloadNamespace(const QModelIndex& index) {
+  if (!lazy_loading_ || !index.isValid()) {
+    return;
+  }
+
+  IExplorerTreeItem* node = common::qt::item<common::qt::gui::TreeItem*, IExplorerTreeItem*>(index);
+  if (!node || node->type() != IExplorerTreeItem::eNamespace) {
+    return;
+  }
+
+  ExplorerNSItem* ns = static_cast<ExplorerNSItem*>(node);
+  if (!ns->childrenCount()) {
+    return;
+  }
+
+  ExplorerDatabaseItem* dbs = ns->db();
+  CHECK(dbs);
+  common::qt::gui::forEachRecursive(ns, [dbs, ns](common::qt::gui::TreeItem* item) {
+    if (item == ns) {
+      return;
+    }
+
+    ExplorerKeyItem* key_item = dynamic_cast<ExplorerKeyItem*>(item);  // +
+    if (key_item) {
+      dbs->unregisterKeyItem(key_item);
+      return;
+    }
+
+    ExplorerNSItem* ns_item = dynamic_cast<ExplorerNSItem*>(item);  // +
+    if (ns_item) {
+      dbs->unregisterNSItem(ns_item);
+    }
+  });
+
+  proxy::IServerSPtr server = dbs->server();
+  std::string nspace = common::ConvertToString(ns->name());
+  ns->setKeysCountHint(ns->keyCount());
+  ns->resetContent(nspace + server->NsSeparator() + "*");
+  removeAllItems(index);
+}
+
 void ExplorerTreeModel::removeKey(proxy::IServer* server, core::IDataBaseInfoSPtr db, const core::NKey& key) {
   ExplorerServerItem* parent = findServerItem(server);
   if (!parent) {
@@ -393,6 +669,7 @@ void ExplorerTreeModel::removeKey(proxy::IServer* server, core::IDataBaseInfoSPt
   if (keyit) {
     common::qt::gui::TreeItem* par = keyit->parent();
     QModelIndex index = createIndex(par->indexOf(keyit), 0, keyit);
+    dbs->unregisterKeyItem(keyit);
     removeItem(index.parent(), keyit);
   }
 }
@@ -412,14 +689,26 @@ void ExplorerTreeModel::updateKey(proxy::IServer* server,
   }
 
   ExplorerKeyItem* keyit = findKeyItem(dbs, old_key);
-  if (keyit) {
-    common::qt::gui::TreeItem* par = keyit->parent();
-    int index_key = par->indexOf(keyit);
-    keyit->setKey(new_key);
-    QModelIndex key_index1 = createIndex(index_key, ExplorerKeyItem::eName, dbs);
-    QModelIndex key_index2 = createIndex(index_key, ExplorerKeyItem::eCountColumns, dbs);
-    updateItem(key_index1, key_index2);
+  if (!keyit) {
+    return;
+  }
+
+  ExplorerKeyItem* existing = findKeyItem(dbs, new_key);
+  if (existing && existing != keyit) {  // rename overwrites destination key
+    common::qt::gui::TreeItem* epar = existing->parent();
+    QModelIndex eindex = createIndex(epar->indexOf(existing), 0, existing);
+    dbs->unregisterKeyItem(existing);
+    removeItem(eindex.parent(), existing);
   }
+
+  common::qt::gui::TreeItem* par = keyit->parent();
+  int index_key = par->indexOf(keyit);
+  dbs->unregisterKeyItem(keyit);
+  keyit->setKey(new_key);
+  dbs->registerKeyItem(keyit);
+  QModelIndex key_index1 = createIndex(index_key, ExplorerKeyItem::eName, keyit);
+  QModelIndex key_index2 = createIndex(index_key, ExplorerKeyItem::eCountColumns, keyit);
+  updateItem(key_index1, key_index2);
 }
 
 void ExplorerTreeModel::updateValue(proxy::IServer* server, core::IDataBaseInfoSPtr db, const core::NDbKValue& dbv) {
@@ -438,8 +727,8 @@ void ExplorerTreeModel::updateValue(proxy::IServer* server, core::IDataBaseInfoS
     common::qt::gui::TreeItem* par = keyit->parent();
     int index_key = par->indexOf(keyit);
     keyit->setDbv(dbv);
-    QModelIndex key_index1 = createIndex(index_key, ExplorerKeyItem::eName, dbs);
-    QModelIndex key_index2 = createIndex(index_key, ExplorerKeyItem::eCountColumns, dbs);
+    QModelIndex key_index1 = createIndex(index_key, ExplorerKeyItem::eName, keyit);
+    QModelIndex key_index2 = createIndex(index_key, ExplorerKeyItem::eCountColumns, keyit);
     updateItem(key_index1, key_index2);
   }
 }
@@ -456,9 +745,93 @@ void ExplorerTreeModel::removeAllKeys(proxy::IServer* server, core::IDataBaseInf
   };
 
   QModelIndex parentdb = createIndex(parent->indexOf(dbs), 0, dbs);
+  dbs->clearItemsIndex();
+  dbs->resetContentCursor();
   removeAllItems(parentdb);
 }
 
+void ExplorerTreeModel::loadKeysCache(proxy::IServer* server, core::IDataBaseInfoSPtr db) {
+  ExplorerServerItem* parent = findServerItem(server);
+  if (!parent) {
+    return;
+  }
+
+  ExplorerDatabaseItem* dbs = findDatabaseItem(parent, db);
+  if (!dbs || dbs->loadedKeysCount()) {
+    return;
+  }
+
+  dbs->loadKeysCache();
+}
+
+void ExplorerTreeModel::addCachedKeys(proxy::IServer* server,
+                                      core::IDataBaseInfoSPtr db,
+                                      const std::vector<core::NDbKValue>& keys,
+                                      const std::string& ns_separator) {
+  ExplorerServerItem* parent = findServerItem(server);
+  if (!parent) {
+    return;
+  }
+
+  ExplorerDatabaseItem* dbs = findDatabaseItem(parent, db);
+  if (!dbs || keys.empty()) {
+    return;
+  }
+
+  addKeysPage(server, db, std::string(), 0, 0, keys, ns_separator);
+  dbs->revalidateKeys(keys);
+}
+
+void ExplorerTreeModel::revalidateKeys(proxy::IServer* server,
+                                       core::IDataBaseInfoSPtr db,
+                                       const std::vector<core::NDbKValue>& alive_keys,
+                                       const std::vector<core::NDbKValue>& stale_keys) {
+  ExplorerServerItem* parent = findServerItem(server);
+  if (!parent) {
+    return;
+  }
+
+  ExplorerDatabaseItem* dbs = findDatabaseItem(parent, db);
+  if (!dbs) {
+    return;
+  }
+
+  for (const core::NDbKValue& dbv : alive_keys) {
+    ExplorerKeyItem* keyit = findKeyItem(dbs, dbv.GetKey());
+    if (keyit) {
+      keyit->setDbv(dbv);
+      keyit->setStale(false);
+      updateKeyItem(keyit);
+    }
+  }
+
+  for (const core::NDbKValue& dbv : stale_keys) {
+    ExplorerKeyItem* keyit = findKeyItem(dbs, dbv.GetKey());
+    if (keyit) {
+      keyit->setStale(true);
+      updateKeyItem(keyit);
+    }
+  }
+
+  dbs->revalidateNextKeys();
+}
+
+QStringList ExplorerTreeModel::loadedKeys(proxy::IServer* server, const QString& prefix, int limit) const {
+  ExplorerServerItem* parent = findServerItem(server);
+  if (!parent) {
+    return QStringList();
+  }
+
+  for (size_t i = 0; i < parent->childrenCount(); ++i) {
+    ExplorerDatabaseItem* item = dynamic_cast<ExplorerDatabaseItem*>(parent->child(i));  // +
+    if (item && item->isDefault()) {
+      return item->loadedKeys(prefix, limit);
+    }
+  }
+
+  return QStringList();
+}
+
 ExplorerClusterItem* ExplorerTreeModel::findClusterItem(proxy::IClusterSPtr cl) {
   common::qt::gui::TreeItem* parent = root_;
   if (!parent) {
@@ -523,61 +896,45 @@ ExplorerDatabaseItem* ExplorerTreeModel::findDatabaseItem(ExplorerServerItem* se
   return nullptr;
 }
 
-ExplorerKeyItem* ExplorerTreeModel::findKeyItem(IExplorerTreeItem* db_or_ns, const core::NKey& key) const {
-  return static_cast<ExplorerKeyItem*>(
-      common::qt::gui::findItemRecursive(db_or_ns, [key](common::qt::gui::TreeItem* item) -> bool {
-        ExplorerKeyItem* key_item = dynamic_cast<ExplorerKeyItem*>(item);  // +
-        if (!key_item) {
-          return false;
-        }
-
-        core::NKey ckey = key_item->key();
-        return ckey.GetKey() == key.GetKey();
-      }));
+ExplorerKeyItem* ExplorerTreeModel::findKeyItem(ExplorerDatabaseItem* db, const core::NKey& key) const {
+  return db->findKeyItem(key.GetKey());
 }
 
-ExplorerNSItem* ExplorerTreeModel::findNSItem(IExplorerTreeItem* db_or_ns, const QString& name) const {
-  return static_cast<ExplorerNSItem*>(
-      common::qt::gui::findItemRecursive(db_or_ns, [name](common::qt::gui::TreeItem* item) -> bool {
-        ExplorerNSItem* ns_item = dynamic_cast<ExplorerNSItem*>(item);  // +
-        if (!ns_item) {
-          return false;
-        }
+// a "<namespace><separator>*" page belongs to the namespace item, any other one to the database
+ExplorerNSItem* ExplorerTreeModel::findPageNSItem(ExplorerDatabaseItem* db,
+                                                  const std::string& pattern,
+                                                  const std::string& ns_separator) const {
+  const std::string ns_suffix = ns_separator + "*";
+  if (pattern.size() <= ns_suffix.size() ||
+      pattern.compare(pattern.size() - ns_suffix.size(), ns_suffix.size(), ns_suffix) != 0) {
+    return nullptr;
+  }
 
-        return ns_item->name() == name;
-      }));
+  QString qnspace;
+  common::ConvertFromString(pattern.substr(0, pattern.size() - ns_suffix.size()), &qnspace);
+  return db->findNSItem(qnspace);
 }
 
-ExplorerNSItem* ExplorerTreeModel::findOrCreateNSItem(IExplorerTreeItem* db_or_ns, const proxy::KeyInfo& kinf) {
+ExplorerNSItem* ExplorerTreeModel::findOrCreateNSItem(ExplorerDatabaseItem* db, const proxy::KeyInfo& kinf) {
   std::string nspace = kinf.GetNspace();
   QString qnspace;
   common::ConvertFromString(nspace, &qnspace);
-  ExplorerNSItem* founded_item = findNSItem(db_or_ns, qnspace);
+  ExplorerNSItem* founded_item = db->findNSItem(qnspace);
   if (founded_item) {
     return founded_item;
   }
 
   size_t sz = kinf.GetNspaceSize();
-  IExplorerTreeItem* par = db_or_ns;
+  IExplorerTreeItem* par = db;
   for (size_t i = 0; i < sz; ++i) {
-    ExplorerNSItem* item = nullptr;
     nspace = kinf.JoinNamespace(i);
     common::ConvertFromString(nspace, &qnspace);
-    for (size_t j = 0; j < par->childrenCount(); ++j) {
-      ExplorerNSItem* ns_item = dynamic_cast<ExplorerNSItem*>(par->child(j));  // +
-      if (!ns_item) {
-        continue;
-      }
-
-      if (ns_item->name() == qnspace) {
-        item = ns_item;
-      }
-    }
-
+    ExplorerNSItem* item = db->findNSItem(qnspace);
     if (!item) {
       common::qt::gui::TreeItem* gpar = par->parent();
       QModelIndex parentdb = createIndex(gpar->indexOf(par), 0, par);
       item = new ExplorerNSItem(qnspace, par);
+      db->registerNSItem(item);
       insertItem(parentdb, item);
     }
 
@@ -587,5 +944,50 @@ ExplorerNSItem* ExplorerTreeModel::findOrCreateNSItem(IExplorerTreeItem* db_or_n
 
   return founded_item;
 }
+
+ExplorerNSItem* ExplorerTreeModel::findOrCreateLazyNSItem(ExplorerDatabaseItem* db,
+                                                          IExplorerTreeItem* parent,
+                                                          const proxy::KeyInfo& kinf,
+                                                          size_t level,
+                                                          const std::string& ns_separator) {
+  const std::string nspace = kinf.JoinNamespace(level);
+  QString qnspace;
+  common::ConvertFromString(nspace, &qnspace);
+  ExplorerNSItem* item = db->findNSItem(qnspace);
+  if (item) {
+    return item;
+  }
+
+  common::qt::gui::TreeItem* gpar = parent->parent();
+  QModelIndex parent_index = createIndex(gpar->indexOf(parent), 0, parent);
+  item = new ExplorerNSItem(qnspace, parent);
+  item->resetContent(nspace + ns_separator + "*");
+  db->registerNSItem(item);
+  insertItem(parent_index, item);
+  return item;
+}
+
+void ExplorerTreeModel::insertKeyItems(IExplorerTreeItem* parent, const std::vector<ExplorerKeyItem*>& items) {
+  if (items.empty()) {
+    return;
+  }
+
+  common::qt::gui::TreeItem* gpar = parent->parent();
+  QModelIndex parent_index = createIndex(gpar->indexOf(parent), 0, parent);
+  int first = static_cast<int>(parent->childrenCount());
+  beginInsertRows(parent_index, first, first + static_cast<int>(items.size()) - 1);
+  for (ExplorerKeyItem* item : items) {
+    parent->addChildren(item);
+  }
+  endInsertRows();
+}
+
+void ExplorerTreeModel::updateKeyItem(ExplorerKeyItem* item) {
+  common::qt::gui::TreeItem* par = item->parent();
+  int index_key = par->indexOf(item);
+  QModelIndex key_index1 = createIndex(index_key, ExplorerKeyItem::eName, item);
+  QModelIndex key_index2 = createIndex(index_key, ExplorerKeyItem::eCountColumns, item);
+  updateItem(key_index1, key_index2);
+}
 }  // namespace gui
 }  // namespace fastonosql
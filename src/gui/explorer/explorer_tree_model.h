@@ -18,6 +18,11 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
+#include <QStringList>
+
 #include <common/qt/gui/base/tree_model.h>  // for TreeModel
 
 #include "proxy/database/idatabase.h"
@@ -57,6 +62,13 @@ class ExplorerTreeModel : public common::qt::gui::TreeModel {
   virtual QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
   virtual int columnCount(const QModelIndex& parent) const override;
 
+  virtual bool hasChildren(const QModelIndex& parent = QModelIndex()) const override;
+  virtual bool canFetchMore(const QModelIndex& parent) const override;
+  virtual void fetchMore(const QModelIndex& parent) override;
+
+  bool isLazyLoading() const;
+  void setLazyLoading(bool lazy);
+
   void addCluster(proxy::IClusterSPtr cluster);
   void removeCluster(proxy::IClusterSPtr cluster);
 
@@ -75,6 +87,23 @@ class ExplorerTreeModel : public common::qt::gui::TreeModel {
               core::IDataBaseInfoSPtr db,
               const core::NDbKValue& dbv,
               const std::string& ns_separator);
+  void addKeys(proxy::IServer* server,
+               core::IDataBaseInfoSPtr db,
+               const std::vector<core::NDbKValue>& keys,
+               const std::string& ns_separator);
+  void addKeysPage(proxy::IServer* server,
+                   core::IDataBaseInfoSPtr db,
+                   const std::string& pattern,
+                   uint64_t cursor_in,
+                   uint64_t cursor_out,
+                   const std::vector<core::NDbKValue>& keys,
+                   const std::string& ns_separator);
+  void cancelKeysPage(proxy::IServer* server,
+                      core::IDataBaseInfoSPtr db,
+                      const std::string& pattern,
+                      uint64_t cursor_in,
+                      const std::string& ns_separator);
+  void unloadNamespace(const QModelIndex& index);
   void removeKey(proxy::IServer* server, core::IDataBaseInfoSPtr db, const core::NKey& key);
   void updateKey(proxy::IServer* server,
                  core::IDataBaseInfoSPtr db,
@@ -83,14 +112,39 @@ class ExplorerTreeModel : public common::qt::gui::TreeModel {
   void updateValue(proxy::IServer* server, core::IDataBaseInfoSPtr db, const core::NDbKValue& dbv);
   void removeAllKeys(proxy::IServer* server, core::IDataBaseInfoSPtr db);
 
+  // keys cache of the previous session: shown at once, then revalidated against the server
+  void loadKeysCache(proxy::IServer* server, core::IDataBaseInfoSPtr db);
+  void addCachedKeys(proxy::IServer* server,
+                     core::IDataBaseInfoSPtr db,
+                     const std::vector<core::NDbKValue>& keys,
+                     const std::string& ns_separator);
+  void revalidateKeys(proxy::IServer* server,
+                      core::IDataBaseInfoSPtr db,
+                      const std::vector<core::NDbKValue>& alive_keys,
+                      const std::vector<core::NDbKValue>& stale_keys);
+
+  // keys of the default database already loaded into the tree, used by the shell completion
+  QStringList loadedKeys(proxy::IServer* server, const QString& prefix, int limit) const;
+
  private:
   ExplorerClusterItem* findClusterItem(proxy::IClusterSPtr cl);
   ExplorerSentinelItem* findSentinelItem(proxy::ISentinelSPtr sentinel);
   ExplorerServerItem* findServerItem(proxy::IServer* server) const;
   ExplorerDatabaseItem* findDatabaseItem(ExplorerServerItem* server, core::IDataBaseInfoSPtr db) const;
-  ExplorerKeyItem* findKeyItem(IExplorerTreeItem* db_or_ns, const core::NKey& key) const;
-  ExplorerNSItem* findNSItem(IExplorerTreeItem* db_or_ns, const QString& name) const;
-  ExplorerNSItem* findOrCreateNSItem(IExplorerTreeItem* db_or_ns, const proxy::KeyInfo& kinf);
+  ExplorerKeyItem* findKeyItem(ExplorerDatabaseItem* db, const core::NKey& key) const;
+  ExplorerNSItem* findOrCreateNSItem(ExplorerDatabaseItem* db, const proxy::KeyInfo& kinf);
+  ExplorerNSItem* findPageNSItem(ExplorerDatabaseItem* db,
+                                 const std::string& pattern,
+                                 const std::string& ns_separator) const;
+  ExplorerNSItem* findOrCreateLazyNSItem(ExplorerDatabaseItem* db,
+                                         IExplorerTreeItem* parent,
+                                         const proxy::KeyInfo& kinf,
+                                         size_t level,
+                                         const std::string& ns_separator);
+  void insertKeyItems(IExplorerTreeItem* parent, const std::vector<ExplorerKeyItem*>& items);
+  void updateKeyItem(ExplorerKeyItem* item);
+
+  bool lazy_loading_;
 };
 }  // namespace gui
 }  // namespace fastonosql
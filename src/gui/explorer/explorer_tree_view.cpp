@@ -29,6 +29,7 @@
 
 #include <common/qt/gui/regexp_input_dialog.h>
 
+#include "core/data_dump.h"              // for DUMP_ARCHIVE_EXTENSION
 #include "proxy/cluster/icluster.h"       // for ICluster
 #include "proxy/sentinel/isentinel.h"     // for Sentinel, etc
 #include "proxy/server/iserver_remote.h"  // for IServer, IServerRemote
@@ -59,6 +60,7 @@ const QString trConnectDisconnect = QObject::tr("Connect/Disconnect");
 const QString trClearDb = QObject::tr("Clear database");
 const QString trRealyRemoveAllKeysTemplate_1S = QObject::tr("Really remove all keys from %1 database?");
 const QString trLoadContentTemplate_1S = QObject::tr("Load %1 content");
+const QString trCountKeys = QObject::tr("Count keys exactly");
 const QString trReallyShutdownTemplate_1S = QObject::tr("Really shutdown \"%1\" server?");
 const QString trSetMaxConnectionOnServerTemplate_1S = QObject::tr("Set max connection on %1 server");
 const QString trMaximumConnectionTemplate = QObject::tr("Maximum connection:");
@@ -77,6 +79,7 @@ namespace gui {
 
 ExplorerTreeView::ExplorerTreeView(QWidget* parent) : QTreeView(parent) {
   source_model_ = new ExplorerTreeModel(this);
+  source_model_->setLazyLoading(proxy::SettingsManager::GetInstance().LazyExplorer());
   proxy_model_ = new ExplorerTreeSortFilterProxyModel(this);
   proxy_model_->setSourceModel(source_model_);
   proxy_model_->setDynamicSortFilter(true);
@@ -90,10 +93,21 @@ ExplorerTreeView::ExplorerTreeView(QWidget* parent) : QTreeView(parent) {
   setSelectionMode(QAbstractItemView::ExtendedSelection);
   setContextMenuPolicy(Qt::CustomContextMenu);
   VERIFY(connect(this, &ExplorerTreeView::customContextMenuRequested, this, &ExplorerTreeView::showContextMenu));
+  VERIFY(connect(this, &ExplorerTreeView::collapsed, this, &ExplorerTreeView::unloadBranch));
+  VERIFY(connect(this, &ExplorerTreeView::expanded, this, &ExplorerTreeView::syncLazyLoading));
 
   retranslateUi();
 }
 
+QStringList ExplorerTreeView::loadedKeys(proxy::IServerSPtr server, const QString& prefix, int limit) const {
+  if (!server) {
+    DNOTREACHED();
+    return QStringList();
+  }
+
+  return source_model_->loadedKeys(server.get(), prefix, limit);
+}
+
 void ExplorerTreeView::addServer(proxy::IServerSPtr server) {
   if (!server) {
     DNOTREACHED();
@@ -237,10 +251,20 @@ void ExplorerTreeView::showContextMenu(const QPoint& point) {
     QAction* infoServerAction = new QAction(translations::trInfo, this);
     VERIFY(connect(infoServerAction, &QAction::triggered, this, &ExplorerTreeView::openInfoServerDialog));
 
+    QAction* importDataAction = new QAction(translations::trImportData, this);
+    VERIFY(connect(importDataAction, &QAction::triggered, this, &ExplorerTreeView::importDataServer));
+
+    QAction* backupDataAction = new QAction(translations::trBackupData, this);
+    VERIFY(connect(backupDataAction, &QAction::triggered, this, &ExplorerTreeView::backupDataServer));
+
     loadDatabaseAction->setEnabled(is_connected);
     menu.addAction(loadDatabaseAction);
     infoServerAction->setEnabled(is_connected);
     menu.addAction(infoServerAction);
+    importDataAction->setEnabled(is_connected);
+    menu.addAction(importDataAction);
+    backupDataAction->setEnabled(is_connected && !is_cluster_member);
+    menu.addAction(backupDataAction);
 
     if (is_redis) {
       QAction* propertyServerAction = new QAction(translations::trProperty, this);
@@ -315,6 +339,9 @@ void ExplorerTreeView::showContextMenu(const QPoint& point) {
     QAction* loadContentAction = new QAction(translations::trLoadContOfDataBases, this);
     VERIFY(connect(loadContentAction, &QAction::triggered, this, &ExplorerTreeView::loadContentDb));
 
+    QAction* countKeysAction = new QAction(trCountKeys, this);
+    VERIFY(connect(countKeysAction, &QAction::triggered, this, &ExplorerTreeView::countKeysDb));
+
     QAction* createKeyAction = new QAction(translations::trCreateKey, this);
     VERIFY(connect(createKeyAction, &QAction::triggered, this, &ExplorerTreeView::createKey));
 
@@ -334,6 +361,9 @@ void ExplorerTreeView::showContextMenu(const QPoint& point) {
     bool is_connected = server->IsConnected();
     loadContentAction->setEnabled(is_default && is_connected);
 
+    menu.addAction(countKeysAction);
+    countKeysAction->setEnabled(is_default && is_connected && !db->isTotalKeysCountExact());
+
     menu.addAction(createKeyAction);
     createKeyAction->setEnabled(is_default && is_connected);
 
@@ -676,13 +706,58 @@ void ExplorerTreeView::importServer() {
     proxy::IServerSPtr server = node->server();
     QString filepath =
         QFileDialog::getOpenFileName(this, translations::trImport, QString(), translations::trfilterForRdb);
-    if (filepath.isEmpty() && server) {
+    if (!filepath.isEmpty() && server) {
       proxy::events_info::ExportInfoRequest req(this, common::ConvertToString(filepath));
       server->ExportFromPath(req);
     }
   }
 }
 
+void ExplorerTreeView::importDataServer() {
+  QModelIndexList selected = selectedEqualTypeIndexes();
+  for (QModelIndex ind : selected) {
+    ExplorerServerItem* node = common::qt::item<common::qt::gui::TreeItem*, ExplorerServerItem*>(ind);
+    if (!node) {
+      DNOTREACHED();
+      continue;
+    }
+
+    proxy::IServerSPtr server = node->server();
+    QString filepath =
+        QFileDialog::getOpenFileName(this, translations::trImportData, QString(), translations::trfilterForDump);
+    if (!filepath.isEmpty() && server) {
+      proxy::events_info::ExportInfoRequest req(this, common::ConvertToString(filepath));
+      server->ExportFromPath(req);
+    }
+  }
+}
+
+void ExplorerTreeView::backupDataServer() {
+  QModelIndexList selected = selectedEqualTypeIndexes();
+  for (QModelIndex ind : selected) {
+    ExplorerServerItem* node = common::qt::item<common::qt::gui::TreeItem*, ExplorerServerItem*>(ind);
+    if (!node) {
+      DNOTREACHED();
+      continue;
+    }
+
+    proxy::IServerSPtr server = node->server();
+    // existing unfinished archive is continued, so overwrite confirmation would be misleading
+    QString filepath = QFileDialog::getSaveFileName(this, translations::trBackupData, QString(),
+                                                    translations::trfilterForBackup, nullptr,
+                                                    QFileDialog::DontConfirmOverwrite);
+    if (filepath.isEmpty() || !server) {
+      continue;
+    }
+
+    if (!filepath.endsWith(DUMP_ARCHIVE_EXTENSION)) {
+      filepath += DUMP_ARCHIVE_EXTENSION;
+    }
+    proxy::events_info::BackupInfoRequest req(this, common::ConvertToString(filepath));
+    server->BackupToPath(req);
+  }
+}
+
 void ExplorerTreeView::shutdownServer() {
   QModelIndexList selected = selectedEqualTypeIndexes();
   for (QModelIndex ind : selected) {
@@ -727,6 +802,19 @@ void ExplorerTreeView::loadContentDb() {
   }
 }
 
+void ExplorerTreeView::countKeysDb() {
+  QModelIndexList selected = selectedEqualTypeIndexes();
+  for (QModelIndex ind : selected) {
+    ExplorerDatabaseItem* node = common::qt::item<common::qt::gui::TreeItem*, ExplorerDatabaseItem*>(ind);
+    if (!node) {
+      DNOTREACHED();
+      continue;
+    }
+
+    node->loadKeysCount();
+  }
+}
+
 void ExplorerTreeView::removeAllKeys() {
   QModelIndexList selected = selectedEqualTypeIndexes();
   for (QModelIndex ind : selected) {
@@ -930,6 +1018,23 @@ void ExplorerTreeView::setTTL() {
   }
 }
 
+void ExplorerTreeView::unloadBranch(const QModelIndex& index) {
+  // lazy mode keeps only expanded namespaces in memory
+  source_model_->unloadNamespace(proxy_model_->mapToSource(index));
+}
+
+void ExplorerTreeView::syncLazyLoading(const QModelIndex& index) {
+  // the preference may have changed since the explorer was created, databases pick it up when expanded
+  QModelIndex source_index = proxy_model_->mapToSource(index);
+  IExplorerTreeItem* node = common::qt::item<common::qt::gui::TreeItem*, IExplorerTreeItem*>(source_index);
+  if (!node || node->type() != IExplorerTreeItem::eDatabase) {
+    return;
+  }
+
+  source_model_->setLazyLoading(proxy::SettingsManager::GetInstance().LazyExplorer());
+  source_model_->fetchMore(source_index);
+}
+
 void ExplorerTreeView::startLoadDatabases(const proxy::events_info::LoadDatabasesInfoRequest& req) {
   UNUSED(req);
 }
@@ -947,6 +1052,9 @@ void ExplorerTreeView::finishLoadDatabases(const proxy::events_info::LoadDatabas
   for (size_t i = 0; i < dbs.size(); ++i) {
     core::IDataBaseInfoSPtr db = dbs[i];
     source_model_->addDatabase(serv, db);
+    if (db->IsDefault()) {  // show keys of the previous session until they are loaded
+      source_model_->loadKeysCache(serv, db);
+    }
   }
 }
 
@@ -955,6 +1063,21 @@ void ExplorerTreeView::startLoadDatabaseContent(const proxy::events_info::LoadDa
 }
 
 void ExplorerTreeView::finishLoadDatabaseContent(const proxy::events_info::LoadDatabaseContentResponce& res) {
+  proxy::IServer* serv = qobject_cast<proxy::IServer*>(sender());
+  CHECK(serv);
+
+  std::string ns = serv->NsSeparator();
+  common::Error er = res.errorInfo();
+  if (er && er->IsError()) {  // the page can be fetched again
+    source_model_->cancelKeysPage(serv, res.inf, res.pattern, res.cursor_in, ns);
+    return;
+  }
+
+  source_model_->addKeysPage(serv, res.inf, res.pattern, res.cursor_in, res.cursor_out, res.keys, ns);
+  source_model_->updateDb(serv, res.inf);
+}
+
+void ExplorerTreeView::finishLoadDatabaseKeysCount(const proxy::events_info::LoadDatabaseKeysCountResponce& res) {
   common::Error er = res.errorInfo();
   if (er && er->IsError()) {
     return;
@@ -963,16 +1086,35 @@ void ExplorerTreeView::finishLoadDatabaseContent(const proxy::events_info::LoadD
   proxy::IServer* serv = qobject_cast<proxy::IServer*>(sender());
   CHECK(serv);
 
-  proxy::events_info::LoadDatabaseContentResponce::keys_container_t keys = res.keys;
-  std::string ns = serv->NsSeparator();
-  for (size_t i = 0; i < keys.size(); ++i) {
-    core::NDbKValue key = keys[i];
-    source_model_->addKey(serv, res.inf, key, ns);
+  source_model_->updateDb(serv, res.inf);
+}
+
+void ExplorerTreeView::finishLoadKeysCache(const proxy::events_info::LoadKeysCacheResponce& res) {
+  common::Error er = res.errorInfo();
+  if (er && er->IsError()) {
+    return;
   }
 
+  proxy::IServer* serv = qobject_cast<proxy::IServer*>(sender());
+  CHECK(serv);
+
+  std::string ns = serv->NsSeparator();
+  source_model_->addCachedKeys(serv, res.inf, res.keys, ns);
   source_model_->updateDb(serv, res.inf);
 }
 
+void ExplorerTreeView::finishRevalidateKeys(const proxy::events_info::RevalidateKeysResponce& res) {
+  common::Error er = res.errorInfo();
+  if (er && er->IsError()) {  // the rest stays unchecked until the next load
+    return;
+  }
+
+  proxy::IServer* serv = qobject_cast<proxy::IServer*>(sender());
+  CHECK(serv);
+
+  source_model_->revalidateKeys(serv, res.inf, res.keys, res.stale_keys);
+}
+
 void ExplorerTreeView::startExecuteCommand(const proxy::events_info::ExecuteInfoRequest& req) {
   UNUSED(req);
 }
@@ -1064,6 +1206,10 @@ void ExplorerTreeView::syncWithServer(proxy::IServer* server) {
       connect(server, &proxy::IServer::LoadDataBaseContentStarted, this, &ExplorerTreeView::startLoadDatabaseContent));
   VERIFY(connect(server, &proxy::IServer::LoadDatabaseContentFinished, this,
                  &ExplorerTreeView::finishLoadDatabaseContent));
+  VERIFY(connect(server, &proxy::IServer::LoadDatabaseKeysCountFinished, this,
+                 &ExplorerTreeView::finishLoadDatabaseKeysCount));
+  VERIFY(connect(server, &proxy::IServer::LoadKeysCacheFinished, this, &ExplorerTreeView::finishLoadKeysCache));
+  VERIFY(connect(server, &proxy::IServer::RevalidateKeysFinished, this, &ExplorerTreeView::finishRevalidateKeys));
   VERIFY(connect(server, &proxy::IServer::ExecuteStarted, this, &ExplorerTreeView::startExecuteCommand));
   VERIFY(connect(server, &proxy::IServer::ExecuteFinished, this, &ExplorerTreeView::finishExecuteCommand));
 
@@ -1087,6 +1233,10 @@ void ExplorerTreeView::unsyncWithServer(proxy::IServer* server) {
                     &ExplorerTreeView::startLoadDatabaseContent));
   VERIFY(disconnect(server, &proxy::IServer::LoadDatabaseContentFinished, this,
                     &ExplorerTreeView::finishLoadDatabaseContent));
+  VERIFY(disconnect(server, &proxy::IServer::LoadDatabaseKeysCountFinished, this,
+                    &ExplorerTreeView::finishLoadDatabaseKeysCount));
+  VERIFY(disconnect(server, &proxy::IServer::LoadKeysCacheFinished, this, &ExplorerTreeView::finishLoadKeysCache));
+  VERIFY(disconnect(server, &proxy::IServer::RevalidateKeysFinished, this, &ExplorerTreeView::finishRevalidateKeys));
   VERIFY(disconnect(server, &proxy::IServer::ExecuteStarted, this, &ExplorerTreeView::startExecuteCommand));
   VERIFY(disconnect(server, &proxy::IServer::ExecuteFinished, this, &ExplorerTreeView::finishExecuteCommand));
 
@@ -44,6 +44,8 @@ class ExplorerTreeView : public QTreeView {
  public:
   explicit ExplorerTreeView(QWidget* parent);
 
+  QStringList loadedKeys(proxy::IServerSPtr server, const QString& prefix, int limit) const;
+
  Q_SIGNALS:
   void consoleOpened(proxy::IServerSPtr server, const QString& text);
   void consoleOpenedAndExecute(proxy::IServerSPtr server, const QString& text);
@@ -80,9 +82,12 @@ class ExplorerTreeView : public QTreeView {
 
   void backupServer();
   void importServer();
+  void importDataServer();
+  void backupDataServer();
   void shutdownServer();
 
   void loadContentDb();
+  void countKeysDb();
   void removeAllKeys();
   void removeBranch();
   void setDefaultDb();
@@ -97,12 +102,20 @@ class ExplorerTreeView : public QTreeView {
   void watchKey();
   void setTTL();
 
+  void unloadBranch(const QModelIndex& index);
+  void syncLazyLoading(const QModelIndex& index);
+
   void startLoadDatabases(const proxy::events_info::LoadDatabasesInfoRequest& req);
   void finishLoadDatabases(const proxy::events_info::LoadDatabasesInfoResponce& res);
 
   void startLoadDatabaseContent(const proxy::events_info::LoadDatabaseContentRequest& req);
   void finishLoadDatabaseContent(const proxy::events_info::LoadDatabaseContentResponce& res);
 
+  void finishLoadDatabaseKeysCount(const proxy::events_info::LoadDatabaseKeysCountResponce& res);
+
+  void finishLoadKeysCache(const proxy::events_info::LoadKeysCacheResponce& res);
+  void finishRevalidateKeys(const proxy::events_info::RevalidateKeysResponce& res);
+
   void startExecuteCommand(const proxy::events_info::ExecuteInfoRequest& req);
   void finishExecuteCommand(const proxy::events_info::ExecuteInfoResponce& res);
 
@@ -53,6 +53,10 @@ ExplorerTreeWidget::ExplorerTreeWidget(QWidget* parent) : QWidget(parent) {
   setLayout(main_layout);
 }
 
+QStringList ExplorerTreeWidget::loadedKeys(proxy::IServerSPtr server, const QString& prefix, int limit) const {
+  return view_->loadedKeys(server, prefix, limit);
+}
+
 void ExplorerTreeWidget::addServer(proxy::IServerSPtr server) {
   view_->addServer(server);
 }
@@ -37,6 +37,8 @@ class ExplorerTreeWidget : public QWidget {
  public:
   explicit ExplorerTreeWidget(QWidget* parent = 0);
 
+  QStringList loadedKeys(proxy::IServerSPtr server, const QString& prefix, int limit) const;
+
  Q_SIGNALS:
   void consoleOpened(proxy::IServerSPtr server, const QString& text);
   void consoleOpenedAndExecute(proxy::IServerSPtr server, const QString& text);
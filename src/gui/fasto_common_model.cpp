@@ -18,6 +18,8 @@
 
 #include "gui/fasto_common_model.h"
 
+#include <algorithm>  // for min
+
 #include <QIcon>
 
 #include <common/qt/convert2string.h>  // for ConvertToString
@@ -177,5 +179,48 @@ void FastoCommonModel::changeValue(const core::NDbKValue& value) {
   }
 }
 
+void FastoCommonModel::insertItems(const QModelIndex& parent,
+                                   const std::vector<common::qt::gui::TreeItem*>& items) {
+  if (items.empty()) {
+    return;
+  }
+
+  common::qt::gui::TreeItem* par =
+      parent.isValid() ? common::qt::item<common::qt::gui::TreeItem*, common::qt::gui::TreeItem*>(parent) : root_;
+  if (!par) {
+    DNOTREACHED();
+    return;
+  }
+
+  int first = static_cast<int>(par->childrenCount());
+  beginInsertRows(parent, first, first + static_cast<int>(items.size()) - 1);
+  for (common::qt::gui::TreeItem* item : items) {
+    par->addChildren(item);
+  }
+  endInsertRows();
+}
+
+void FastoCommonModel::removeFirstItems(const QModelIndex& parent, size_t count) {
+  common::qt::gui::TreeItem* par =
+      parent.isValid() ? common::qt::item<common::qt::gui::TreeItem*, common::qt::gui::TreeItem*>(parent) : root_;
+  if (!par) {
+    DNOTREACHED();
+    return;
+  }
+
+  count = std::min(count, par->childrenCount());
+  if (!count) {
+    return;
+  }
+
+  beginRemoveRows(parent, 0, static_cast<int>(count) - 1);
+  for (size_t i = 0; i < count; ++i) {
+    common::qt::gui::TreeItem* child = par->child(0);
+    par->removeChildren(child);
+    delete child;
+  }
+  endRemoveRows();
+}
+
 }  // namespace gui
 }  // namespace fastonosql
@@ -18,6 +18,10 @@
 
 #pragma once
 
+#include <stddef.h>  // for size_t
+
+#include <vector>  // for vector
+
 #include <common/qt/gui/base/tree_model.h>  // for TreeModel
 
 class QModelIndex;
@@ -46,6 +50,10 @@ class FastoCommonModel : public common::qt::gui::TreeModel {
 
   void changeValue(const core::NDbKValue& value);
 
+  // one rows notification for the whole batch
+  void insertItems(const QModelIndex& parent, const std::vector<common::qt::gui::TreeItem*>& items);
+  void removeFirstItems(const QModelIndex& parent, size_t count);
+
  Q_SIGNALS:
   void changedValue(const core::NDbKValue& value);
 };
@@ -212,6 +212,10 @@ MainWindow::MainWindow() : QMainWindow(), isCheckedInSession_(false) {
   setCentralWidget(mainW);
 
   exp_ = new ExplorerTreeWidget(this);
+  ExplorerTreeWidget* explorer = exp_;
+  mainW->setLoadedKeysSource([explorer](proxy::IServerSPtr server, const QString& prefix, int limit) {
+    return explorer->loadedKeys(server, prefix, limit);
+  });
   VERIFY(connect(exp_, &ExplorerTreeWidget::consoleOpened, mainW, &MainWidget::openConsole));
   VERIFY(connect(exp_, &ExplorerTreeWidget::consoleOpenedAndExecute, mainW, &MainWidget::openConsoleAndExecute));
   VERIFY(connect(exp_, &ExplorerTreeWidget::serverClosed, this, &MainWindow::closeServer, Qt::DirectConnection));
@@ -21,11 +21,13 @@
 #include <QCheckBox>
 #include <QComboBox>
 #include <QFileDialog>
+#include <QInputDialog>
 #include <QLabel>
 #include <QMessageBox>
 #include <QProgressBar>
 #include <QSpinBox>
 #include <QSplitter>
+#include <QTime>
 #include <QToolBar>
 #include <QVBoxLayout>
 
@@ -55,6 +57,13 @@ const QString trAdvancedOptions = QObject::tr("Advanced options");
 const QString trCalculating = QObject::tr("Calculate...");
 const QString trIntervalMsec = QObject::tr("Interval msec:");
 const QString trRepeat = QObject::tr("Repeat:");
+const QString trPipelineWindow = QObject::tr("Pipeline window:");
+const QString trPipelineWindowTooltip =
+    QObject::tr("Commands sent before their replies are read, 0 - wait for every reply");
+const QString trProgressRateTemplate_2S = QObject::tr("%p% (%1/s, left %2)");
+const QString trExecuteFromFile = QObject::tr("Execute from file...");
+const QString trStartFromLine = QObject::tr("Start from line:");
+const QString progressFormat = QString("%p%");
 }  // namespace
 
 namespace fastonosql {
@@ -69,7 +78,7 @@ BaseShell* makeBaseShell(core::connectionTypes type, QWidget* parent) {
 }
 }  // namespace
 BaseShellWidget::BaseShellWidget(proxy::IServerSPtr server, const QString& filePath, QWidget* parent)
-    : QWidget(parent), server_(server), input_(nullptr), filePath_(filePath) {
+    : QWidget(parent), server_(server), input_(nullptr), filePath_(filePath), scriptPath_(), scriptResumeLine_(1) {
   CHECK(server_);
 
   VERIFY(connect(server_.get(), &proxy::IServer::ConnectStarted, this, &BaseShellWidget::startConnect));
@@ -126,6 +135,10 @@ BaseShellWidget::BaseShellWidget(proxy::IServerSPtr server, const QString& fileP
   VERIFY(connect(executeAction_, &QAction::triggered, this, &BaseShellWidget::execute));
   savebar->addAction(executeAction_);
 
+  executeFromFileAction_ = new QAction(gui::GuiFactory::GetInstance().executeIcon(), trExecuteFromFile, savebar);
+  VERIFY(connect(executeFromFileAction_, &QAction::triggered, this, &BaseShellWidget::executeFromFile));
+  savebar->addAction(executeFromFileAction_);
+
   stopAction_ = new QAction(gui::GuiFactory::GetInstance().stopIcon(), translations::trStop, savebar);
   VERIFY(connect(stopAction_, &QAction::triggered, this, &BaseShellWidget::stop));
   savebar->addAction(stopAction_);
@@ -181,10 +194,20 @@ BaseShellWidget::BaseShellWidget(proxy::IServerSPtr server, const QString& fileP
   intervalLayout->addWidget(intervalLabel);
   intervalLayout->addWidget(intervalMsec_);
 
+  QHBoxLayout* pipelineLayout = new QHBoxLayout;
+  QLabel* pipelineLabel = new QLabel(trPipelineWindow);
+  pipelineWindow_ = new QSpinBox;
+  pipelineWindow_->setRange(0, INT32_MAX);
+  pipelineWindow_->setSingleStep(100);
+  pipelineWindow_->setToolTip(trPipelineWindowTooltip);
+  pipelineLayout->addWidget(pipelineLabel);
+  pipelineLayout->addWidget(pipelineWindow_);
+
   historyCall_ = new QCheckBox(translations::trHistory);
   historyCall_->setChecked(true);
   advOptLayout->addLayout(repeatLayout);
   advOptLayout->addLayout(intervalLayout);
+  advOptLayout->addLayout(pipelineLayout);
   advOptLayout->addWidget(historyCall_);
   advancedOptionsWidget_->setLayout(advOptLayout);
 
@@ -243,6 +266,10 @@ QString BaseShellWidget::text() const {
   return input_->text();
 }
 
+void BaseShellWidget::setKeysCompletionSource(keys_completion_source_t source) {
+  input_->setKeysCompletionSource(source);
+}
+
 void BaseShellWidget::setText(const QString& text) {
   input_->setText(text);
 }
@@ -280,12 +307,43 @@ void BaseShellWidget::execute() {
   int repeat = repeatCount_->value();
   int interval = intervalMsec_->value();
   bool history = historyCall_->isChecked();
-  executeArgs(selected, repeat, interval, history);
+  int pipeline_window = pipelineWindow_->value();
+  executeArgs(selected, repeat, interval, history, pipeline_window);
 }
 
-void BaseShellWidget::executeArgs(const QString& text, int repeat, int interval, bool history) {
+void BaseShellWidget::executeArgs(const QString& text, int repeat, int interval, bool history, int pipeline_window) {
   core::command_buffer_t text_cmd = common::ConvertToString(text);
   proxy::events_info::ExecuteInfoRequest req(this, text_cmd, repeat, interval, history);
+  req.pipeline_window = pipeline_window;
+  req.stream_retention = proxy::SettingsManager::GetInstance().StreamingRetention();
+  server_->Execute(req);
+}
+
+void BaseShellWidget::executeFromFile() {
+  QString filepath =
+      QFileDialog::getOpenFileName(this, trExecuteFromFile, scriptPath_, translations::trfilterForScripts);
+  if (filepath.isEmpty()) {
+    return;
+  }
+
+  // the script isn't loaded into the editor, the driver validates and executes it line by line
+  int start_line = 1;
+  if (filepath == scriptPath_ && scriptResumeLine_ > 1) {
+    bool ok;
+    start_line = QInputDialog::getInt(this, trExecuteFromFile, trStartFromLine, static_cast<int>(scriptResumeLine_), 1,
+                                      INT32_MAX, 1, &ok);
+    if (!ok) {
+      return;
+    }
+  }
+
+  scriptPath_ = filepath;
+  const std::string path = common::ConvertToString(filepath);
+  proxy::events_info::ExecuteInfoRequest req(this, path, 0, 0, historyCall_->isChecked());
+  req.script_path = path;
+  req.start_line = start_line;
+  req.pipeline_window = pipelineWindow_->value();
+  req.stream_retention = proxy::SettingsManager::GetInstance().StreamingRetention();
   server_->Execute(req);
 }
 
@@ -415,6 +473,12 @@ void BaseShellWidget::finishDisconnect(const proxy::events_info::DisConnectInfoR
 
 void BaseShellWidget::progressChange(const proxy::events_info::ProgressInfoResponce& res) {
   workProgressBar_->setValue(res.progress);
+  if (res.rate > 0 && res.progress < 100) {
+    const QString eta = QTime(0, 0).addMSecs(static_cast<int>(res.eta_msec)).toString("hh:mm:ss");
+    workProgressBar_->setFormat(trProgressRateTemplate_2S.arg(static_cast<qlonglong>(res.rate)).arg(eta));
+  } else {
+    workProgressBar_->setFormat(progressFormat);
+  }
 }
 
 void BaseShellWidget::enterMode(const proxy::events_info::EnterModeInfo& res) {
@@ -449,18 +513,27 @@ void BaseShellWidget::startExecute(const proxy::events_info::ExecuteInfoRequest&
 
   repeatCount_->setEnabled(false);
   intervalMsec_->setEnabled(false);
+  pipelineWindow_->setEnabled(false);
   historyCall_->setEnabled(false);
   executeAction_->setEnabled(false);
+  executeFromFileAction_->setEnabled(false);
   stopAction_->setEnabled(true);
 }
 void BaseShellWidget::finishExecute(const proxy::events_info::ExecuteInfoResponce& res) {
-  UNUSED(res);
-
   repeatCount_->setEnabled(true);
   intervalMsec_->setEnabled(true);
+  pipelineWindow_->setEnabled(true);
   historyCall_->setEnabled(true);
   executeAction_->setEnabled(true);
+  executeFromFileAction_->setEnabled(true);
   stopAction_->setEnabled(false);
+
+  QString script_path;
+  common::ConvertFromString(res.script_path, &script_path);
+  if (!script_path.isEmpty() && script_path == scriptPath_) {
+    common::Error err = res.errorInfo();
+    scriptResumeLine_ = err && err->IsError() ? res.executed_line + 1 : 1;
+  }
 }
 
 void BaseShellWidget::serverConnect() {
@@ -540,6 +613,7 @@ void BaseShellWidget::syncConnectionActions() {
   connectAction_->setVisible(!is_connected);
   disConnectAction_->setVisible(is_connected);
   executeAction_->setEnabled(true);
+  executeFromFileAction_->setEnabled(true);
   stopAction_->setEnabled(false);
 }
 
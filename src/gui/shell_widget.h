@@ -27,6 +27,8 @@
 
 #include "proxy/proxy_fwd.h"  // for IServerSPtr
 
+#include "gui/base_lexer.h"  // for keys_completion_source_t
+
 class QAction;       // lines 26-26
 class QComboBox;     // lines 29-29
 class QProgressBar;  // lines 27-27
@@ -140,14 +142,16 @@ class BaseShellWidget : public QWidget {
   virtual ~BaseShellWidget();
 
   QString text() const;
+  void setKeysCompletionSource(keys_completion_source_t source);
 
  public Q_SLOTS:
   void setText(const QString& text);
   void executeText(const QString& text);
-  void executeArgs(const QString& text, int repeat, int interval, bool history);
+  void executeArgs(const QString& text, int repeat, int interval, bool history, int pipeline_window = 0);
 
  private Q_SLOTS:
   void execute();
+  void executeFromFile();
   void stop();
   void connectToServer();
   void disconnectFromServer();
@@ -190,6 +194,7 @@ class BaseShellWidget : public QWidget {
 
   const proxy::IServerSPtr server_;
   QAction* executeAction_;
+  QAction* executeFromFileAction_;
   QAction* stopAction_;
   QAction* connectAction_;
   QAction* disConnectAction_;
@@ -209,8 +214,11 @@ class BaseShellWidget : public QWidget {
   QWidget* advancedOptionsWidget_;
   QSpinBox* repeatCount_;
   QSpinBox* intervalMsec_;
+  QSpinBox* pipelineWindow_;
   QCheckBox* historyCall_;
   QString filePath_;
+  QString scriptPath_;
+  size_t scriptResumeLine_;
 };
 
 }  // namespace gui
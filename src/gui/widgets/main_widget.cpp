@@ -29,7 +29,7 @@
 namespace fastonosql {
 namespace gui {
 
-MainWidget::MainWidget(QWidget* parent) : QTabWidget(parent) {
+MainWidget::MainWidget(QWidget* parent) : QTabWidget(parent), keys_source_() {
   MainTabBar* tab = new MainTabBar(this);
 
   VERIFY(connect(tab, &MainTabBar::createdNewTab, this, &MainWidget::createNewTab));
@@ -57,6 +57,10 @@ QueryWidget* MainWidget::widget(int index) const {
   return qobject_cast<QueryWidget*>(QTabWidget::widget(index));
 }
 
+void MainWidget::setLoadedKeysSource(loaded_keys_source_t source) {
+  keys_source_ = source;
+}
+
 void MainWidget::openConsole(proxy::IServerSPtr server, const QString& text) {
   if (!server) {
     DNOTREACHED();
@@ -160,6 +164,7 @@ void MainWidget::addWidgetToTab(QueryWidget* wid, const QString& title) {
     return;
   }
 
+  wid->setLoadedKeysSource(keys_source_);
   addTab(wid, GuiFactory::GetInstance().icon(wid->connectionType()), title);
   setCurrentWidget(wid);
 }
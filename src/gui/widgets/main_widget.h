@@ -22,12 +22,9 @@
 
 #include "proxy/proxy_fwd.h"  // for IServerSPtr
 
+#include "gui/widgets/query_widget.h"  // for loaded_keys_source_t
+
 class QWidget;
-namespace fastonosql {
-namespace gui {
-class QueryWidget;
-}
-}  // namespace fastonosql
 
 namespace fastonosql {
 namespace gui {
@@ -39,6 +36,7 @@ class MainWidget : public QTabWidget {
 
   QueryWidget* currentWidget() const;
   QueryWidget* widget(int index) const;
+  void setLoadedKeysSource(loaded_keys_source_t source);
 
  public Q_SLOTS:
   void openConsole(proxy::IServerSPtr server, const QString& text);
@@ -58,6 +56,8 @@ class MainWidget : public QTabWidget {
  private:
   void addWidgetToTab(QueryWidget* wid, const QString& title);
   void openNewTab(QueryWidget* src, const QString& title, const QString& text);
+
+  loaded_keys_source_t keys_source_;
 };
 
 }  // namespace gui
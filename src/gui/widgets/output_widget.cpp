@@ -22,6 +22,7 @@
 #include <QHeaderView>
 #include <QPushButton>
 #include <QSplitter>
+#include <QTimer>
 
 #include <common/convert2string.h>  // for ConvertFromString
 #include <common/qt/convert2string.h>
@@ -40,6 +41,12 @@
 #include "gui/fasto_tree_view.h"     // for FastoTreeView
 #include "gui/gui_factory.h"         // for GuiFactory
 
+#define STREAMS_FLUSH_INTERVAL_MSEC 40  // 25 frames per second
+
+namespace {
+const QString trStreamCounters_2S = QObject::tr("%1 received, %2 dropped");
+}  // namespace
+
 namespace fastonosql {
 namespace gui {
 namespace {
@@ -54,6 +61,34 @@ FastoCommonItem* createItem(common::qt::gui::TreeItem* parent,
   return new FastoCommonItem(nkey, item->Delimiter(), readOnly, parent, item);
 }
 
+// streamed replies are released once drawn, so their items don't keep object pointers
+FastoCommonItem* createStreamItem(common::qt::gui::TreeItem* parent, core::FastoObject* item) {
+  core::NValue value = item->Value();
+  core::key_t raw_key;
+  core::NDbKValue nkey(core::NKey(raw_key), value);
+  FastoCommonItem* result = new FastoCommonItem(nkey, item->Delimiter(), true, parent, nullptr);
+  core::FastoObject::childs_t childrens = item->Childrens();
+  for (size_t i = 0; i < childrens.size(); ++i) {
+    result->addChildren(createStreamItem(result, childrens[i].get()));
+  }
+  return result;
+}
+
+core::NValue makeStreamCounters(proxy::StreamBufferSPtr stream) {
+  QString counters = trStreamCounters_2S.arg(stream->ReceivedCount()).arg(stream->DroppedCount());
+  return core::NValue(common::Value::CreateStringValue(common::ConvertToString(counters)));
+}
+
+QModelIndex indexOfItem(FastoCommonModel* model, common::qt::gui::TreeItem* item) {
+  common::qt::gui::TreeItem* par = item->parent();
+  if (!par) {
+    return QModelIndex();
+  }
+
+  QModelIndex parent_index = par == model->root() ? QModelIndex() : indexOfItem(model, par);
+  return model->index(par->indexOf(item), FastoCommonItem::eKey, parent_index);
+}
+
 FastoCommonItem* createRootItem(core::FastoObject* item) {
   core::NValue value = item->Value();
   core::key_t raw_key;
@@ -64,9 +99,14 @@ FastoCommonItem* createRootItem(core::FastoObject* item) {
 
 }  // namespace
 
-OutputWidget::OutputWidget(proxy::IServerSPtr server, QWidget* parent) : QWidget(parent), server_(server) {
+OutputWidget::OutputWidget(proxy::IServerSPtr server, QWidget* parent)
+    : QWidget(parent), server_(server), streams_() {
   CHECK(server_);
 
+  streams_timer_ = new QTimer(this);
+  streams_timer_->setInterval(STREAMS_FLUSH_INTERVAL_MSEC);
+  VERIFY(connect(streams_timer_, &QTimer::timeout, this, &OutputWidget::flushStreams));
+
   commonModel_ = new FastoCommonModel(this);
   VERIFY(connect(commonModel_, &FastoCommonModel::changedValue, this, &OutputWidget::createKey, Qt::DirectConnection));
   VERIFY(connect(server_.get(), &proxy::IServer::ExecuteStarted, this, &OutputWidget::startExecuteCommand,
@@ -83,6 +123,8 @@ OutputWidget::OutputWidget(proxy::IServerSPtr server, QWidget* parent) : QWidget
 
   VERIFY(connect(server_.get(), &proxy::IServer::ChildAdded, this, &OutputWidget::addChild, Qt::DirectConnection));
   VERIFY(connect(server_.get(), &proxy::IServer::ItemUpdated, this, &OutputWidget::updateItem, Qt::DirectConnection));
+  VERIFY(
+      connect(server_.get(), &proxy::IServer::StreamStarted, this, &OutputWidget::startStream, Qt::DirectConnection));
 
   treeView_ = new QTreeView;
   treeView_->setModel(commonModel_);
@@ -139,6 +181,11 @@ void OutputWidget::rootCreate(const proxy::events_info::CommandRootCreatedInfo&
 }
 
 void OutputWidget::rootCompleate(const proxy::events_info::CommandRootCompleatedInfo& res) {
+  if (!streams_.empty()) {
+    flushStreams();
+    streams_.clear();
+    streams_timer_->stop();
+  }
   updateTimeLabel(res);
 }
 
@@ -227,6 +274,62 @@ void OutputWidget::addChild(core::FastoObjectIPtr child) {
   }
 }
 
+void OutputWidget::startStream(proxy::StreamBufferSPtr stream) {
+  core::FastoObjectIPtr command = stream->Command();
+  QModelIndex parent;
+  bool isFound = commonModel_->findItem(command->Parent(), &parent);
+  if (!isFound) {
+    return;
+  }
+
+  common::qt::gui::TreeItem* par = nullptr;
+  if (!parent.isValid()) {
+    par = commonModel_->root();
+  } else {
+    par = common::qt::item<common::qt::gui::TreeItem*, common::qt::gui::TreeItem*>(parent);
+  }
+
+  if (!par) {
+    DNOTREACHED();
+    return;
+  }
+
+  core::FastoObjectCommand* cmd = static_cast<core::FastoObjectCommand*>(command.get());
+  core::NDbKValue nkey(core::NKey(core::key_t(cmd->InputCommand())), makeStreamCounters(stream));
+  FastoCommonItem* node = new FastoCommonItem(nkey, command->Delimiter(), true, par, nullptr);
+  commonModel_->insertItem(parent, node);
+  streams_.push_back(std::make_pair(stream, node));
+  streams_timer_->start();
+}
+
+void OutputWidget::flushStreams() {
+  for (size_t i = 0; i < streams_.size(); ++i) {
+    proxy::StreamBufferSPtr stream = streams_[i].first;
+    FastoCommonItem* node = streams_[i].second;
+    proxy::StreamBuffer::replies_t replies = stream->TakeAll();
+    if (replies.empty()) {
+      continue;
+    }
+
+    QModelIndex node_index = indexOfItem(commonModel_, node);
+    std::vector<common::qt::gui::TreeItem*> items;
+    items.reserve(replies.size());
+    for (size_t j = 0; j < replies.size(); ++j) {
+      items.push_back(createStreamItem(node, replies[j].get()));
+    }
+    commonModel_->insertItems(node_index, items);
+
+    const size_t retention = stream->Capacity();
+    if (node->childrenCount() > retention) {
+      commonModel_->removeFirstItems(node_index, node->childrenCount() - retention);
+    }
+
+    node->setValue(makeStreamCounters(stream));
+    commonModel_->updateItem(node_index.sibling(node_index.row(), FastoCommonItem::eValue),
+                             node_index.sibling(node_index.row(), FastoCommonItem::eType));
+  }
+}
+
 void OutputWidget::updateItem(core::FastoObject* item, common::ValueSPtr newValue) {
   QModelIndex index;
   bool isFound = commonModel_->findItem(item, &index);
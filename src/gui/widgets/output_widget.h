@@ -18,6 +18,9 @@
 
 #pragma once
 
+#include <utility>  // for pair
+#include <vector>   // for vector
+
 #include <QWidget>
 
 #include "core/database/idatabase_info.h"
@@ -25,7 +28,10 @@
 
 #include "core/global.h"  // for FastoObject, etc
 
+#include "proxy/driver/stream_buffer.h"  // for StreamBufferSPtr
+
 class QPushButton;  // lines 27-27
+class QTimer;
 class QTreeView;
 class QTableView;
 
@@ -51,6 +57,7 @@ namespace fastonosql {
 namespace gui {
 class FastoTextView;
 class FastoCommonModel;
+class FastoCommonItem;
 }  // namespace gui
 }  // namespace fastonosql
 
@@ -77,6 +84,9 @@ class OutputWidget : public QWidget {
   void addChild(core::FastoObjectIPtr child);
   void updateItem(core::FastoObject* item, common::ValueSPtr newValue);
 
+  void startStream(proxy::StreamBufferSPtr stream);
+  void flushStreams();
+
   void setTreeView();
   void setTableView();
   void setTextView();
@@ -94,6 +104,10 @@ class OutputWidget : public QWidget {
   QTableView* tableView_;
   FastoTextView* textView_;
   const proxy::IServerSPtr server_;
+
+  typedef std::pair<proxy::StreamBufferSPtr, FastoCommonItem*> stream_output_t;  // buffer, node of its replies
+  std::vector<stream_output_t> streams_;
+  QTimer* streams_timer_;
 };
 
 }  // namespace gui
@@ -63,6 +63,17 @@ void QueryWidget::setInputText(const QString& text) {
   shellWidget_->setText(text);
 }
 
+void QueryWidget::setLoadedKeysSource(loaded_keys_source_t source) {
+  if (!source) {
+    shellWidget_->setKeysCompletionSource(keys_completion_source_t());
+    return;
+  }
+
+  const proxy::IServerSPtr server = server_;
+  shellWidget_->setKeysCompletionSource(
+      [source, server](const QString& prefix, int limit) { return source(server, prefix, limit); });
+}
+
 void QueryWidget::execute(const QString& text) {
   shellWidget_->executeText(text);
 }
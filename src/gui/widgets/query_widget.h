@@ -20,6 +20,8 @@
 
 #include <QWidget>
 
+#include <functional>  // for function
+
 #include "core/connection_types.h"  // for connectionTypes
 #include "proxy/proxy_fwd.h"        // for IServerSPtr
 
@@ -36,6 +38,9 @@ class BaseShellWidget;
 
 namespace fastonosql {
 namespace gui {
+// loaded key names of the server starting with prefix, at most limit
+typedef std::function<QStringList(proxy::IServerSPtr server, const QString& prefix, int limit)> loaded_keys_source_t;
+
 class QueryWidget : public QWidget {
   Q_OBJECT
  public:
@@ -45,6 +50,7 @@ class QueryWidget : public QWidget {
   core::connectionTypes connectionType() const;
   QString inputText() const;
   void setInputText(const QString& text);
+  void setLoadedKeysSource(loaded_keys_source_t source);
 
  public Q_SLOTS:
   void execute(const QString& text);
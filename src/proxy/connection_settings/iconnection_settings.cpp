@@ -32,6 +32,8 @@
 
 #include "proxy/settings_manager.h"
 
+#define KEYS_CACHE_FILE_EXTENSION ".keys"
+
 #ifdef BUILD_WITH_REDIS
 #define LOGGING_REDIS_FILE_EXTENSION ".red"
 #endif
@@ -198,6 +200,10 @@ std::string IConnectionSettingsBase::LoggingPath() const {
   return std::string();
 }
 
+std::string IConnectionSettingsBase::KeysCachePath() const {
+  return SettingsManager::SettingsDirPath() + Hash() + KEYS_CACHE_FILE_EXTENSION;
+}
+
 std::string IConnectionSettingsBase::ToString() const {
   std::stringstream str;
   str << IConnectionSettings::ToString() << ',' << CommandLine();
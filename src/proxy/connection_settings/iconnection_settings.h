@@ -87,6 +87,7 @@ class IConnectionSettingsBase : public IConnectionSettings {
   std::string Hash() const;
 
   std::string LoggingPath() const;
+  std::string KeysCachePath() const;
 
   void SetConnectionPathAndUpdateHash(const connection_path_t& name);
 
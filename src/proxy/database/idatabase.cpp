@@ -58,6 +58,24 @@ void IDatabase::LoadContent(const events_info::LoadDatabaseContentRequest& req)
   server_->LoadDatabaseContent(req);
 }
 
+void IDatabase::LoadKeysCount(const events_info::LoadDatabaseKeysCountRequest& req) {
+  DCHECK_EQ(req.inf, info_);
+
+  server_->LoadDatabaseKeysCount(req);
+}
+
+void IDatabase::LoadKeysCache(const events_info::LoadKeysCacheRequest& req) {
+  DCHECK_EQ(req.inf, info_);
+
+  server_->LoadKeysCache(req);
+}
+
+void IDatabase::RevalidateKeys(const events_info::RevalidateKeysRequest& req) {
+  DCHECK_EQ(req.inf, info_);
+
+  server_->RevalidateKeys(req);
+}
+
 core::IDataBaseInfoSPtr IDatabase::Info() const {
   return info_;
 }
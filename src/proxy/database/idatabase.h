@@ -36,6 +36,9 @@ namespace fastonosql {
 namespace proxy {
 namespace events_info {
 struct LoadDatabaseContentRequest;
+struct LoadDatabaseKeysCountRequest;
+struct LoadKeysCacheRequest;
+struct RevalidateKeysRequest;
 }
 }  // namespace proxy
 }  // namespace fastonosql
@@ -55,6 +58,9 @@ class IDatabase {
   std::string Name() const;
 
   void LoadContent(const events_info::LoadDatabaseContentRequest& req);
+  void LoadKeysCount(const events_info::LoadDatabaseKeysCountRequest& req);
+  void LoadKeysCache(const events_info::LoadKeysCacheRequest& req);
+  void RevalidateKeys(const events_info::RevalidateKeysRequest& req);
   void Execute(const events_info::ExecuteInfoRequest& req);
 
  protected:
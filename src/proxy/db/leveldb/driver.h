@@ -71,6 +71,9 @@ class Driver : public IDriverLocal {
   virtual common::Error SyncDisconnect() override WARN_UNUSED_RESULT;
 
   virtual common::Error ExecuteImpl(const core::command_buffer_t& command, core::FastoObject* out) override;
+  virtual common::Error BulkSetImpl(const core::NDbKValues& keys) override;
+  virtual common::Error WalkImpl(const std::string& position, core::walk_callback_t cb) override;
+  virtual common::Error ExistsImpl(const core::NKeys& keys, core::NKeys* existing_keys) override;
   virtual common::Error CurrentServerInfo(core::IServerInfo** info) override;
   virtual common::Error CurrentDataBaseInfo(core::IDataBaseInfo** info) override;
 
@@ -123,6 +123,22 @@ common::Error Driver::ExecuteImpl(const core::command_buffer_t& command, core::F
   return impl_->Execute(command, out);
 }
 
+common::Error Driver::BulkSetImpl(const core::NDbKValues& keys) {
+  return impl_->BulkSet(keys);
+}
+
+common::Error Driver::WalkImpl(const std::string& position, core::walk_callback_t cb) {
+  return impl_->Walk(position, cb);
+}
+
+common::Error Driver::ExistsImpl(const core::NKeys& keys, core::NKeys* existing_keys) {
+  return impl_->Exists(keys, existing_keys);
+}
+
+common::Error Driver::ExecutePipelineImpl(const std::vector<core::FastoObjectCommandIPtr>& cmds) {
+  return impl_->ExecuteAsPipeline(cmds, &LOG_COMMAND);
+}
+
 common::Error Driver::CurrentServerInfo(core::IServerInfo** info) {
   core::FastoObjectCommandIPtr cmd = CreateCommandFast(MEMCACHED_INFO_REQUEST, core::C_INNER);
   LOG_COMMAND(cmd);
@@ -224,6 +240,7 @@ void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEv
     }
   }
 done:
+  UpdateKeysCache(res);
   NotifyProgress(sender, 75);
   Reply(sender, new events::LoadDatabaseContentResponceEvent(this, res));
   NotifyProgress(sender, 100);
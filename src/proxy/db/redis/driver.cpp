@@ -20,8 +20,11 @@
 
 #include <stddef.h>  // for size_t
 #include <stdint.h>  // for uint32_t
+#include <string.h>  // for strcasecmp
 
-#include <memory>  // for __shared_ptr, shared_ptr
+#include <algorithm>  // for min, max
+#include <memory>     // for __shared_ptr, shared_ptr
+#include <mutex>      // for mutex, lock_guard
 #include <sstream>
 #include <vector>  // for vector
 
@@ -33,6 +36,7 @@
 #include <common/value.h>           // for Value, ErrorValue, etc
 
 #include "core/connection_types.h"
+#include "core/data_dump.h"                // for DumpFormatFromPath
 #include "core/database/idatabase_info.h"  // for IDataBaseInfoSPtr, etc
 #include "core/db_key.h"                   // for NDbKValue, NValue, ttl_t, etc
 #include "core/server_property_info.h"     // for MakeServerProperty, etc
@@ -44,6 +48,7 @@
 #include "core/internal/cdb_connection.h"
 #include "core/internal/db_connection.h"
 
+#include "core/db/redis/cluster_scanner.h"       // for ClusterKeysScanner
 #include "core/db/redis/config.h"                // for Config
 #include "core/db/redis/database_info.h"         // for DataBaseInfo
 #include "core/db/redis/db_connection.h"         // for DBConnection, INFO_REQUEST, etc
@@ -97,7 +102,7 @@ namespace proxy {
 namespace redis {
 
 Driver::Driver(IConnectionSettingsBaseSPtr settings)
-    : IDriverRemote(settings), impl_(new core::redis::DBConnection(this)) {
+    : IDriverRemote(settings), impl_(new core::redis::DBConnection(this)), cluster_masters_(), cluster_discovered_(false) {
   COMPILE_ASSERT(core::redis::DBConnection::connection_t == core::REDIS,
                  "DBConnection must be the same type as Driver!");
   CHECK(Type() == core::REDIS);
@@ -120,6 +125,17 @@ std::string Driver::Delimiter() const {
   return impl_->Delimiter();
 }
 
+bool Driver::IsStreamingCommand(const core::command_buffer_t& command) const {
+  static const char* streaming_commands[] = {"MONITOR", "SUBSCRIBE", "PSUBSCRIBE", "SYNC", "PSYNC"};
+  for (size_t i = 0; i < SIZEOFMASS(streaming_commands); ++i) {
+    if (strcasecmp(command.c_str(), streaming_commands[i]) == 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 bool Driver::IsInterrupted() const {
   return impl_->IsInterrupted();
 }
@@ -158,17 +174,59 @@ common::Error Driver::SyncConnect() {
   ConnectionSettings* set = dynamic_cast<ConnectionSettings*>(settings_.get());  // +
   CHECK(set);
   core::redis::RConfig rconf(set->Info(), set->SSHInfo());
-  return impl_->Connect(rconf);
+  cluster_masters_.clear();
+  cluster_discovered_ = false;
+  common::Error err = impl_->Connect(rconf);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  // standalone servers reply with an error and keep single node execution
+  err = impl_->EnableClusterMode();
+  UNUSED(err);
+  return common::Error();
 }
 
 common::Error Driver::SyncDisconnect() {
   return impl_->Disconnect();
 }
 
+common::Error Driver::SyncSelectDatabase(const std::string& name) {
+  if (impl_->CurrentDBName() == name) {
+    return common::Error();
+  }
+
+  return impl_->Select(name, nullptr);
+}
+
 common::Error Driver::ExecuteImpl(const core::command_buffer_t& command, core::FastoObject* out) {
   return impl_->Execute(command, out);
 }
 
+common::Error Driver::BulkSetImpl(const core::NDbKValues& keys) {
+  return impl_->BulkSet(keys);
+}
+
+common::Error Driver::WalkImpl(const std::string& position, core::walk_callback_t cb) {
+  return impl_->Walk(position, cb);
+}
+
+core::DumpValueEncoding Driver::BackupValueEncoding() const {
+  return core::DUMP_REDIS_VALUES;  // DUMP payloads keep every data type
+}
+
+common::Error Driver::RestoreImpl(const core::NDbKValues& keys) {
+  return impl_->Restore(keys);
+}
+
+common::Error Driver::ExecutePipelineImpl(const std::vector<core::FastoObjectCommandIPtr>& cmds) {
+  return impl_->ExecuteAsPipeline(cmds, &LOG_COMMAND, cmds.size());
+}
+
+common::Error Driver::RevalidateKeysImpl(core::NDbKValues* keys) {
+  return LoadKeysInfo(impl_, keys);  // TTL of a missing key is -2
+}
+
 common::Error Driver::CurrentServerInfo(core::IServerInfo** info) {
   core::FastoObjectCommandIPtr cmd = CreateCommandFast(INFO_REQUEST, core::C_INNER);
   common::Error err = Execute(cmd.get());
@@ -210,6 +268,12 @@ void Driver::HandleShutdownEvent(events::ShutDownRequestEvent* ev) {
 }
 
 void Driver::HandleBackupEvent(events::BackupRequestEvent* ev) {
+  core::DumpFormat format;
+  if (core::DumpFormatFromPath(ev->value().path, &format) && format == core::DUMP_ARCHIVE) {
+    IDriverRemote::HandleBackupEvent(ev);  // streamed DUMP of every key, resumable
+    return;
+  }
+
   QObject* sender = ev->sender();
   NotifyProgress(sender, 0);
   events::BackupResponceEvent::value_type res(ev->value());
@@ -230,6 +294,12 @@ void Driver::HandleBackupEvent(events::BackupRequestEvent* ev) {
 }
 
 void Driver::HandleExportEvent(events::ExportRequestEvent* ev) {
+  core::DumpFormat format;
+  if (core::DumpFormatFromPath(ev->value().path, &format)) {
+    IDriverRemote::HandleExportEvent(ev);  // key/value dump, pipelined import
+    return;
+  }
+
   QObject* sender = ev->sender();
   NotifyProgress(sender, 0);
   events::ExportResponceEvent::value_type res(ev->value());
@@ -340,116 +410,238 @@ void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEv
   QObject* sender = ev->sender();
   NotifyProgress(sender, 0);
   events::LoadDatabaseContentResponceEvent::value_type res(ev->value());
-  const core::command_buffer_t pattern_result =
-      core::internal::GetKeysPattern(res.cursor_in, res.pattern, res.count_keys);
-  core::FastoObjectCommandIPtr cmd = CreateCommandFast(pattern_result, core::C_INNER);
-  NotifyProgress(sender, 50);
-  common::Error err = Execute(cmd);
-  if (err && err->IsError()) {
-    res.setErrorInfo(err);
-  } else {
+  if (res.cursor_in == 0 && DiscoveryClusterNodes() && cluster_masters_.size() > 1) {
+    LoadClusterContent(sender, &res);
+    goto done;
+  }
+
+  {
+    const core::command_buffer_t pattern_result =
+        core::internal::GetKeysPattern(res.cursor_in, res.pattern, res.count_keys);
+    core::FastoObjectCommandIPtr cmd = CreateCommandFast(pattern_result, core::C_INNER);
+    NotifyProgress(sender, 50);
+    common::Error err = Execute(cmd);
+    if (err && err->IsError()) {
+      res.setErrorInfo(err);
+      goto done;
+    }
+
     core::FastoObject::childs_t rchildrens = cmd->Childrens();
-    if (rchildrens.size()) {
-      CHECK_EQ(rchildrens.size(), 1);
-      core::FastoObjectArray* array = dynamic_cast<core::FastoObjectArray*>(rchildrens[0].get());  // +
-      if (!array) {
-        goto done;
-      }
+    if (!rchildrens.size()) {
+      goto done;
+    }
 
-      common::ArrayValue* arm = array->Array();
-      if (!arm->GetSize()) {
-        goto done;
-      }
+    CHECK_EQ(rchildrens.size(), 1);
+    core::FastoObjectArray* array = dynamic_cast<core::FastoObjectArray*>(rchildrens[0].get());  // +
+    if (!array) {
+      goto done;
+    }
 
-      std::string cursor;
-      bool isok = arm->GetString(0, &cursor);
-      if (!isok) {
-        goto done;
-      }
+    common::ArrayValue* arm = array->Array();
+    if (!arm->GetSize()) {
+      goto done;
+    }
 
-      uint64_t lcursor;
-      if (common::ConvertFromString(cursor, &lcursor)) {
-        res.cursor_out = lcursor;
-      }
+    std::string cursor;
+    bool isok = arm->GetString(0, &cursor);
+    if (!isok) {
+      goto done;
+    }
 
-      rchildrens = array->Childrens();
-      if (!rchildrens.size()) {
-        goto done;
-      }
+    uint64_t lcursor;
+    if (common::ConvertFromString(cursor, &lcursor)) {
+      res.cursor_out = lcursor;
+    }
 
-      core::FastoObject* obj = rchildrens[0].get();
-      core::FastoObjectArray* arr = dynamic_cast<core::FastoObjectArray*>(obj);  // +
-      if (!arr) {
-        goto done;
-      }
+    rchildrens = array->Childrens();
+    if (!rchildrens.size()) {
+      goto done;
+    }
 
-      common::ArrayValue* ar = arr->Array();
-      if (ar->IsEmpty()) {
-        goto done;
-      }
+    core::FastoObject* obj = rchildrens[0].get();
+    core::FastoObjectArray* arr = dynamic_cast<core::FastoObjectArray*>(obj);  // +
+    if (!arr) {
+      goto done;
+    }
 
-      std::vector<core::FastoObjectCommandIPtr> cmds;
-      cmds.reserve(ar->GetSize() * 2);
-      for (size_t i = 0; i < ar->GetSize(); ++i) {
-        std::string key;
-        bool isok = ar->GetString(i, &key);
-        if (isok) {
-          core::key_t key_str(key);
-          core::NKey k(key_str);
-          core::NDbKValue dbv(k, core::NValue());
-          core::command_buffer_writer_t wr_type;
-          wr_type << "TYPE " << key_str.GetKeyData();
-          cmds.push_back(CreateCommandFast(wr_type.str(), core::C_INNER));
-
-          core::command_buffer_writer_t wr_ttl;
-          wr_ttl << "TTL " << key_str.GetKeyData();
-          cmds.push_back(CreateCommandFast(wr_ttl.str(), core::C_INNER));
-          res.keys.push_back(dbv);
-        }
+    common::ArrayValue* ar = arr->Array();
+    for (size_t i = 0; i < ar->GetSize(); ++i) {
+      std::string key;
+      if (ar->GetString(i, &key)) {
+        res.keys.push_back(core::NDbKValue(core::NKey(core::key_t(key)), core::NValue()));
       }
+    }
 
-      err = impl_->ExecuteAsPipeline(cmds, &LOG_COMMAND);
-      if (err && err->IsError()) {
-        goto done;
-      }
+    err = LoadKeysInfo(impl_, &res.keys);
+    if (err && err->IsError()) {
+      res.setErrorInfo(err);
+      goto done;
+    }
 
-      for (size_t i = 0; i < res.keys.size(); ++i) {
-        core::FastoObjectIPtr cmdType = cmds[i * 2];
-        core::FastoObject::childs_t tchildrens = cmdType->Childrens();
-        if (tchildrens.size()) {
-          DCHECK_EQ(tchildrens.size(), 1);
-          if (tchildrens.size() == 1) {
-            std::string typeRedis = tchildrens[0]->ToString();
-            common::Value::Type ctype = convertFromStringRType(typeRedis);
-            common::ValueSPtr empty_val(common::Value::CreateEmptyValueFromType(ctype));
-            res.keys[i].SetValue(empty_val);
-          }
+    err = impl_->DBkcount(&res.db_keys_count);
+    DCHECK(!err);
+  }
+done:
+  UpdateKeysCache(res);
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::LoadDatabaseContentResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+bool Driver::DiscoveryClusterNodes() {
+  if (!cluster_discovered_) {
+    cluster_discovered_ = true;
+    common::Error err = core::redis::DiscoveryClusterMasters(impl_->config(), &cluster_masters_);
+    if (err && err->IsError()) {  // cluster support disabled
+      cluster_masters_.clear();
+    }
+  }
+
+  return !cluster_masters_.empty();
+}
+
+void Driver::LoadClusterContent(QObject* sender, events_info::LoadDatabaseContentResponce* res) {
+  core::redis::ClusterKeysScanner scanner(cluster_masters_, res->pattern, res->count_keys);
+  const size_t nodes_count = scanner.NodesCount();
+  std::mutex keys_lock;
+  size_t finished_nodes = 0;
+  auto keys_cb = [this, res, &keys_lock](size_t node, core::redis::DBConnection* connection,
+                                         const std::vector<std::string>& keys) -> common::Error {
+    UNUSED(node);
+    std::vector<core::NDbKValue> node_keys;
+    node_keys.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+      node_keys.push_back(core::NDbKValue(core::NKey(core::key_t(keys[i])), core::NValue()));
+    }
+
+    // metadata is loaded on the owning node, only the merge is serialized
+    common::Error err = LoadKeysInfo(connection, &node_keys);
+    if (err && err->IsError()) {
+      return err;
+    }
+
+    std::lock_guard<std::mutex> lock(keys_lock);
+    res->keys.insert(res->keys.end(), node_keys.begin(), node_keys.end());
+    return common::Error();
+  };
+  auto progress_cb = [this, sender, nodes_count, &finished_nodes, &scanner, res](size_t node, uint64_t node_keys,
+                                                                                 bool finished) {
+    UNUSED(node);
+    UNUSED(node_keys);
+    if (finished) {
+      finished_nodes++;
+    }
+    const double nodes_part = double(finished_nodes) / nodes_count;
+    const double keys_part = res->count_keys ? double(scanner.FoundKeysCount()) / res->count_keys : 0;
+    NotifyProgress(sender, 5 + static_cast<int>(70 * std::min(std::max(nodes_part, keys_part), 1.0)));
+  };
+  auto interrupted_cb = [this]() { return IsInterrupted(); };
+
+  common::Error err = scanner.Scan(keys_cb, progress_cb, interrupted_cb);
+  if (err && err->IsError()) {
+    res->setErrorInfo(err);
+    return;
+  }
+
+  res->cursor_out = 0;  // every node cursor is exhausted or limit reached
+  res->db_keys_count = scanner.NodesKeysCount();
+}
+
+common::Error Driver::LoadKeysInfo(core::redis::DBConnection* connection, std::vector<core::NDbKValue>* keys) {
+  if (keys->empty()) {
+    return common::Error();
+  }
+
+  std::vector<core::FastoObjectCommandIPtr> cmds;
+  cmds.reserve(keys->size() * 2);
+  for (size_t i = 0; i < keys->size(); ++i) {
+    const core::key_t key_str = (*keys)[i].GetKey().GetKey();
+    core::command_buffer_writer_t wr_type;
+    wr_type << "TYPE " << key_str.GetKeyData();
+    cmds.push_back(CreateCommandFast(wr_type.str(), core::C_INNER));
+
+    core::command_buffer_writer_t wr_ttl;
+    wr_ttl << "TTL " << key_str.GetKeyData();
+    cmds.push_back(CreateCommandFast(wr_ttl.str(), core::C_INNER));
+  }
+
+  // cluster node connections share the settings of the main one,
+  // keys info fails on the first error reply like before, the replies in flight are only drained
+  const core::redis::RConfig config = impl_->config();
+  common::Error err = connection->ExecuteAsPipeline(cmds, &LOG_COMMAND, config.pipeline_window);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  std::vector<size_t> string_keys;
+  for (size_t i = 0; i < keys->size(); ++i) {
+    core::FastoObjectIPtr cmdType = cmds[i * 2];
+    core::FastoObject::childs_t tchildrens = cmdType->Childrens();
+    if (tchildrens.size()) {
+      DCHECK_EQ(tchildrens.size(), 1);
+      if (tchildrens.size() == 1) {
+        std::string typeRedis = tchildrens[0]->ToString();
+        common::Value::Type ctype = convertFromStringRType(typeRedis);
+        common::ValueSPtr empty_val(common::Value::CreateEmptyValueFromType(ctype));
+        (*keys)[i].SetValue(empty_val);
+        if (ctype == common::Value::TYPE_STRING) {
+          string_keys.push_back(i);
         }
+      }
+    }
 
-        core::FastoObjectIPtr cmdType2 = cmds[i * 2 + 1];
-        tchildrens = cmdType2->Childrens();
-        if (tchildrens.size()) {
-          DCHECK_EQ(tchildrens.size(), 1);
-          if (tchildrens.size() == 1) {
-            auto vttl = tchildrens[0]->Value();
-            core::ttl_t ttl = 0;
-            if (vttl->GetAsLongLongInteger(&ttl)) {
-              core::NKey key = res.keys[i].GetKey();
-              key.SetTTL(ttl);
-              res.keys[i].SetKey(key);
-            }
-          }
+    core::FastoObjectIPtr cmdType2 = cmds[i * 2 + 1];
+    tchildrens = cmdType2->Childrens();
+    if (tchildrens.size()) {
+      DCHECK_EQ(tchildrens.size(), 1);
+      if (tchildrens.size() == 1) {
+        auto vttl = tchildrens[0]->Value();
+        core::ttl_t ttl = 0;
+        if (vttl->GetAsLongLongInteger(&ttl)) {
+          core::NKey key = (*keys)[i].GetKey();
+          key.SetTTL(ttl);
+          (*keys)[i].SetKey(key);
         }
       }
+    }
+  }
+
+  const size_t preview_size = config.value_preview_size;
+  if (!preview_size || string_keys.empty()) {
+    return common::Error();
+  }
+
+  // one byte over the limit tells whether the whole value fitted
+  std::vector<core::FastoObjectCommandIPtr> preview_cmds;
+  preview_cmds.reserve(string_keys.size());
+  for (size_t i = 0; i < string_keys.size(); ++i) {
+    core::NKey key = (*keys)[string_keys[i]].GetKey();
+    core::command_buffer_writer_t wr_range;
+    wr_range << "GETRANGE " << key.GetKey().GetKeyData() << " 0 " << preview_size;
+    preview_cmds.push_back(CreateCommandFast(wr_range.str(), core::C_INNER));
+  }
+
+  err = connection->ExecuteAsPipeline(preview_cmds, &LOG_COMMAND, config.pipeline_window);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  for (size_t i = 0; i < string_keys.size(); ++i) {
+    core::FastoObject::childs_t tchildrens = preview_cmds[i]->Childrens();
+    if (tchildrens.size() != 1) {
+      continue;
+    }
 
-      err = impl_->DBkcount(&res.db_keys_count);
-      DCHECK(!err);
+    std::string value_str;
+    auto vrange = tchildrens[0]->Value();
+    if (vrange->GetType() == common::Value::TYPE_STRING && vrange->GetAsString(&value_str) &&
+        value_str.size() <= preview_size) {
+      common::ValueSPtr val(common::Value::CreateStringValue(value_str));
+      (*keys)[string_keys[i]].SetValue(val);
     }
   }
-done:
-  NotifyProgress(sender, 75);
-  Reply(sender, new events::LoadDatabaseContentResponceEvent(this, res));
-  NotifyProgress(sender, 100);
+
+  return common::Error();
 }
 
 void Driver::HandleLoadServerPropertyEvent(events::ServerPropertyInfoRequestEvent* ev) {
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <string>  // for string
+#include <vector>  // for vector
 
 #include <common/error.h>      // for Error
 #include <common/macros.h>     // for WARN_UNUSED_RESULT
@@ -43,6 +44,7 @@ namespace fastonosql {
 namespace core {
 namespace redis {
 class DBConnection;
+struct RConfig;
 }
 }  // namespace core
 }  // namespace fastonosql
@@ -68,6 +70,8 @@ class Driver : public IDriverRemote {
   virtual std::string NsSeparator() const override;
   virtual std::string Delimiter() const override;
 
+  virtual bool IsStreamingCommand(const core::command_buffer_t& command) const override;
+
  private:
   virtual void InitImpl() override;
   virtual void ClearImpl() override;
@@ -81,8 +85,15 @@ class Driver : public IDriverRemote {
 
   virtual common::Error SyncConnect() override WARN_UNUSED_RESULT;
   virtual common::Error SyncDisconnect() override WARN_UNUSED_RESULT;
+  virtual common::Error SyncSelectDatabase(const std::string& name) override WARN_UNUSED_RESULT;
 
   virtual common::Error ExecuteImpl(const core::command_buffer_t& command, core::FastoObject* out) override;
+  virtual common::Error BulkSetImpl(const core::NDbKValues& keys) override;
+  virtual common::Error WalkImpl(const std::string& position, core::walk_callback_t cb) override;
+  virtual core::DumpValueEncoding BackupValueEncoding() const override;
+  virtual common::Error RestoreImpl(const core::NDbKValues& keys) override;
+  virtual common::Error ExecutePipelineImpl(const std::vector<core::FastoObjectCommandIPtr>& cmds) override;
+  virtual common::Error RevalidateKeysImpl(core::NDbKValues* keys) override;
 
   virtual common::Error CurrentServerInfo(core::IServerInfo** info) override;
   virtual common::Error CurrentDataBaseInfo(core::IDataBaseInfo** info) override;
@@ -101,7 +112,15 @@ class Driver : public IDriverRemote {
 
   virtual core::IServerInfoSPtr MakeServerInfoFromString(const std::string& val) override;
 
+  bool DiscoveryClusterNodes();  // once per connection, true for a cluster node
+  void LoadClusterContent(QObject* sender, events_info::LoadDatabaseContentResponce* res);
+  // TYPE, TTL and string preview of keys, pipelined on connection
+  common::Error LoadKeysInfo(core::redis::DBConnection* connection, std::vector<core::NDbKValue>* keys)
+      WARN_UNUSED_RESULT;
+
   core::redis::DBConnection* const impl_;
+  std::vector<core::redis::RConfig> cluster_masters_;
+  bool cluster_discovered_;
 };
 
 }  // namespace redis
@@ -32,6 +32,7 @@
 #include "proxy/db/redis/driver.h"     // for Driver
 #include "proxy/events/events_info.h"  // for DiscoveryInfoResponce
 #include "proxy/server/iserver.h"      // for IServer
+#include "proxy/settings_manager.h"    // for SettingsManager
 
 namespace fastonosql {
 namespace proxy {
@@ -39,6 +40,10 @@ namespace redis {
 
 Server::Server(IConnectionSettingsBaseSPtr settings)
     : IServerRemote(new Driver(settings)), role_(core::MASTER), mode_(core::STANDALONE) {
+  if (SettingsManager::GetInstance().ConnectionLanes()) {
+    SetLaneDriver(BACKGROUND_LANE, new Driver(settings));
+    SetLaneDriver(MONITORING_LANE, new Driver(settings));
+  }
   StartCheckKeyExistTimer();
 }
 
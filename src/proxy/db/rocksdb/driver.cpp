@@ -121,6 +121,18 @@ common::Error Driver::ExecuteImpl(const core::command_buffer_t& command, core::F
   return impl_->Execute(command, out);
 }
 
+common::Error Driver::BulkSetImpl(const core::NDbKValues& keys) {
+  return impl_->BulkSet(keys);
+}
+
+common::Error Driver::WalkImpl(const std::string& position, core::walk_callback_t cb) {
+  return impl_->Walk(position, cb);
+}
+
+common::Error Driver::ExistsImpl(const core::NKeys& keys, core::NKeys* existing_keys) {
+  return impl_->Exists(keys, existing_keys);
+}
+
 common::Error Driver::CurrentServerInfo(core::IServerInfo** info) {
   core::FastoObjectCommandIPtr cmd = CreateCommandFast(ROCKSDB_INFO_REQUEST, core::C_INNER);
   LOG_COMMAND(cmd);
@@ -206,11 +218,12 @@ void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEv
         }
       }
 
-      common::Error err = impl_->DBkcount(&res.db_keys_count);
+      common::Error err = impl_->DBkcountEstimate(&res.db_keys_count, &res.db_keys_count_exact);
       DCHECK(!err);
     }
   }
 done:
+  UpdateKeysCache(res);
   NotifyProgress(sender, 75);
   Reply(sender, new events::LoadDatabaseContentResponceEvent(this, res));
   NotifyProgress(sender, 100);
@@ -20,12 +20,17 @@
 
 #include "proxy/db/ssdb/database.h"
 #include "proxy/db/ssdb/driver.h"
+#include "proxy/settings_manager.h"
 
 namespace fastonosql {
 namespace proxy {
 namespace ssdb {
 
 Server::Server(IConnectionSettingsBaseSPtr settings) : IServerRemote(new Driver(settings)) {
+  if (SettingsManager::GetInstance().ConnectionLanes()) {
+    SetLaneDriver(BACKGROUND_LANE, new Driver(settings));
+    SetLaneDriver(MONITORING_LANE, new Driver(settings));
+  }
   StartCheckKeyExistTimer();
 }
 
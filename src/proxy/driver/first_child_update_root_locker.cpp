@@ -29,10 +29,16 @@ FirstChildUpdateRootLocker::FirstChildUpdateRootLocker(IDriver* parent,
                                                        QObject* receiver,
                                                        const core::command_buffer_t& text,
                                                        bool silence,
+                                                       size_t stream_retention,
                                                        const std::vector<core::command_buffer_t>& commands)
-    : RootLocker(parent, receiver, text, silence), commands_(commands), watched_cmds_() {}
+    : RootLocker(parent, receiver, text, silence, stream_retention), commands_(commands), watched_cmds_() {}
 
 void FirstChildUpdateRootLocker::ChildrenAdded(core::FastoObjectIPtr child) {
+  if (IsStreamingReply(child)) {
+    RootLocker::ChildrenAdded(child);
+    return;
+  }
+
   auto val = child->Value();
   core::FastoObjectCommand* cmd = dynamic_cast<core::FastoObjectCommand*>(child.get());
   if (cmd) {
@@ -41,6 +41,7 @@ class FirstChildUpdateRootLocker : public RootLocker {
                              QObject* receiver,
                              const core::command_buffer_t& text,
                              bool silence,
+                             size_t stream_retention,
                              const std::vector<core::command_buffer_t>& commands);
 
  private:
@@ -24,9 +24,13 @@
 #include <signal.h>
 #endif
 
-#include <memory>  // for __shared_ptr
-#include <string>  // for allocator, string, etc
-#include <vector>  // for vector
+#include <inttypes.h>  // for PRIu64
+
+#include <algorithm>  // for min
+#include <memory>     // for __shared_ptr
+#include <set>        // for set
+#include <string>     // for allocator, string, etc
+#include <vector>     // for vector
 
 #include <QApplication>
 #include <QThread>
@@ -47,6 +51,16 @@
 #include "proxy/driver/root_locker.h"  // for RootLocker
 #include "proxy/events/events_info.h"
 
+#include "core/data_dump.h"                // for DumpReader
+#include "core/internal/cdb_connection.h"  // for GetKeysPattern
+#include "core/keys_cache.h"               // for KeysCacheWriter
+#include "core/script_reader.h"            // for ScriptReader
+#include "core/server/server_info_history.h"  // for ServerInfoHistoryWriter
+
+#define KEYS_COUNT_SCAN_PAGE_SIZE 10000
+#define IMPORT_BATCH_SIZE 1000
+#define IMPORT_PROGRESS_INTERVAL_MSEC 250
+
 namespace {
 #ifdef OS_WIN
 struct WinsockInit {
@@ -64,36 +78,6 @@ struct SigIgnInit {
 } sig_init;
 #endif
 
-const char magicNumber = 0x1E;
-std::string createStamp(common::time64_t time) {
-  return magicNumber + common::ConvertToString(time) + '\n';
-}
-
-bool getStamp(common::buffer_t stamp, common::time64_t* time_out) {
-  if (stamp.empty()) {
-    return false;
-  }
-
-  if (stamp[0] != magicNumber) {
-    return false;
-  }
-
-  stamp.erase(stamp.begin());  // pop_front
-  if (stamp.empty()) {
-    return false;
-  }
-
-  if (stamp[stamp.size() - 1] == '\n') {
-    stamp.pop_back();
-  }
-
-  common::time64_t ltime_out;
-  if (!common::ConvertFromBytes(stamp, &ltime_out)) {
-    return false;
-  }
-  *time_out = ltime_out;
-  return ltime_out != 0;
-}
 }  // namespace
 
 namespace fastonosql {
@@ -110,17 +94,18 @@ struct RegisterTypes {
     qRegisterMetaType<core::command_buffer_t>("core::command_buffer_t");
     qRegisterMetaType<core::string_key_t>("core::string_key_t");
     qRegisterMetaType<core::ServerInfoSnapShoot>("core::ServerInfoSnapShoot");
+    qRegisterMetaType<proxy::StreamBufferSPtr>("proxy::StreamBufferSPtr");
   }
 } reg_type;
 
-void notifyProgressImpl(IDriver* sender, QObject* reciver, int value) {
-  IDriver::Reply(reciver, new events::ProgressResponceEvent(sender, events::ProgressResponceEvent::value_type(value)));
+void notifyProgressImpl(IDriver* sender, QObject* reciver, const events::ProgressResponceEvent::value_type& value) {
+  IDriver::Reply(reciver, new events::ProgressResponceEvent(sender, value));
 }
 
 template <typename event_request_type, typename event_responce_type>
 void replyNotImplementedYet(IDriver* sender, event_request_type* ev, const char* eventCommandText) {
   QObject* esender = ev->sender();
-  notifyProgressImpl(sender, esender, 0);
+  notifyProgressImpl(sender, esender, events::ProgressResponceEvent::value_type(0));
   typename event_responce_type::value_type res(ev->value());
 
   std::string patternResult =
@@ -129,13 +114,33 @@ void replyNotImplementedYet(IDriver* sender, event_request_type* ev, const char*
   res.setErrorInfo(er);
   event_responce_type* resp = new event_responce_type(sender, res);
   IDriver::Reply(esender, resp);
-  notifyProgressImpl(sender, esender, 100);
+  notifyProgressImpl(sender, esender, events::ProgressResponceEvent::value_type(100));
+}
+
+// requests IServer sends to the background and monitoring lanes that need the connection;
+// keys cache updates and the replies and progress events a lane gets from itself are not among them
+bool isLaneRequestEvent(QEvent::Type type) {
+  return type == static_cast<QEvent::Type>(events::LoadDatabaseContentRequestEvent::EventType) ||
+         type == static_cast<QEvent::Type>(events::LoadDatabaseKeysCountRequestEvent::EventType) ||
+         type == static_cast<QEvent::Type>(events::LoadKeysCacheRequestEvent::EventType) ||
+         type == static_cast<QEvent::Type>(events::RevalidateKeysRequestEvent::EventType) ||
+         type == static_cast<QEvent::Type>(events::ServerInfoRequestEvent::EventType) ||
+         type == static_cast<QEvent::Type>(events::ServerInfoHistoryRequestEvent::EventType) ||
+         type == static_cast<QEvent::Type>(events::ClearServerHistoryRequestEvent::EventType);
 }
 
 }  // namespace
 
 IDriver::IDriver(IConnectionSettingsBaseSPtr settings)
-    : settings_(settings), thread_(nullptr), timer_info_id_(0), log_file_(nullptr) {
+    : settings_(settings),
+      thread_(nullptr),
+      timer_info_id_(0),
+      history_writer_(nullptr),
+      keys_cache_(nullptr),
+      keys_cache_db_(),
+      execute_reciver_(nullptr),
+      lane_reconnect_(false),
+      serving_lanes_((1 << LANES_COUNT) - 1) {
   thread_ = new QThread(this);
   moveToThread(thread_);
 
@@ -144,10 +149,8 @@ IDriver::IDriver(IConnectionSettingsBaseSPtr settings)
 }
 
 IDriver::~IDriver() {
-  if (log_file_) {
-    log_file_->Close();
-    destroy(&log_file_);
-  }
+  destroy(&history_writer_);
+  destroy(&keys_cache_);
 }
 
 common::Error IDriver::Execute(core::FastoObjectCommandIPtr cmd) {
@@ -186,6 +189,18 @@ void IDriver::Interrupt() {
   SetInterrupted(true);
 }
 
+bool IDriver::IsServingLane(DriverLane lane) const {
+  return serving_lanes_ & (1 << lane);
+}
+
+void IDriver::SetServingLane(DriverLane lane, bool serve) {
+  if (serve) {
+    serving_lanes_ |= (1 << lane);
+  } else {
+    serving_lanes_ &= ~(1 << lane);
+  }
+}
+
 void IDriver::Init() {
   if (settings_->IsHistoryEnabled()) {
     int interval = settings_->LoggingMsTimeInterval();
@@ -211,6 +226,16 @@ void IDriver::customEvent(QEvent* event) {
   SetInterrupted(false);
 
   QEvent::Type type = event->type();
+  if (type == static_cast<QEvent::Type>(events::ConnectRequestEvent::EventType)) {
+    lane_reconnect_ = true;  // lanes get it once the main connection is up
+  } else if (type == static_cast<QEvent::Type>(events::DisconnectRequestEvent::EventType)) {
+    lane_reconnect_ = false;
+  } else if (lane_reconnect_ && !IsServingLane(INTERACTIVE_LANE) && isLaneRequestEvent(type) && !IsConnected()) {
+    // lane drivers reconnect on demand, a failure is reported by the request itself
+    common::Error err = SyncConnect();
+    UNUSED(err);
+  }
+
   if (type == static_cast<QEvent::Type>(events::ConnectRequestEvent::EventType)) {
     events::ConnectRequestEvent* ev = static_cast<events::ConnectRequestEvent*>(event);
     HandleConnectEvent(ev);
@@ -259,7 +284,40 @@ void IDriver::customEvent(QEvent* event) {
     HandleChangeMaxConnectionEvent(ev);  // ni
   } else if (type == static_cast<QEvent::Type>(events::LoadDatabaseContentRequestEvent::EventType)) {
     events::LoadDatabaseContentRequestEvent* ev = static_cast<events::LoadDatabaseContentRequestEvent*>(event);
-    HandleLoadDatabaseContentEvent(ev);
+    common::Error err = PrepareLaneRequest(ev->value().inf);
+    if (err && err->IsError()) {
+      events::LoadDatabaseContentResponceEvent::value_type res(ev->value());
+      res.setErrorInfo(err);
+      Reply(ev->sender(), new events::LoadDatabaseContentResponceEvent(this, res));
+    } else {
+      HandleLoadDatabaseContentEvent(ev);
+    }
+  } else if (type == static_cast<QEvent::Type>(events::LoadDatabaseKeysCountRequestEvent::EventType)) {
+    events::LoadDatabaseKeysCountRequestEvent* ev = static_cast<events::LoadDatabaseKeysCountRequestEvent*>(event);
+    common::Error err = PrepareLaneRequest(ev->value().inf);
+    if (err && err->IsError()) {
+      events::LoadDatabaseKeysCountResponceEvent::value_type res(ev->value());
+      res.setErrorInfo(err);
+      Reply(ev->sender(), new events::LoadDatabaseKeysCountResponceEvent(this, res));
+    } else {
+      HandleLoadDatabaseKeysCountEvent(ev);
+    }
+  } else if (type == static_cast<QEvent::Type>(events::LoadKeysCacheRequestEvent::EventType)) {
+    events::LoadKeysCacheRequestEvent* ev = static_cast<events::LoadKeysCacheRequestEvent*>(event);
+    HandleLoadKeysCacheEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::RevalidateKeysRequestEvent::EventType)) {
+    events::RevalidateKeysRequestEvent* ev = static_cast<events::RevalidateKeysRequestEvent*>(event);
+    common::Error err = PrepareLaneRequest(ev->value().inf);
+    if (err && err->IsError()) {
+      events::RevalidateKeysResponceEvent::value_type res(ev->value());
+      res.setErrorInfo(err);
+      Reply(ev->sender(), new events::RevalidateKeysResponceEvent(this, res));
+    } else {
+      HandleRevalidateKeysEvent(ev);
+    }
+  } else if (type == static_cast<QEvent::Type>(events::UpdateKeysCacheRequestEvent::EventType)) {
+    events::UpdateKeysCacheRequestEvent* ev = static_cast<events::UpdateKeysCacheRequestEvent*>(event);
+    HandleUpdateKeysCacheEvent(ev);
   } else if (type == static_cast<QEvent::Type>(events::DiscoveryInfoRequestEvent::EventType)) {
     events::DiscoveryInfoRequestEvent* ev = static_cast<events::DiscoveryInfoRequestEvent*>(event);
     HandleDiscoveryInfoEvent(ev);  //
@@ -269,29 +327,29 @@ void IDriver::customEvent(QEvent* event) {
 }
 
 void IDriver::timerEvent(QTimerEvent* event) {
-  if (timer_info_id_ == event->timerId() && settings_->IsHistoryEnabled() && IsConnected()) {
-    if (!log_file_) {
+  if (timer_info_id_ == event->timerId() && settings_->IsHistoryEnabled() && IsServingLane(MONITORING_LANE) &&
+      IsConnected()) {
+    if (!history_writer_) {
       std::string path = settings_->LoggingPath();
       std::string dir = common::file_system::get_dir_path(path);
       common::Error err = common::file_system::create_directory(dir, true);
       if (err && err->IsError()) {
       }
       if (common::file_system::is_directory(dir) == common::SUCCESS) {
-        common::file_system::ascii_string_path p(path);
-        log_file_ = new common::file_system::ANSIFile(p);
+        const core::connectionTypes type = Type();
+        history_writer_ = new core::ServerInfoHistoryWriter(path, type, core::ServerInfoHistoryColumnsFromType(type));
       }
     }
 
-    if (log_file_ && !log_file_->IsOpened()) {
-      common::Error err = log_file_->Open("ab+");
+    if (history_writer_ && !history_writer_->IsOpened()) {
+      common::Error err = history_writer_->Open();
       if (err && err->IsError()) {
         DNOTREACHED();
       }
     }
 
-    if (log_file_ && log_file_->IsOpened()) {
+    if (history_writer_ && history_writer_->IsOpened()) {
       common::time64_t time = common::time::current_mstime();
-      std::string stamp = createStamp(time);
       core::IServerInfo* info = nullptr;
       common::Error er = CurrentServerInfo(&info);
       if (er && er->IsError()) {
@@ -302,16 +360,22 @@ void IDriver::timerEvent(QTimerEvent* event) {
       struct core::ServerInfoSnapShoot shot(time, core::IServerInfoSPtr(info));
       emit ServerInfoSnapShoot(shot);
 
-      log_file_->Write(stamp);
-      log_file_->Write(info->ToString());
-      log_file_->Flush();
+      core::ServerInfoHistoryRow row = core::MakeServerInfoHistoryRow(info, history_writer_->Columns(), time);
+      common::Error err = history_writer_->Append(row);
+      if (err && err->IsError()) {
+        DNOTREACHED();
+      }
     }
   }
   QObject::timerEvent(event);
 }
 
 void IDriver::NotifyProgress(QObject* reciver, int value) {
-  notifyProgressImpl(this, reciver, value);
+  notifyProgressImpl(this, reciver, events::ProgressResponceEvent::value_type(value));
+}
+
+void IDriver::NotifyProgress(QObject* reciver, int value, double rate, common::time64_t eta_msec) {
+  notifyProgressImpl(this, reciver, events::ProgressResponceEvent::value_type(value, rate, eta_msec));
 }
 
 void IDriver::HandleConnectEvent(events::ConnectRequestEvent* ev) {
@@ -322,6 +386,13 @@ void IDriver::HandleConnectEvent(events::ConnectRequestEvent* ev) {
   common::Error er = SyncConnect();
   if (er && er->IsError()) {
     res.setErrorInfo(er);
+  } else {
+    core::IDataBaseInfo* info = nullptr;
+    common::Error dberr = CurrentDataBaseInfo(&info);
+    if (!dberr || !dberr->IsError()) {  // engines without SELECT on connect start in their only database
+      keys_cache_db_ = info->Name();
+      delete info;
+    }
   }
   NotifyProgress(sender, 75);
   Reply(sender, new events::ConnectResponceEvent(this, res));
@@ -343,10 +414,42 @@ void IDriver::HandleDisconnectEvent(events::DisconnectRequestEvent* ev) {
   NotifyProgress(sender, 100);
 }
 
+common::Error IDriver::SyncSelectDatabase(const std::string& name) {
+  UNUSED(name);
+  return common::Error();
+}
+
+common::Error IDriver::PrepareLaneRequest(core::IDataBaseInfoSPtr db) {
+  if (IsServingLane(INTERACTIVE_LANE) || !db) {
+    return common::Error();
+  }
+
+  // own connection of the lane follows the database of the request
+  return SyncSelectDatabase(db->Name());
+}
+
+bool IDriver::IsStreamingCommand(const core::command_buffer_t& command) const {
+  UNUSED(command);
+  return false;
+}
+
 void IDriver::HandleExecuteEvent(events::ExecuteRequestEvent* ev) {
   QObject* sender = ev->sender();
   NotifyProgress(sender, 0);
   events::ExecuteResponceEvent::value_type res(ev->value());
+  if (!res.script_path.empty()) {
+    RootLocker lock(this, sender, res.text, res.silence, res.stream_retention);
+    execute_reciver_ = sender;
+    common::Error err = ExecuteScript(sender, res.script_path, res.start_line, res.pipeline_window, res.logtype,
+                                      &res.executed_line);
+    execute_reciver_ = nullptr;
+    if (err && err->IsError()) {
+      res.setErrorInfo(err);
+    }
+    Reply(sender, new events::ExecuteResponceEvent(this, res));
+    NotifyProgress(sender, 100);
+    return;
+  }
 
   const core::command_buffer_t input_line = res.text;
   std::vector<core::command_buffer_t> commands;
@@ -363,11 +466,16 @@ void IDriver::HandleExecuteEvent(events::ExecuteRequestEvent* ev) {
   const bool history = res.history;
   const common::time64_t msec_repeat_interval = res.msec_repeat_interval;
   const core::CmdLoggingType log_type = res.logtype;
-  RootLocker* lock = history ? new RootLocker(this, sender, input_line, silence)
-                             : new FirstChildUpdateRootLocker(this, sender, input_line, silence, commands);
+  const size_t pipeline_window = res.pipeline_window;
+  const size_t stream_retention = res.stream_retention;
+  RootLocker* lock = history ? new RootLocker(this, sender, input_line, silence, stream_retention)
+                             : new FirstChildUpdateRootLocker(this, sender, input_line, silence, stream_retention,
+                                                              commands);
   core::FastoObjectIPtr obj = lock->Root();
+  execute_reciver_ = sender;
   const double step = 99.0 / double(commands.size() * (repeat + 1));
   double cur_progress = 0.0;
+  std::vector<core::FastoObjectCommandIPtr> pipeline;
   for (size_t r = 0; r < repeat + 1; ++r) {
     common::time64_t start_ts = common::time::current_mstime();
     for (size_t i = 0; i < commands.size(); ++i) {
@@ -383,6 +491,21 @@ void IDriver::HandleExecuteEvent(events::ExecuteRequestEvent* ev) {
       core::command_buffer_t command = commands[i];
       core::FastoObjectCommandIPtr cmd =
           silence ? CreateCommandFast(command, log_type) : CreateCommand(obj.get(), command, log_type);  //
+      if (pipeline_window) {
+        pipeline.push_back(cmd);
+        if (pipeline.size() < pipeline_window && i + 1 < commands.size()) {
+          continue;
+        }
+
+        common::Error err = ExecutePipelineImpl(pipeline);
+        pipeline.clear();
+        if (err && err->IsError()) {
+          res.setErrorInfo(err);
+          goto done;
+        }
+        continue;
+      }
+
       common::Error err = Execute(cmd);
       if (err && err->IsError()) {
         res.setErrorInfo(err);
@@ -399,11 +522,72 @@ void IDriver::HandleExecuteEvent(events::ExecuteRequestEvent* ev) {
   }
 
 done:
+  execute_reciver_ = nullptr;
   Reply(sender, new events::ExecuteResponceEvent(this, res));
   NotifyProgress(sender, 100);
   delete lock;
 }
 
+void IDriver::HandleLoadDatabaseKeysCountEvent(events::LoadDatabaseKeysCountRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::LoadDatabaseKeysCountResponceEvent::value_type res(ev->value());
+  const size_t estimated = res.inf ? res.inf->DBKeysCount() : 0;
+  uint64_t cursor = 0;
+  size_t counted = 0;
+  do {
+    if (IsInterrupted()) {
+      res.setErrorInfo(common::make_error_value("Interrupted keys count.", common::ErrorValue::E_INTERRUPTED,
+                                                common::logging::L_WARNING));
+      goto done;
+    }
+
+    const core::command_buffer_t pattern_result =
+        core::internal::GetKeysPattern(cursor, ALL_KEYS_PATTERNS, KEYS_COUNT_SCAN_PAGE_SIZE);
+    core::FastoObjectCommandIPtr cmd = CreateCommandFast(pattern_result, core::C_INNER);
+    common::Error err = Execute(cmd);
+    if (err && err->IsError()) {
+      res.setErrorInfo(err);
+      goto done;
+    }
+
+    // reply is [cursor, [keys]], same as for database content
+    cursor = 0;
+    core::FastoObject::childs_t rchildrens = cmd->Childrens();
+    if (rchildrens.size() != 1) {
+      break;
+    }
+
+    core::FastoObjectArray* array = dynamic_cast<core::FastoObjectArray*>(rchildrens[0].get());
+    if (!array) {
+      break;
+    }
+
+    std::string cursor_str;
+    if (!array->Array()->GetString(0, &cursor_str) || !common::ConvertFromString(cursor_str, &cursor)) {
+      cursor = 0;
+    }
+
+    rchildrens = array->Childrens();
+    if (rchildrens.size()) {
+      core::FastoObjectArray* keys = dynamic_cast<core::FastoObjectArray*>(rchildrens[0].get());
+      if (keys) {
+        counted += keys->Array()->GetSize();
+      }
+    }
+
+    if (estimated) {
+      NotifyProgress(sender, std::min<size_t>(counted * 99 / estimated, 99));
+    }
+  } while (cursor != 0);
+
+  res.db_keys_count = counted;
+
+done:
+  Reply(sender, new events::LoadDatabaseKeysCountResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
 void IDriver::HandleLoadServerPropertyEvent(events::ServerPropertyInfoRequestEvent* ev) {
   replyNotImplementedYet<events::ServerPropertyInfoRequestEvent, events::ServerPropertyInfoResponceEvent>(
       this, ev, "server property");
@@ -424,11 +608,305 @@ void IDriver::HandleShutdownEvent(events::ShutDownRequestEvent* ev) {
 }
 
 void IDriver::HandleBackupEvent(events::BackupRequestEvent* ev) {
-  replyNotImplementedYet<events::BackupRequestEvent, events::BackupResponceEvent>(this, ev, "backup server");
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::BackupResponceEvent::value_type res(ev->value());
+  common::Error err = BackupToPath(sender, res.path, &res.saved_keys);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+  }
+  Reply(sender, new events::BackupResponceEvent(this, res));
+  NotifyProgress(sender, 100);
 }
 
 void IDriver::HandleExportEvent(events::ExportRequestEvent* ev) {
-  replyNotImplementedYet<events::ExportRequestEvent, events::ExportResponceEvent>(this, ev, "export server");
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::ExportResponceEvent::value_type res(ev->value());
+  common::Error err = ImportFromPath(sender, res.path, &res.imported_keys);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+  }
+  Reply(sender, new events::ExportResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+common::Error IDriver::ImportFromPath(QObject* reciver, const std::string& path, size_t* imported_keys) {
+  core::DumpFormat format;
+  if (!core::DumpFormatFromPath(path, &format)) {
+    return common::make_error_value("Unknown format of dump file: " + path, common::ErrorValue::E_ERROR);
+  }
+
+  core::DumpReader reader(format);
+  common::Error err = reader.Open(path);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  // records are written in batches through the fastest write path of the engine
+  const common::time64_t start_ts = common::time::current_mstime();
+  common::time64_t notify_ts = start_ts;
+  core::NDbKValues batch;
+  batch.reserve(IMPORT_BATCH_SIZE);
+  *imported_keys = 0;
+  bool eof = false;
+  while (!eof) {
+    if (IsInterrupted()) {
+      return common::make_error_value("Interrupted import.", common::ErrorValue::E_INTERRUPTED,
+                                      common::logging::L_WARNING);
+    }
+
+    batch.clear();
+    while (batch.size() < IMPORT_BATCH_SIZE) {
+      core::NDbKValue record;
+      err = reader.Next(&record, &eof);
+      if (err && err->IsError()) {
+        return err;
+      }
+
+      if (eof) {
+        break;
+      }
+      batch.push_back(record);
+    }
+
+    // redis DUMP payloads are only valid for RESTORE
+    err = reader.ValueEncoding() == core::DUMP_REDIS_VALUES ? RestoreImpl(batch) : BulkSetImpl(batch);
+    if (err && err->IsError()) {
+      return err;
+    }
+    *imported_keys += batch.size();
+
+    const common::time64_t cur_ts = common::time::current_mstime();
+    if (cur_ts - notify_ts < IMPORT_PROGRESS_INTERVAL_MSEC) {
+      continue;
+    }
+
+    notify_ts = cur_ts;
+    const double elapsed_msec = std::max<common::time64_t>(cur_ts - start_ts, 1);
+    const double read = reader.BytesRead();
+    const double size = std::max<double>(reader.Size(), read);
+    const int progress = size ? static_cast<int>(read * 99 / size) : 0;
+    const double rate = *imported_keys * 1000 / elapsed_msec;
+    const common::time64_t eta_msec = read ? static_cast<common::time64_t>((size - read) * elapsed_msec / read) : 0;
+    NotifyProgress(reciver, progress, rate, eta_msec);
+  }
+
+  return common::Error();
+}
+
+common::Error IDriver::ExecuteScript(QObject* reciver,
+                                     const std::string& path,
+                                     size_t start_line,
+                                     size_t pipeline_window,
+                                     core::CmdLoggingType log_type,
+                                     size_t* executed_line) {
+  core::ScriptReader reader;
+  common::Error err = reader.Open(path);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  err = reader.SkipTo(start_line);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  // replies aren't kept in the output tree, a command log can have millions of lines
+  const core::translator_t tran = Translator();
+  const uint64_t start_offset = reader.BytesRead();
+  const common::time64_t start_ts = common::time::current_mstime();
+  common::time64_t notify_ts = start_ts;
+  *executed_line = reader.LineNumber();
+  size_t executed = 0;
+  std::vector<core::FastoObjectCommandIPtr> pipeline;
+  while (true) {
+    if (IsInterrupted()) {
+      std::string msg = common::MemSPrintf("Interrupted script exec after line %" PRIu64 ".",
+                                           static_cast<uint64_t>(*executed_line));
+      return common::make_error_value(msg, common::ErrorValue::E_INTERRUPTED, common::logging::L_WARNING);
+    }
+
+    core::command_buffer_t command;
+    bool eof = false;
+    err = reader.Next(&command, &eof);
+    if (err && err->IsError()) {
+      return err;
+    }
+
+    if (!eof) {
+      err = tran->TestCommandLine(command);
+      if (err && err->IsError()) {
+        std::string msg = common::MemSPrintf("Script line %" PRIu64 ": %s",
+                                             static_cast<uint64_t>(reader.LineNumber()), err->GetDescription());
+        return common::make_error_value(msg, common::ErrorValue::E_ERROR);
+      }
+
+      pipeline.push_back(CreateCommandFast(command, log_type));
+      if (pipeline.size() < std::max<size_t>(pipeline_window, 1)) {
+        continue;
+      }
+    }
+
+    // a failed window may be partly done, resume repeats it from its first line
+    if (!pipeline.empty()) {
+      err = pipeline.size() == 1 ? Execute(pipeline[0]) : ExecutePipelineImpl(pipeline);
+      if (err && err->IsError()) {
+        std::string msg = pipeline.size() == 1
+                              ? common::MemSPrintf("Script line %" PRIu64 ": %s",
+                                                   static_cast<uint64_t>(reader.LineNumber()), err->GetDescription())
+                              : common::MemSPrintf("Script lines %" PRIu64 "-%" PRIu64 ": %s",
+                                                   static_cast<uint64_t>(*executed_line + 1),
+                                                   static_cast<uint64_t>(reader.LineNumber()), err->GetDescription());
+        return common::make_error_value(msg, common::ErrorValue::E_ERROR);
+      }
+      *executed_line = reader.LineNumber();
+      executed += pipeline.size();
+      pipeline.clear();
+    }
+
+    if (eof) {
+      break;
+    }
+
+    const common::time64_t cur_ts = common::time::current_mstime();
+    if (cur_ts - notify_ts < IMPORT_PROGRESS_INTERVAL_MSEC) {
+      continue;
+    }
+
+    notify_ts = cur_ts;
+    const double elapsed_msec = std::max<common::time64_t>(cur_ts - start_ts, 1);
+    const double read = reader.BytesRead();
+    const double size = std::max<double>(reader.Size(), read);
+    const double done = read - start_offset;
+    const int progress = size ? static_cast<int>(read * 99 / size) : 0;
+    const double rate = executed * 1000 / elapsed_msec;
+    const common::time64_t eta_msec = done ? static_cast<common::time64_t>((size - read) * elapsed_msec / done) : 0;
+    NotifyProgress(reciver, progress, rate, eta_msec);
+  }
+
+  return common::Error();
+}
+
+common::Error IDriver::BackupToPath(QObject* reciver, const std::string& path, size_t* saved_keys) {
+  core::DumpFormat format;
+  if (!core::DumpFormatFromPath(path, &format) || format != core::DUMP_ARCHIVE) {
+    return common::make_error_value("Backup is written only into " DUMP_ARCHIVE_EXTENSION " archive: " + path,
+                                    common::ErrorValue::E_ERROR);
+  }
+
+  // total is only for progress, so statistics estimate is good enough
+  size_t keys_count = 0;
+  core::IDataBaseInfo* info = nullptr;
+  common::Error err = CurrentDataBaseInfo(&info);
+  if (!err || !err->IsError()) {
+    keys_count = info->DBKeysCount();
+    delete info;
+  }
+
+  core::DumpArchiveWriter writer(Type(), BackupValueEncoding());
+  std::string position;
+  err = writer.Open(path, &position);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  const common::time64_t start_ts = common::time::current_mstime();
+  const uint64_t resumed_keys = writer.RecordsCount();
+  common::time64_t notify_ts = start_ts;
+  auto append_cb = [&](const core::NDbKValue& record, const std::string& resume_position) -> common::Error {
+    if (IsInterrupted()) {  // written chunks are kept, next backup into this path continues
+      return common::make_error_value("Interrupted backup.", common::ErrorValue::E_INTERRUPTED,
+                                      common::logging::L_WARNING);
+    }
+
+    common::Error err = writer.Append(record, resume_position);
+    if (err && err->IsError()) {
+      return err;
+    }
+
+    const common::time64_t cur_ts = common::time::current_mstime();
+    if (cur_ts - notify_ts < IMPORT_PROGRESS_INTERVAL_MSEC) {
+      return common::Error();
+    }
+
+    notify_ts = cur_ts;
+    const double elapsed_msec = std::max<common::time64_t>(cur_ts - start_ts, 1);
+    const double saved = writer.RecordsCount();
+    const double total = std::max<double>(keys_count, saved);
+    const int progress = total ? static_cast<int>(saved * 99 / total) : 0;
+    const double rate = (saved - resumed_keys) * 1000 / elapsed_msec;
+    const common::time64_t eta_msec = rate ? static_cast<common::time64_t>((total - saved) * 1000 / rate) : 0;
+    NotifyProgress(reciver, progress, rate, eta_msec);
+    return common::Error();
+  };
+
+  err = WalkImpl(position, append_cb);
+  *saved_keys = writer.RecordsCount();
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  return writer.Finish();
+}
+
+core::DumpValueEncoding IDriver::BackupValueEncoding() const {
+  return core::DUMP_RAW_VALUES;
+}
+
+common::Error IDriver::RestoreImpl(const core::NDbKValues& keys) {
+  UNUSED(keys);
+  return common::make_error_value("Redis backup can be restored only into Redis", common::ErrorValue::E_ERROR);
+}
+
+common::Error IDriver::RevalidateKeysImpl(core::NDbKValues* keys) {
+  if (!IsConnected()) {
+    return common::make_error_value("Not connected", common::ErrorValue::E_ERROR);
+  }
+
+  core::NKeys cached_keys;
+  for (size_t i = 0; i < keys->size(); ++i) {
+    cached_keys.push_back((*keys)[i].GetKey());
+  }
+
+  core::NKeys existing_keys;
+  common::Error err = ExistsImpl(cached_keys, &existing_keys);
+  if (err && err->IsError()) {
+    return err;
+  }
+
+  std::set<core::string_key_t> existing;
+  for (size_t i = 0; i < existing_keys.size(); ++i) {
+    existing.insert(existing_keys[i].GetKey().ToBytes());
+  }
+
+  for (size_t i = 0; i < keys->size(); ++i) {
+    core::NDbKValue& key = (*keys)[i];
+    if (existing.find(key.GetKey().GetKey().ToBytes()) == existing.end()) {
+      core::NKey nkey = key.GetKey();
+      nkey.SetTTL(EXPIRED_TTL);
+      key.SetKey(nkey);
+    }
+  }
+
+  return common::Error();
+}
+
+common::Error IDriver::ExistsImpl(const core::NKeys& keys, core::NKeys* existing_keys) {
+  UNUSED(keys);
+  UNUSED(existing_keys);
+  return common::make_error_value("Keys existence check not supported", common::ErrorValue::E_ERROR);
+}
+
+common::Error IDriver::ExecutePipelineImpl(const std::vector<core::FastoObjectCommandIPtr>& cmds) {
+  for (size_t i = 0; i < cmds.size(); ++i) {
+    common::Error err = Execute(cmds[i]);
+    if (err && err->IsError()) {
+      return err;
+    }
+  }
+
+  return common::Error();
 }
 
 void IDriver::HandleChangePasswordEvent(events::ChangePasswordRequestEvent* ev) {
@@ -479,43 +957,13 @@ void IDriver::HandleLoadServerInfoHistoryEvent(events::ServerInfoHistoryRequestE
   QObject* sender = ev->sender();
   events::ServerInfoHistoryResponceEvent::value_type res(ev->value());
 
-  std::string path = settings_->LoggingPath();
-  common::file_system::ascii_string_path p(path);
-  common::file_system::ANSIFile readFile(p);
-  if (readFile.Open("rb")) {
-    events::ServerInfoHistoryResponceEvent::value_type::infos_container_type tmpInfos;
-
-    common::time64_t curStamp = 0;
-    common::buffer_t dataInfo;
-
-    while (!readFile.IsEOF()) {
-      common::buffer_t data;
-      bool res = readFile.ReadLine(&data);
-      if (!res || readFile.IsEOF()) {
-        if (curStamp) {
-          struct core::ServerInfoSnapShoot shoot(curStamp, MakeServerInfoFromString(common::ConvertToString(dataInfo)));
-          tmpInfos.push_back(shoot);
-        }
-        break;
-      }
-
-      common::time64_t tmpStamp = 0;
-      bool isSt = getStamp(data, &tmpStamp);
-      if (isSt) {
-        if (curStamp) {
-          struct core::ServerInfoSnapShoot shoot(curStamp, MakeServerInfoFromString(common::ConvertToString(dataInfo)));
-          tmpInfos.push_back(shoot);
-        }
-        curStamp = tmpStamp;
-        dataInfo.clear();
-      } else {
-        dataInfo.insert(dataInfo.end(), data.begin(), data.end());
-      }
-    }
-    res.setInfos(tmpInfos);
-    readFile.Close();
+  core::ServerInfoHistory history;
+  common::Error err = core::ReadServerInfoHistory(settings_->LoggingPath(), Type(), res.from_msec, res.to_msec,
+                                                  res.resolution_msec, &history);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
   } else {
-    res.setErrorInfo(common::make_error_value("History file not found", common::ErrorValue::E_ERROR));
+    res.setHistory(history);
   }
 
   Reply(sender, new events::ServerInfoHistoryResponceEvent(this, res));
@@ -527,8 +975,9 @@ void IDriver::HandleClearServerHistoryEvent(events::ClearServerHistoryRequestEve
 
   bool ret = false;
 
-  if (log_file_ && log_file_->IsOpened()) {
-    ret = log_file_->Truncate(0);
+  if (history_writer_ && history_writer_->IsOpened()) {
+    common::Error err = history_writer_->Clear();
+    ret = !err || !err->IsError();
   } else {
     std::string path = settings_->LoggingPath();
     if (common::file_system::is_file_exist(path)) {
@@ -550,6 +999,156 @@ void IDriver::HandleClearServerHistoryEvent(events::ClearServerHistoryRequestEve
   Reply(sender, new events::ClearServerHistoryResponceEvent(this, res));
 }
 
+void IDriver::HandleLoadKeysCacheEvent(events::LoadKeysCacheRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  events::LoadKeysCacheResponceEvent::value_type res(ev->value());
+
+  const std::string path = settings_->KeysCachePath();
+  if (res.inf && common::file_system::is_file_exist(path)) {  // nothing saved for the first connection
+    core::keys_cache_entries_t entries;
+    common::Error err = core::ReadKeysCache(path, Type(), res.inf->Name(), &entries);
+    if (err && err->IsError()) {
+      res.setErrorInfo(err);
+    } else {
+      const common::time64_t now = common::time::current_mstime();
+      for (size_t i = 0; i < entries.size(); ++i) {
+        core::NDbKValue key = entries[i].ToKey(now);
+        if (key.GetKey().GetTTL() != EXPIRED_TTL) {
+          res.keys.push_back(key);
+        }
+      }
+    }
+  }
+
+  Reply(sender, new events::LoadKeysCacheResponceEvent(this, res));
+}
+
+void IDriver::HandleRevalidateKeysEvent(events::RevalidateKeysRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  events::RevalidateKeysResponceEvent::value_type res(ev->value());
+
+  core::NDbKValues keys = res.keys;
+  res.keys.clear();
+  common::Error err = RevalidateKeysImpl(&keys);
+  if (err && err->IsError()) {
+    res.setErrorInfo(err);
+    Reply(sender, new events::RevalidateKeysResponceEvent(this, res));
+    return;
+  }
+
+  const common::time64_t now = common::time::current_mstime();
+  core::keys_cache_entries_t alive;
+  std::vector<std::string> stale;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (keys[i].GetKey().GetTTL() == EXPIRED_TTL) {
+      res.stale_keys.push_back(keys[i]);
+      stale.push_back(keys[i].GetKey().GetKey().ToBytes());
+    } else {
+      res.keys.push_back(keys[i]);
+      alive.push_back(core::KeysCacheEntry(keys[i], now));
+    }
+  }
+
+  core::KeysCacheWriter* cache = KeysCache();
+  if (cache && res.inf) {
+    common::Error werr = cache->Put(res.inf->Name(), alive);
+    if (!werr || !werr->IsError()) {
+      werr = cache->Remove(res.inf->Name(), stale);
+    }
+    if (werr && werr->IsError()) {
+      DNOTREACHED();
+    }
+  }
+
+  Reply(sender, new events::RevalidateKeysResponceEvent(this, res));
+}
+
+void IDriver::HandleUpdateKeysCacheEvent(events::UpdateKeysCacheRequestEvent* ev) {
+  const events::UpdateKeysCacheRequestEvent::value_type req = ev->value();
+  core::KeysCacheWriter* cache = req.inf ? KeysCache() : nullptr;
+  if (!cache) {
+    return;
+  }
+
+  const std::string db_name = req.inf->Name();
+  common::Error err;
+  if (req.type == events_info::UpdateKeysCacheRequest::RESET_KEYS) {
+    err = cache->Reset(db_name);
+  } else if (req.type == events_info::UpdateKeysCacheRequest::PUT_KEYS) {
+    const common::time64_t now = common::time::current_mstime();
+    core::keys_cache_entries_t entries;
+    for (size_t i = 0; i < req.keys.size(); ++i) {
+      entries.push_back(core::KeysCacheEntry(req.keys[i], now));
+    }
+    err = cache->Put(db_name, entries);
+  } else {
+    std::vector<std::string> raw_keys;
+    for (size_t i = 0; i < req.keys.size(); ++i) {
+      raw_keys.push_back(req.keys[i].GetKey().GetKey().ToBytes());
+    }
+    err = cache->Remove(db_name, raw_keys);
+  }
+  UNUSED(err);
+}
+
+core::KeysCacheWriter* IDriver::KeysCache() {
+  if (!IsServingLane(BACKGROUND_LANE)) {
+    return nullptr;
+  }
+
+  if (!keys_cache_) {
+    std::string path = settings_->KeysCachePath();
+    std::string dir = common::file_system::get_dir_path(path);
+    common::Error err = common::file_system::create_directory(dir, true);
+    if (err && err->IsError()) {
+      return nullptr;
+    }
+    keys_cache_ = new core::KeysCacheWriter(path, Type());
+  }
+
+  if (!keys_cache_->IsOpened()) {
+    common::Error err = keys_cache_->Open();
+    if (err && err->IsError()) {
+      return nullptr;
+    }
+  }
+
+  return keys_cache_;
+}
+
+void IDriver::UpdateKeysCache(const events_info::LoadDatabaseContentResponce& res) {
+  common::Error err = res.errorInfo();
+  if ((err && err->IsError()) || !res.inf) {
+    return;
+  }
+
+  core::KeysCacheWriter* cache = KeysCache();
+  if (!cache) {
+    return;
+  }
+
+  // content of any database may be loaded, the key hooks keep following the current one
+  const std::string db_name = res.inf->Name();
+  if (res.cursor_in == 0 && res.pattern == ALL_KEYS_PATTERNS) {
+    err = cache->Reset(db_name);
+    if (err && err->IsError()) {
+      return;
+    }
+  }
+
+  const common::time64_t now = common::time::current_mstime();
+  core::keys_cache_entries_t entries;
+  entries.reserve(res.keys.size());
+  for (size_t i = 0; i < res.keys.size(); ++i) {
+    entries.push_back(core::KeysCacheEntry(res.keys[i], now));
+  }
+
+  err = cache->Put(db_name, entries);
+  if (err && err->IsError()) {
+    DNOTREACHED();
+  }
+}
+
 void IDriver::HandleDiscoveryInfoEvent(events::DiscoveryInfoRequestEvent* ev) {
   QObject* sender = ev->sender();
   NotifyProgress(sender, 0);
@@ -602,21 +1201,43 @@ common::Error IDriver::ServerDiscoveryInfo(core::IServerInfo** sinfo, core::IDat
 }
 
 void IDriver::OnFlushedCurrentDB() {
+  core::KeysCacheWriter* cache = keys_cache_db_.empty() ? nullptr : KeysCache();
+  if (cache) {
+    common::Error err = cache->Reset(keys_cache_db_);
+    UNUSED(err);
+  }
   emit FlushedDB();
 }
 
 void IDriver::OnCurrentDataBaseChanged(core::IDataBaseInfo* info) {
+  keys_cache_db_ = info->Name();
   core::IDataBaseInfoSPtr curdb(info->Clone());
   emit CurrentDataBaseChanged(curdb);
 }
 
 void IDriver::OnKeysRemoved(const core::NKeys& keys) {
+  core::KeysCacheWriter* cache = keys_cache_db_.empty() ? nullptr : KeysCache();
+  if (cache) {
+    std::vector<std::string> raw_keys;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      raw_keys.push_back(keys[i].GetKey().ToBytes());
+    }
+    common::Error err = cache->Remove(keys_cache_db_, raw_keys);
+    UNUSED(err);
+  }
+
   for (size_t i = 0; i < keys.size(); ++i) {
     emit KeyRemoved(keys[i]);
   }
 }
 
 void IDriver::OnKeyAdded(const core::NDbKValue& key) {
+  core::KeysCacheWriter* cache = keys_cache_db_.empty() ? nullptr : KeysCache();
+  if (cache) {
+    core::keys_cache_entries_t entries(1, core::KeysCacheEntry(key, common::time::current_mstime()));
+    common::Error err = cache->Put(keys_cache_db_, entries);
+    UNUSED(err);
+  }
   emit KeyAdded(key);
 }
 
@@ -625,6 +1246,11 @@ void IDriver::OnKeyLoaded(const core::NDbKValue& key) {
 }
 
 void IDriver::OnKeyRenamed(const core::NKey& key, const core::string_key_t& new_key) {
+  core::KeysCacheWriter* cache = keys_cache_db_.empty() ? nullptr : KeysCache();
+  if (cache) {  // the new name is picked up by the next load
+    common::Error err = cache->Remove(keys_cache_db_, std::vector<std::string>(1, key.GetKey().ToBytes()));
+    UNUSED(err);
+  }
   emit KeyRenamed(key, new_key);
 }
 
@@ -640,5 +1266,11 @@ void IDriver::OnQuited() {
   emit Disconnected();
 }
 
+void IDriver::OnProgressChanged(int value) {
+  if (execute_reciver_) {
+    NotifyProgress(execute_reciver_, value);
+  }
+}
+
 }  // namespace proxy
 }  // namespace fastonosql
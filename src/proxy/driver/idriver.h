@@ -18,15 +18,18 @@
 
 #pragma once
 
+#include <atomic>  // for atomic
 #include <string>  // for string
 
 #include <QObject>
 
 #include <common/error.h>   // for Error
 #include <common/macros.h>  // for WARN_UNUSED_RESULT
+#include <common/types.h>   // for time64_t
 #include <common/value.h>   // for Value, Value::CommandLogging...
 
 #include "core/connection_types.h"     // for core::connectionTypes
+#include "core/data_dump.h"            // for walk_callback_t, DumpValueEncoding
 #include "core/db_key.h"               // for NKey (ptr only), NDbKValue (...
 #include "core/icommand_translator.h"  // for translator_t
 
@@ -34,6 +37,7 @@
 #include "core/internal/cdb_connection_client.h"             // for CDBConnectionClient
 #include "core/server/iserver_info.h"                        // for IServerInfoSPtr, etc
 #include "proxy/connection_settings/iconnection_settings.h"  // for IConnectionSettingsBaseSPtr
+#include "proxy/driver/stream_buffer.h"                      // for StreamBufferSPtr
 #include "proxy/events/events.h"                             // for BackupRequestEvent, ChangeMa...
 
 #include "core/global.h"  // for FastoObject (ptr only), etc
@@ -41,15 +45,20 @@
 class QEvent;
 class QThread;  // lines 37-37
 class QTimerEvent;
-namespace common {
-namespace file_system {
-class File;
+namespace fastonosql {
+namespace core {
+class KeysCacheWriter;
+class ServerInfoHistoryWriter;
 }
-}  // namespace common
+}  // namespace fastonosql
 
 namespace fastonosql {
 namespace proxy {
 
+// Kinds of requests a server can schedule on separate connections, so a
+// heavy load doesn't delay interactive commands or the info poller.
+enum DriverLane { INTERACTIVE_LANE = 0, BACKGROUND_LANE, MONITORING_LANE, LANES_COUNT };
+
 class IDriver : public QObject, public core::CDBConnectionClient {
   Q_OBJECT
  public:
@@ -68,6 +77,10 @@ class IDriver : public QObject, public core::CDBConnectionClient {
 
   void Interrupt();
 
+  // all lanes by default, an additional lane driver serves only its own
+  bool IsServingLane(DriverLane lane) const;
+  void SetServingLane(DriverLane lane, bool serve);
+
   virtual bool IsInterrupted() const = 0;
   virtual void SetInterrupted(bool interrupted) = 0;
 
@@ -77,9 +90,13 @@ class IDriver : public QObject, public core::CDBConnectionClient {
   virtual std::string Delimiter() const = 0;
   virtual std::string NsSeparator() const = 0;
 
+  // commands which reply until interrupted, like MONITOR
+  virtual bool IsStreamingCommand(const core::command_buffer_t& command) const;
+
  Q_SIGNALS:
   void ChildAdded(core::FastoObjectIPtr child);
   void ItemUpdated(core::FastoObject* item, common::ValueSPtr val);
+  void StreamStarted(proxy::StreamBufferSPtr stream);
   void ServerInfoSnapShoot(core::ServerInfoSnapShoot shot);
 
   void FlushedDB();
@@ -101,6 +118,7 @@ class IDriver : public QObject, public core::CDBConnectionClient {
   virtual void timerEvent(QTimerEvent* event) override;
 
   void NotifyProgress(QObject* reciver, int value);
+  void NotifyProgress(QObject* reciver, int value, double rate, common::time64_t eta_msec);
 
  protected:
   explicit IDriver(IConnectionSettingsBaseSPtr settings);
@@ -112,6 +130,7 @@ class IDriver : public QObject, public core::CDBConnectionClient {
   virtual void HandleExecuteEvent(events::ExecuteRequestEvent* ev);
 
   virtual void HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) = 0;
+  virtual void HandleLoadDatabaseKeysCountEvent(events::LoadDatabaseKeysCountRequestEvent* ev);  // exact, by SCAN
 
   virtual void HandleLoadServerPropertyEvent(events::ServerPropertyInfoRequestEvent* ev);
   virtual void HandleServerPropertyChangeEvent(events::ChangeServerPropertyInfoRequestEvent* ev);
@@ -125,7 +144,22 @@ class IDriver : public QObject, public core::CDBConnectionClient {
 
   const IConnectionSettingsBaseSPtr settings_;
 
+  // drivers save every loaded page, the first page of all keys replaces the database list
+  void UpdateKeysCache(const events_info::LoadDatabaseContentResponce& res);
+
   common::Error Execute(core::FastoObjectCommandIPtr cmd) WARN_UNUSED_RESULT;
+  // streams RESP, JSON lines or CSV dump (by extension) into the current database
+  common::Error ImportFromPath(QObject* reciver, const std::string& path, size_t* imported_keys) WARN_UNUSED_RESULT;
+  // validates and executes commands of the file line by line from start_line,
+  // executed_line is the last done one, so an interrupted script can be resumed
+  common::Error ExecuteScript(QObject* reciver,
+                              const std::string& path,
+                              size_t start_line,
+                              size_t pipeline_window,
+                              core::CmdLoggingType log_type,
+                              size_t* executed_line) WARN_UNUSED_RESULT;
+  // walks the current database into resumable archive, an unfinished one is continued
+  common::Error BackupToPath(QObject* reciver, const std::string& path, size_t* saved_keys) WARN_UNUSED_RESULT;
   virtual core::FastoObjectCommandIPtr CreateCommand(core::FastoObject* parent,
                                                      const core::command_buffer_t& input,
                                                      core::CmdLoggingType ct) = 0;
@@ -136,12 +170,28 @@ class IDriver : public QObject, public core::CDBConnectionClient {
  private:
   virtual common::Error SyncConnect() WARN_UNUSED_RESULT = 0;
   virtual common::Error SyncDisconnect() WARN_UNUSED_RESULT = 0;
+  virtual common::Error SyncSelectDatabase(const std::string& name) WARN_UNUSED_RESULT;  // for lane drivers
+  common::Error PrepareLaneRequest(core::IDataBaseInfoSPtr db) WARN_UNUSED_RESULT;
   void HandleLoadServerInfoEvent(events::ServerInfoRequestEvent* ev);  // call ServerInfo
   void HandleLoadServerInfoHistoryEvent(events::ServerInfoHistoryRequestEvent* ev);
   void HandleDiscoveryInfoEvent(events::DiscoveryInfoRequestEvent* ev);
   void HandleClearServerHistoryEvent(events::ClearServerHistoryRequestEvent* ev);
+  void HandleLoadKeysCacheEvent(events::LoadKeysCacheRequestEvent* ev);
+  void HandleRevalidateKeysEvent(events::RevalidateKeysRequestEvent* ev);
+  void HandleUpdateKeysCacheEvent(events::UpdateKeysCacheRequestEvent* ev);
+  core::KeysCacheWriter* KeysCache();  // only the background lane driver writes the file
 
   virtual common::Error ExecuteImpl(const core::command_buffer_t& command, core::FastoObject* out) = 0;
+  virtual common::Error BulkSetImpl(const core::NDbKValues& keys) = 0;
+  virtual common::Error WalkImpl(const std::string& position, core::walk_callback_t cb) = 0;
+  virtual core::DumpValueEncoding BackupValueEncoding() const;  // raw values by default
+  virtual common::Error RestoreImpl(const core::NDbKValues& keys);  // for not raw values, error by default
+  // sends commands without waiting for every reply where the engine can, replies go into
+  // the command nodes in order, one by one by default
+  virtual common::Error ExecutePipelineImpl(const std::vector<core::FastoObjectCommandIPtr>& cmds);
+  // refreshes type and ttl of the keys, missing ones get EXPIRED_TTL, only checks existence by default
+  virtual common::Error RevalidateKeysImpl(core::NDbKValues* keys);
+  virtual common::Error ExistsImpl(const core::NKeys& keys, core::NKeys* existing_keys);  // error by default
 
   virtual void OnFlushedCurrentDB() override;
   virtual void OnCurrentDataBaseChanged(core::IDataBaseInfo* info) override;
@@ -152,6 +202,7 @@ class IDriver : public QObject, public core::CDBConnectionClient {
   virtual void OnKeyTTLChanged(const core::NKey& key, core::ttl_t ttl) override;
   virtual void OnKeyTTLLoaded(const core::NKey& key, core::ttl_t ttl) override;
   virtual void OnQuited() override;
+  virtual void OnProgressChanged(int value) override;
 
   // internal methods
   virtual core::IServerInfoSPtr MakeServerInfoFromString(const std::string& val) = 0;
@@ -164,7 +215,12 @@ class IDriver : public QObject, public core::CDBConnectionClient {
  private:
   QThread* thread_;
   int timer_info_id_;
-  common::file_system::ANSIFile* log_file_;
+  core::ServerInfoHistoryWriter* history_writer_;
+  core::KeysCacheWriter* keys_cache_;
+  std::string keys_cache_db_;  // current database of the key hooks, set on connect and on SELECT
+  QObject* execute_reciver_;  // progress of long running commands
+  bool lane_reconnect_;       // lane drivers: main connection is up, lost lane connection comes back on demand
+  std::atomic<int> serving_lanes_;
 };
 
 }  // namespace proxy
@@ -18,6 +18,8 @@
 
 #include "proxy/driver/root_locker.h"
 
+#include <algorithm>  // for max
+
 #include <QObject>
 
 #include <common/macros.h>  // for DCHECK
@@ -29,12 +31,18 @@
 namespace fastonosql {
 namespace proxy {
 
-RootLocker::RootLocker(IDriver* parent, QObject* receiver, const core::command_buffer_t& text, bool silence)
+RootLocker::RootLocker(IDriver* parent,
+                       QObject* receiver,
+                       const core::command_buffer_t& text,
+                       bool silence,
+                       size_t stream_retention)
     : core::FastoObject::IFastoObjectObserver(),
+      streams_(),
       parent_(parent),
       receiver_(receiver),
       tstart_(common::time::current_mstime()),
-      silence_(silence) {
+      silence_(silence),
+      stream_retention_(std::max(stream_retention, static_cast<size_t>(1))) {
   DCHECK(parent_);
 
   root_ = core::FastoObject::CreateRoot(text, this);
@@ -56,12 +64,52 @@ core::FastoObjectIPtr RootLocker::Root() const {
 }
 
 void RootLocker::ChildrenAdded(core::FastoObjectIPtr child) {
-  emit parent_->ChildAdded(child);
+  if (!IsStreamingReply(child)) {
+    emit parent_->ChildAdded(child);
+    return;
+  }
+
+  core::FastoObject* command = child->Parent();
+  if (!dynamic_cast<core::FastoObjectCommand*>(command)) {  // +
+    return;  // part of a reply which is already buffered
+  }
+
+  // drivers add a streaming reply only once it is complete, the GUI reads it concurrently from the buffer
+  StreamBufferSPtr stream = FindStream(command);
+  if (!stream) {
+    stream = std::make_shared<StreamBuffer>(command, stream_retention_);
+    streams_.push_back(stream);
+    emit parent_->StreamStarted(stream);
+  }
+
+  stream->Push(child);
+  command->Clear();  // from now the reply is owned by the stream buffer
 }
 
 void RootLocker::Updated(core::FastoObject* item, core::FastoObject::value_t val) {
   emit parent_->ItemUpdated(item, val);
 }
 
+bool RootLocker::IsStreamingReply(core::FastoObjectIPtr child) const {
+  for (core::FastoObject* par = child->Parent(); par; par = par->Parent()) {
+    core::FastoObjectCommand* command = dynamic_cast<core::FastoObjectCommand*>(par);  // +
+    if (command) {
+      return parent_->IsStreamingCommand(command->InputCmd());
+    }
+  }
+
+  return false;
+}
+
+StreamBufferSPtr RootLocker::FindStream(core::FastoObject* command) const {
+  for (size_t i = 0; i < streams_.size(); ++i) {
+    if (streams_[i]->Command().get() == command) {
+      return streams_[i];
+    }
+  }
+
+  return StreamBufferSPtr();
+}
+
 }  // namespace proxy
 }  // namespace fastonosql
@@ -18,12 +18,17 @@
 
 #pragma once
 
+#include <stddef.h>  // for size_t
+
 #include <string>  // for string
+#include <vector>  // for vector
 
 #include <common/types.h>  // for time64_t
 
 #include "core/global.h"  // for FastoObjectIPtr, etc
 
+#include "proxy/driver/stream_buffer.h"  // for StreamBufferSPtr
+
 class QObject;
 namespace fastonosql {
 namespace proxy {
@@ -36,7 +41,11 @@ namespace proxy {
 
 class RootLocker : core::FastoObject::IFastoObjectObserver {
  public:
-  RootLocker(IDriver* parent, QObject* receiver, const core::command_buffer_t& text, bool silence);
+  RootLocker(IDriver* parent,
+             QObject* receiver,
+             const core::command_buffer_t& text,
+             bool silence,
+             size_t stream_retention);
   virtual ~RootLocker();
 
   core::FastoObjectIPtr Root() const;
@@ -46,12 +55,19 @@ class RootLocker : core::FastoObject::IFastoObjectObserver {
   virtual void ChildrenAdded(core::FastoObjectIPtr child) override;
   virtual void Updated(core::FastoObject* item, core::FastoObject::value_t val) override;
 
+  // replies of streaming commands bypass per child notifications
+  bool IsStreamingReply(core::FastoObjectIPtr child) const;
+
  private:
+  StreamBufferSPtr FindStream(core::FastoObject* command) const;
+
   core::FastoObjectIPtr root_;
+  std::vector<StreamBufferSPtr> streams_;
   IDriver* parent_;
   QObject* receiver_;
   const common::time64_t tstart_;
   const bool silence_;
+  const size_t stream_retention_;
 };
 
 }  // namespace proxy
@@ -0,0 +1,67 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "proxy/driver/stream_buffer.h"
+
+#include <common/macros.h>  // for DCHECK
+
+namespace fastonosql {
+namespace proxy {
+
+StreamBuffer::StreamBuffer(core::FastoObjectIPtr command, size_t capacity)
+    : command_(command), capacity_(capacity), lock_(), replies_(), received_(0), dropped_(0) {
+  DCHECK(capacity_);
+}
+
+core::FastoObjectIPtr StreamBuffer::Command() const {
+  return command_;
+}
+
+size_t StreamBuffer::Capacity() const {
+  return capacity_;
+}
+
+void StreamBuffer::Push(core::FastoObjectIPtr reply) {
+  std::lock_guard<std::mutex> lock(lock_);
+  received_++;
+  if (replies_.size() == capacity_) {
+    replies_.pop_front();
+    dropped_++;
+  }
+  replies_.push_back(reply);
+}
+
+StreamBuffer::replies_t StreamBuffer::TakeAll() {
+  std::lock_guard<std::mutex> lock(lock_);
+  replies_t replies(replies_.begin(), replies_.end());
+  replies_.clear();
+  return replies;
+}
+
+uint64_t StreamBuffer::ReceivedCount() const {
+  std::lock_guard<std::mutex> lock(lock_);
+  return received_;
+}
+
+uint64_t StreamBuffer::DroppedCount() const {
+  std::lock_guard<std::mutex> lock(lock_);
+  return dropped_;
+}
+
+}  // namespace proxy
+}  // namespace fastonosql
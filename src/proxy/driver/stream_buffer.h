@@ -0,0 +1,65 @@
+/*  Copyright (C) 2014-2017 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint64_t
+
+#include <deque>   // for deque
+#include <memory>  // for shared_ptr
+#include <mutex>   // for mutex
+#include <vector>  // for vector
+
+#include "core/global.h"  // for FastoObjectIPtr
+
+namespace fastonosql {
+namespace proxy {
+
+// Bounded ring buffer of replies of a streaming command (MONITOR, SUBSCRIBE, SYNC).
+// Filled on the driver thread, drained by the GUI at its own frame rate,
+// the oldest replies are dropped when the reader falls behind.
+class StreamBuffer {
+ public:
+  typedef std::vector<core::FastoObjectIPtr> replies_t;
+
+  StreamBuffer(core::FastoObjectIPtr command, size_t capacity);
+
+  core::FastoObjectIPtr Command() const;
+  size_t Capacity() const;
+
+  void Push(core::FastoObjectIPtr reply);
+  replies_t TakeAll();
+
+  uint64_t ReceivedCount() const;
+  uint64_t DroppedCount() const;
+
+ private:
+  const core::FastoObjectIPtr command_;
+  const size_t capacity_;
+
+  mutable std::mutex lock_;
+  std::deque<core::FastoObjectIPtr> replies_;
+  uint64_t received_;
+  uint64_t dropped_;
+};
+
+typedef std::shared_ptr<StreamBuffer> StreamBufferSPtr;
+
+}  // namespace proxy
+}  // namespace fastonosql
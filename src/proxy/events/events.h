@@ -83,6 +83,19 @@ typedef common::qt::Event<events_info::ChangePasswordResponce, QEvent::User + 36
 typedef common::qt::Event<events_info::ChangeMaxConnectionRequest, QEvent::User + 37> ChangeMaxConnectionRequestEvent;
 typedef common::qt::Event<events_info::ChangeMaxConnectionResponce, QEvent::User + 38> ChangeMaxConnectionResponceEvent;
 
+typedef common::qt::Event<events_info::LoadDatabaseKeysCountRequest, QEvent::User + 39>
+    LoadDatabaseKeysCountRequestEvent;
+typedef common::qt::Event<events_info::LoadDatabaseKeysCountResponce, QEvent::User + 40>
+    LoadDatabaseKeysCountResponceEvent;
+
+typedef common::qt::Event<events_info::LoadKeysCacheRequest, QEvent::User + 41> LoadKeysCacheRequestEvent;
+typedef common::qt::Event<events_info::LoadKeysCacheResponce, QEvent::User + 42> LoadKeysCacheResponceEvent;
+
+typedef common::qt::Event<events_info::RevalidateKeysRequest, QEvent::User + 43> RevalidateKeysRequestEvent;
+typedef common::qt::Event<events_info::RevalidateKeysResponce, QEvent::User + 44> RevalidateKeysResponceEvent;
+
+typedef common::qt::Event<events_info::UpdateKeysCacheRequest, QEvent::User + 45> UpdateKeysCacheRequestEvent;
+
 typedef common::qt::Event<events_info::ProgressInfoResponce, QEvent::User + 100> ProgressResponceEvent;
 
 }  // namespace events
@@ -47,12 +47,12 @@ ShutDownInfoResponce::ShutDownInfoResponce(const base_class& request) : base_cla
 BackupInfoRequest::BackupInfoRequest(initiator_type sender, const std::string& path, error_type er)
     : base_class(sender, er), path(path) {}
 
-BackupInfoResponce::BackupInfoResponce(const base_class& request) : base_class(request) {}
+BackupInfoResponce::BackupInfoResponce(const base_class& request) : base_class(request), saved_keys(0) {}
 
 ExportInfoRequest::ExportInfoRequest(initiator_type sender, const std::string& path, error_type er)
     : base_class(sender, er), path(path) {}
 
-ExportInfoResponce::ExportInfoResponce(const base_class& request) : base_class(request) {}
+ExportInfoResponce::ExportInfoResponce(const base_class& request) : base_class(request), imported_keys(0) {}
 
 ChangePasswordRequest::ChangePasswordRequest(initiator_type sender,
                                              const std::string& oldPassword,
@@ -107,9 +107,13 @@ ExecuteInfoRequest::ExecuteInfoRequest(initiator_type sender,
       msec_repeat_interval(msec_repeat_interval),
       history(history),
       silence(silence),
-      logtype(logtype) {}
+      logtype(logtype),
+      script_path(),
+      start_line(0),
+      pipeline_window(0),
+      stream_retention(0) {}
 
-ExecuteInfoResponce::ExecuteInfoResponce(const base_class& request) : base_class(request) {}
+ExecuteInfoResponce::ExecuteInfoResponce(const base_class& request) : base_class(request), executed_line(0) {}
 
 LoadDatabasesInfoRequest::LoadDatabasesInfoRequest(initiator_type sender, error_type er) : base_class(sender, er) {}
 
@@ -124,7 +128,35 @@ LoadDatabaseContentRequest::LoadDatabaseContentRequest(initiator_type sender,
     : base_class(sender, er), inf(inf), pattern(pattern), count_keys(countKeys), cursor_in(cursor) {}
 
 LoadDatabaseContentResponce::LoadDatabaseContentResponce(const base_class& request)
-    : base_class(request), keys(), cursor_out(0), db_keys_count(0) {}
+    : base_class(request), keys(), cursor_out(0), db_keys_count(0), db_keys_count_exact(true) {}
+
+LoadDatabaseKeysCountRequest::LoadDatabaseKeysCountRequest(initiator_type sender,
+                                                           core::IDataBaseInfoSPtr inf,
+                                                           error_type er)
+    : base_class(sender, er), inf(inf) {}
+
+LoadDatabaseKeysCountResponce::LoadDatabaseKeysCountResponce(const base_class& request)
+    : base_class(request), db_keys_count(0) {}
+
+LoadKeysCacheRequest::LoadKeysCacheRequest(initiator_type sender, core::IDataBaseInfoSPtr inf, error_type er)
+    : base_class(sender, er), inf(inf) {}
+
+LoadKeysCacheResponce::LoadKeysCacheResponce(const base_class& request) : base_class(request), keys() {}
+
+RevalidateKeysRequest::RevalidateKeysRequest(initiator_type sender,
+                                             core::IDataBaseInfoSPtr inf,
+                                             const keys_container_t& keys,
+                                             error_type er)
+    : base_class(sender, er), inf(inf), keys(keys) {}
+
+RevalidateKeysResponce::RevalidateKeysResponce(const base_class& request) : base_class(request), stale_keys() {}
+
+UpdateKeysCacheRequest::UpdateKeysCacheRequest(initiator_type sender,
+                                               core::IDataBaseInfoSPtr inf,
+                                               UpdateType type,
+                                               const keys_container_t& keys,
+                                               error_type er)
+    : base_class(sender, er), inf(inf), type(type), keys(keys) {}
 
 LoadServerChannelsRequest::LoadServerChannelsRequest(initiator_type sender, const std::string& pattern, error_type er)
     : base_class(sender, er), pattern(pattern) {}
@@ -145,16 +177,21 @@ void ServerInfoResponce::setInfo(core::IServerInfoSPtr inf) {
 
 ServerInfoResponce::~ServerInfoResponce() {}
 
-ServerInfoHistoryRequest::ServerInfoHistoryRequest(initiator_type sender, error_type er) : base_class(sender, er) {}
+ServerInfoHistoryRequest::ServerInfoHistoryRequest(initiator_type sender,
+                                                   common::time64_t from,
+                                                   common::time64_t to,
+                                                   common::time64_t resolution,
+                                                   error_type er)
+    : base_class(sender, er), from_msec(from), to_msec(to), resolution_msec(resolution) {}
 
-ServerInfoHistoryResponce::ServerInfoHistoryResponce(const base_class& request) : base_class(request) {}
+ServerInfoHistoryResponce::ServerInfoHistoryResponce(const base_class& request) : base_class(request), history_() {}
 
-ServerInfoHistoryResponce::infos_container_type ServerInfoHistoryResponce::infos() const {
-  return infos_;
+ServerInfoHistoryResponce::history_type ServerInfoHistoryResponce::history() const {
+  return history_;
 }
 
-void ServerInfoHistoryResponce::setInfos(const infos_container_type& inf) {
-  infos_ = inf;
+void ServerInfoHistoryResponce::setHistory(const history_type& history) {
+  history_ = history;
 }
 
 ClearServerHistoryRequest::ClearServerHistoryRequest(initiator_type sender, error_type er) : base_class(sender, er) {}
@@ -172,7 +209,8 @@ ChangeServerPropertyInfoRequest::ChangeServerPropertyInfoRequest(initiator_type
 
 ChangeServerPropertyInfoResponce::ChangeServerPropertyInfoResponce(const base_class& request) : base_class(request) {}
 
-ProgressInfoResponce::ProgressInfoResponce(int pr) : progress(pr) {}
+ProgressInfoResponce::ProgressInfoResponce(int pr, double rt, common::time64_t eta)
+    : progress(pr), rate(rt), eta_msec(eta) {}
 
 }  // namespace events_info
 }  // namespace proxy
@@ -33,6 +33,7 @@
 #include "core/db_key.h"  // for NDbKValue
 #include "core/db_ps_channel.h"
 #include "core/server/iserver_info.h"   // for IDataBaseInfoSPtr, IServerInf...
+#include "core/server/server_info_history.h"  // for ServerInfoHistory
 #include "core/server_property_info.h"  // for property_t, ServerPropertiesInfo
 
 #include "core/global.h"  // for FastoObjectIPtr
@@ -81,6 +82,8 @@ struct BackupInfoRequest : public EventInfoBase {
 struct BackupInfoResponce : BackupInfoRequest {
   typedef BackupInfoRequest base_class;
   explicit BackupInfoResponce(const base_class& request);
+
+  size_t saved_keys;
 };
 
 struct ExportInfoRequest : public EventInfoBase {
@@ -92,6 +95,8 @@ struct ExportInfoRequest : public EventInfoBase {
 struct ExportInfoResponce : ExportInfoRequest {
   typedef ExportInfoRequest base_class;
   explicit ExportInfoResponce(const base_class& request);
+
+  size_t imported_keys;
 };
 
 struct ChangePasswordRequest : public EventInfoBase {
@@ -190,11 +195,22 @@ struct ExecuteInfoRequest : public EventInfoBase {
   const bool history;
   const bool silence;
   const core::CmdLoggingType logtype;
+
+  // if set, commands are streamed from this file line by line starting from
+  // start_line (from 1), text is only the title of the output
+  std::string script_path;
+  size_t start_line;
+  // up to pipeline_window commands are sent before their replies are read, 0 - one by one
+  size_t pipeline_window;
+  // replies of a streaming command (MONITOR, SUBSCRIBE) buffered until the output drains them, at least one
+  size_t stream_retention;
 };
 
 struct ExecuteInfoResponce : ExecuteInfoRequest {
   typedef ExecuteInfoRequest base_class;
   explicit ExecuteInfoResponce(const base_class& request);
+
+  size_t executed_line;  // last executed line of the script, resume from the next one
 };
 
 struct LoadDatabasesInfoRequest : public EventInfoBase {
@@ -233,6 +249,73 @@ struct LoadDatabaseContentResponce : LoadDatabaseContentRequest {
   keys_container_t keys;
   uint64_t cursor_out;
   size_t db_keys_count;
+  bool db_keys_count_exact;
+};
+
+struct LoadDatabaseKeysCountRequest : public EventInfoBase {
+  typedef EventInfoBase base_class;
+  LoadDatabaseKeysCountRequest(initiator_type sender, core::IDataBaseInfoSPtr inf, error_type er = error_type());
+
+  core::IDataBaseInfoSPtr inf;
+};
+
+struct LoadDatabaseKeysCountResponce : LoadDatabaseKeysCountRequest {
+  typedef LoadDatabaseKeysCountRequest base_class;
+  explicit LoadDatabaseKeysCountResponce(const base_class& request);
+
+  size_t db_keys_count;
+};
+
+// keys of the database saved by the previous session, ttls counted down
+struct LoadKeysCacheRequest : public EventInfoBase {
+  typedef EventInfoBase base_class;
+  LoadKeysCacheRequest(initiator_type sender, core::IDataBaseInfoSPtr inf, error_type er = error_type());
+
+  core::IDataBaseInfoSPtr inf;
+};
+
+struct LoadKeysCacheResponce : LoadKeysCacheRequest {
+  typedef LoadKeysCacheRequest base_class;
+  typedef std::vector<core::NDbKValue> keys_container_t;
+  explicit LoadKeysCacheResponce(const base_class& request);
+
+  keys_container_t keys;
+};
+
+// checks cached keys against the server, alive ones come back with fresh type and ttl
+struct RevalidateKeysRequest : public EventInfoBase {
+  typedef EventInfoBase base_class;
+  typedef std::vector<core::NDbKValue> keys_container_t;
+  RevalidateKeysRequest(initiator_type sender,
+                        core::IDataBaseInfoSPtr inf,
+                        const keys_container_t& keys,
+                        error_type er = error_type());
+
+  core::IDataBaseInfoSPtr inf;
+  keys_container_t keys;
+};
+
+struct RevalidateKeysResponce : RevalidateKeysRequest {
+  typedef RevalidateKeysRequest base_class;
+  explicit RevalidateKeysResponce(const base_class& request);
+
+  keys_container_t stale_keys;
+};
+
+// key changes made through another lane, written to the keys cache by the background lane, no reply
+struct UpdateKeysCacheRequest : public EventInfoBase {
+  typedef EventInfoBase base_class;
+  typedef std::vector<core::NDbKValue> keys_container_t;
+  enum UpdateType { PUT_KEYS, REMOVE_KEYS, RESET_KEYS };
+  UpdateKeysCacheRequest(initiator_type sender,
+                         core::IDataBaseInfoSPtr inf,
+                         UpdateType type,
+                         const keys_container_t& keys = keys_container_t(),
+                         error_type er = error_type());
+
+  core::IDataBaseInfoSPtr inf;
+  UpdateType type;
+  keys_container_t keys;
 };
 
 struct LoadServerChannelsRequest : public EventInfoBase {
@@ -270,20 +353,28 @@ class ServerInfoResponce : public ServerInfoRequest {
 
 struct ServerInfoHistoryRequest : public EventInfoBase {
   typedef EventInfoBase base_class;
-  explicit ServerInfoHistoryRequest(initiator_type sender, error_type er = error_type());
+  explicit ServerInfoHistoryRequest(initiator_type sender,
+                                    common::time64_t from = 0,
+                                    common::time64_t to = 0,
+                                    common::time64_t resolution = 0,
+                                    error_type er = error_type());
+
+  const common::time64_t from_msec;        // 0 from the first snapshot
+  const common::time64_t to_msec;          // 0 up to the last snapshot
+  const common::time64_t resolution_msec;  // 0 without downsampling
 };
 
 class ServerInfoHistoryResponce : public ServerInfoHistoryRequest {
  public:
   typedef ServerInfoHistoryRequest base_class;
-  typedef std::vector<core::ServerInfoSnapShoot> infos_container_type;
+  typedef core::ServerInfoHistory history_type;
   explicit ServerInfoHistoryResponce(const base_class& request);
 
-  infos_container_type infos() const;
-  void setInfos(const infos_container_type& inf);
+  history_type history() const;
+  void setHistory(const history_type& history);
 
  private:
-  infos_container_type infos_;
+  history_type history_;
 };
 
 struct ClearServerHistoryRequest : public EventInfoBase {
@@ -323,9 +414,11 @@ struct ChangeServerPropertyInfoResponce : ChangeServerPropertyInfoRequest {
 };
 
 struct ProgressInfoResponce {
-  explicit ProgressInfoResponce(int pr);
+  explicit ProgressInfoResponce(int pr, double rt = 0, common::time64_t eta = 0);
 
   const int progress;
+  const double rate;                // items per second of long running operations, 0 if not measured
+  const common::time64_t eta_msec;  // remaining time, 0 if unknown
 };
 
 }  // namespace events_info
@@ -39,6 +39,7 @@ namespace proxy {
 IServer::IServer(IDriver* drv) : drv_(drv), server_info_(), current_database_info_(), timer_check_key_exists_id_(0) {
   VERIFY(QObject::connect(drv_, &IDriver::ChildAdded, this, &IServer::ChildAdded));
   VERIFY(QObject::connect(drv_, &IDriver::ItemUpdated, this, &IServer::ItemUpdated));
+  VERIFY(QObject::connect(drv_, &IDriver::StreamStarted, this, &IServer::StreamStarted));
   VERIFY(QObject::connect(drv_, &IDriver::ServerInfoSnapShoot, this, &IServer::ServerInfoSnapShoot));
 
   VERIFY(QObject::connect(drv_, &IDriver::FlushedDB, this, &IServer::FlushDB));
@@ -52,10 +53,19 @@ IServer::IServer(IDriver* drv) : drv_(drv), server_info_(), current_database_inf
   VERIFY(QObject::connect(drv_, &IDriver::Disconnected, this, &IServer::Disconnected));
 
   drv_->Start();
+  for (size_t i = 0; i < LANES_COUNT; ++i) {
+    lanes_[i] = drv_;
+  }
 }
 
 IServer::~IServer() {
   StopCurrentEvent();
+  for (size_t i = 0; i < LANES_COUNT; ++i) {
+    if (lanes_[i] != drv_) {
+      lanes_[i]->Stop();
+      delete lanes_[i];
+    }
+  }
   drv_->Stop();
   delete drv_;
 }
@@ -73,7 +83,9 @@ void IServer::StopCheckKeyExistTimer() {
 }
 
 void IServer::StopCurrentEvent() {
-  drv_->Interrupt();
+  for (size_t i = 0; i < LANES_COUNT; ++i) {
+    lanes_[i]->Interrupt();
+  }
 }
 
 bool IServer::IsConnected() const {
@@ -157,6 +169,11 @@ void IServer::Disconnect(const events_info::DisConnectInfoRequest& req) {
   emit DisconnectStarted(req);
   QEvent* ev = new events::DisconnectRequestEvent(this, req);
   Notify(ev);
+  for (size_t i = 0; i < LANES_COUNT; ++i) {
+    if (lanes_[i] != drv_) {  // lane replies to itself, server waits only main connection
+      qApp->postEvent(lanes_[i], new events::DisconnectRequestEvent(lanes_[i], req));
+    }
+  }
 }
 
 void IServer::LoadDatabases(const events_info::LoadDatabasesInfoRequest& req) {
@@ -168,7 +185,25 @@ void IServer::LoadDatabases(const events_info::LoadDatabasesInfoRequest& req) {
 void IServer::LoadDatabaseContent(const events_info::LoadDatabaseContentRequest& req) {
   emit LoadDataBaseContentStarted(req);
   QEvent* ev = new events::LoadDatabaseContentRequestEvent(this, req);
-  Notify(ev);
+  Notify(ev, BACKGROUND_LANE);
+}
+
+void IServer::LoadDatabaseKeysCount(const events_info::LoadDatabaseKeysCountRequest& req) {
+  emit LoadDatabaseKeysCountStarted(req);
+  QEvent* ev = new events::LoadDatabaseKeysCountRequestEvent(this, req);
+  Notify(ev, BACKGROUND_LANE);
+}
+
+void IServer::LoadKeysCache(const events_info::LoadKeysCacheRequest& req) {
+  emit LoadKeysCacheStarted(req);
+  QEvent* ev = new events::LoadKeysCacheRequestEvent(this, req);
+  Notify(ev, BACKGROUND_LANE);
+}
+
+void IServer::RevalidateKeys(const events_info::RevalidateKeysRequest& req) {
+  emit RevalidateKeysStarted(req);
+  QEvent* ev = new events::RevalidateKeysRequestEvent(this, req);
+  Notify(ev, BACKGROUND_LANE);
 }
 
 void IServer::Execute(const events_info::ExecuteInfoRequest& req) {
@@ -210,7 +245,7 @@ void IServer::SetMaxConnection(const events_info::ChangeMaxConnectionRequest& re
 void IServer::LoadServerInfo(const events_info::ServerInfoRequest& req) {
   emit LoadServerInfoStarted(req);
   QEvent* ev = new events::ServerInfoRequestEvent(this, req);
-  Notify(ev);
+  Notify(ev, MONITORING_LANE);
 }
 
 void IServer::ServerProperty(const events_info::ServerPropertyInfoRequest& req) {
@@ -222,13 +257,13 @@ void IServer::ServerProperty(const events_info::ServerPropertyInfoRequest& req)
 void IServer::RequestHistoryInfo(const events_info::ServerInfoHistoryRequest& req) {
   emit LoadServerHistoryInfoStarted(req);
   QEvent* ev = new events::ServerInfoHistoryRequestEvent(this, req);
-  Notify(ev);
+  Notify(ev, MONITORING_LANE);
 }
 
 void IServer::ClearHistory(const events_info::ClearServerHistoryRequest& req) {
   emit ClearServerHistoryStarted(req);
   QEvent* ev = new events::ClearServerHistoryRequestEvent(this, req);
-  Notify(ev);
+  Notify(ev, MONITORING_LANE);
 }
 
 void IServer::ChangeProperty(const events_info::ChangeServerPropertyInfoRequest& req) {
@@ -252,6 +287,13 @@ void IServer::customEvent(QEvent* event) {
     events::ConnectResponceEvent::value_type v = ev->value();
     common::Error er(v.errorInfo());
     if (!er) {
+      // lanes connect only after the main connection, a lane replies to itself
+      for (size_t i = 0; i < LANES_COUNT; ++i) {
+        if (lanes_[i] != drv_) {
+          qApp->postEvent(lanes_[i], new events::ConnectRequestEvent(lanes_[i], v));
+        }
+      }
+
       events_info::DiscoveryInfoRequest dreq(this);
       ProcessDiscoveryInfo(dreq);
     }
@@ -309,6 +351,15 @@ void IServer::customEvent(QEvent* event) {
   } else if (type == static_cast<QEvent::Type>(events::LoadDatabaseContentResponceEvent::EventType)) {
     events::LoadDatabaseContentResponceEvent* ev = static_cast<events::LoadDatabaseContentResponceEvent*>(event);
     HandleLoadDatabaseContentEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::LoadDatabaseKeysCountResponceEvent::EventType)) {
+    events::LoadDatabaseKeysCountResponceEvent* ev = static_cast<events::LoadDatabaseKeysCountResponceEvent*>(event);
+    HandleLoadDatabaseKeysCountEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::LoadKeysCacheResponceEvent::EventType)) {
+    events::LoadKeysCacheResponceEvent* ev = static_cast<events::LoadKeysCacheResponceEvent*>(event);
+    HandleLoadKeysCacheEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::RevalidateKeysResponceEvent::EventType)) {
+    events::RevalidateKeysResponceEvent* ev = static_cast<events::RevalidateKeysResponceEvent*>(event);
+    HandleRevalidateKeysEvent(ev);
   } else if (type == static_cast<QEvent::Type>(events::ExecuteResponceEvent::EventType)) {
     events::ExecuteResponceEvent* ev = static_cast<events::ExecuteResponceEvent*>(event);
     HandleExecuteEvent(ev);
@@ -332,10 +383,36 @@ void IServer::timerEvent(QTimerEvent* event) {
   QObject::timerEvent(event);
 }
 
-void IServer::Notify(QEvent* ev) {
+void IServer::UpdateKeysCache(database_t db,
+                              events_info::UpdateKeysCacheRequest::UpdateType type,
+                              const events_info::UpdateKeysCacheRequest::keys_container_t& keys) {
+  IDriver* background = lanes_[BACKGROUND_LANE];
+  if (background == drv_) {
+    return;
+  }
+
+  events_info::UpdateKeysCacheRequest req(this, db, type, keys);
+  qApp->postEvent(background, new events::UpdateKeysCacheRequestEvent(this, req));
+}
+
+void IServer::SetLaneDriver(DriverLane lane, IDriver* drv) {
+  CHECK(lane != INTERACTIVE_LANE && lanes_[lane] == drv_);
+  VERIFY(QObject::connect(drv, &IDriver::ServerInfoSnapShoot, this, &IServer::ServerInfoSnapShoot));
+  VERIFY(QObject::connect(drv, &IDriver::KeyLoaded, this, &IServer::KeyLoad));
+  VERIFY(QObject::connect(drv, &IDriver::KeyTTLLoaded, this, &IServer::KeyTTLLoad));
+  for (size_t i = 0; i < LANES_COUNT; ++i) {
+    DriverLane cur = static_cast<DriverLane>(i);
+    drv->SetServingLane(cur, cur == lane);
+  }
+  drv_->SetServingLane(lane, false);
+  lanes_[lane] = drv;
+  drv->Start();
+}
+
+void IServer::Notify(QEvent* ev, DriverLane lane) {
   events_info::ProgressInfoResponce resp(0);
   emit ProgressChanged(resp);
-  qApp->postEvent(drv_, ev);
+  qApp->postEvent(lanes_[lane], ev);
 }
 
 void IServer::HandleConnectEvent(events::ConnectResponceEvent* ev) {
@@ -482,6 +559,7 @@ void IServer::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentResponce
     if (dbs) {
       dbs->SetKeys(v.keys);
       dbs->SetDBKeysCount(v.db_keys_count);
+      dbs->SetDBKeysCountExact(v.db_keys_count_exact);
       v.inf = dbs;
     }
   }
@@ -489,12 +567,61 @@ void IServer::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentResponce
   emit LoadDatabaseContentFinished(v);
 }
 
+void IServer::HandleLoadDatabaseKeysCountEvent(events::LoadDatabaseKeysCountResponceEvent* ev) {
+  auto v = ev->value();
+  common::Error er(v.errorInfo());
+  if (er && er->IsError()) {
+    LOG_ERROR(er, true);
+  } else {
+    database_t dbs = FindDatabase(v.inf);
+    if (dbs) {
+      dbs->SetDBKeysCount(v.db_keys_count);
+      dbs->SetDBKeysCountExact(true);
+      v.inf = dbs;
+    }
+  }
+
+  emit LoadDatabaseKeysCountFinished(v);
+}
+
+void IServer::HandleLoadKeysCacheEvent(events::LoadKeysCacheResponceEvent* ev) {
+  auto v = ev->value();
+  common::Error er(v.errorInfo());
+  if (er && er->IsError()) {
+    LOG_ERROR(er, true);
+  } else {
+    database_t dbs = FindDatabase(v.inf);
+    if (dbs) {
+      v.inf = dbs;
+    }
+  }
+
+  emit LoadKeysCacheFinished(v);
+}
+
+void IServer::HandleRevalidateKeysEvent(events::RevalidateKeysResponceEvent* ev) {
+  auto v = ev->value();
+  common::Error er(v.errorInfo());
+  if (er && er->IsError()) {
+    LOG_ERROR(er, true);
+  } else {
+    database_t dbs = FindDatabase(v.inf);
+    if (dbs) {
+      v.inf = dbs;
+    }
+  }
+
+  emit RevalidateKeysFinished(v);
+}
+
 void IServer::FlushDB() {
   database_t cdb = CurrentDatabaseInfo();
   if (!cdb) {
     return;
   }
 
+  UpdateKeysCache(cdb, events_info::UpdateKeysCacheRequest::RESET_KEYS);
+
   cdb->ClearKeys();
   cdb->SetDBKeysCount(0);
   emit FlushedDB(cdb);
@@ -536,6 +663,9 @@ void IServer::KeyRemove(core::NKey key) {
     return;
   }
 
+  UpdateKeysCache(cdb, events_info::UpdateKeysCacheRequest::REMOVE_KEYS,
+                  events_info::UpdateKeysCacheRequest::keys_container_t(1, core::NDbKValue(key, core::NValue())));
+
   if (cdb->RemoveKey(key)) {
     emit KeyRemoved(cdb, key);
   }
@@ -547,6 +677,9 @@ void IServer::KeyAdd(core::NDbKValue key) {
     return;
   }
 
+  UpdateKeysCache(cdb, events_info::UpdateKeysCacheRequest::PUT_KEYS,
+                  events_info::UpdateKeysCacheRequest::keys_container_t(1, key));
+
   if (cdb->InsertKey(key)) {
     emit KeyAdded(cdb, key);
   } else {
@@ -573,6 +706,10 @@ void IServer::KeyRename(core::NKey key, core::string_key_t new_name) {
     return;
   }
 
+  // the new name is picked up by the next load
+  UpdateKeysCache(cdb, events_info::UpdateKeysCacheRequest::REMOVE_KEYS,
+                  events_info::UpdateKeysCacheRequest::keys_container_t(1, core::NDbKValue(key, core::NValue())));
+
   if (cdb->RenameKey(key, core::key_t(new_name))) {
     emit KeyRenamed(cdb, key, new_name);
   }
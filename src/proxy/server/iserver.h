@@ -31,17 +31,13 @@
 
 #include "core/database/idatabase_info.h"  // for IDataBaseInfoSPtr
 #include "core/server/iserver_info.h"      // for IServerInfoSPtr, etc
+#include "proxy/driver/idriver.h"          // for DriverLane
+#include "proxy/driver/stream_buffer.h"    // for StreamBufferSPtr
 #include "proxy/events/events.h"           // for BackupResponceEvent, etc
 #include "proxy/server/iserver_base.h"     // for IServerBase
 
 #include "core/global.h"  // for FastoObject (ptr only), etc
 
-namespace fastonosql {
-namespace proxy {
-class IDriver;
-}
-}  // namespace fastonosql
-
 namespace fastonosql {
 namespace proxy {
 
@@ -128,12 +124,22 @@ class IServer : public IServerBase, public std::enable_shared_from_this<IServer>
   void LoadDataBaseContentStarted(const events_info::LoadDatabaseContentRequest& req);
   void LoadDatabaseContentFinished(const events_info::LoadDatabaseContentResponce& res);
 
+  void LoadDatabaseKeysCountStarted(const events_info::LoadDatabaseKeysCountRequest& req);
+  void LoadDatabaseKeysCountFinished(const events_info::LoadDatabaseKeysCountResponce& res);
+
+  void LoadKeysCacheStarted(const events_info::LoadKeysCacheRequest& req);
+  void LoadKeysCacheFinished(const events_info::LoadKeysCacheResponce& res);
+
+  void RevalidateKeysStarted(const events_info::RevalidateKeysRequest& req);
+  void RevalidateKeysFinished(const events_info::RevalidateKeysResponce& res);
+
   void LoadDiscoveryInfoStarted(const events_info::DiscoveryInfoRequest& res);
   void LoadDiscoveryInfoFinished(const events_info::DiscoveryInfoResponce& res);
 
  Q_SIGNALS:
   void ChildAdded(core::FastoObjectIPtr child);
   void ItemUpdated(core::FastoObject* item, common::ValueSPtr val);
+  void StreamStarted(proxy::StreamBufferSPtr stream);
   void ServerInfoSnapShoot(core::ServerInfoSnapShoot shot);
 
   void FlushedDB(core::IDataBaseInfoSPtr db);
@@ -154,6 +160,13 @@ class IServer : public IServerBase, public std::enable_shared_from_this<IServer>
                                                                          // LoadDatabasesFinished
   void LoadDatabaseContent(const events_info::LoadDatabaseContentRequest& req);  // signals: LoadDataBaseContentStarted,
                                                                                  // LoadDatabaseContentFinished
+  void LoadDatabaseKeysCount(const events_info::LoadDatabaseKeysCountRequest& req);  // signals:
+                                                                                     // LoadDatabaseKeysCountStarted,
+                                                                                     // LoadDatabaseKeysCountFinished
+  void LoadKeysCache(const events_info::LoadKeysCacheRequest& req);    // signals: LoadKeysCacheStarted,
+                                                                       // LoadKeysCacheFinished
+  void RevalidateKeys(const events_info::RevalidateKeysRequest& req);  // signals: RevalidateKeysStarted,
+                                                                       // RevalidateKeysFinished
   void Execute(const events_info::ExecuteInfoRequest& req);                      // signals: ExecuteStarted
 
   void ShutDown(const events_info::ShutDownInfoRequest& req);                 // signals: ShutdownStarted,
@@ -182,6 +195,7 @@ class IServer : public IServerBase, public std::enable_shared_from_this<IServer>
 
  protected:
   explicit IServer(IDriver* drv);  // take ownerships
+  void SetLaneDriver(DriverLane lane, IDriver* drv);  // take ownerships, own connection for lane requests
 
   void StartCheckKeyExistTimer();
   void StopCheckKeyExistTimer();
@@ -190,7 +204,7 @@ class IServer : public IServerBase, public std::enable_shared_from_this<IServer>
   virtual void timerEvent(QTimerEvent* event) override;
 
   virtual IDatabaseSPtr CreateDatabase(core::IDataBaseInfoSPtr info) = 0;
-  void Notify(QEvent* ev);
+  void Notify(QEvent* ev, DriverLane lane = INTERACTIVE_LANE);
 
   // handle server events
   virtual void HandleConnectEvent(events::ConnectResponceEvent* ev);
@@ -209,11 +223,15 @@ class IServer : public IServerBase, public std::enable_shared_from_this<IServer>
   // handle database events
   virtual void HandleLoadDatabaseInfosEvent(events::LoadDatabasesInfoResponceEvent* ev);
   virtual void HandleLoadDatabaseContentEvent(events::LoadDatabaseContentResponceEvent* ev);
+  virtual void HandleLoadDatabaseKeysCountEvent(events::LoadDatabaseKeysCountResponceEvent* ev);
+  virtual void HandleLoadKeysCacheEvent(events::LoadKeysCacheResponceEvent* ev);
+  virtual void HandleRevalidateKeysEvent(events::RevalidateKeysResponceEvent* ev);
 
   // handle command events
   virtual void HandleDiscoveryInfoResponceEvent(events::DiscoveryInfoResponceEvent* ev);
 
   IDriver* const drv_;
+  IDriver* lanes_[LANES_COUNT];  // drv_ if lane hasn't own driver
   databases_t databases_;
 
  private Q_SLOTS:
@@ -229,6 +247,12 @@ class IServer : public IServerBase, public std::enable_shared_from_this<IServer>
 
  private:
   void HandleCheckDBKeys(core::IDataBaseInfoSPtr db, core::ttl_t expired_time);
+  // interactive key changes for the keys cache of a separate background lane driver,
+  // a shared driver updates its cache in its own hooks
+  void UpdateKeysCache(database_t db,
+                       events_info::UpdateKeysCacheRequest::UpdateType type,
+                       const events_info::UpdateKeysCacheRequest::keys_container_t& keys =
+                           events_info::UpdateKeysCacheRequest::keys_container_t());
 
   void HandleEnterModeEvent(events::EnterModeEvent* ev);
   void HandleLeaveModeEvent(events::LeaveModeEvent* ev);
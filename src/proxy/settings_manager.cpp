@@ -55,6 +55,9 @@
 #define AUTOOPENCONSOLE PREFIX "auto_open_console"
 #define AUTOCONNECTDB "auto_connect_db"
 #define FASTVIEWKEYS PREFIX "fast_view_keys"
+#define LAZYEXPLORER PREFIX "lazy_explorer"
+#define STREAMINGRETENTION PREFIX "streaming_retention"
+#define CONNECTIONLANES PREFIX "connection_lanes"
 #define CONFIG_VERSION PREFIX "version"
 
 namespace {
@@ -92,7 +95,10 @@ SettingsManager::SettingsManager()
       auto_check_update_(),
       auto_completion_(),
       auto_open_console_(),
-      fast_view_keys_() {
+      fast_view_keys_(),
+      lazy_explorer_(),
+      streaming_retention_(),
+      connection_lanes_() {
   Load();
 }
 
@@ -294,6 +300,30 @@ void SettingsManager::SetFastViewKeys(bool fast_view) {
   fast_view_keys_ = fast_view;
 }
 
+bool SettingsManager::LazyExplorer() const {
+  return lazy_explorer_;
+}
+
+void SettingsManager::SetLazyExplorer(bool lazy) {
+  lazy_explorer_ = lazy;
+}
+
+int SettingsManager::StreamingRetention() const {
+  return streaming_retention_;
+}
+
+void SettingsManager::SetStreamingRetention(int replies) {
+  streaming_retention_ = replies;
+}
+
+bool SettingsManager::ConnectionLanes() const {
+  return connection_lanes_;
+}
+
+void SettingsManager::SetConnectionLanes(bool lanes) {
+  connection_lanes_ = lanes;
+}
+
 void SettingsManager::ReloadFromPath(const std::string& path, bool merge) {
   if (path.empty()) {
     return;
@@ -375,6 +405,9 @@ void SettingsManager::ReloadFromPath(const std::string& path, bool merge) {
   auto_open_console_ = settings.value(AUTOOPENCONSOLE, true).toBool();
   auto_connect_db_ = settings.value(AUTOCONNECTDB, true).toBool();
   fast_view_keys_ = settings.value(FASTVIEWKEYS, true).toBool();
+  lazy_explorer_ = settings.value(LAZYEXPLORER, false).toBool();
+  streaming_retention_ = settings.value(STREAMINGRETENTION, 10000).toInt();
+  connection_lanes_ = settings.value(CONNECTIONLANES, false).toBool();
   config_version_ = settings.value(CONFIG_VERSION, PROJECT_VERSION_NUMBER).toUInt();
   Save();
 }
@@ -449,6 +482,9 @@ void SettingsManager::Save() {
   settings.setValue(AUTOOPENCONSOLE, auto_open_console_);
   settings.setValue(AUTOCONNECTDB, auto_connect_db_);
   settings.setValue(FASTVIEWKEYS, fast_view_keys_);
+  settings.setValue(LAZYEXPLORER, lazy_explorer_);
+  settings.setValue(STREAMINGRETENTION, streaming_retention_);
+  settings.setValue(CONNECTIONLANES, connection_lanes_);
   settings.setValue(CONFIG_VERSION, config_version_);
 }
 
@@ -106,6 +106,15 @@ class SettingsManager : public common::patterns::LazySingleton<SettingsManager>
   bool FastViewKeys() const;
   void SetFastViewKeys(bool fast_view);
 
+  bool LazyExplorer() const;
+  void SetLazyExplorer(bool lazy);
+
+  int StreamingRetention() const;
+  void SetStreamingRetention(int replies);
+
+  bool ConnectionLanes() const;
+  void SetConnectionLanes(bool lanes);
+
   void ReloadFromPath(const std::string& path, bool merge);
 
  private:
@@ -131,6 +140,9 @@ class SettingsManager : public common::patterns::LazySingleton<SettingsManager>
   bool auto_open_console_;
   bool auto_connect_db_;
   bool fast_view_keys_;
+  bool lazy_explorer_;
+  int streaming_retention_;
+  bool connection_lanes_;
 };
 
 }  // namespace proxy
@@ -88,6 +88,8 @@ public:
     virtual Status auth(const std::string &password) = 0;
     virtual Status expire(const std::string& key, int ttl) = 0;
     virtual Status ttl(const std::string& key, int* ttl) = 0;
+    // sends all requests before reading the first response, responses are in order of requests
+    virtual Status pipeline(const std::vector<std::vector<std::string> > &reqs, std::vector<std::vector<std::string> > *resps) = 0;
 #endif
 	virtual Status dbsize(int64_t *ret) = 0;
 	virtual Status get_kv_range(std::string *start, std::string *end) = 0;
@@ -171,6 +171,32 @@ const std::vector<std::string>* ClientImpl::request(const std::string &cmd, cons
 /******************** misc *************************/
 
 #ifdef FASTO
+Status ClientImpl::pipeline(const std::vector<std::vector<std::string> > &reqs, std::vector<std::vector<std::string> > *resps)
+{
+    for(size_t i = 0; i < reqs.size(); i++){
+        if(link->send(reqs[i]) == -1){
+            return Status("error");
+        }
+    }
+    if(link->flush() == -1){
+        return Status("error");
+    }
+
+    resps->clear();
+    for(size_t i = 0; i < reqs.size(); i++){
+        const std::vector<Bytes> *packet = link->response();
+        if(packet == NULL){
+            return Status("error");
+        }
+        std::vector<std::string> resp;
+        for(std::vector<Bytes>::const_iterator it = packet->begin(); it != packet->end(); it++){
+            resp.push_back(it->String());
+        }
+        resps->push_back(resp);
+    }
+    return Status("ok");
+}
+
 Status ClientImpl::auth(const std::string &password)
 {
     const std::vector<std::string> *resp;
@@ -30,6 +30,7 @@ public:
     virtual Status auth(const std::string &password);
     virtual Status expire(const std::string& key, int ttl);
     virtual Status ttl(const std::string& key, int* ttl);
+    virtual Status pipeline(const std::vector<std::vector<std::string> > &reqs, std::vector<std::vector<std::string> > *resps);
 #endif
 	virtual Status dbsize(int64_t *ret);
 	virtual Status get_kv_range(std::string *start, std::string *end);
@@ -26,6 +26,9 @@ namespace translations {
 const QString trfilterForScripts = QObject::tr("Text Files (*.txt);; All Files (*.*)");
 const QString trfilterForAll = QObject::tr("All Files (*.*)");
 const QString trfilterForRdb = QObject::tr("Redis database files (*.rdb)");
+const QString trfilterForDump = QObject::tr(
+    "Key/value dumps (*.resp *.aof *.jsonl *.json *.csv);; Backups (*.fnbackup);; Text Files (*.txt);; All Files (*.*)");
+const QString trfilterForBackup = QObject::tr("Backups (*.fnbackup)");
 
 const QString trBasic = QObject::tr("Basic");
 const QString trAdvanced = QObject::tr("Advanced");
@@ -52,6 +55,8 @@ const QString trInfo = QObject::tr("Info");
 const QString trTools = QObject::tr("Tools");
 const QString trLoadFromFile = QObject::tr("Load from file...");
 const QString trImport = QObject::tr("Import");
+const QString trImportData = QObject::tr("Import data...");
+const QString trBackupData = QObject::tr("Backup data...");
 const QString trExport = QObject::tr("Export...");
 const QString trImportSettings = QObject::tr("Import settings");
 const QString trExportSettings = QObject::tr("Export settings");
@@ -26,6 +26,8 @@ namespace translations {
 extern const QString trfilterForScripts;
 extern const QString trfilterForAll;
 extern const QString trfilterForRdb;
+extern const QString trfilterForDump;
+extern const QString trfilterForBackup;
 
 extern const QString trBasic;
 extern const QString trAdvanced;
@@ -51,6 +53,8 @@ extern const QString trFile;
 extern const QString trInfo;
 extern const QString trTools;
 extern const QString trImport;
+extern const QString trImportData;
+extern const QString trBackupData;
 extern const QString trExport;
 extern const QString trImportSettings;
 extern const QString trExportSettings;
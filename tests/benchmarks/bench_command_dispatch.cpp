@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <common/macros.h>
+
+#include "core/command_holder.h"
+#include "core/internal/command_handler.h"
+
+#include "bench_report.h"
+#include "fake_translator.h"
+
+using namespace fastonosql;
+using fastonosql::tests::FakeTranslator;
+
+namespace {
+core::internal::CommandHandler* ghand = NULL;
+
+common::Error test(core::internal::CommandHandler* handler, core::commands_args_t argv, core::FastoObject* out) {
+  UNUSED(argv);
+
+  CHECK(handler == ghand);
+  CHECK(out == NULL);
+
+  return common::Error();
+}
+
+const size_t dispatch_repeat = 100;
+}  // namespace
+
+TEST(CommandHandler, dispatch_speed) {
+  // table shaped like redis one: many single word commands plus multi word groups
+  std::vector<core::CommandHolder> bench_cmds;
+  for (size_t i = 0; i < 150; ++i) {
+    std::string name = "CMD" + std::to_string(i);
+    bench_cmds.push_back(
+        core::CommandHolder(name, "<key>", "Bench command.", UNDEFINED_SINCE, UNDEFINED_EXAMPLE_STR, 1, 0, &test));
+  }
+  for (size_t i = 0; i < 30; ++i) {
+    std::string name = "GROUP SUB" + std::to_string(i);
+    bench_cmds.push_back(
+        core::CommandHolder(name, "<key>", "Bench command.", UNDEFINED_SINCE, UNDEFINED_EXAMPLE_STR, 1, 0, &test));
+  }
+
+  FakeTranslator* ft = new FakeTranslator(bench_cmds);
+  core::internal::CommandHandler* hand = new core::internal::CommandHandler(ft);
+  ghand = hand;
+
+  std::vector<core::command_buffer_t> script;
+  for (size_t i = 0; i < 1000; ++i) {
+    if (i % 3 == 0) {
+      script.push_back("group sub" + std::to_string(i % 30) + " key:" + std::to_string(i));
+    } else {
+      script.push_back("cmd" + std::to_string(i % 150) + " key:" + std::to_string(i));
+    }
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t r = 0; r < dispatch_repeat; ++r) {
+    for (const core::command_buffer_t& line : script) {
+      common::Error err = hand->Execute(line, NULL);
+      ASSERT_FALSE(err && err->IsError());
+    }
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  common::Error err = hand->Execute("GROUP SUB999 key", NULL);
+  ASSERT_TRUE(err && err->IsError());
+  delete hand;
+
+  const double nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  tests::ReportBenchmark("commands_table_size", bench_cmds.size());
+  tests::ReportBenchmark("nsec_per_command_line", nsec / (script.size() * dispatch_repeat));
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "core/db/redis/server_info.h"
+
+#include "bench_report.h"
+
+using namespace fastonosql::core;
+
+namespace {
+// INFO reply of a redis 3.2 master
+const char redis_info_reply[] =
+    "# Server\r\n"
+    "redis_version:3.2.8\r\n"
+    "redis_git_sha1:00000000\r\n"
+    "redis_git_dirty:0\r\n"
+    "redis_build_id:d0c5b2b6f9d3e5a8\r\n"
+    "redis_mode:standalone\r\n"
+    "os:Linux 4.9.0-3-amd64 x86_64\r\n"
+    "arch_bits:64\r\n"
+    "multiplexing_api:epoll\r\n"
+    "gcc_version:6.3.0\r\n"
+    "process_id:1042\r\n"
+    "run_id:6f5d35c7a1b54b6cc2cf4ba4e2e5ff0be5d2e0a1\r\n"
+    "tcp_port:6379\r\n"
+    "uptime_in_seconds:1728431\r\n"
+    "uptime_in_days:20\r\n"
+    "hz:10\r\n"
+    "lru_clock:4731552\r\n"
+    "executable:/usr/bin/redis-server\r\n"
+    "config_file:/etc/redis/redis.conf\r\n"
+    "\r\n"
+    "# Clients\r\n"
+    "connected_clients:87\r\n"
+    "client_longest_output_list:0\r\n"
+    "client_biggest_input_buf:0\r\n"
+    "blocked_clients:3\r\n"
+    "\r\n"
+    "# Memory\r\n"
+    "used_memory:1073283736\r\n"
+    "used_memory_human:1023.56M\r\n"
+    "used_memory_rss:1139736576\r\n"
+    "used_memory_rss_human:1.06G\r\n"
+    "used_memory_peak:1181523352\r\n"
+    "used_memory_peak_human:1.10G\r\n"
+    "total_system_memory:16826155008\r\n"
+    "total_system_memory_human:15.67G\r\n"
+    "used_memory_lua:37888\r\n"
+    "used_memory_lua_human:37.00K\r\n"
+    "maxmemory:0\r\n"
+    "maxmemory_human:0B\r\n"
+    "maxmemory_policy:noeviction\r\n"
+    "mem_fragmentation_ratio:1.06\r\n"
+    "mem_allocator:jemalloc-4.0.3\r\n"
+    "\r\n"
+    "# Persistence\r\n"
+    "loading:0\r\n"
+    "rdb_changes_since_last_save:48211\r\n"
+    "rdb_bgsave_in_progress:0\r\n"
+    "rdb_last_save_time:1497538213\r\n"
+    "rdb_last_bgsave_status:ok\r\n"
+    "rdb_last_bgsave_time_sec:4\r\n"
+    "rdb_current_bgsave_time_sec:-1\r\n"
+    "aof_enabled:0\r\n"
+    "aof_rewrite_in_progress:0\r\n"
+    "aof_rewrite_scheduled:0\r\n"
+    "aof_last_rewrite_time_sec:-1\r\n"
+    "aof_current_rewrite_time_sec:-1\r\n"
+    "aof_last_bgrewrite_status:ok\r\n"
+    "aof_last_write_status:ok\r\n"
+    "\r\n"
+    "# Stats\r\n"
+    "total_connections_received:913204\r\n"
+    "total_commands_processed:2896311047\r\n"
+    "instantaneous_ops_per_sec:1721\r\n"
+    "total_net_input_bytes:214338766153\r\n"
+    "total_net_output_bytes:1061278127410\r\n"
+    "instantaneous_input_kbps:131.20\r\n"
+    "instantaneous_output_kbps:702.11\r\n"
+    "rejected_connections:0\r\n"
+    "sync_full:1\r\n"
+    "sync_partial_ok:0\r\n"
+    "sync_partial_err:0\r\n"
+    "expired_keys:3819274\r\n"
+    "evicted_keys:0\r\n"
+    "keyspace_hits:1489270395\r\n"
+    "keyspace_misses:203818475\r\n"
+    "pubsub_channels:4\r\n"
+    "pubsub_patterns:1\r\n"
+    "latest_fork_usec:27164\r\n"
+    "migrate_cached_sockets:0\r\n"
+    "\r\n"
+    "# Replication\r\n"
+    "role:master\r\n"
+    "connected_slaves:1\r\n"
+    "slave0:ip=10.0.0.12,port=6379,state=online,offset=98214457361,lag=1\r\n"
+    "master_repl_offset:98214457361\r\n"
+    "repl_backlog_active:1\r\n"
+    "repl_backlog_size:1048576\r\n"
+    "repl_backlog_first_byte_offset:98213408786\r\n"
+    "repl_backlog_histlen:1048576\r\n"
+    "\r\n"
+    "# CPU\r\n"
+    "used_cpu_sys:15329.42\r\n"
+    "used_cpu_user:9624.18\r\n"
+    "used_cpu_sys_children:731.05\r\n"
+    "used_cpu_user_children:5117.93\r\n"
+    "\r\n"
+    "# Commandstats\r\n"
+    "cmdstat_get:calls=1320127361,usec=2092377125,usec_per_call=1.58\r\n"
+    "cmdstat_set:calls=412836214,usec=1573962215,usec_per_call=3.81\r\n"
+    "cmdstat_del:calls=12836283,usec=52839912,usec_per_call=4.12\r\n"
+    "cmdstat_hget:calls=413902183,usec=762093511,usec_per_call=1.84\r\n"
+    "cmdstat_hset:calls=90384712,usec=331870022,usec_per_call=3.67\r\n"
+    "cmdstat_expire:calls=88127364,usec=153220013,usec_per_call=1.74\r\n"
+    "cmdstat_info:calls=1728542,usec=93120833,usec_per_call=53.87\r\n"
+    "cmdstat_scan:calls=172233,usec=48823122,usec_per_call=283.47\r\n"
+    "\r\n"
+    "# Keyspace\r\n"
+    "db0:keys=4218733,expires=1937212,avg_ttl=2731102\r\n"
+    "db3:keys=18234,expires=0,avg_ttl=0\r\n";
+
+const size_t parse_iterations = 100000;
+}  // namespace
+
+TEST(RedisServerInfo, parse_fields) {
+  std::unique_ptr<redis::ServerInfo> info(redis::MakeRedisServerInfo(redis_info_reply));
+  ASSERT_TRUE(info.get());
+  ASSERT_EQ(info->server_.redis_version_, "3.2.8");
+  ASSERT_EQ(info->server_.tcp_port_, 6379u);
+  ASSERT_EQ(info->clients_.blocked_clients_, 3u);
+  ASSERT_EQ(info->memory_.used_memory_, 1073283736u);
+  ASSERT_EQ(info->memory_.mem_allocator_, "jemalloc-4.0.3");
+  ASSERT_FLOAT_EQ(info->memory_.mem_fragmentation_ratio_, 1.06f);
+  ASSERT_EQ(info->persistence_.rdb_current_bgsave_time_sec_, -1);
+  ASSERT_EQ(info->stats_.keyspace_misses_, 203818475u);
+  ASSERT_EQ(info->replication_.role_, "master");
+  ASSERT_FLOAT_EQ(info->cpu_.used_cpu_user_children_, 5117.93f);
+
+  const redis::ServerInfo::section_fields_t* commandstats = info->OtherSection("Commandstats");
+  ASSERT_TRUE(commandstats);
+  ASSERT_EQ(commandstats->size(), 8u);
+  ASSERT_EQ(commandstats->front().first, "cmdstat_get");
+  ASSERT_EQ(commandstats->front().second, "calls=1320127361,usec=2092377125,usec_per_call=1.58");
+  const redis::ServerInfo::section_fields_t* keyspace = info->OtherSection("Keyspace");
+  ASSERT_TRUE(keyspace);
+  ASSERT_EQ(keyspace->size(), 2u);
+  ASSERT_EQ(keyspace->back().first, "db3");
+
+  std::unique_ptr<redis::ServerInfo> copy(redis::MakeRedisServerInfo(info->ToString()));
+  ASSERT_TRUE(copy.get());
+  ASSERT_EQ(copy->stats_.keyspace_hits_, info->stats_.keyspace_hits_);
+  ASSERT_EQ(copy->other_sections_.size(), info->other_sections_.size());
+}
+
+TEST(RedisServerInfo, parse_speed) {
+  const std::string reply = redis_info_reply;
+  size_t parsed = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < parse_iterations; ++i) {
+    std::unique_ptr<redis::ServerInfo> info(redis::MakeRedisServerInfo(reply));
+    parsed += info->clients_.connected_clients_ != 0;
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  ASSERT_EQ(parsed, parse_iterations);
+
+  const double nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  fastonosql::tests::ReportBenchmark("reply_bytes", reply.size());
+  fastonosql::tests::ReportBenchmark("nsec_per_reply", nsec / parse_iterations);
+  fastonosql::tests::ReportBenchmark("mib_per_sec", (reply.size() * parse_iterations) / (nsec / 1e9) / (1024 * 1024));
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace fastonosql {
+namespace tests {
+
+// results are test properties, run with --gtest_output=xml or json to collect them
+inline void ReportBenchmark(const std::string& name, double value) {
+  ::testing::Test::RecordProperty(name, std::to_string(value));
+}
+
+}  // namespace tests
+}  // namespace fastonosql
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <common/macros.h>
+
+#include "core/icommand_translator.h"
+
+namespace fastonosql {
+namespace tests {
+
+// translator without key commands, for command table and dispatch tests
+class FakeTranslator : public core::ICommandTranslator {
+ public:
+  explicit FakeTranslator(const std::vector<core::CommandHolder>& commands) : core::ICommandTranslator(commands) {}
+  virtual const char* GetDBName() const override { return "Fake"; }
+
+ private:
+  virtual common::Error CreateKeyCommandImpl(const core::NDbKValue& key,
+                                             core::command_buffer_t* cmdstring) const override {
+    UNUSED(key);
+    UNUSED(cmdstring);
+    return common::Error();
+  }
+  virtual common::Error LoadKeyCommandImpl(const core::NKey& key,
+                                           common::Value::Type type,
+                                           core::command_buffer_t* cmdstring) const override {
+    UNUSED(key);
+    UNUSED(type);
+    UNUSED(cmdstring);
+    return common::Error();
+  }
+  virtual common::Error DeleteKeyCommandImpl(const core::NKey& key, core::command_buffer_t* cmdstring) const override {
+    UNUSED(key);
+    UNUSED(cmdstring);
+    return common::Error();
+  }
+  virtual common::Error RenameKeyCommandImpl(const core::NKey& key,
+                                             const core::key_t& new_name,
+                                             core::command_buffer_t* cmdstring) const override {
+    UNUSED(key);
+    UNUSED(new_name);
+    UNUSED(cmdstring);
+    return common::Error();
+  }
+  virtual common::Error ChangeKeyTTLCommandImpl(const core::NKey& key,
+                                                core::ttl_t ttl,
+                                                core::command_buffer_t* cmdstring) const override {
+    UNUSED(key);
+    UNUSED(ttl);
+    UNUSED(cmdstring);
+    return common::Error();
+  }
+  virtual common::Error LoadKeyTTLCommandImpl(const core::NKey& key, core::command_buffer_t* cmdstring) const override {
+    UNUSED(key);
+    UNUSED(cmdstring);
+    return common::Error();
+  }
+
+  virtual bool IsLoadKeyCommandImpl(const core::CommandInfo& cmd) const override {
+    UNUSED(cmd);
+    return false;
+  }
+
+  virtual common::Error PublishCommandImpl(const core::NDbPSChannel& channel,
+                                           const std::string& message,
+                                           core::command_buffer_t* cmdstring) const override {
+    UNUSED(channel);
+    UNUSED(message);
+    UNUSED(cmdstring);
+    return common::Error();
+  }
+  virtual common::Error SubscribeCommandImpl(const core::NDbPSChannel& channel,
+                                             core::command_buffer_t* cmdstring) const override {
+    UNUSED(channel);
+    UNUSED(cmdstring);
+    return common::Error();
+  }
+};
+
+}  // namespace tests
+}  // namespace fastonosql
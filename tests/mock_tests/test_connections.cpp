@@ -47,6 +47,31 @@ void CheckSetGet(core::internal::CDBConnection<NConnection, Config, ContType>* d
   ASSERT_TRUE(db->IsConnected());
 }
 
+template <typename NConnection, typename Config, core::connectionTypes ContType>
+void CheckSnapshot(core::internal::CDBConnection<NConnection, Config, ContType>* db) {
+  core::NKey key(core::key_t("snapshot"));
+  core::NDbKValue res;
+  common::Error err = db->Set(core::NDbKValue(key, core::NValue(common::Value::CreateStringValue("before"))), &res);
+  ASSERT_TRUE(!err);
+  err = db->CreateSnapshot();
+  ASSERT_TRUE(!err);
+  err = db->Set(core::NDbKValue(key, core::NValue(common::Value::CreateStringValue("after"))), &res);
+  ASSERT_TRUE(!err);
+
+  core::NDbKValue loaded;
+  err = db->Get(key, &loaded);
+  ASSERT_TRUE(!err);
+  ASSERT_EQ(loaded.ValueString(), "before");
+
+  err = db->ReleaseSnapshot();
+  ASSERT_TRUE(!err);
+  err = db->Get(key, &loaded);
+  ASSERT_TRUE(!err);
+  ASSERT_EQ(loaded.ValueString(), "after");
+  err = db->ReleaseSnapshot();
+  ASSERT_TRUE(err && err->IsError());
+}
+
 TEST(Connection, leveldb) {
   core::leveldb::DBConnection db(nullptr);
   core::leveldb::Config lcfg;
@@ -65,6 +90,7 @@ TEST(Connection, leveldb) {
   ASSERT_TRUE(db.IsConnected());
 
   CheckSetGet(&db);
+  CheckSnapshot(&db);
 
   err = db.Disconnect();
   ASSERT_TRUE(!err);
@@ -92,6 +118,7 @@ TEST(Connection, rocksdb) {
   ASSERT_TRUE(db.IsConnected());
 
   CheckSetGet(&db);
+  CheckSnapshot(&db);
 
   err = db.Disconnect();
   ASSERT_TRUE(!err);
@@ -1,10 +1,15 @@
 #include <gtest/gtest.h>
 
+#include <string>
+
 #include <common/sprintf.h>
 
 #include "core/command_holder.h"
+#include "core/command_matcher.h"
 #include "core/internal/command_handler.h"
 
+#include "fake_translator.h"
+
 #define SET "SET"
 #define GET "GET"
 #define GET2 "GET2"
@@ -13,6 +18,7 @@
 #define GET_CONFIG_INVALID GET " " CONFIG "E"
 
 using namespace fastonosql;
+using fastonosql::tests::FakeTranslator;
 
 core::internal::CommandHandler* ghand = NULL;
 
@@ -44,74 +50,6 @@ static const std::vector<core::CommandHolder> cmds = {
                         &test),
     core::CommandHolder(GET2, "<key>", "Set the value of a key.", UNDEFINED_SINCE, UNDEFINED_EXAMPLE_STR, 1, 0, &test)};
 
-class FakeTranslator : public core::ICommandTranslator {
- public:
-  explicit FakeTranslator(const std::vector<core::CommandHolder>& commands) : core::ICommandTranslator(commands) {}
-  virtual const char* GetDBName() const override { return "Fake"; }
-
- private:
-  virtual common::Error CreateKeyCommandImpl(const core::NDbKValue& key,
-                                             core::command_buffer_t* cmdstring) const override {
-    UNUSED(key);
-    UNUSED(cmdstring);
-    return common::Error();
-  }
-  virtual common::Error LoadKeyCommandImpl(const core::NKey& key,
-                                           common::Value::Type type,
-                                           core::command_buffer_t* cmdstring) const override {
-    UNUSED(key);
-    UNUSED(type);
-    UNUSED(cmdstring);
-    return common::Error();
-  }
-  virtual common::Error DeleteKeyCommandImpl(const core::NKey& key, core::command_buffer_t* cmdstring) const override {
-    UNUSED(key);
-    UNUSED(cmdstring);
-    return common::Error();
-  }
-  virtual common::Error RenameKeyCommandImpl(const core::NKey& key,
-                                             const core::key_t& new_name,
-                                             core::command_buffer_t* cmdstring) const override {
-    UNUSED(key);
-    UNUSED(new_name);
-    UNUSED(cmdstring);
-    return common::Error();
-  }
-  virtual common::Error ChangeKeyTTLCommandImpl(const core::NKey& key,
-                                                core::ttl_t ttl,
-                                                core::command_buffer_t* cmdstring) const override {
-    UNUSED(key);
-    UNUSED(ttl);
-    UNUSED(cmdstring);
-    return common::Error();
-  }
-  virtual common::Error LoadKeyTTLCommandImpl(const core::NKey& key, core::command_buffer_t* cmdstring) const override {
-    UNUSED(key);
-    UNUSED(cmdstring);
-    return common::Error();
-  }
-
-  virtual bool IsLoadKeyCommandImpl(const core::CommandInfo& cmd) const override {
-    UNUSED(cmd);
-    return false;
-  }
-
-  virtual common::Error PublishCommandImpl(const core::NDbPSChannel& channel,
-                                           const std::string& message,
-                                           core::command_buffer_t* cmdstring) const override {
-    UNUSED(channel);
-    UNUSED(message);
-    UNUSED(cmdstring);
-    return common::Error();
-  }
-  virtual common::Error SubscribeCommandImpl(const core::NDbPSChannel& channel,
-                                             core::command_buffer_t* cmdstring) const override {
-    UNUSED(channel);
-    UNUSED(cmdstring);
-    return common::Error();
-  }
-};
-
 TEST(CommandHolder, execute) {
   FakeTranslator* ft = new FakeTranslator(cmds);
   core::internal::CommandHandler* hand = new core::internal::CommandHandler(ft);
@@ -146,3 +84,22 @@ TEST(CommandHolder, execute) {
 
   delete hand;
 }
+
+TEST(CommandMatcher, token_aligned_longest) {
+  core::CommandMatcher matcher({"GET", "CONFIG GET", "SET", "MGET", "get"});
+  ASSERT_EQ(matcher.PatternsCount(), 4u);
+
+  const std::string text = "mget a\nconfig get x\n  Get key\nforget GETX set";
+  core::CommandMatcher::matches_t matches = matcher.FindAll(text.data(), text.size());
+  ASSERT_EQ(matches.size(), 4u);
+  ASSERT_EQ(matches[0].offset, 0u);
+  ASSERT_EQ(matches[0].pattern_index, 3u);
+  ASSERT_EQ(text.substr(matches[1].offset, matches[1].length), "config get");
+  ASSERT_EQ(matches[1].pattern_index, 1u);
+  ASSERT_EQ(text.substr(matches[2].offset, matches[2].length), "Get");
+  ASSERT_EQ(matches[2].pattern_index, 0u);
+  ASSERT_EQ(text.substr(matches[3].offset, matches[3].length), "set");
+  ASSERT_EQ(matches[3].pattern_index, 2u);
+
+  ASSERT_TRUE(matcher.FindAll(text.data(), 0).empty());
+}
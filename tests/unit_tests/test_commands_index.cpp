@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <QString>
+
+#include <common/macros.h>
+
+#include "gui/commands_index.h"
+
+using namespace fastonosql;
+
+namespace {
+
+common::Error exec(core::internal::CommandHandler* handler, core::commands_args_t argv, core::FastoObject* out) {
+  UNUSED(handler);
+  UNUSED(argv);
+  UNUSED(out);
+  return common::Error();
+}
+
+core::CommandHolder makeCommand(const std::string& name, uint32_t since) {
+  return core::CommandHolder(name, "<args>", "Summary.", since, UNDEFINED_EXAMPLE_STR, 0, 1, &exec);
+}
+
+enum { GET, GETRANGE, CONFIG_GET, CONFIG_SET, CLIENT_LIST, CLIENT_PAUSE };
+
+const std::vector<core::CommandHolder> cmds = {makeCommand("GET", UNDEFINED_SINCE),
+                                               makeCommand("GETRANGE", PROJECT_VERSION_GENERATE(2, 4, 0)),
+                                               makeCommand("CONFIG GET", PROJECT_VERSION_GENERATE(2, 0, 0)),
+                                               makeCommand("CONFIG SET", PROJECT_VERSION_GENERATE(2, 0, 0)),
+                                               makeCommand("CLIENT LIST", PROJECT_VERSION_GENERATE(2, 4, 0)),
+                                               makeCommand("CLIENT PAUSE", PROJECT_VERSION_GENERATE(2, 9, 50))};
+
+gui::CommandsIndex::indexes_t complete(const gui::CommandsIndex& index, const QString& prefix, uint32_t version) {
+  gui::CommandsIndex::indexes_t out;
+  index.complete(gui::CommandsIndex::normalize(prefix), version, &out);
+  return out;
+}
+
+}  // namespace
+
+TEST(CommandsIndex, normalize) {
+  ASSERT_EQ(gui::CommandsIndex::normalize("  CONFIG   Get  "), QString("config get"));
+}
+
+TEST(CommandsIndex, complete) {
+  const gui::CommandsIndex index(cmds);
+  ASSERT_EQ(complete(index, QString(), UNDEFINED_SINCE).size(), cmds.size());
+  ASSERT_EQ(complete(index, "get", UNDEFINED_SINCE), gui::CommandsIndex::indexes_t({GET, GETRANGE}));
+  ASSERT_EQ(complete(index, "Config  ", UNDEFINED_SINCE), gui::CommandsIndex::indexes_t({CONFIG_GET, CONFIG_SET}));
+  ASSERT_EQ(complete(index, "config s", UNDEFINED_SINCE), gui::CommandsIndex::indexes_t({CONFIG_SET}));
+  ASSERT_TRUE(complete(index, "set", UNDEFINED_SINCE).empty());
+  ASSERT_EQ(index.name(CONFIG_SET), QString("CONFIG SET"));
+}
+
+TEST(CommandsIndex, complete_version_filter) {
+  const gui::CommandsIndex index(cmds);
+  // commands without version are always available
+  ASSERT_EQ(complete(index, "get", PROJECT_VERSION_GENERATE(2, 2, 0)), gui::CommandsIndex::indexes_t({GET}));
+  ASSERT_EQ(complete(index, "get", PROJECT_VERSION_GENERATE(2, 4, 0)), gui::CommandsIndex::indexes_t({GET, GETRANGE}));
+  ASSERT_TRUE(complete(index, "client", PROJECT_VERSION_GENERATE(2, 2, 0)).empty());
+  ASSERT_EQ(complete(index, "client", PROJECT_VERSION_GENERATE(2, 8, 0)),
+            gui::CommandsIndex::indexes_t({CLIENT_LIST}));
+  ASSERT_EQ(complete(index, "client", PROJECT_VERSION_GENERATE(3, 0, 0)),
+            gui::CommandsIndex::indexes_t({CLIENT_LIST, CLIENT_PAUSE}));
+  ASSERT_TRUE(complete(index, "client p", PROJECT_VERSION_GENERATE(2, 8, 0)).empty());
+}
+
+TEST(CommandsIndex, find) {
+  const gui::CommandsIndex index(cmds);
+  size_t found = 0;
+  ASSERT_TRUE(index.find("config get", &found));
+  ASSERT_EQ(found, static_cast<size_t>(CONFIG_GET));
+  ASSERT_TRUE(index.find("  CONFIG  GET ", &found));
+  ASSERT_EQ(found, static_cast<size_t>(CONFIG_GET));
+  ASSERT_TRUE(index.find("GetRange", &found));
+  ASSERT_EQ(found, static_cast<size_t>(GETRANGE));
+
+  ASSERT_FALSE(index.find("config", &found));
+  ASSERT_FALSE(index.find("getr", &found));
+  ASSERT_FALSE(index.find("config get maxmemory", &found));
+}
+
+TEST(CommandsIndex, longest_prefix) {
+  const gui::CommandsIndex index(cmds);
+  size_t found = 0;
+  int length = 0;
+  ASSERT_TRUE(index.findLongestPrefixOf("config get maxmemory", &found, &length));
+  ASSERT_EQ(found, static_cast<size_t>(CONFIG_GET));
+  ASSERT_EQ(length, 10);
+
+  ASSERT_TRUE(index.findLongestPrefixOf("getrange key 0 1", &found, &length));
+  ASSERT_EQ(found, static_cast<size_t>(GETRANGE));
+  ASSERT_EQ(length, 8);
+
+  ASSERT_TRUE(index.findLongestPrefixOf("get key", &found, &length));
+  ASSERT_EQ(found, static_cast<size_t>(GET));
+  ASSERT_EQ(length, 3);
+
+  ASSERT_TRUE(index.findLongestPrefixOf("client pause", &found, &length));
+  ASSERT_EQ(found, static_cast<size_t>(CLIENT_PAUSE));
+  ASSERT_EQ(length, 12);
+
+  // only whole words match
+  ASSERT_FALSE(index.findLongestPrefixOf("getr key", &found, &length));
+  ASSERT_FALSE(index.findLongestPrefixOf("configs get", &found, &length));
+  ASSERT_FALSE(index.findLongestPrefixOf("client", &found, &length));
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include <stdio.h>  // for remove
+
+#include "core/data_dump.h"
+
+using namespace fastonosql::core;
+
+namespace {
+const char dump_path[] = "test_data_dump.tmp";
+
+void writeDump(const std::string& content) {
+  FILE* file = fopen(dump_path, "wb");
+  ASSERT_TRUE(file);
+  ASSERT_EQ(fwrite(content.data(), 1, content.size(), file), content.size());
+  fclose(file);
+}
+
+void readDump(DumpFormat format, NDbKValues* records) {
+  DumpReader reader(format);
+  ASSERT_FALSE(reader.Open(dump_path));
+  while (true) {
+    NDbKValue record;
+    bool eof = false;
+    ASSERT_FALSE(reader.Next(&record, &eof));
+    if (eof) {
+      break;
+    }
+    records->push_back(record);
+  }
+  ASSERT_EQ(reader.BytesRead(), reader.Size());
+}
+}  // namespace
+
+TEST(DataDump, format_from_path) {
+  DumpFormat format;
+  ASSERT_TRUE(DumpFormatFromPath("/tmp/appendonly.aof", &format));
+  ASSERT_EQ(format, DUMP_RESP);
+  ASSERT_TRUE(DumpFormatFromPath("keys.JSONL", &format));
+  ASSERT_EQ(format, DUMP_JSON_LINES);
+  ASSERT_TRUE(DumpFormatFromPath("keys.csv", &format));
+  ASSERT_EQ(format, DUMP_CSV);
+  ASSERT_FALSE(DumpFormatFromPath("dump.rdb", &format));
+}
+
+TEST(DataDump, resp) {
+  const std::string big_value(DUMP_READ_BUFFER_SIZE + 10, 'v');  // crosses the read buffer
+  writeDump("*2\r\n$6\r\nSELECT\r\n$1\r\n0\r\n"
+            "*3\r\n$3\r\nSET\r\n$3\r\nkey\r\n$7\r\nva\r\nlue\r\n"
+            "*3\r\n$3\r\nset\r\n$3\r\nbig\r\n$" + std::to_string(big_value.size()) + "\r\n" + big_value + "\r\n"
+            "*5\r\n$3\r\nSET\r\n$1\r\na\r\n$1\r\nb\r\n$2\r\nPX\r\n$4\r\n1500\r\n"
+            "SETEX inline 10 value\n");
+  NDbKValues records;
+  readDump(DUMP_RESP, &records);
+  ASSERT_EQ(records.size(), 4u);
+  ASSERT_EQ(records[0].GetKey().GetKey().ToBytes(), "key");
+  ASSERT_EQ(records[0].ValueString(), "va\r\nlue");
+  ASSERT_EQ(records[0].GetKey().GetTTL(), NO_TTL);
+  ASSERT_EQ(records[1].ValueString(), big_value);
+  ASSERT_EQ(records[2].GetKey().GetTTL(), 2);
+  ASSERT_EQ(records[3].GetKey().GetKey().ToBytes(), "inline");
+  ASSERT_EQ(records[3].GetKey().GetTTL(), 10);
+
+  writeDump("HSET hash field value\n");
+  DumpReader reader(DUMP_RESP);
+  ASSERT_FALSE(reader.Open(dump_path));
+  NDbKValue record;
+  bool eof = false;
+  ASSERT_TRUE(reader.Next(&record, &eof));
+  remove(dump_path);
+}
+
+TEST(DataDump, csv) {
+  writeDump("key,value,ttl\r\nplain,text,\n\"with,comma\",\"say \"\"hi\"\"\",5\n\nmulti,\"line\nvalue\"\n");
+  NDbKValues records;
+  readDump(DUMP_CSV, &records);
+  ASSERT_EQ(records.size(), 3u);
+  ASSERT_EQ(records[0].GetKey().GetKey().ToBytes(), "plain");
+  ASSERT_EQ(records[0].GetKey().GetTTL(), NO_TTL);
+  ASSERT_EQ(records[1].GetKey().GetKey().ToBytes(), "with,comma");
+  ASSERT_EQ(records[1].ValueString(), "say \"hi\"");
+  ASSERT_EQ(records[1].GetKey().GetTTL(), 5);
+  ASSERT_EQ(records[2].ValueString(), "line\nvalue");
+  remove(dump_path);
+}
+
+TEST(DataDump, archive_resume) {
+  const char archive_path[] = "test_data_dump" DUMP_ARCHIVE_EXTENSION;
+  remove(archive_path);
+  const std::string value(1000, 'x');  // about a thousand records per chunk
+  std::string position;
+  {
+    DumpArchiveWriter writer(LEVELDB, DUMP_RAW_VALUES);
+    ASSERT_FALSE(writer.Open(archive_path, &position));
+    ASSERT_TRUE(position.empty());
+    for (int i = 0; i < 2500; ++i) {
+      const std::string key = std::to_string(100000 + i);
+      NDbKValue record(NKey(fastonosql::core::key_t(key), i % 2 ? 10 : NO_TTL), NValue(common::Value::CreateStringValue(value)));
+      ASSERT_FALSE(writer.Append(record, key));
+    }
+  }  // interrupted, the last chunk is not written
+
+  FILE* file = fopen(archive_path, "ab");
+  ASSERT_TRUE(file);
+  fseek(file, 0, SEEK_END);
+  const long valid_size = ftell(file);
+  fputs("torn chunk", file);
+  fclose(file);
+
+  {  // the torn tail is cut off even if nothing is appended after it
+    DumpArchiveWriter writer(LEVELDB, DUMP_RAW_VALUES);
+    ASSERT_FALSE(writer.Open(archive_path, &position));
+    ASSERT_FALSE(position.empty());
+  }
+  file = fopen(archive_path, "rb");
+  ASSERT_TRUE(file);
+  fseek(file, 0, SEEK_END);
+  ASSERT_EQ(ftell(file), valid_size);
+  fclose(file);
+
+  {
+    DumpArchiveWriter writer(LEVELDB, DUMP_RAW_VALUES);
+    ASSERT_FALSE(writer.Open(archive_path, &position));
+    ASSERT_FALSE(position.empty());
+    int next = std::stoi(position) - 100000 + 1;
+    ASSERT_EQ(writer.RecordsCount(), static_cast<uint64_t>(next));
+    for (int i = next; i < 3000; ++i) {
+      const std::string key = std::to_string(100000 + i);
+      NDbKValue record(NKey(fastonosql::core::key_t(key), i % 2 ? 10 : NO_TTL), NValue(common::Value::CreateStringValue(value)));
+      ASSERT_FALSE(writer.Append(record, key));
+    }
+    ASSERT_FALSE(writer.Finish());
+    ASSERT_EQ(writer.RecordsCount(), 3000u);
+  }
+
+  DumpFormat format;
+  ASSERT_TRUE(DumpFormatFromPath(archive_path, &format));
+  DumpReader reader(format);
+  ASSERT_FALSE(reader.Open(archive_path));
+  ASSERT_EQ(reader.ValueEncoding(), DUMP_RAW_VALUES);
+  for (int i = 0; i < 3000; ++i) {
+    NDbKValue record;
+    bool eof = false;
+    ASSERT_FALSE(reader.Next(&record, &eof));
+    ASSERT_FALSE(eof);
+    ASSERT_EQ(record.GetKey().GetKey().ToBytes(), std::to_string(100000 + i));
+    ASSERT_EQ(record.GetKey().GetTTL(), i % 2 ? 10 : NO_TTL);
+    ASSERT_EQ(record.ValueString(), value);
+  }
+  NDbKValue record;
+  bool eof = false;
+  ASSERT_FALSE(reader.Next(&record, &eof));
+  ASSERT_TRUE(eof);
+
+  // finished archive is started over
+  DumpArchiveWriter writer(LEVELDB, DUMP_RAW_VALUES);
+  ASSERT_FALSE(writer.Open(archive_path, &position));
+  ASSERT_TRUE(position.empty());
+  writer.Close();
+  remove(archive_path);
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <stdio.h>  // for remove
+
+#include "core/keys_cache.h"
+
+using namespace fastonosql::core;
+
+namespace {
+const char cache_path[] = "test_keys_cache.bin";
+
+KeysCacheEntry makeEntry(const std::string& key, common::Value::Type type, ttl_t ttl) {
+  KeysCacheEntry entry;
+  entry.key = key;
+  entry.type = type;
+  entry.ttl = ttl;
+  entry.loaded_msec = 1000;
+  return entry;
+}
+}  // namespace
+
+TEST(KeysCache, put_remove_reset) {
+  remove(cache_path);
+  {
+    KeysCacheWriter writer(cache_path, REDIS);
+    ASSERT_FALSE(writer.Open());
+    keys_cache_entries_t entries;
+    entries.push_back(makeEntry("b", common::Value::TYPE_STRING, NO_TTL));
+    entries.push_back(makeEntry(std::string("a\0z", 3), common::Value::TYPE_HASH, 100));
+    entries.push_back(makeEntry("c", common::Value::TYPE_SET, NO_TTL));
+    ASSERT_FALSE(writer.Put("0", entries));
+    ASSERT_FALSE(writer.Put("1", entries));
+    ASSERT_FALSE(writer.Remove("0", std::vector<std::string>(1, "c")));
+    ASSERT_FALSE(writer.Reset("1"));
+  }
+
+  keys_cache_entries_t out;
+  ASSERT_FALSE(ReadKeysCache(cache_path, REDIS, "0", &out));
+  ASSERT_EQ(out.size(), 2u);
+  ASSERT_EQ(out[0].key, std::string("a\0z", 3));
+  ASSERT_EQ(out[0].type, common::Value::TYPE_HASH);
+  ASSERT_EQ(out[0].ttl, 100);
+  ASSERT_EQ(out[1].key, "b");
+
+  ASSERT_FALSE(ReadKeysCache(cache_path, REDIS, "1", &out));
+  ASSERT_TRUE(out.empty());
+  ASSERT_TRUE(ReadKeysCache(cache_path, SSDB, "0", &out));  // other connection type
+
+  remove(cache_path);
+}
+
+TEST(KeysCache, ttl_count_down) {
+  const KeysCacheEntry entry = makeEntry("a", common::Value::TYPE_HASH, 100);
+  NDbKValue key = entry.ToKey(31000);
+  ASSERT_EQ(key.GetKey().GetTTL(), 70);
+  ASSERT_EQ(key.GetType(), common::Value::TYPE_HASH);
+  ASSERT_EQ(entry.ToKey(200000).GetKey().GetTTL(), EXPIRED_TTL);
+  ASSERT_EQ(makeEntry("b", common::Value::TYPE_STRING, NO_TTL).ToKey(200000).GetKey().GetTTL(), NO_TTL);
+}
+
+TEST(KeysCache, compaction_and_torn_tail) {
+  remove(cache_path);
+  {
+    KeysCacheWriter writer(cache_path, REDIS);
+    ASSERT_FALSE(writer.Open());
+    for (int i = 0; i < 100; ++i) {
+      ASSERT_FALSE(writer.Put("0", keys_cache_entries_t(1, makeEntry("key", common::Value::TYPE_STRING, i))));
+    }
+  }
+
+  FILE* file = fopen(cache_path, "rb");
+  ASSERT_TRUE(file);
+  fseek(file, 0, SEEK_END);
+  const long full_size = ftell(file);
+  fclose(file);
+
+  {
+    KeysCacheWriter writer(cache_path, REDIS);  // keeps only the live entry
+    ASSERT_FALSE(writer.Open());
+    ASSERT_FALSE(writer.Put("0", keys_cache_entries_t(1, makeEntry("other", common::Value::TYPE_STRING, NO_TTL))));
+  }
+
+  file = fopen(cache_path, "rb");
+  ASSERT_TRUE(file);
+  fseek(file, 0, SEEK_END);
+  const long compacted_size = ftell(file);
+  fclose(file);
+  ASSERT_LT(compacted_size, full_size);
+  ASSERT_FALSE(fopen((std::string(cache_path) + ".tmp").c_str(), "rb"));  // renamed over the cache
+
+  file = fopen(cache_path, "ab");  // interrupted put record
+  ASSERT_TRUE(file);
+  const char torn[] = {1, 1, '0', 5, 3, 'k'};
+  fwrite(torn, 1, sizeof(torn), file);
+  fclose(file);
+
+  keys_cache_entries_t out;
+  ASSERT_FALSE(ReadKeysCache(cache_path, REDIS, "0", &out));
+  ASSERT_EQ(out.size(), 2u);
+  ASSERT_EQ(out[0].key, "key");
+  ASSERT_EQ(out[0].ttl, 99);
+  ASSERT_EQ(out[1].key, "other");
+  remove(cache_path);
+}
@@ -8,6 +8,9 @@ extern "C" {
 
 #include <string.h>
 
+#include "core/script_reader.h"
+#include "core/types.h"
+
 TEST(sds, sdssplitargslong) {
   const std::string json = R"({
                              "array": [
@@ -86,3 +89,55 @@ TEST(sds, sdssplitargslong) {
     sdsfreesplitres(argv, argc);
   }
 }
+
+TEST(types, ParseCommandLine) {
+  ASSERT_EQ(fastonosql::core::StableCommand("  SET   key  value\r"), "SET key value");
+  ASSERT_EQ(fastonosql::core::StableCommand("GET \\x61\\x62"), "GET \"\\x61\\x62\"");
+  ASSERT_EQ(fastonosql::core::StableCommand("   "), "");
+
+  fastonosql::core::commands_args_t argv;
+  ASSERT_FALSE(fastonosql::core::ParseCommandLine("   ", &argv));
+  ASSERT_TRUE(fastonosql::core::ParseCommandLine("SET  key \"big value\"", &argv));
+  ASSERT_EQ(argv.size(), 3u);
+  ASSERT_EQ(argv[0], "SET");
+  ASSERT_EQ(argv[1], "key");
+  ASSERT_EQ(argv[2], "big value");
+}
+
+TEST(types, ScriptReader) {
+  const char script_path[] = "test_script_reader.tmp";
+  FILE* file = fopen(script_path, "wb");
+  ASSERT_TRUE(file);
+  const std::string script = "SET a 1\r\n\n   \nGET  a\nDEL a";
+  ASSERT_EQ(fwrite(script.data(), 1, script.size(), file), script.size());
+  fclose(file);
+
+  fastonosql::core::ScriptReader reader;
+  ASSERT_FALSE(reader.Open(script_path));
+  fastonosql::core::command_buffer_t command;
+  bool eof = false;
+  ASSERT_FALSE(reader.Next(&command, &eof));
+  ASSERT_FALSE(eof);
+  ASSERT_EQ(command, "SET a 1");
+  ASSERT_EQ(reader.LineNumber(), 1u);
+  ASSERT_FALSE(reader.Next(&command, &eof));
+  ASSERT_EQ(command, "GET a");
+  ASSERT_EQ(reader.LineNumber(), 4u);
+  ASSERT_FALSE(reader.Next(&command, &eof));
+  ASSERT_EQ(command, "DEL a");
+  ASSERT_FALSE(reader.Next(&command, &eof));
+  ASSERT_TRUE(eof);
+  ASSERT_EQ(reader.BytesRead(), reader.Size());
+
+  // resume after the interrupted second command
+  ASSERT_FALSE(reader.Open(script_path));
+  ASSERT_FALSE(reader.SkipTo(5));
+  ASSERT_FALSE(reader.Next(&command, &eof));
+  ASSERT_EQ(command, "DEL a");
+  ASSERT_EQ(reader.LineNumber(), 5u);
+
+  ASSERT_FALSE(reader.Open(script_path));
+  ASSERT_TRUE(reader.SkipTo(7));
+  reader.Close();
+  remove(script_path);
+}
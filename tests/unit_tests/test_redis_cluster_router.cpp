@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include "core/db/redis/cluster_router.h"
+
+using namespace fastonosql::core;
+
+TEST(RedisClusterRouter, key_hash_slot) {
+  ASSERT_EQ(redis::KeyHashSlot("123456789"), 0x31C3 & (REDIS_CLUSTER_SLOTS_COUNT - 1));
+  ASSERT_EQ(redis::KeyHashSlot("foo"), 12182);
+  ASSERT_EQ(redis::KeyHashSlot("{user1000}.following"), redis::KeyHashSlot("{user1000}.followers"));
+  ASSERT_EQ(redis::KeyHashSlot("{user1000}.following"), redis::KeyHashSlot("user1000"));
+  ASSERT_EQ(redis::KeyHashSlot("foo{}{bar}"), redis::KeyHashSlot(std::string("foo{}{bar}")));
+  ASSERT_NE(redis::KeyHashSlot("foo{}{bar}"), redis::KeyHashSlot("bar"));
+  ASSERT_EQ(redis::KeyHashSlot("foo{{bar}}zap"), redis::KeyHashSlot("{bar"));
+}
+
+TEST(RedisClusterRouter, parse_redirect) {
+  redis::ClusterRedirect redirect;
+  ASSERT_TRUE(redis::ParseClusterRedirect("MOVED 3999 127.0.0.1:6381", &redirect));
+  ASSERT_FALSE(redirect.ask);
+  ASSERT_EQ(redirect.slot, 3999);
+  ASSERT_EQ(redirect.host.host, "127.0.0.1");
+  ASSERT_EQ(redirect.host.port, 6381);
+
+  ASSERT_TRUE(redis::ParseClusterRedirect("ASK 12182 ::1:7002", &redirect));
+  ASSERT_TRUE(redirect.ask);
+  ASSERT_EQ(redirect.slot, 12182);
+  ASSERT_EQ(redirect.host.host, "::1");
+  ASSERT_EQ(redirect.host.port, 7002);
+
+  ASSERT_FALSE(redis::ParseClusterRedirect("ERR unknown command", &redirect));
+  ASSERT_FALSE(redis::ParseClusterRedirect("MOVED 99999 127.0.0.1:6381", &redirect));
+  ASSERT_FALSE(redis::ParseClusterRedirect("MOVED 3999 127.0.0.1", &redirect));
+}
+
+TEST(RedisClusterRouter, slots_map) {
+  redis::ClusterSlotsMap slots;
+  ASSERT_TRUE(slots.IsEmpty());
+
+  common::net::HostAndPort first("127.0.0.1", 7000);
+  common::net::HostAndPort second("127.0.0.1", 7001);
+  slots.SetSlots(0, 8191, first);
+  slots.SetSlots(8192, REDIS_CLUSTER_SLOTS_COUNT - 1, second);
+  ASSERT_EQ(slots.Nodes().size(), 2u);
+
+  common::net::HostAndPort host;
+  ASSERT_TRUE(slots.FindNode(0, &host));
+  ASSERT_EQ(host.port, 7000);
+  ASSERT_TRUE(slots.FindNode(12182, &host));
+  ASSERT_EQ(host.port, 7001);
+
+  slots.SetSlots(12182, 12182, first);  // MOVED
+  ASSERT_TRUE(slots.FindNode(12182, &host));
+  ASSERT_EQ(host.port, 7000);
+  ASSERT_EQ(slots.Nodes().size(), 2u);
+
+  slots.Clear();
+  ASSERT_TRUE(slots.IsEmpty());
+  ASSERT_FALSE(slots.FindNode(0, &host));
+}
+
+TEST(RedisClusterRouter, command_keys_slot) {
+  bool has_keys = true;
+  uint16_t slot = 0;
+  common::Error err = redis::CommandKeysSlot({"PING"}, redis::ClusterKeySpec(), &has_keys, &slot);
+  ASSERT_FALSE(err);
+  ASSERT_FALSE(has_keys);
+
+  err = redis::CommandKeysSlot({"GET", "foo"}, redis::ClusterKeySpec(1, 1, 1), &has_keys, &slot);
+  ASSERT_FALSE(err);
+  ASSERT_TRUE(has_keys);
+  ASSERT_EQ(slot, 12182);
+
+  const redis::ClusterKeySpec mset(1, -1, 2);
+  err = redis::CommandKeysSlot({"MSET", "{user1000}.a", "1", "{user1000}.b", "2"}, mset, &has_keys, &slot);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(slot, redis::KeyHashSlot("user1000"));
+
+  err = redis::CommandKeysSlot({"MSET", "foo", "bar", "bar", "foo"}, mset, &has_keys, &slot);
+  ASSERT_TRUE(err && err->IsError());
+
+  const redis::ClusterKeySpec del(1, -1, 1);
+  err = redis::CommandKeysSlot({"DEL", "foo", "{foo}.bar"}, del, &has_keys, &slot);
+  ASSERT_FALSE(err);
+  err = redis::CommandKeysSlot({"DEL", "foo", "bar"}, del, &has_keys, &slot);
+  ASSERT_TRUE(err && err->IsError());
+}
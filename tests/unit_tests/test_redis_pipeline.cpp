@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/db/redis/db_connection.h"
+
+using namespace fastonosql;
+
+namespace {
+
+class PipelineCommand : public core::FastoObjectCommand {
+ public:
+  explicit PipelineCommand(const std::string& cmd)
+      : core::FastoObjectCommand(nullptr,
+                                 common::Value::CreateStringValue(cmd),
+                                 core::C_INNER,
+                                 std::string(),
+                                 core::REDIS) {}
+};
+
+// answers GET with the key name, GET of "bad" with an error and anything else with OK,
+// keeps the names of received commands
+class FakeRedisServer {
+ public:
+  FakeRedisServer() : listen_fd_(socket(AF_INET, SOCK_STREAM, 0)), port_(0) {
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), len) == 0 && listen(listen_fd_, 1) == 0 &&
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len) == 0) {
+      port_ = ntohs(addr.sin_port);
+      thread_ = std::thread(&FakeRedisServer::Serve, this);
+    }
+  }
+
+  ~FakeRedisServer() {
+    shutdown(listen_fd_, SHUT_RDWR);
+    close(listen_fd_);
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  uint16_t port() const { return port_; }
+
+  std::vector<std::string> received() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return received_;
+  }
+
+ private:
+  void Serve() {
+    int fd = accept(listen_fd_, nullptr, nullptr);
+    if (fd < 0) {
+      return;
+    }
+
+    std::string buff;
+    char chunk[4096];
+    ssize_t nread;
+    while ((nread = read(fd, chunk, sizeof(chunk))) > 0) {
+      buff.append(chunk, nread);
+      std::vector<std::string> argv;
+      size_t used;
+      while ((used = ParseCommand(buff, &argv)) != 0) {
+        buff.erase(0, used);
+        const std::string reply = MakeReply(argv);
+        if (write(fd, reply.data(), reply.size()) != static_cast<ssize_t>(reply.size())) {
+          break;
+        }
+      }
+    }
+    close(fd);
+  }
+
+  // RESP array of bulk strings, returns consumed size or 0 if the command isn't complete
+  static size_t ParseCommand(const std::string& buff, std::vector<std::string>* argv) {
+    argv->clear();
+    size_t pos = buff.find("\r\n");
+    if (buff.empty() || buff[0] != '*' || pos == std::string::npos) {
+      return 0;
+    }
+
+    const long argc = std::stol(buff.substr(1, pos - 1));
+    pos += 2;
+    for (long i = 0; i < argc; ++i) {
+      size_t end = buff.find("\r\n", pos);
+      if (end == std::string::npos) {
+        return 0;
+      }
+
+      const size_t len = std::stoul(buff.substr(pos + 1, end - pos - 1));
+      pos = end + 2;
+      if (buff.size() < pos + len + 2) {
+        return 0;
+      }
+
+      argv->push_back(buff.substr(pos, len));
+      pos += len + 2;
+    }
+    return pos;
+  }
+
+  std::string MakeReply(const std::vector<std::string>& argv) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      received_.push_back(argv.empty() ? std::string() : argv.back());
+    }
+
+    if (argv.size() != 2 || argv[0] != "GET") {
+      return "+OK\r\n";
+    }
+
+    if (argv[1] == "bad") {
+      return "-ERR bad key\r\n";
+    }
+
+    return "$" + std::to_string(argv[1].size()) + "\r\n" + argv[1] + "\r\n";
+  }
+
+  int listen_fd_;
+  uint16_t port_;
+  std::thread thread_;
+  std::mutex mutex_;
+  std::vector<std::string> received_;
+};
+
+}  // namespace
+
+TEST(RedisPipeline, error_reply_stops_sending_and_keeps_connection_in_sync) {
+  FakeRedisServer server;
+  ASSERT_NE(server.port(), 0);
+
+  core::redis::RConfig config;
+  config.host = common::net::HostAndPort("127.0.0.1", server.port());
+  config.pipeline_window = 2;
+  core::redis::DBConnection db(nullptr);
+  common::Error err = db.Connect(config);
+  ASSERT_FALSE(err && err->IsError());
+
+  std::vector<core::FastoObjectCommandIPtr> cmds = {new PipelineCommand("GET a"), new PipelineCommand("GET bad"),
+                                                    new PipelineCommand("GET c"), new PipelineCommand("GET d")};
+  err = db.ExecuteAsPipeline(cmds, nullptr);
+  ASSERT_TRUE(err && err->IsError());
+  ASSERT_EQ(err->Description(), "ERR bad key");
+
+  // "c" was in flight when the error came, its reply is read, "d" isn't sent at all
+  ASSERT_EQ(cmds[0]->Childrens().size(), 1u);
+  ASSERT_EQ(cmds[2]->Childrens().size(), 1u);
+  ASSERT_EQ(cmds[2]->Childrens()[0]->ToString(), "c");
+  ASSERT_TRUE(cmds[3]->Childrens().empty());
+
+  // next pipeline reads its own replies
+  std::vector<core::FastoObjectCommandIPtr> next = {new PipelineCommand("GET e")};
+  err = db.ExecuteAsPipeline(next, nullptr);
+  ASSERT_FALSE(err && err->IsError());
+  ASSERT_EQ(next[0]->Childrens().size(), 1u);
+  ASSERT_EQ(next[0]->Childrens()[0]->ToString(), "e");
+
+  const std::vector<std::string> received = server.received();
+  ASSERT_EQ(std::count(received.begin(), received.end(), "d"), 0);
+  err = db.Disconnect();
+  ASSERT_FALSE(err && err->IsError());
+}
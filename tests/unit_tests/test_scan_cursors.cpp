@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include "core/internal/cdb_connection.h"
+
+using namespace fastonosql::core;
+
+TEST(ScanCursors, pattern_prefix) {
+  ASSERT_EQ(internal::GetKeysPatternPrefix("*"), "");
+  ASSERT_EQ(internal::GetKeysPatternPrefix("user:*"), "user:");
+  ASSERT_EQ(internal::GetKeysPatternPrefix("user:?:name"), "user:");
+  ASSERT_EQ(internal::GetKeysPatternPrefix("user:[ab]*"), "user:");
+  ASSERT_EQ(internal::GetKeysPatternPrefix("user\\*"), "user");
+  ASSERT_EQ(internal::GetKeysPatternPrefix("user:1"), "user:1");
+
+  ASSERT_TRUE(internal::IsKeyHasPrefix("user:1", "user:"));
+  ASSERT_TRUE(internal::IsKeyHasPrefix("user:1", ""));
+  ASSERT_FALSE(internal::IsKeyHasPrefix("use", "user:"));
+  ASSERT_FALSE(internal::IsKeyHasPrefix("group:1", "user:"));
+}
+
+TEST(ScanCursors, cache) {
+  internal::ScanCursorCache cache;
+  std::string last_key;
+  ASSERT_FALSE(cache.Find(0, &last_key));
+
+  const uint64_t first = cache.Save("alex");
+  const uint64_t second = cache.Save("palec");
+  ASSERT_NE(first, 0u);
+  ASSERT_NE(first, second);
+  ASSERT_TRUE(cache.Find(first, &last_key));
+  ASSERT_EQ(last_key, "alex");
+  ASSERT_TRUE(cache.Find(second, &last_key));
+  ASSERT_EQ(last_key, "palec");
+
+  cache.Clear();
+  ASSERT_FALSE(cache.Find(first, &last_key));
+}
+
+TEST(ScanCursors, snapshot_lives_with_cursors) {
+  int released = 0;
+  internal::ScanCursorCache cache;
+  std::string last_key;
+  {
+    internal::scan_snapshot_t snapshot(&released, [](int* counter) { ++*counter; });
+    const uint64_t first = cache.Save("alex", snapshot);
+    const uint64_t second = cache.Save("palec", snapshot);
+    internal::scan_snapshot_t other(&released, [](int* counter) { ++*counter; });
+    const uint64_t third = cache.Save("sasha", other);
+    snapshot.reset();
+    other.reset();
+
+    internal::scan_snapshot_t found;
+    ASSERT_TRUE(cache.Find(second, &last_key, &found));
+    ASSERT_EQ(found.get(), &released);
+    found.reset();
+
+    cache.Erase(first);
+    ASSERT_EQ(released, 0);
+    cache.Erase(second);  // other pagination keeps its own snapshot
+    ASSERT_EQ(released, 1);
+    ASSERT_TRUE(cache.Find(third, &last_key));
+  }
+
+  cache.Clear();
+  ASSERT_EQ(released, 2);
+}
+
+TEST(ScanCursors, evicted_cursor_releases_snapshot) {
+  int released = 0;
+  internal::ScanCursorCache cache;
+  const uint64_t first = cache.Save("alex", internal::scan_snapshot_t(&released, [](int* counter) { ++*counter; }));
+  for (size_t i = 0; i < 1024; ++i) {
+    cache.Save("palec");
+  }
+
+  std::string last_key;
+  ASSERT_FALSE(cache.Find(first, &last_key));
+  ASSERT_EQ(released, 1);
+}
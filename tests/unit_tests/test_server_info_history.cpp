@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <stdio.h>  // for remove
+
+#include "core/server/server_info_history.h"
+
+using namespace fastonosql::core;
+
+namespace {
+const char history_path[] = "test_server_info_history.bin";
+
+ServerInfoHistoryRow makeRow(int i) {
+  ServerInfoHistoryRow row;
+  row.msec = 1000 + i * 1000;
+  row.values.push_back(i * 3 - 100);
+  row.values.push_back(i * 0.5);
+  return row;
+}
+}  // namespace
+
+TEST(ServerInfoHistory, write_read) {
+  remove(history_path);
+  server_info_history_columns_t columns;
+  columns.push_back(ServerInfoHistoryColumn(0, 1, false));
+  columns.push_back(ServerInfoHistoryColumn(2, 3, true));
+
+  {
+    ServerInfoHistoryWriter writer(history_path, REDIS, columns);
+    ASSERT_FALSE(writer.Open());
+    for (int i = 0; i < 5000; ++i) {
+      ASSERT_FALSE(writer.Append(makeRow(i)));
+    }
+  }
+  {
+    ServerInfoHistoryWriter writer(history_path, REDIS, columns);  // continues the last block
+    ASSERT_FALSE(writer.Open());
+    for (int i = 5000; i < 6000; ++i) {
+      ASSERT_FALSE(writer.Append(makeRow(i)));
+    }
+  }
+
+  ServerInfoHistory history;
+  ASSERT_FALSE(ReadServerInfoHistory(history_path, REDIS, 0, 0, 0, &history));
+  ASSERT_EQ(history.RowsCount(), 6000u);
+  const ServerInfoHistory::values_t* integers = history.ColumnValues(0, 1);
+  const ServerInfoHistory::values_t* doubles = history.ColumnValues(2, 3);
+  ASSERT_TRUE(integers && doubles);
+  ASSERT_FALSE(history.ColumnValues(1, 1));
+  for (int i = 0; i < 6000; ++i) {
+    ASSERT_EQ(history.Stamps()[i], 1000 + i * 1000);
+    ASSERT_EQ((*integers)[i], i * 3 - 100);
+    ASSERT_EQ((*doubles)[i], i * 0.5);
+  }
+
+  ASSERT_FALSE(ReadServerInfoHistory(history_path, REDIS, 101000, 200000, 0, &history));
+  ASSERT_EQ(history.RowsCount(), 100u);
+  ASSERT_EQ(history.Stamps().front(), 101000);
+
+  // buckets of ten rows
+  ASSERT_FALSE(ReadServerInfoHistory(history_path, REDIS, 1000, 0, 10000, &history));
+  ASSERT_EQ(history.RowsCount(), 600u);
+  ASSERT_EQ((*history.ColumnValues(0, 1))[0], -86.5);
+
+  ASSERT_TRUE(ReadServerInfoHistory(history_path, MEMCACHED, 0, 0, 0, &history));
+  remove(history_path);
+}